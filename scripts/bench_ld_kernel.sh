@@ -0,0 +1,36 @@
+#!/bin/bash
+# Benchmark: plink_ld pair kernels. Generates a dense-LD-window fixture and
+# A/B-times a windowed `plink_ld` scan under plinking_ld_kernel = scalar (the
+# reference per-sample loop), popcount (portable bitplane kernel) and auto (the
+# widest SIMD popcount variant this CPU supports), using DuckDB's `.timer on`.
+#
+# NOT a pass/fail test (timings are machine-dependent) -- a reproducible harness
+# to measure the kernel win on your own hardware. Correctness (every kernel
+# bit-identical to scalar) is asserted by test/sql/plink_ld_kernel.test.
+#
+#   DUCKDB=./build/release/duckdb ./scripts/bench_ld_kernel.sh [N_SAMP] [N_VAR] [WINDOW_KB]
+#
+# Requires: a built duckdb with the extension (DUCKDB=path), plink2 (PLINK2=path).
+# plink2 --dummy places variants 1 bp apart, so every pair in the fixture falls in
+# one window: N_VAR*(N_VAR-1)/2 pair kernels per run.
+set -euo pipefail
+DUCKDB="${DUCKDB:-./build/release/duckdb}"
+PLINK2="${PLINK2:-plink2}"
+N="${1:-50000}"; M="${2:-2000}"; W="${3:-1000}"
+TMP="$(mktemp -d)"; trap 'rm -rf "$TMP"' EXIT
+
+echo "Generating $M variants x $N samples ..."
+"$PLINK2" --dummy "$N" "$M" --make-pgen --out "$TMP/bench" >/dev/null
+
+P="$TMP/bench.pgen"
+run() { # threads kernel
+  "$DUCKDB" -c ".timer on" -c \
+    "SET threads=$1; SET plinking_ld_kernel='$2'; SELECT count(*), sum(OBS_CT) FROM plink_ld('$P', window_kb := $W, r2_threshold := 0.0);" \
+    2>&1 | grep -i "Run Time" | sed 's/^/    /'
+}
+for t in 1 8; do
+  echo "threads=$t:"
+  echo -n "  scalar   "; run "$t" scalar
+  echo -n "  popcount "; run "$t" popcount
+  echo -n "  auto     "; run "$t" auto
+done
@@ -0,0 +1,35 @@
+#!/bin/bash
+# Benchmark: plink_ld windowed-mode cache. A/B-times a windowed `plink_ld` scan
+# with plinking_ld_window_cache_bytes = 0 (every partner decoded from the .pgen
+# once per anchor) vs the default (each variant decoded about once per thread),
+# using DuckDB's `.timer on`.
+#
+# NOT a pass/fail test (timings are machine-dependent). Correctness (identical
+# rows with the cache off, undersized and on) is asserted by
+# test/sql/plink_ld_window_cache.test.
+#
+#   DUCKDB=./build/release/duckdb ./scripts/bench_ld_window_cache.sh [N_SAMP] [N_VAR] [WINDOW_KB]
+#
+# Requires: a built duckdb with the extension (DUCKDB=path), plink2 (PLINK2=path).
+# plink2 --dummy places variants 1 bp apart, so a WINDOW_KB window spans
+# WINDOW_KB*1000 partners per anchor.
+set -euo pipefail
+DUCKDB="${DUCKDB:-./build/release/duckdb}"
+PLINK2="${PLINK2:-plink2}"
+N="${1:-20000}"; M="${2:-20000}"; W="${3:-1}"
+TMP="$(mktemp -d)"; trap 'rm -rf "$TMP"' EXIT
+
+echo "Generating $M variants x $N samples ..."
+"$PLINK2" --dummy "$N" "$M" --make-pgen --out "$TMP/bench" >/dev/null
+
+P="$TMP/bench.pgen"
+run() { # threads cache_bytes
+  "$DUCKDB" -c ".timer on" -c \
+    "SET threads=$1; SET plinking_ld_window_cache_bytes=$2; SELECT count(*), sum(OBS_CT) FROM plink_ld('$P', window_kb := $W, r2_threshold := 0.0);" \
+    2>&1 | grep -i "Run Time" | sed 's/^/    /'
+}
+for t in 1 8; do
+  echo "threads=$t:"
+  echo -n "  no cache "; run "$t" 0
+  echo -n "  cached   "; run "$t" 67108864
+done
@@ -0,0 +1,41 @@
+#!/bin/bash
+# Benchmark: end-of-Phase-1 merge of per-thread per-sample accumulators
+# (StripedReduction) in plink_missing sample mode, read_pfile sample-orient
+# counts and plink_score. Generates a TALL fixture (many samples, enough variants
+# for every thread to get work) and times each scan at several thread counts,
+# using DuckDB's `.timer on`. The merge is O(samples x threads), so it dominates
+# when samples are many and variants per thread are few.
+#
+# NOT a pass/fail test (timings are machine-dependent). For the single-mutex
+# baseline, build the commit before StripedReduction and run the same script.
+# Correctness (identical results at any thread count) is asserted by the
+# existing plink_missing / read_pfile / plink_score tests.
+#
+#   DUCKDB=./build/release/duckdb ./scripts/bench_parallel_merge.sh [N_SAMP] [N_VAR]
+#
+# Requires: a built duckdb with the extension (DUCKDB=path), plink2 (PLINK2=path).
+set -euo pipefail
+DUCKDB="${DUCKDB:-./build/release/duckdb}"
+PLINK2="${PLINK2:-plink2}"
+# plink_missing / read_pfile give one thread per 500 variants, so 16000 variants
+# keep 32 threads busy; the .pgen is ~N_SAMP x N_VAR / 4 bytes (4 GB by default).
+N="${1:-1000000}"; M="${2:-16000}"
+TMP="$(mktemp -d)"; trap 'rm -rf "$TMP"' EXIT
+
+echo "Generating $M variants x $N samples ..."
+"$PLINK2" --dummy "$N" "$M" 0.02 acgt --make-pgen --out "$TMP/bench" >/dev/null
+
+P="$TMP/bench"
+run() { # threads query
+  "$DUCKDB" -c ".timer on" -c "SET threads=$1; SET plinking_max_threads=$1; $2" \
+    2>&1 | grep -i "Run Time" | sed 's/^/    /'
+}
+for t in 1 8 32; do
+  echo "threads=$t:"
+  echo -n "  plink_missing (sample) "
+  run "$t" "SELECT sum(MISSING_CT) FROM plink_missing('$P.pgen', mode := 'sample');"
+  echo -n "  read_pfile counts      "
+  run "$t" "SELECT sum(genotypes.het) FROM read_pfile('$P', orient := 'sample', genotypes := 'counts');"
+  echo -n "  plink_score            "
+  run "$t" "SELECT sum(SCORE_SUM) FROM plink_score('$P.pgen', weights := (SELECT list(0.01) FROM range($M)));"
+done
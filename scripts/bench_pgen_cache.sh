@@ -0,0 +1,94 @@
+#!/bin/bash
+# Benchmark: shared .pgen block cache (plinking_pgen_cache_size). Serves a fixture
+# over a local HTTP range server (a stand-in for s3:// / https://) and times a
+# full read_pgen scan, then the same scan again in the same process, with the
+# cache disabled (0 — each reader keeps a private 2 MiB read-ahead) vs enabled,
+# using DuckDB's `.timer on`. Also prints the server's request count and
+# plinking_pgen_cache_stats() per run (with the cache on, scans also prefetch each
+# claimed batch in one coalesced range request: compare the request counts).
+#
+# NOT a pass/fail test (timings are machine-dependent). Correctness (identical
+# rows with the cache on, undersized and off) is asserted by
+# test/sql/pgen_vfs_cache.test.
+#
+#   DUCKDB=./build/release/duckdb ./scripts/bench_pgen_cache.sh [N_SAMP] [N_VAR] [DELAY_MS]
+#
+# Requires: a built duckdb with the extension (DUCKDB=path) and httpfs available,
+# plink2 (PLINK2=path), python3. DELAY_MS adds latency per range request to mimic
+# an object store (default 5).
+set -euo pipefail
+DUCKDB="${DUCKDB:-./build/release/duckdb}"
+PLINK2="${PLINK2:-plink2}"
+N="${1:-2000}"; M="${2:-100000}"; DELAY="${3:-5}"
+TMP="$(mktemp -d)"
+SERVER_PID=""
+trap '[ -n "$SERVER_PID" ] && kill "$SERVER_PID" 2>/dev/null; rm -rf "$TMP"' EXIT
+
+echo "Generating $M variants x $N samples ..."
+"$PLINK2" --dummy "$N" "$M" --make-pgen --out "$TMP/bench" >/dev/null
+
+# Minimal HTTP/1.1 server with Range support and a per-request delay; counts the
+# range requests it serves in $TMP/requests.
+cat > "$TMP/range_server.py" <<'EOF'
+import http.server, os, re, sys, threading, time
+root, port, delay = sys.argv[1], int(sys.argv[2]), float(sys.argv[3]) / 1000.0
+lock = threading.Lock()
+count = [0]
+class H(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    def log_message(self, *a):
+        pass
+    def _file(self):
+        return os.path.join(root, self.path.lstrip("/"))
+    def _head(self, code, length, extra=()):
+        st = os.stat(self._file())
+        self.send_response(code)
+        self.send_header("Content-Length", str(length))
+        self.send_header("Accept-Ranges", "bytes")
+        self.send_header("Last-Modified", self.date_time_string(st.st_mtime))
+        for k, v in extra:
+            self.send_header(k, v)
+        self.end_headers()
+    def do_HEAD(self):
+        if not os.path.isfile(self._file()):
+            self.send_error(404); return
+        self._head(200, os.path.getsize(self._file()))
+    def do_GET(self):
+        path = self._file()
+        if not os.path.isfile(path):
+            self.send_error(404); return
+        size = os.path.getsize(path)
+        m = re.match(r"bytes=(\d+)-(\d*)", self.headers.get("Range", ""))
+        start, end = (int(m.group(1)), int(m.group(2)) if m and m.group(2) else size - 1) if m else (0, size - 1)
+        end = min(end, size - 1)
+        time.sleep(delay)
+        with lock:
+            count[0] += 1
+            open(os.path.join(root, "requests"), "w").write(str(count[0]))
+        extra = [("Content-Range", "bytes %d-%d/%d" % (start, end, size))] if m else []
+        self._head(206 if m else 200, end - start + 1, extra)
+        with open(path, "rb") as f:
+            f.seek(start)
+            self.wfile.write(f.read(end - start + 1))
+http.server.ThreadingHTTPServer(("127.0.0.1", port), H).serve_forever()
+EOF
+PORT="${PORT:-8765}"
+python3 "$TMP/range_server.py" "$TMP" "$PORT" "$DELAY" &
+SERVER_PID=$!
+sleep 1
+
+URL="http://127.0.0.1:$PORT/bench.pgen"
+Q="SELECT count(*), sum(list_sum(list_transform(genotypes, x -> CASE WHEN x < 0 THEN 0 ELSE x END))) FROM read_pgen('$URL', pvar := '$TMP/bench.pvar', psam := '$TMP/bench.psam');"
+run() { # threads cache_bytes
+  echo 0 > "$TMP/requests"
+  "$DUCKDB" -c "LOAD httpfs;" -c "SET threads=$1; SET GLOBAL plinking_pgen_cache_size=$2;" -c ".timer on" \
+    -c "$Q" -c "$Q" -c ".timer off" \
+    -c "SELECT hits, misses, evictions, prefetched_blocks FROM plinking_pgen_cache_stats();" 2>&1 |
+    grep -Ei "Run Time|│ *[0-9]" | tail -3 | sed 's/^/    /'
+  echo "    range requests: $(cat "$TMP/requests")"
+}
+for t in 1 8; do
+  echo "threads=$t (first scan, repeat scan, cache stats):"
+  echo "  no shared cache"; run "$t" 0
+  echo "  shared cache";    run "$t" 268435456
+done
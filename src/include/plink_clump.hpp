@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//! Register the plink_clump table function with DuckDB.
+void RegisterPlinkClump(ExtensionLoader &loader);
+
+} // namespace duckdb
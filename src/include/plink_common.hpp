@@ -8,7 +8,9 @@
 #include <pgenlib_ffi_support.h>
 #include <pgenlib_misc.h>
 
+#include <atomic>
 #include <cstring>
+#include <mutex>
 #include <unordered_set>
 
 namespace duckdb {
@@ -117,6 +119,81 @@ struct AlignedBuffer {
 	}
 };
 
+//! Cache-aligned buffer drawn from DuckDB's buffer allocator: unlike AlignedBuffer
+//! it counts against memory_limit for as long as it lives. For large, query-lifetime
+//! buffers (whole-dataset genotype caches, bitplanes).
+struct TrackedBuffer {
+	AllocatedData data;
+	void *ptr = nullptr;
+
+	//! Free any current allocation and reset to empty.
+	void Reset() {
+		data.Reset();
+		ptr = nullptr;
+	}
+
+	//! Allocate `size` bytes. Throws OutOfMemoryException when memory_limit cannot
+	//! fit them (after evicting what the buffer manager can).
+	void Allocate(ClientContext &context, idx_t size);
+
+	template <typename T>
+	T *As() {
+		return static_cast<T *>(ptr);
+	}
+
+	template <typename T>
+	const T *As() const {
+		return static_cast<const T *>(ptr);
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Shared .pgen index (one PgenFileInfo per bound .pgen)
+// ---------------------------------------------------------------------------
+
+//! A .pgen's header and variant record index (PgfiInitPhase1 + PgfiInitPhase2),
+//! loaded once at bind and shared read-only by every thread's PgenReader.
+//! PgrInit takes a shallow copy of the PgenFileInfo whose arrays point into
+//! pgfi_alloc_buf, so readers hold the shared_ptr and must be cleaned up first.
+//! The handle that loaded the index is closed after loading: each reader opens its
+//! own, and PgrInit never writes to the shared struct.
+struct PgenIndex {
+	plink2::PgenFileInfo pgfi;
+	AlignedBuffer pgfi_alloc_buf;
+	uint32_t max_vrec_width = 0;
+	uintptr_t pgr_alloc_cacheline_ct = 0;
+
+	PgenIndex();
+	~PgenIndex();
+	PgenIndex(const PgenIndex &) = delete;
+	PgenIndex &operator=(const PgenIndex &) = delete;
+};
+
+//! Load `pgen_path`'s index. `raw_variant_ct` / `raw_sample_ct` are the counts
+//! validated at bind (UINT32_MAX takes the header's). Call inside the caller's
+//! PgenVfsScope. Throws IOException prefixed with `func_name`.
+shared_ptr<PgenIndex> LoadPgenIndex(const string &pgen_path, uint32_t raw_variant_ct, uint32_t raw_sample_ct,
+                                    const string &func_name);
+
+//! PgrInit a per-thread reader on a shared index; the reader opens its own handle
+//! on `pgen_path` (inside the caller's PgenVfsScope). On failure the reader is
+//! cleaned up and an IOException prefixed with `func_name` is thrown.
+void InitPgenReader(const PgenIndex &index, const string &pgen_path, plink2::PgenReader &pgr,
+                    AlignedBuffer &pgr_alloc_buf, const string &func_name);
+
+//! Hint that effective positions [start, end) of a scan are about to be read through
+//! `pgr`; `effective` maps them to raw variant indices (nullptr = identity). Scan
+//! loops call it on claiming a batch, with the span of the batch after it (hinting
+//! the claimed batch itself would stall its first read on the whole coalesced fetch):
+//! under Path V the shim fetches the records' byte range as one coalesced read into
+//! the shared block cache in the background, and under Path U (plinking_pgen_io :=
+//! 'uring') it queues the range on the reader's io_uring — either way overlapping
+//! the I/O with decoding. A no-op for native and mmap reads, for Path V when
+//! plinking_pgen_cache_size = 0, and for a sparse or unordered slice of `effective`
+//! (its span is mostly records the scan skips).
+void PrefetchPgenBatch(const PgenIndex &index, plink2::PgenReader &pgr, const vector<uint32_t> *effective,
+                       uint32_t start, uint32_t end);
+
 // ---------------------------------------------------------------------------
 // Offset-indexed variant metadata (memory-efficient Scan-time access)
 // ---------------------------------------------------------------------------
@@ -560,6 +637,13 @@ void FillGenotypeVector(Vector &vec, idx_t row_idx, GenotypeMode mode, uint32_t
 vector<uint32_t> ResolveVariantsParameter(const Value &val, const VariantMetadataIndex &variants,
                                           uint32_t raw_variant_ct, const string &func_name);
 
+//! Resolve one variant string without throwing: an ID from `id_to_idx` (built by
+//! BuildVariantIdIndex) or, failing that, a CHROM:POS[:REF:ALT] string. Returns false
+//! when nothing matches, for callers that skip unmatched input (e.g. GWAS results
+//! against a reference panel).
+bool TryResolveVariantString(const string &id, const VariantMetadataIndex &variants,
+                             const unordered_map<string, uint32_t> &id_to_idx, uint32_t &vidx);
+
 // ---------------------------------------------------------------------------
 // Ploidy- and sex-aware statistics for sex/organelle chromosomes (chrX/Y/MT)
 // ---------------------------------------------------------------------------
@@ -647,4 +731,52 @@ uint32_t GetPlinkingMaxThreads(ClientContext &context);
 //! Otherwise returns min(computed, 16) (existing default behavior).
 idx_t ApplyMaxThreadsCap(idx_t computed, uint32_t config_max_threads);
 
+// ---------------------------------------------------------------------------
+// Parallel merge of per-thread accumulators
+// ---------------------------------------------------------------------------
+
+//! Merges per-thread partial accumulators (per-sample vectors filled during a
+//! variant-parallel Phase 1) into the shared global vectors. The element range is
+//! split into stripes with one lock each, and every merging thread starts at a
+//! different stripe, so threads that finish Phase 1 together add disjoint ranges
+//! concurrently instead of queueing the whole O(samples) merge behind one mutex.
+//!
+//! Init() once in InitGlobal; each thread then calls Merge() with a callback that
+//! adds its partials over [begin, end). Callbacks for different stripes run
+//! concurrently; a stripe is only ever merged by one thread at a time.
+class StripedReduction {
+public:
+	//! 64K elements per stripe: large enough that lock traffic is negligible, small
+	//! enough that a 7M-sample merge spreads across ~100 stripes.
+	static constexpr idx_t DEFAULT_STRIPE_ELEMENTS = 64 * 1024;
+
+	void Init(idx_t element_ct, idx_t stripe_elements = DEFAULT_STRIPE_ELEMENTS);
+
+	idx_t StripeCount() const {
+		return stripe_ct;
+	}
+
+	template <class MERGE_RANGE>
+	void Merge(MERGE_RANGE &&merge_range) {
+		if (stripe_ct == 0) {
+			return;
+		}
+		idx_t first = next_first_stripe.fetch_add(1, std::memory_order_relaxed) % stripe_ct;
+		for (idx_t i = 0; i < stripe_ct; i++) {
+			idx_t stripe = (first + i) % stripe_ct;
+			idx_t begin = stripe * stripe_elements;
+			idx_t end = MinValue(begin + stripe_elements, element_ct);
+			std::lock_guard<std::mutex> lock(stripe_locks[stripe]);
+			merge_range(begin, end);
+		}
+	}
+
+private:
+	idx_t element_ct = 0;
+	idx_t stripe_elements = DEFAULT_STRIPE_ELEMENTS;
+	idx_t stripe_ct = 0;
+	unique_ptr<std::mutex[]> stripe_locks;
+	std::atomic<idx_t> next_first_stripe {0};
+};
+
 } // namespace duckdb
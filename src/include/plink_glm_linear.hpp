@@ -0,0 +1,207 @@
+#pragma once
+
+// plink_glm_linear — covariate-projected linear association engine for plink_glm.
+//
+// For y = b0 + b_x * x + C g + e, the genotype coefficient and its SE only depend
+// on x and y after both are residualized on the intercept + covariates Z
+// (Frisch–Waugh–Lovell). Z never changes between variants, so it is factored once
+// (R factor of Z via Cholesky of Z'Z; R'R = Z'Z) and each variant costs one pass
+// of dot products (x'Z, x'x, x'y) plus a q×q triangular solve — instead of
+// rebuilding the p×n design and inverting a p×p system per variant.
+//
+// Traits that share a missingness pattern share Z, so one projection carries all
+// of them: x'y becomes a (variant block × samples) · (samples × traits) product,
+// and everything else per variant is computed once for the whole trait set.
+
+#include "plink_common.hpp"
+
+#include <unordered_map>
+
+namespace duckdb {
+
+// ---------------------------------------------------------------------------
+// Engine selection
+// ---------------------------------------------------------------------------
+
+enum class GlmLinearEngine : uint8_t {
+	PROJECTED, //!< Covariates factored once per missingness pattern (default)
+	FULL       //!< Reference: full p×p regression per variant (plink2's LinearRegressionInv)
+};
+
+//! Read the plinking_glm_linear_engine setting ('projected' | 'full').
+GlmLinearEngine ResolveGlmLinearEngine(ClientContext &context);
+
+// ---------------------------------------------------------------------------
+// Result type
+// ---------------------------------------------------------------------------
+
+//! Genotype-term statistics of one variant. errcode is non-null when the fit is
+//! undefined (TOO_FEW_SAMPLES, CONST_ALLELE, SINGULAR_MATRIX, ZERO_VARIANCE); the
+//! p-value is left to the caller (t distribution with `df` degrees of freedom).
+struct LinearAssocResult {
+	double beta = NAN;
+	double se = NAN;
+	double t_stat = NAN;
+	double df = NAN;
+	double a1_freq = NAN;
+	uint32_t obs_ct = 0;
+	const char *errcode = nullptr;
+};
+
+// ---------------------------------------------------------------------------
+// Covariate factorization
+// ---------------------------------------------------------------------------
+
+//! Intercept + covariates over the `active` samples, sample-major (active × q,
+//! column 0 = intercept). Covariates are centered and scaled to unit variance
+//! over the active samples.
+void BuildCovariateDesign(const vector<uint32_t> &active, const vector<vector<double>> &covariates, vector<double> &z);
+
+//! Z'Z factor plus the residualized phenotype sums for one set of observed samples.
+struct CovariateFactor {
+	vector<double> chol;       //!< lower-triangular L (q×q, row-major), L L' = Z'Z
+	vector<double> v;          //!< L^-1 Z'Y (q×traits, row-major)
+	vector<double> y_resid_ss; //!< per trait: y'y - v'v, residual sum of squares of y on Z
+	bool singular = false;     //!< Z is rank-deficient on these samples
+};
+
+//! The covariate side of the model, built once per query and shared read-only by
+//! every scan thread. Samples with a missing phenotype are dropped up front;
+//! covariates are centered and scaled over the remaining ("active") samples, and y
+//! is centered, which leaves the genotype statistics unchanged (the intercept spans
+//! the means) but keeps Z'Z well conditioned.
+class CovariateProjection {
+public:
+	//! phenotypes[t][s] (NaN = missing) and covariates[c][s] over the same sample_ct
+	//! samples. Every phenotype must be missing on exactly the same samples.
+	void Init(const vector<const vector<double> *> &phenotypes, const vector<vector<double>> &covariates);
+
+	//! Columns of Z: intercept + covariates.
+	uint32_t ZColumnCount() const {
+		return q;
+	}
+	uint32_t ActiveCount() const {
+		return static_cast<uint32_t>(active.size());
+	}
+	idx_t TraitCount() const {
+		return trait_ct;
+	}
+
+	//! Factor Z'Z over the active samples minus `missing` (positions into the active
+	//! set), by downdating the full Gram matrix with the missing rows.
+	void FactorWithout(const vector<uint32_t> &missing, CovariateFactor &out) const;
+
+	//! Build cols_f32 for AddDenseVariantF32 (precision := 'float').
+	void EnableSinglePrecision();
+
+	static constexpr uint32_t INACTIVE = UINT32_MAX;
+
+	vector<uint32_t> active;     //!< sample index of each active sample
+	vector<uint32_t> active_pos; //!< per sample: position in `active`, or INACTIVE
+	vector<double> y;            //!< active × traits, sample-major, centered per trait
+	vector<double> z;            //!< active × q, sample-major (column 0 = intercept)
+	CovariateFactor full;        //!< factor over all active samples
+	vector<float> cols_f32;      //!< (q + traits) × active, column-major: Z columns then Y columns
+
+private:
+	uint32_t q = 0;
+	idx_t trait_ct = 0;
+	vector<double> gram; //!< Z'Z over all active samples
+	vector<double> zy;   //!< Z'Y over all active samples (q×traits)
+	vector<double> yy;   //!< per trait y'y over all active samples
+};
+
+//! Per-thread scratch for a block of variants, and a cache of factors for
+//! missingness patterns already seen. A block is filled with BeginBlock, then
+//! AddDenseVariant / AddSparseVariant per variant, and fitted by FinishProjectedLinear.
+struct LinearProjectionWorkspace {
+	idx_t block_capacity = 0;
+	idx_t block_ct = 0;           //!< variants added to the current block
+	vector<double> x;             //!< block × active dosages of dense variants (missing stored as 0)
+	vector<double> xy;            //!< block × traits: x'y
+	vector<double> zx;            //!< block × q: Z'x
+	vector<double> sum_x;         //!< per block variant
+	vector<double> xx;            //!< per block variant
+	//! How a block variant's x'y is gathered in FinishProjectedLinear.
+	enum class RowKind : uint8_t {
+		DENSE,      //!< row in `x`, through the block × trait product
+		SPARSE,     //!< from its carriers
+		PRECOMPUTED //!< already in `xy` (single-precision rows)
+	};
+
+	vector<RowKind> kind;         //!< per block variant
+	vector<uint32_t> missing;     //!< missing active positions of all block variants, concatenated
+	vector<idx_t> missing_end;    //!< per block variant: end offset into `missing`
+	vector<uint32_t> carrier_pos; //!< sparse variants: active positions of non-hom-ref calls, concatenated
+	vector<double> carrier_x;     //!< sparse variants: their dosages
+	vector<idx_t> carrier_end;    //!< per block variant: end offset into `carrier_pos`
+	vector<double> u;             //!< L^-1 Z'x
+	vector<double> uv;            //!< per trait: u'v
+	vector<float> x_f32;          //!< single-precision row compacted onto the active samples
+	vector<double> dots;          //!< q + traits: x'Z then x'Y of a single-precision row
+
+	//! Factors keyed by a hash of the missing positions (the positions are stored
+	//! alongside and compared, so a collision only costs a refactor).
+	struct Pattern {
+		vector<uint32_t> missing;
+		CovariateFactor factor;
+	};
+	std::unordered_map<uint64_t, Pattern> patterns;
+
+	void Init(const CovariateProjection &proj, idx_t block_capacity);
+	void BeginBlock();
+};
+
+//! Add a variant from its ALT dosages (-9.0 = missing) over all samples the
+//! projection was built over.
+void AddDenseVariant(const CovariateProjection &proj, const double *dosages, LinearProjectionWorkspace &ws);
+
+//! Add a hom-ref-majority variant from its other calls only: `entry_ct` ascending
+//! sample indices with their dosages (-9.0 = missing); every sample not listed is
+//! hom-ref. Gives the same results as the equivalent dense row, while touching
+//! only the listed samples.
+void AddSparseVariant(const CovariateProjection &proj, const uint32_t *sample_ids, const double *x_vals,
+                      idx_t entry_ct, LinearProjectionWorkspace &ws);
+
+//! Single-precision form of AddDenseVariant: x'Z and x'y come from masked float
+//! kernels (see ComputeMaskedDotsF32). Needs proj.EnableSinglePrecision().
+void AddDenseVariantF32(const CovariateProjection &proj, const float *dosages, LinearProjectionWorkspace &ws);
+
+//! Fit the genotype term of every variant in the block against every trait of
+//! `proj`. `results` receives block_ct × TraitCount() entries, variant-major.
+void FinishProjectedLinear(const CovariateProjection &proj, LinearProjectionWorkspace &ws,
+                           LinearAssocResult *results);
+
+//! Dense convenience form: `dosages` holds variant_ct rows, `dosage_stride` apart.
+void ComputeProjectedLinear(const CovariateProjection &proj, const double *dosages, idx_t dosage_stride,
+                            idx_t variant_ct, LinearProjectionWorkspace &ws, LinearAssocResult *results);
+
+// ---------------------------------------------------------------------------
+// Single-precision kernels (precision := 'float')
+// ---------------------------------------------------------------------------
+
+//! Sums of the no-covariate model over the samples where both x and y are observed.
+struct SimpleLinearSums {
+	uint32_t n = 0;
+	double sum_x = 0.0;
+	double sum_xx = 0.0;
+	double sum_y = 0.0;
+	double sum_yy = 0.0;
+	double sum_xy = 0.0;
+};
+
+//! `x` are ALT dosages (-9.0 = missing) and `y` phenotype values (NaN = missing).
+//! Missing samples are masked out rather than branched on. Center y first: the
+//! products are summed in float.
+SimpleLinearSums ComputeSimpleLinearSumsF32(const float *x, const float *y, uint32_t sample_ct);
+
+//! dots[c] += sum_j x'[j] * cols[c * col_stride + j] for every c < col_ct, where x'
+//! is `x` with missing dosages (-9.0) zeroed; sum_x / sum_xx accumulate x' and x'².
+//! Returns the number of missing dosages.
+uint32_t ComputeMaskedDotsF32(const float *x, uint32_t n, const float *cols, idx_t col_ct, idx_t col_stride,
+                              double *dots, double &sum_x, double &sum_xx);
+
+//! Name of the variant the float kernels dispatch to on this CPU ("avx2", "portable").
+const char *GlmFloatKernelName();
+
+} // namespace duckdb
@@ -0,0 +1,46 @@
+#pragma once
+
+// plink_glm_score — score-test prefilter for logistic plink_glm.
+//
+// The covariate-only (null) logistic model is fitted once per phenotype. Under it,
+// the score statistic of a variant is U = x'(y - mu) with variance
+// V = x'Wx - x'WZ (Z'WZ)^-1 Z'Wx, W = diag(mu(1 - mu)): one pass of dot products
+// per variant, no iteration. Only variants whose score-test p-value falls below
+// the cutoff get the full IRLS / Firth fit.
+
+#include "plink_glm_linear.hpp"
+
+namespace duckdb {
+
+//! Null logistic model y ~ Z over the samples with a non-missing phenotype.
+struct LogisticNullModel {
+	uint32_t q = 0;          //!< columns of Z: intercept + covariates
+	vector<uint32_t> active; //!< sample index of each active sample
+	vector<double> z;        //!< active × q, sample-major (BuildCovariateDesign)
+	vector<double> resid;    //!< per active sample: y - mu
+	vector<double> weight;   //!< per active sample: mu (1 - mu)
+	vector<double> chol;     //!< lower-triangular L (q×q, row-major), L L' = Z'WZ
+
+	//! Newton–Raphson fit of y (0/1, NaN = missing) on the covariates. Returns false
+	//! when the fit does not converge or is degenerate (separation on the
+	//! covariates, singular Z'WZ); the caller then fits every variant exactly.
+	bool Fit(const vector<double> &phenotype, const vector<vector<double>> &covariates);
+};
+
+//! Score test of one variant against the null model. Missing genotypes are
+//! mean-imputed (the exact refit drops them). `valid` is false when the statistic
+//! is undefined (too few samples, genotype constant or in the span of Z).
+struct LogisticScoreResult {
+	double beta = NAN;   //!< one-step estimate U / V
+	double se = NAN;     //!< 1 / sqrt(V)
+	double z_stat = NAN; //!< U / sqrt(V)
+	double a1_freq = NAN;
+	uint32_t obs_ct = 0;
+	bool valid = false;
+};
+
+//! `dosages` are ALT dosages (-9.0 = missing) for all samples the null model was
+//! fitted over; `scratch` is 2q doubles of caller scratch.
+LogisticScoreResult ComputeLogisticScore(const LogisticNullModel &null_model, const double *dosages, double *scratch);
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//! Register the plink_grm table function with DuckDB.
+void RegisterPlinkGrm(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//! Register the plink_king table function with DuckDB.
+void RegisterPlinkKing(ExtensionLoader &loader);
+
+} // namespace duckdb
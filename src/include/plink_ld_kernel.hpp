@@ -0,0 +1,155 @@
+#pragma once
+
+// plink_ld_kernel — the genotype-pair LD kernel shared by plink_ld and the LD-driven
+// functions built on it. See plink_ld.cpp for the estimator caveat (genotype-level
+// Pearson r², composite D' — not plink2's phased-haplotype values).
+
+#include "plink_common.hpp"
+
+namespace duckdb {
+
+// ---------------------------------------------------------------------------
+// Result type
+// ---------------------------------------------------------------------------
+
+struct LdResult {
+	double r2;
+	double d_prime;
+	uint32_t obs_ct;
+	bool is_valid; // false if monomorphic, < 2 obs, etc.
+};
+
+//! Derive r², D' and OBS_CT from the pair's genotype sums over jointly observed
+//! samples. Shared by every kernel, so they differ only in how the (exact, integer)
+//! sums are gathered — results are bit-identical across kernels.
+LdResult FinishLdStats(uint32_t n, double sum_a, double sum_b, double sum_ab, double sum_a2, double sum_b2);
+
+// ---------------------------------------------------------------------------
+// Kernel selection
+// ---------------------------------------------------------------------------
+
+//! Which pair kernel gathers the genotype sums.
+enum class LdKernel : uint8_t {
+	SCALAR,   //!< Reference: walk every sample two bits at a time (the original loop)
+	POPCOUNT, //!< Bitplane AND + popcount on portable 64-bit words
+	AUTO      //!< POPCOUNT via the widest SIMD variant this CPU supports (AVX-512 / AVX2 / portable)
+};
+
+//! Read the plinking_ld_kernel setting ('auto' | 'popcount' | 'scalar').
+LdKernel ResolveLdKernel(ClientContext &context, const string &func_name);
+
+//! Name of the popcount variant AUTO dispatches to on this CPU ("avx512", "avx2", "portable").
+const char *LdPopcountVariantName();
+
+// ---------------------------------------------------------------------------
+// Decoded per-variant genotypes
+// ---------------------------------------------------------------------------
+
+//! One variant's genotypes in the form its kernel consumes. SCALAR keeps the packed
+//! 2-bit genovec; the popcount kernels keep three 1-bit-per-sample planes instead —
+//! [is_alt | is_hom_alt | is_nonmissing], each `plane_word_ct` words and zero past
+//! sample_ct — so a pair with no missing calls needs only the cross term. Planes are
+//! 3/8 byte per sample vs the genovec's 1/4. The counts are filled under every kernel.
+struct LdVariantGenotypes {
+	AlignedBuffer buf;
+	uint32_t sample_ct = 0;
+	uint32_t plane_word_ct = 0; //!< words per plane (multiple of 8 → whole 512-bit vectors)
+	uint32_t nonmissing_ct = 0;
+	uint32_t alt_ct = 0;     //!< samples carrying ≥ 1 ALT (het or hom-alt)
+	uint32_t hom_alt_ct = 0; //!< hom-alt samples
+	LdKernel kernel = LdKernel::AUTO;
+
+	//! Size the buffer for `sample_ct` samples under `kernel`. Cheap to repeat with
+	//! the same arguments (the buffer is kept).
+	void Allocate(uint32_t sample_ct, LdKernel kernel);
+
+	//! Load from a packed genovec (PgrGet output for `sample_ct` samples).
+	void Assign(const uintptr_t *genovec);
+
+	//! Bytes held per variant for this sample count / kernel (for cache budgeting).
+	static idx_t BytesPerVariant(uint32_t sample_ct, LdKernel kernel);
+
+	//! ALT allele frequency over the non-missing calls (0 if none).
+	double AltFreq() const {
+		return nonmissing_ct ? static_cast<double>(alt_ct + hom_alt_ct) / (2.0 * nonmissing_ct) : 0.0;
+	}
+
+	const uintptr_t *Genovec() const {
+		return buf.As<uintptr_t>();
+	}
+	const uintptr_t *Planes() const {
+		return buf.As<uintptr_t>();
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Per-thread window cache
+// ---------------------------------------------------------------------------
+
+//! Direct-mapped ring of decoded variants keyed by vidx (slot = vidx % SlotCount()).
+//! A thread walking consecutive anchors re-reads the same window of partners; with
+//! the cache each of them is decoded once per anchor run instead of once per anchor.
+//! Any two vidx less than SlotCount() apart occupy different slots, so an anchor's
+//! slot stays valid while partners within that distance are fetched.
+struct LdWindowCache {
+	//! Size the ring (0 or 1 slot disables it). Slot buffers are allocated on first use.
+	void Init(uint32_t slot_ct, uint32_t sample_ct, LdKernel kernel);
+
+	uint32_t SlotCount() const {
+		return static_cast<uint32_t>(slots.size());
+	}
+	bool Enabled() const {
+		return slots.size() > 1;
+	}
+
+	//! Slot for `vidx`. Returns true (hit) if it already holds `vidx`; otherwise the
+	//! slot is re-tagged to `vidx` and the caller must Assign() it before use.
+	bool Lookup(uint32_t vidx, LdVariantGenotypes *&slot);
+
+	//! Slots a per-thread byte budget buys, capped at `max_useful` (no point holding
+	//! more variants than a window ever spans).
+	static uint32_t SlotCountForBudget(idx_t budget_bytes, uint32_t sample_ct, LdKernel kernel, uint32_t max_useful);
+
+private:
+	vector<LdVariantGenotypes> slots;
+	vector<uint32_t> slot_vidx; // UINT32_MAX = empty
+	uint32_t sample_ct = 0;
+	LdKernel kernel = LdKernel::AUTO;
+};
+
+//! Read the plinking_ld_window_cache_bytes setting (per-thread budget; 0 disables).
+idx_t GetLdWindowCacheBytes(ClientContext &context);
+
+//! Largest number of same-chromosome partners within `window_bp` that any variant in
+//! [start, end) has — what a window cache must hold so no partner is decoded twice.
+//! Two-pointer sweep over the (CHROM, POS)-sorted variants.
+uint32_t LdMaxWindowVariantCount(const VariantMetadataIndex &variants, uint32_t start, uint32_t end,
+                                 int64_t window_bp);
+
+// ---------------------------------------------------------------------------
+// Standardized-block (matrix) kernel
+// ---------------------------------------------------------------------------
+
+//! Variants per tile edge of the blocked r matrix (output := 'matrix' | 'triangle').
+static constexpr uint32_t LD_TILE = 32;
+
+//! Center and scale one variant's int8 genotypes (GenoarrToBytesMinus9 output) to
+//! unit norm over its non-missing calls; missing calls become 0 (mean-imputed). The
+//! dot product of two such rows is their Pearson r — exactly plink_ld's r when
+//! neither variant has missing calls. Returns false (row zeroed) for variants with
+//! < 2 calls or no variance.
+bool StandardizeLdRow(const int8_t *genotypes, uint32_t sample_ct, double *out);
+
+//! out[i * out_stride + j] = dot(a row i, b row j) for a LD_TILE x LD_TILE tile.
+//! Rows are `len` doubles, `row_stride` apart. Blocked over samples with 4x4
+//! register tiles; the per-pair summation order is fixed, so dot(a, b) and
+//! dot(b, a) are bit-identical whichever thread computes them.
+void LdDotTile(const double *a, const double *b, idx_t row_stride, idx_t len, double *out, idx_t out_stride);
+
+//! Compute LD for a pair loaded under the same kernel and sample count.
+LdResult ComputeLdStats(const LdVariantGenotypes &a, const LdVariantGenotypes &b);
+
+//! Reference kernel over two raw genovecs (2-bit: 0=hom_ref, 1=het, 2=hom_alt, 3=missing).
+LdResult ComputeLdStatsScalar(const uintptr_t *genovec_a, const uintptr_t *genovec_b, uint32_t sample_ct);
+
+} // namespace duckdb
@@ -7,4 +7,7 @@ namespace duckdb {
 //! Register the plink_pca table function with DuckDB.
 void RegisterPlinkPca(ExtensionLoader &loader);
 
+//! Register the plink_pca_project table function with DuckDB.
+void RegisterPlinkPcaProject(ExtensionLoader &loader);
+
 } // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//! Register the plink_prune table function with DuckDB.
+void RegisterPlinkPrune(ExtensionLoader &loader);
+
+} // namespace duckdb
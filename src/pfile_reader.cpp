@@ -337,6 +337,7 @@ struct PfileSource {
 
 	// pgenlib header: this file's variant count. raw_sample_ct is shared (PfileBindData).
 	uint32_t raw_variant_ct = 0;
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
 
 	// Effective variant list for this source (intersection of region + variant filter).
 	// When has_effective_variant_list is false, scan all raw_variant_ct sequentially.
@@ -553,7 +554,8 @@ struct PfileGlobalState : public GlobalTableFunctionState {
 	std::atomic<uint32_t> smp_next_batch {0};           // Phase 1: claims into `batches`
 	std::atomic<uint32_t> smp_phase1_active {0};        // threads currently in Phase 1
 	std::atomic<bool> smp_phase1_done {false};          // accumulation complete → Phase 2
-	std::mutex smp_merge_mutex;                         // guards the global-accumulator merge
+	std::mutex smp_merge_mutex;                         // guards the keep-list build
+	StripedReduction smp_merge;                         // stripe-parallel accumulator merge
 	vector<uint32_t> smp_het, smp_hom_alt, smp_missing; // per output-sample (hom_ref derived)
 	vector<uint8_t> smp_in_range, smp_has_missing;      // per output-sample (row filter)
 	vector<uint32_t> smp_sample_keep;                   // built by last Phase-1 thread (row filter)
@@ -587,8 +589,8 @@ struct PfileGlobalState : public GlobalTableFunctionState {
 // ---------------------------------------------------------------------------
 
 struct PfileLocalState : public LocalTableFunctionState {
-	plink2::PgenFileInfo pgfi;
-	AlignedBuffer pgfi_alloc_buf;
+	// Index of the source pgr is open on; shared read-only, declared first so it outlives pgr
+	shared_ptr<PgenIndex> pgen_index;
 
 	plink2::PgenReader pgr;
 	AlignedBuffer pgr_alloc_buf;
@@ -613,7 +615,7 @@ struct PfileLocalState : public LocalTableFunctionState {
 
 	bool initialized = false;
 
-	// Multi-file: index of the source this thread's pgr/pgfi are currently open on
+	// Multi-file: index of the source this thread's pgr is currently open on
 	// (DConstants::INVALID_INDEX = none open yet). Reopened on a source boundary.
 	idx_t current_source_idx = DConstants::INVALID_INDEX;
 
@@ -653,7 +655,6 @@ struct PfileLocalState : public LocalTableFunctionState {
 		if (initialized) {
 			plink2::PglErr reterr = plink2::kPglRetSuccess;
 			plink2::CleanupPgr(&pgr, &reterr);
-			plink2::CleanupPgfi(&pgfi, &reterr);
 		}
 	}
 };
@@ -755,44 +756,16 @@ static PfileSource LoadPfileSource(ClientContext &context, FileSystem &fs, const
 		}
 	}
 
-	// --- Read the .pgen header (counts) ---
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
 	// Under 'localize', materialize a local temp copy of this source's .pgen now
 	// (rewrites src.pgen_path in place) so the header and every later scan open read
 	// the native temp. No-op for other policies.
 	LocalizePgenIfRequested(context, src.pgen_path, localize_guard);
 	// Route the header open through the VFS for a remote/VFS path (Path V).
 	PgenVfsScope pgen_vfs_scope(context, PgenIoUseVfs(context, src.pgen_path));
-	plink2::PgenFileInfo pgfi;
-	plink2::PreinitPgfi(&pgfi);
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err = plink2::PgfiInitPhase1(src.pgen_path.c_str(), nullptr, UINT32_MAX, UINT32_MAX, &header_ctrl,
-	                                            &pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("read_pfile: failed to open '%s': %s", src.pgen_path, errstr_buf);
-	}
-
-	src.raw_variant_ct = pgfi.raw_variant_ct;
-	raw_sample_ct_out = pgfi.raw_sample_ct;
-
-	AlignedBuffer pgfi_alloc;
-	if (pgfi_alloc_cacheline_ct > 0) {
-		pgfi_alloc.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, pgfi.raw_variant_ct, &max_vrec_width, &pgfi,
-	                             pgfi_alloc.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-	plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-	plink2::CleanupPgfi(&pgfi, &cleanup_err);
-	if (err != plink2::kPglRetSuccess) {
-		throw IOException("read_pfile: failed to initialize '%s' (phase 2): %s", src.pgen_path, errstr_buf);
-	}
+	src.pgen_index = LoadPgenIndex(src.pgen_path, UINT32_MAX, UINT32_MAX, "read_pfile");
+	src.raw_variant_ct = src.pgen_index->pgfi.raw_variant_ct;
+	raw_sample_ct_out = src.pgen_index->pgfi.raw_sample_ct;
 
 	// --- Load variant metadata (region pushdown for parquet) ---
 	if (region.active && IsParquetFile(src.pvar_path)) {
@@ -1299,53 +1272,11 @@ static unique_ptr<FunctionData> PfileBind(ClientContext &context, TableFunctionB
 			// Count-filter readers open .pgen — route through the VFS while active.
 			PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
 			for (auto &src : bind_data->sources) {
-				// Init temporary PgenReader for count filtering
-				plink2::PgenFileInfo cf_pgfi;
-				plink2::PreinitPgfi(&cf_pgfi);
-
-				char cf_errstr[plink2::kPglErrstrBufBlen];
-				plink2::PgenHeaderCtrl cf_hdr;
-				uintptr_t cf_pgfi_alloc_ct = 0;
-
-				err = plink2::PgfiInitPhase1(src.pgen_path.c_str(), nullptr, src.raw_variant_ct,
-				                             bind_data->raw_sample_ct, &cf_hdr, &cf_pgfi, &cf_pgfi_alloc_ct, cf_errstr);
-				if (err != plink2::kPglRetSuccess) {
-					plink2::PglErr ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgfi(&cf_pgfi, &ce);
-					throw IOException("read_pfile: failed to init PgenReader for count filter: %s", cf_errstr);
-				}
-
-				AlignedBuffer cf_pgfi_alloc;
-				if (cf_pgfi_alloc_ct > 0) {
-					cf_pgfi_alloc.Allocate(cf_pgfi_alloc_ct * plink2::kCacheline);
-				}
-
-				uint32_t cf_max_vrec = 0;
-				uintptr_t cf_pgr_alloc_ct = 0;
-				err = plink2::PgfiInitPhase2(cf_hdr, 0, 0, 0, 0, cf_pgfi.raw_variant_ct, &cf_max_vrec, &cf_pgfi,
-				                             cf_pgfi_alloc.As<unsigned char>(), &cf_pgr_alloc_ct, cf_errstr);
-				if (err != plink2::kPglRetSuccess) {
-					plink2::PglErr ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgfi(&cf_pgfi, &ce);
-					throw IOException("read_pfile: count filter PgenReader init failed (phase 2): %s", cf_errstr);
-				}
-
+				// Temporary PgenReader for count filtering, on the source's index
 				plink2::PgenReader cf_pgr;
 				plink2::PreinitPgr(&cf_pgr);
 				AlignedBuffer cf_pgr_alloc;
-				if (cf_pgr_alloc_ct > 0) {
-					cf_pgr_alloc.Allocate(cf_pgr_alloc_ct * plink2::kCacheline);
-				}
-
-				err = plink2::PgrInit(src.pgen_path.c_str(), cf_max_vrec, &cf_pgfi, &cf_pgr,
-				                      cf_pgr_alloc.As<unsigned char>());
-				if (err != plink2::kPglRetSuccess) {
-					plink2::PglErr ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgr(&cf_pgr, &ce);
-					ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgfi(&cf_pgfi, &ce);
-					throw IOException("read_pfile: PgrInit failed for count filter");
-				}
+				InitPgenReader(*src.pgen_index, src.pgen_path, cf_pgr, cf_pgr_alloc, "read_pfile");
 
 				// Set up sample subsetting for PgrGetCounts
 				plink2::PgrSampleSubsetIndex cf_pssi;
@@ -1378,8 +1309,6 @@ static unique_ptr<FunctionData> PfileBind(ClientContext &context, TableFunctionB
 					if (cf_err != plink2::kPglRetSuccess) {
 						plink2::PglErr ce = plink2::kPglRetSuccess;
 						plink2::CleanupPgr(&cf_pgr, &ce);
-						ce = plink2::kPglRetSuccess;
-						plink2::CleanupPgfi(&cf_pgfi, &ce);
 						throw IOException("read_pfile: PgrGetCounts failed for variant %u during count filter", vidx);
 					}
 
@@ -1399,8 +1328,6 @@ static unique_ptr<FunctionData> PfileBind(ClientContext &context, TableFunctionB
 				{
 					plink2::PglErr ce = plink2::kPglRetSuccess;
 					plink2::CleanupPgr(&cf_pgr, &ce);
-					ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgfi(&cf_pgfi, &ce);
 				}
 			}
 		}
@@ -1633,50 +1560,11 @@ static unique_ptr<FunctionData> PfileBind(ClientContext &context, TableFunctionB
 				PfileSource &src = bind_data->sources[src_idx];
 				uint32_t global_offset = bind_data->variant_offsets[src_idx];
 
-				// Temporary PgenReader for THIS source.
-				plink2::PgenFileInfo tmp_pgfi;
-				plink2::PreinitPgfi(&tmp_pgfi);
-				char errstr_buf2[plink2::kPglErrstrBufBlen];
-				plink2::PgenHeaderCtrl header_ctrl2;
-				uintptr_t pgfi_alloc_ct2 = 0;
-				err =
-				    plink2::PgfiInitPhase1(src.pgen_path.c_str(), nullptr, src.raw_variant_ct, bind_data->raw_sample_ct,
-				                           &header_ctrl2, &tmp_pgfi, &pgfi_alloc_ct2, errstr_buf2);
-				if (err != plink2::kPglRetSuccess) {
-					plink2::PglErr ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgfi(&tmp_pgfi, &ce);
-					throw IOException("read_pfile: failed to init PgenReader for sample-orient pre-read: %s",
-					                  errstr_buf2);
-				}
-				AlignedBuffer pgfi_alloc2;
-				if (pgfi_alloc_ct2 > 0) {
-					pgfi_alloc2.Allocate(pgfi_alloc_ct2 * plink2::kCacheline);
-				}
-				uint32_t max_vrec2 = 0;
-				uintptr_t pgr_alloc_ct2 = 0;
-				err = plink2::PgfiInitPhase2(header_ctrl2, 0, 0, 0, 0, tmp_pgfi.raw_variant_ct, &max_vrec2, &tmp_pgfi,
-				                             pgfi_alloc2.As<unsigned char>(), &pgr_alloc_ct2, errstr_buf2);
-				if (err != plink2::kPglRetSuccess) {
-					plink2::PglErr ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgfi(&tmp_pgfi, &ce);
-					throw IOException("read_pfile: failed to init PgenReader for sample-orient pre-read (phase 2): %s",
-					                  errstr_buf2);
-				}
+				// Temporary PgenReader for THIS source, on its index.
 				plink2::PgenReader tmp_pgr;
 				plink2::PreinitPgr(&tmp_pgr);
 				AlignedBuffer pgr_alloc2;
-				if (pgr_alloc_ct2 > 0) {
-					pgr_alloc2.Allocate(pgr_alloc_ct2 * plink2::kCacheline);
-				}
-				err = plink2::PgrInit(src.pgen_path.c_str(), max_vrec2, &tmp_pgfi, &tmp_pgr,
-				                      pgr_alloc2.As<unsigned char>());
-				if (err != plink2::kPglRetSuccess) {
-					plink2::PglErr ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgr(&tmp_pgr, &ce);
-					ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgfi(&tmp_pgfi, &ce);
-					throw IOException("read_pfile: PgrInit failed for sample-orient pre-read");
-				}
+				InitPgenReader(*src.pgen_index, src.pgen_path, tmp_pgr, pgr_alloc2, "read_pfile");
 				plink2::PgrSampleSubsetIndex pssi2;
 				if (bind_data->has_sample_subset) {
 					plink2::PgrSetSampleSubsetIndex(preread_subset.CumulativePopcounts(), &tmp_pgr, &pssi2);
@@ -1699,8 +1587,6 @@ static unique_ptr<FunctionData> PfileBind(ClientContext &context, TableFunctionB
 						if (err != plink2::kPglRetSuccess) {
 							plink2::PglErr ce = plink2::kPglRetSuccess;
 							plink2::CleanupPgr(&tmp_pgr, &ce);
-							ce = plink2::kPglRetSuccess;
-							plink2::CleanupPgfi(&tmp_pgfi, &ce);
 							throw IOException("read_pfile: PgrGetD failed for variant %u during sample-orient pre-read",
 							                  vidx);
 						}
@@ -1725,8 +1611,6 @@ static unique_ptr<FunctionData> PfileBind(ClientContext &context, TableFunctionB
 						if (err != plink2::kPglRetSuccess) {
 							plink2::PglErr ce = plink2::kPglRetSuccess;
 							plink2::CleanupPgr(&tmp_pgr, &ce);
-							ce = plink2::kPglRetSuccess;
-							plink2::CleanupPgfi(&tmp_pgfi, &ce);
 							throw IOException("read_pfile: PgrGetP failed for variant %u during sample-orient pre-read",
 							                  vidx);
 						}
@@ -1766,8 +1650,6 @@ static unique_ptr<FunctionData> PfileBind(ClientContext &context, TableFunctionB
 						if (err != plink2::kPglRetSuccess) {
 							plink2::PglErr ce = plink2::kPglRetSuccess;
 							plink2::CleanupPgr(&tmp_pgr, &ce);
-							ce = plink2::kPglRetSuccess;
-							plink2::CleanupPgfi(&tmp_pgfi, &ce);
 							throw IOException("read_pfile: PgrGet failed for variant %u during sample-orient pre-read",
 							                  vidx);
 						}
@@ -1804,8 +1686,6 @@ static unique_ptr<FunctionData> PfileBind(ClientContext &context, TableFunctionB
 				{
 					plink2::PglErr ce = plink2::kPglRetSuccess;
 					plink2::CleanupPgr(&tmp_pgr, &ce);
-					ce = plink2::kPglRetSuccess;
-					plink2::CleanupPgfi(&tmp_pgfi, &ce);
 				}
 			}
 
@@ -2066,6 +1946,7 @@ static unique_ptr<GlobalTableFunctionState> PfileInitGlobal(ClientContext &conte
 			state->smp_het.assign(osc, 0);
 			state->smp_hom_alt.assign(osc, 0);
 			state->smp_missing.assign(osc, 0);
+			state->smp_merge.Init(osc);
 			if (bind_data.genotype_filter.active) {
 				state->smp_in_range.assign(osc, 0);
 				state->smp_has_missing.assign(osc, 0);
@@ -2152,77 +2033,32 @@ static unique_ptr<GlobalTableFunctionState> PfileInitGlobal(ClientContext &conte
 // Init local (per-thread PgenReader)
 // ---------------------------------------------------------------------------
 
-//! Open (or reopen) this thread's PgenFileInfo/PgenReader on sources[source_idx].
+//! Open (or reopen) this thread's PgenReader on sources[source_idx].
 //! The one-time per-thread buffers (genovec/phase/dosage/sample_include/
 //! cumulative_popcounts) are sized off the shared raw_sample_ct and are NOT touched
 //! here — they are built once in PfileInitLocal and reused across source swaps
-//! (identical samples by contract). Only pgfi/pgr are torn down and rebuilt, and
-//! pssi is re-bound to the new pgr. No-op if already open on source_idx.
+//! (identical samples by contract). Only pgr is torn down and rebuilt on the
+//! source's shared index, and pssi is re-bound to the new pgr. No-op if already
+//! open on source_idx.
 static void OpenSourceReader(ClientContext &context, PfileLocalState &state, const PfileBindData &bind_data,
                              idx_t source_idx) {
 	if (state.initialized && state.current_source_idx == source_idx) {
 		return;
 	}
 	if (state.initialized) {
-		// Tear down the reader currently open on another source (pgr before pgfi).
+		// Tear down the reader currently open on another source (before its index).
 		plink2::PglErr ce = plink2::kPglRetSuccess;
 		plink2::CleanupPgr(&state.pgr, &ce);
-		plink2::CleanupPgfi(&state.pgfi, &ce);
+		state.pgen_index.reset();
 		state.initialized = false;
 	}
 
 	// Route this reader's .pgen opens through the VFS while active (Path V).
 	PgenVfsScope pgen_vfs_scope(context, bind_data.use_vfs);
 
-	const PfileSource &src = bind_data.sources[source_idx];
-
-	plink2::PreinitPgfi(&state.pgfi);
-	plink2::PreinitPgr(&state.pgr);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err =
-	    plink2::PgfiInitPhase1(src.pgen_path.c_str(), nullptr, src.raw_variant_ct, bind_data.raw_sample_ct,
-	                           &header_ctrl, &state.pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state.pgfi, &cleanup_err);
-		throw IOException("read_pfile: thread init failed (phase 1) for '%s': %s", src.pgen_path, errstr_buf);
-	}
-
-	if (pgfi_alloc_cacheline_ct > 0) {
-		state.pgfi_alloc_buf.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	} else {
-		state.pgfi_alloc_buf.Reset();
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, state.pgfi.raw_variant_ct, &max_vrec_width, &state.pgfi,
-	                             state.pgfi_alloc_buf.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state.pgfi, &cleanup_err);
-		throw IOException("read_pfile: thread init failed (phase 2) for '%s': %s", src.pgen_path, errstr_buf);
-	}
-
-	if (pgr_alloc_cacheline_ct > 0) {
-		state.pgr_alloc_buf.Allocate(pgr_alloc_cacheline_ct * plink2::kCacheline);
-	} else {
-		state.pgr_alloc_buf.Reset();
-	}
-
-	err = plink2::PgrInit(src.pgen_path.c_str(), max_vrec_width, &state.pgfi, &state.pgr,
-	                      state.pgr_alloc_buf.As<unsigned char>());
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgr(&state.pgr, &cleanup_err);
-		cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state.pgfi, &cleanup_err);
-		throw IOException("read_pfile: PgrInit failed for '%s'", src.pgen_path);
-	}
+	state.pgen_index = bind_data.sources[source_idx].pgen_index;
+	InitPgenReader(*state.pgen_index, bind_data.sources[source_idx].pgen_path, state.pgr, state.pgr_alloc_buf,
+	               "read_pfile");
 
 	// Re-bind the sample-subset index to the (new) pgr. cumulative_popcounts_buf was
 	// filled once in PfileInitLocal and is identical across sources.
@@ -2236,6 +2072,22 @@ static void OpenSourceReader(ClientContext &context, PfileLocalState &state, con
 	state.initialized = true;
 }
 
+//! Multi-file claim loops: hint the batch after `batch_idx` when it is on the same
+//! source (the reader is open there), so its records arrive while this one decodes.
+static void PrefetchNextSourceBatch(const PfileGlobalState &gstate, PfileLocalState &state,
+                                    const PfileSource &source, uint32_t batch_idx) {
+	if (batch_idx + 1 >= gstate.batches.size()) {
+		return;
+	}
+	const ScanBatch &next = gstate.batches[batch_idx + 1];
+	if (next.source_idx != gstate.batches[batch_idx].source_idx) {
+		return;
+	}
+	PrefetchPgenBatch(*state.pgen_index, state.pgr,
+	                  source.has_effective_variant_list ? &source.effective_variant_indices : nullptr,
+	                  next.local_start, next.local_end);
+}
+
 static unique_ptr<LocalTableFunctionState> PfileInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
                                                           GlobalTableFunctionState *global_state) {
 	auto &bind_data = input.bind_data->Cast<PfileBindData>();
@@ -2270,7 +2122,7 @@ static unique_ptr<LocalTableFunctionState> PfileInitLocal(ExecutionContext &cont
 
 	// --- Allocate one-time per-thread buffers (sized off shared raw_sample_ct) ---
 	// These are reused across all sources (identical samples by contract); only the
-	// pgfi/pgr reader swaps at a file boundary.
+	// pgr reader swaps at a file boundary.
 	uint32_t genovec_sample_ct = bind_data.raw_sample_ct;
 	uintptr_t genovec_word_ct = plink2::NypCtToAlignedWordCt(genovec_sample_ct);
 	state->genovec_buf.Allocate(genovec_word_ct * sizeof(uintptr_t));
@@ -2790,6 +2642,11 @@ static void PfileDefaultScan(ClientContext &context, TableFunctionInput &data_p,
 				break;
 			}
 			uint32_t batch_end = std::min(batch_start + claim_size, total_variants);
+			if (lstate.initialized) {
+				PrefetchPgenBatch(*lstate.pgen_index, lstate.pgr,
+				                  source.has_effective_variant_list ? &source.effective_variant_indices : nullptr,
+				                  batch_end, std::min(batch_end + claim_size, total_variants));
+			}
 			for (uint32_t effective_pos = batch_start; effective_pos < batch_end; effective_pos++) {
 				if (emit_variant_row(source, effective_pos)) {
 					rows_emitted++;
@@ -2812,6 +2669,9 @@ static void PfileDefaultScan(ClientContext &context, TableFunctionInput &data_p,
 			const PfileSource &source = bind_data.sources[batch.source_idx];
 			if (gstate.need_pgen_reader) {
 				OpenSourceReader(context, lstate, bind_data, batch.source_idx);
+				if (lstate.mf_local == batch.local_start) {
+					PrefetchNextSourceBatch(gstate, lstate, source, lstate.mf_batch);
+				}
 			}
 			while (lstate.mf_local < batch.local_end && rows_emitted < STANDARD_VECTOR_SIZE) {
 				if (emit_variant_row(source, lstate.mf_local)) {
@@ -3177,6 +3037,13 @@ static void PfileTidyScan(ClientContext &context, TableFunctionInput &data_p, Da
 					break; // no more work
 				}
 				lstate.batch_end = std::min(lstate.batch_start + PFILE_GENOTYPE_BATCH_SIZE, total_effective_variants);
+				if (lstate.initialized) {
+					PrefetchPgenBatch(
+					    *lstate.pgen_index, lstate.pgr,
+					    source.has_effective_variant_list ? &source.effective_variant_indices : nullptr,
+					    lstate.batch_end,
+					    std::min(lstate.batch_end + PFILE_GENOTYPE_BATCH_SIZE, total_effective_variants));
+				}
 				lstate.current_variant_in_batch = lstate.batch_start;
 				lstate.current_sample_in_variant = 0;
 				lstate.batch_variant_loaded = false;
@@ -3234,6 +3101,9 @@ static void PfileTidyScan(ClientContext &context, TableFunctionInput &data_p, Da
 			const PfileSource &source = bind_data.sources[batch.source_idx];
 			if (gstate.need_pgen_reader) {
 				OpenSourceReader(context, lstate, bind_data, batch.source_idx);
+				if (lstate.mf_local == batch.local_start) {
+					PrefetchNextSourceBatch(gstate, lstate, source, lstate.mf_batch);
+				}
 			}
 
 			while (lstate.mf_local < batch.local_end && rows_emitted < STANDARD_VECTOR_SIZE) {
@@ -3419,21 +3289,21 @@ static void PfileSampleOrientScan(ClientContext &context, TableFunctionInput &da
 			}
 		}
 
-		// Merge thread-local accumulators into the global state.
-		{
-			std::lock_guard<std::mutex> lock(gstate.smp_merge_mutex);
-			for (uint32_t s = 0; s < output_sample_ct; s++) {
+		// Merge thread-local accumulators into the global state, one sample stripe at a
+		// time (threads finishing together merge different stripes concurrently).
+		gstate.smp_merge.Merge([&](idx_t begin, idx_t end) {
+			for (idx_t s = begin; s < end; s++) {
 				gstate.smp_het[s] += lstate.smp_local_het[s];
 				gstate.smp_hom_alt[s] += lstate.smp_local_hom_alt[s];
 				gstate.smp_missing[s] += lstate.smp_local_missing[s];
 			}
 			if (filter_active) {
-				for (uint32_t s = 0; s < output_sample_ct; s++) {
+				for (idx_t s = begin; s < end; s++) {
 					gstate.smp_in_range[s] |= lstate.smp_local_in_range[s];
 					gstate.smp_has_missing[s] |= lstate.smp_local_has_missing[s];
 				}
 			}
-		}
+		});
 		lstate.smp_phase1_contributed = true;
 
 		// Last thread out of Phase 1 finalizes and opens Phase 2. Non-last threads
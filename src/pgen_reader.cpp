@@ -20,6 +20,7 @@ struct PgenBindData : public TableFunctionData {
 	string pgen_path;
 	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
 	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
 	string pvar_path;
 	string psam_path;
 
@@ -82,6 +83,9 @@ struct PgenGlobalState : public GlobalTableFunctionState {
 	vector<column_t> column_ids;
 	uint32_t max_threads_config = 0;
 
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
 	idx_t MaxThreads() const override {
 		return ApplyMaxThreadsCap(total_variants / 1000 + 1, max_threads_config);
 	}
@@ -92,10 +96,9 @@ struct PgenGlobalState : public GlobalTableFunctionState {
 // ---------------------------------------------------------------------------
 
 struct PgenLocalState : public LocalTableFunctionState {
-	// Per-thread PgenFileInfo — must outlive the PgenReader since pgr
-	// holds a reference to pgfi's shared state.
-	plink2::PgenFileInfo pgfi;
-	AlignedBuffer pgfi_alloc_buf;
+	// The query's shared PgenFileInfo — must outlive the PgenReader since pgr
+	// holds pointers into its index arrays.
+	shared_ptr<PgenIndex> pgen_index;
 
 	plink2::PgenReader pgr;
 	AlignedBuffer pgr_alloc_buf;
@@ -127,7 +130,6 @@ struct PgenLocalState : public LocalTableFunctionState {
 			// PgenReader must be cleaned up before PgenFileInfo
 			plink2::PglErr reterr = plink2::kPglRetSuccess;
 			plink2::CleanupPgr(&pgr, &reterr);
-			plink2::CleanupPgfi(&pgfi, &reterr);
 			// AlignedBuffer destructors handle the aligned allocs
 		}
 	}
@@ -217,53 +219,16 @@ static unique_ptr<FunctionData> PgenBind(ClientContext &context, TableFunctionBi
 		// .psam is optional for read_pgen — if not found, we operate in index-only mode
 	}
 
-	// --- Initialize pgenlib (Phase 1) ---
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
 	// Decide once how .pgen bytes are read (native fopen vs DuckDB VFS); the scope
 	// routes pgenlib's opens on this thread through the VFS while active.
 	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
 	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
 	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
 
-	plink2::PgenFileInfo pgfi;
-	plink2::PreinitPgfi(&pgfi);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err = plink2::PgfiInitPhase1(bind_data->pgen_path.c_str(), nullptr, // no .pgi file
-	                                            UINT32_MAX,                            // infer raw_variant_ct
-	                                            UINT32_MAX,                            // infer raw_sample_ct
-	                                            &header_ctrl, &pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("read_pgen: failed to open '%s': %s", bind_data->pgen_path, errstr_buf);
-	}
-
-	bind_data->raw_variant_ct = pgfi.raw_variant_ct;
-	bind_data->raw_sample_ct = pgfi.raw_sample_ct;
-
-	// --- Phase 2: allocate pgfi memory and complete init ---
-	AlignedBuffer pgfi_alloc;
-	if (pgfi_alloc_cacheline_ct > 0) {
-		pgfi_alloc.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, pgfi.raw_variant_ct, &max_vrec_width, &pgfi,
-	                             pgfi_alloc.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	// Clean up pgfi — we only needed it to get counts and alloc sizes.
-	plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-	plink2::CleanupPgfi(&pgfi, &cleanup_err);
-
-	if (err != plink2::kPglRetSuccess) {
-		throw IOException("read_pgen: failed to initialize '%s' (phase 2): %s", bind_data->pgen_path, errstr_buf);
-	}
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "read_pgen");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
 
 	// --- Load variant metadata ---
 	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "read_pgen");
@@ -500,6 +465,10 @@ static unique_ptr<GlobalTableFunctionState> PgenInitGlobal(ClientContext &contex
 	state->need_pgen_reader = state->need_genotypes || bind_data.count_filter.HasFilter() ||
 	                          bind_data.genotype_filter.active || need_aggregate_pgen;
 
+	if (state->need_pgen_reader) {
+		state->pgen_index = bind_data.pgen_index;
+	}
+
 	return std::move(state);
 }
 
@@ -518,56 +487,11 @@ static unique_ptr<LocalTableFunctionState> PgenInitLocal(ExecutionContext &conte
 		return std::move(state);
 	}
 
-	// --- Initialize per-thread PgenFileInfo + PgenReader ---
+	// --- Per-thread PgenReader on the query's shared index ---
 	// Route the reader's opens through the VFS while active (Path V), matching bind.
 	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
-	plink2::PreinitPgfi(&state->pgfi);
-	plink2::PreinitPgr(&state->pgr);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err =
-	    plink2::PgfiInitPhase1(bind_data.pgen_path.c_str(), nullptr, bind_data.raw_variant_ct, bind_data.raw_sample_ct,
-	                           &header_ctrl, &state->pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("read_pgen: thread init failed (phase 1): %s", errstr_buf);
-	}
-
-	if (pgfi_alloc_cacheline_ct > 0) {
-		state->pgfi_alloc_buf.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, state->pgfi.raw_variant_ct, &max_vrec_width, &state->pgfi,
-	                             state->pgfi_alloc_buf.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("read_pgen: thread init failed (phase 2): %s", errstr_buf);
-	}
-
-	if (pgr_alloc_cacheline_ct > 0) {
-		state->pgr_alloc_buf.Allocate(pgr_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	err = plink2::PgrInit(bind_data.pgen_path.c_str(), max_vrec_width, &state->pgfi, &state->pgr,
-	                      state->pgr_alloc_buf.As<unsigned char>());
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgr(&state->pgr, &cleanup_err);
-		cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("read_pgen: PgrInit failed for '%s'", bind_data.pgen_path);
-	}
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "read_pgen");
 
 	// Allocate genovec buffer (2 bits per sample, vector-aligned for SIMD safety)
 	uint32_t effective_sample_ct = bind_data.has_sample_subset ? bind_data.raw_sample_ct : bind_data.sample_ct;
@@ -654,6 +578,11 @@ static void PgenScan(ClientContext &context, TableFunctionInput &data_p, DataChu
 			break;
 		}
 		uint32_t batch_end = std::min(batch_start + claim_size, total_variants);
+		if (lstate.initialized) {
+			PrefetchPgenBatch(*lstate.pgen_index, lstate.pgr,
+			                  bind_data.has_effective_variant_list ? &bind_data.effective_variant_indices : nullptr,
+			                  batch_end, std::min(batch_end + claim_size, total_variants));
+		}
 
 		for (uint32_t ev = batch_start; ev < batch_end; ev++) {
 			uint32_t vidx = bind_data.has_effective_variant_list ? bind_data.effective_variant_indices[ev] : ev;
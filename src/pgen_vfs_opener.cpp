@@ -1,4 +1,5 @@
 #include "pgen_vfs_opener.hpp"
+#include "duckdb_compat.hpp"
 #include "plinking_pgen_vfs.hpp"
 
 #include "duckdb/common/file_system.hpp"
@@ -6,6 +7,7 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/config.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
 
 #include <atomic>
 
@@ -60,12 +62,42 @@ int64_t PgenVfsSize(void *handle) {
 	}
 }
 
+int64_t PgenVfsVersion(void *handle) {
+	auto *fh = static_cast<FileHandle *>(handle);
+	try {
+		// Last-modified time (httpfs: the Last-Modified header); with the size it keys
+		// the shared block cache, so a rewritten file never serves stale blocks.
+		return fh->file_system.GetLastModifiedTime(*fh).value;
+	} catch (...) {
+		return 0;
+	}
+}
+
 void PgenVfsClose(void *handle) {
 	delete static_cast<FileHandle *>(handle);
 }
 
 } // namespace
 
+static string PgenIoPolicy(ClientContext &context) {
+	string policy = "auto";
+	Value v;
+	if (context.TryGetCurrentSetting("plinking_pgen_io", v) && !v.IsNull()) {
+		policy = StringUtil::Lower(v.ToString());
+	}
+	if (policy != "auto" && policy != "native" && policy != "vfs" && policy != "localize" && policy != "mmap" &&
+	    policy != "uring") {
+		throw InvalidInputException(
+		    "unknown plinking_pgen_io := '%s' (expected 'auto', 'native', 'vfs', 'localize', 'mmap', 'uring')",
+		    policy);
+	}
+	return policy;
+}
+
+void SetPgenCacheBudget(int64_t bytes) {
+	plinking_pgen_cache_set_budget(static_cast<uint64_t>(MaxValue<int64_t>(bytes, 0)));
+}
+
 struct PgenVfsScope::State {
 	PgenVfsUser user;
 	PlinkingPgenVfsOpener opener;
@@ -73,6 +105,17 @@ struct PgenVfsScope::State {
 
 PgenVfsScope::PgenVfsScope(ClientContext &context, bool use_vfs) : active_(use_vfs) {
 	if (!active_) {
+		// Path M: local opens served from the shim's shared mapping; Path U: through
+		// io_uring read-ahead (falling back to fopen where io_uring is unavailable)
+		string policy = PgenIoPolicy(context);
+		mmap_ = policy == "mmap";
+		if (mmap_) {
+			plinking_pgen_set_mmap(1);
+		}
+		uring_ = policy == "uring";
+		if (uring_) {
+			plinking_pgen_set_uring(1);
+		}
 		return;
 	}
 	state_ = make_uniq<State>();
@@ -81,6 +124,7 @@ PgenVfsScope::PgenVfsScope(ClientContext &context, bool use_vfs) : active_(use_v
 	state_->opener.open = PgenVfsOpen;
 	state_->opener.pread = PgenVfsPread;
 	state_->opener.size = PgenVfsSize;
+	state_->opener.version = PgenVfsVersion;
 	state_->opener.close = PgenVfsClose;
 	plinking_pgen_set_vfs_opener(&state_->opener);
 }
@@ -89,19 +133,12 @@ PgenVfsScope::~PgenVfsScope() {
 	if (active_) {
 		plinking_pgen_set_vfs_opener(nullptr);
 	}
-}
-
-static string PgenIoPolicy(ClientContext &context) {
-	string policy = "auto";
-	Value v;
-	if (context.TryGetCurrentSetting("plinking_pgen_io", v) && !v.IsNull()) {
-		policy = StringUtil::Lower(v.ToString());
+	if (mmap_) {
+		plinking_pgen_set_mmap(0);
 	}
-	if (policy != "auto" && policy != "native" && policy != "vfs" && policy != "localize") {
-		throw InvalidInputException("unknown plinking_pgen_io := '%s' (expected 'auto', 'native', 'vfs', 'localize')",
-		                            policy);
+	if (uring_) {
+		plinking_pgen_set_uring(0);
 	}
-	return policy;
 }
 
 bool PgenIoUseVfs(ClientContext &context, const string &pgen_path) {
@@ -114,6 +151,7 @@ bool PgenIoUseVfs(ClientContext &context, const string &pgen_path) {
 		return false;
 	}
 	// auto: route remote/VFS paths through Path V; plain-local uses native fopen.
+	// mmap / uring: likewise (both serve local files only); local opens take Path M / U.
 	return FileSystem::IsRemoteFile(pgen_path);
 }
 
@@ -251,4 +289,55 @@ void LocalizePgenIfRequested(ClientContext &context, string &pgen_path, PgenLoca
 	pgen_path = temp; // downstream opens read the native local temp
 }
 
+// --- plinking_pgen_cache_stats(): the shared block cache's counters --------------
+
+namespace {
+
+struct PgenCacheStatsState : public GlobalTableFunctionState {
+	bool done = false;
+};
+
+unique_ptr<FunctionData> PgenCacheStatsBind(ClientContext &, TableFunctionBindInput &,
+                                            vector<LogicalType> &return_types, vector<string> &names) {
+	for (auto name : {"budget_bytes", "cached_bytes", "cached_blocks", "hits", "misses", "evictions",
+	                  "prefetched_blocks", "uring_opens"}) {
+		names.emplace_back(name);
+		return_types.emplace_back(LogicalType::UBIGINT);
+	}
+	// Whether plinking_pgen_io := 'uring' can take effect here (compiled in and not
+	// refused by the kernel); uring_opens counts the opens it served
+	names.emplace_back("uring_supported");
+	return_types.emplace_back(LogicalType::BOOLEAN);
+	return make_uniq<TableFunctionData>();
+}
+
+unique_ptr<GlobalTableFunctionState> PgenCacheStatsInit(ClientContext &, TableFunctionInitInput &) {
+	return make_uniq<PgenCacheStatsState>();
+}
+
+void PgenCacheStatsScan(ClientContext &, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<PgenCacheStatsState>();
+	if (state.done) {
+		return;
+	}
+	state.done = true;
+	PlinkingPgenCacheStats stats;
+	plinking_pgen_cache_stats(&stats);
+	uint64_t values[] = {stats.budget, stats.bytes,     stats.blocks,     stats.hits,
+	                     stats.misses, stats.evictions, stats.prefetched, stats.uring_opens};
+	idx_t value_ct = sizeof(values) / sizeof(values[0]);
+	for (idx_t col = 0; col < value_ct; col++) {
+		output.SetValue(col, 0, Value::UBIGINT(values[col]));
+	}
+	output.SetValue(value_ct, 0, Value::BOOLEAN(plinking_pgen_uring_supported() != 0));
+	CompatSetOutputCardinality(output, 1);
+}
+
+} // namespace
+
+void RegisterPgenCacheStats(ExtensionLoader &loader) {
+	TableFunction stats("plinking_pgen_cache_stats", {}, PgenCacheStatsScan, PgenCacheStatsBind, PgenCacheStatsInit);
+	loader.RegisterFunction(stats);
+}
+
 } // namespace duckdb
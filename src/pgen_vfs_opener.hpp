@@ -10,11 +10,21 @@
 
 namespace duckdb {
 
+//! Default byte budget of the shim's process-wide .pgen block cache
+//! (plinking_pgen_cache_size).
+static constexpr int64_t PGEN_CACHE_SIZE_DEFAULT = 256LL * 1024 * 1024;
+
+//! Resize the shim's block cache. It is shared by the whole process, so this is
+//! applied only from SET GLOBAL plinking_pgen_cache_size, never per query.
+void SetPgenCacheBudget(int64_t bytes);
+
 //! Resolve the `plinking_pgen_io` policy against a path: should this pgen open go
 //! through DuckDB's VFS (Path V, cookie over FileHandle) vs a native local fopen
 //! (Path L)? auto (default) => remote paths use V; native => always L; vfs =>
 //! always V; localize => L (the path has already been rewritten to a local temp by
-//! LocalizePgenIfRequested). Pure: no I/O, safe to call more than once.
+//! LocalizePgenIfRequested); mmap => remote paths use V, local ones the shared
+//! mapping (Path M, armed by PgenVfsScope); uring => likewise, local ones through
+//! io_uring read-ahead (Path U). Pure: no I/O, safe to call more than once.
 bool PgenIoUseVfs(ClientContext &context, const string &pgen_path);
 
 //! RAII owner of localized (downloaded-to-local-temp) .pgen copies. Lives as a
@@ -50,8 +60,11 @@ private:
 void LocalizePgenIfRequested(ClientContext &context, string &pgen_path, PgenLocalizeGuard &guard);
 
 //! RAII: while in scope AND use_vfs, pgen opens on THIS thread are served from the
-//! VFS. A no-op (native fopen) when use_vfs is false. Register/clear is per-thread,
-//! so construct one around each pgenlib open region (bind, per-thread reader init).
+//! VFS, through the shim's shared block cache (sized from plinking_pgen_cache_size).
+//! When use_vfs is false, opens use native fopen, the shim's shared mapping under
+//! plinking_pgen_io := 'mmap', or its io_uring reader under 'uring'. Register/clear
+//! is per-thread, so construct one around each pgenlib open region (bind, per-thread
+//! reader init).
 class PgenVfsScope {
 public:
 	PgenVfsScope(ClientContext &context, bool use_vfs);
@@ -61,8 +74,14 @@ public:
 
 private:
 	bool active_;
+	bool mmap_ = false;
+	bool uring_ = false;
 	struct State;
 	unique_ptr<State> state_;
 };
 
+//! Register plinking_pgen_cache_stats(): one row of the shared block cache's budget,
+//! occupancy and hit/miss/eviction counters.
+void RegisterPgenCacheStats(ExtensionLoader &loader);
+
 } // namespace duckdb
@@ -0,0 +1,633 @@
+// plink_clump.cpp — LD clumping of association results (plink2 --clump) against a
+// reference .pgen.
+//
+// `results` is a list of (id, p) structs, typically
+// `(SELECT list({'id': ID, 'p': P}) FROM gwas)`. Variants with p <= p2 that resolve
+// in the reference are candidates. Per chromosome, candidates with p <= p1 become
+// index variants in ascending-P order; each index variant not already in a clump
+// claims every still-unassigned candidate within window_kb with r² >= r2_threshold.
+// r² is plink_ld's genotype-level pair statistic, so LD is only computed between an
+// index variant and the unassigned candidates of its window — never all pairs.
+//
+// Decoded candidates stay resident in a per-thread LdWindowCache keyed by their
+// position in the chromosome's candidate list, so a candidate that falls in several
+// index windows is read from the .pgen once. Chromosomes are independent and are
+// claimed by threads one at a time.
+
+#include "plink_clump.hpp"
+#include "duckdb_compat.hpp"
+#include "plink_common.hpp"
+#include "plink_ld_kernel.hpp"
+#include "pgen_vfs_opener.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace duckdb {
+
+// ---------------------------------------------------------------------------
+// Column indices
+// ---------------------------------------------------------------------------
+
+static constexpr idx_t COL_CHROM = 0;
+static constexpr idx_t COL_POS = 1;
+static constexpr idx_t COL_ID = 2;
+static constexpr idx_t COL_P = 3;
+static constexpr idx_t COL_TOTAL = 4;
+static constexpr idx_t COL_SP2 = 5;
+
+// ---------------------------------------------------------------------------
+// Bind data
+// ---------------------------------------------------------------------------
+
+struct ClumpCandidate {
+	uint32_t vidx;
+	double p;
+};
+
+struct PlinkClumpBindData : public TableFunctionData {
+	string pgen_path;
+	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
+	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
+	string pvar_path;
+	string psam_path;
+
+	VariantMetadataIndex variants;
+	SampleInfo sample_info;
+	bool has_sample_info = false;
+
+	uint32_t raw_variant_ct = 0;
+	uint32_t raw_sample_ct = 0;
+
+	// Sample subsetting
+	bool has_sample_subset = false;
+	unique_ptr<SampleSubset> sample_subset;
+	uint32_t effective_sample_ct = 0;
+
+	// Region filtering
+	VariantRange variant_range;
+
+	// Clumping parameters (plink2 --clump-p1 / -p2 / -r2 / -kb defaults)
+	double p1 = 1e-4;
+	double p2 = 1e-2;
+	double r2_threshold = 0.5;
+	int64_t window_bp = 250000; // window_kb * 1000
+
+	//! Resolved results with p <= p2, sorted by vidx
+	vector<ClumpCandidate> candidates;
+	//! [start, end) into candidates of each chromosome that has an index variant
+	vector<std::pair<uint32_t, uint32_t>> chrom_ranges;
+	//! Most candidates any window spans (sizes the window cache)
+	uint32_t max_window_ct = 0;
+
+	// Pair kernel (plinking_ld_kernel)
+	LdKernel ld_kernel = LdKernel::AUTO;
+};
+
+// ---------------------------------------------------------------------------
+// Global state
+// ---------------------------------------------------------------------------
+
+struct PlinkClumpGlobalState : public GlobalTableFunctionState {
+	std::atomic<uint32_t> next_chrom {0};
+	idx_t chrom_ct = 0;
+	uint32_t max_threads_config = 0;
+
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
+	idx_t MaxThreads() const override {
+		return ApplyMaxThreadsCap(MaxValue<idx_t>(chrom_ct, 1), max_threads_config);
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Local state (per-thread)
+// ---------------------------------------------------------------------------
+
+struct ClumpRow {
+	uint32_t index;          // position in bind_data.candidates
+	vector<uint32_t> members; // positions in bind_data.candidates, file order
+};
+
+struct PlinkClumpLocalState : public LocalTableFunctionState {
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
+
+	plink2::PgenReader pgr;
+	AlignedBuffer pgr_alloc_buf;
+
+	plink2::PgrSampleSubsetIndex pssi;
+
+	AlignedBuffer genovec_buf;       // PgrGet decode target
+	LdVariantGenotypes anchor_geno;  // uncached path
+	LdVariantGenotypes partner_geno; // uncached path
+	LdWindowCache window_cache;      // keyed by candidate position
+
+	// Clumps of the current chromosome, emitted across scan calls
+	vector<ClumpRow> clumps;
+	idx_t clumps_emitted = 0;
+
+	bool initialized = false;
+
+	~PlinkClumpLocalState() {
+		if (initialized) {
+			plink2::PglErr reterr = plink2::kPglRetSuccess;
+			plink2::CleanupPgr(&pgr, &reterr);
+		}
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Bind
+// ---------------------------------------------------------------------------
+
+//! Parse `results` := LIST(STRUCT(id VARCHAR, p DOUBLE)) into candidates with p <= p2.
+//! Entries that do not resolve in the reference (or fall outside the region) are
+//! skipped; a variant listed more than once keeps its smallest P.
+static void ResolveClumpResults(const Value &results, PlinkClumpBindData &bind_data) {
+	auto &type = results.type();
+	if (type.id() != LogicalTypeId::LIST || ListType::GetChildType(type).id() != LogicalTypeId::STRUCT) {
+		throw InvalidInputException("plink_clump: results must be LIST(STRUCT(id VARCHAR, p DOUBLE)), "
+		                            "e.g. (SELECT list({'id': ID, 'p': P}) FROM gwas)");
+	}
+
+	auto &struct_children = StructType::GetChildTypes(ListType::GetChildType(type));
+	bool has_id = false, has_p = false;
+	idx_t id_idx = 0, p_idx = 0;
+	for (idx_t i = 0; i < struct_children.size(); i++) {
+		auto name = StringUtil::Lower(struct_children[i].first);
+		if (name == "id") {
+			has_id = true;
+			id_idx = i;
+		} else if (name == "p") {
+			has_p = true;
+			p_idx = i;
+		}
+	}
+	if (!has_id || !has_p) {
+		throw InvalidInputException("plink_clump: results must be LIST(STRUCT(id VARCHAR, p DOUBLE))");
+	}
+
+	// list() over no rows is NULL, e.g. when no result passes a WHERE P < ... filter
+	if (results.IsNull()) {
+		throw InvalidInputException("plink_clump: results is NULL (no association results were passed); "
+		                            "check the filter of the results subquery");
+	}
+	auto &children = ListValue::GetChildren(results);
+	if (children.empty()) {
+		throw InvalidInputException("plink_clump: results list is empty");
+	}
+
+	uint32_t range_start = bind_data.variant_range.has_filter ? bind_data.variant_range.start_idx : 0;
+	uint32_t range_end =
+	    bind_data.variant_range.has_filter ? bind_data.variant_range.end_idx : bind_data.raw_variant_ct;
+
+	auto id_to_idx = BuildVariantIdIndex(bind_data.variants);
+	for (auto &entry : children) {
+		if (entry.IsNull()) {
+			continue;
+		}
+		auto &struct_vals = StructValue::GetChildren(entry);
+		if (struct_vals[id_idx].IsNull() || struct_vals[p_idx].IsNull()) {
+			continue;
+		}
+		double p = struct_vals[p_idx].GetValue<double>();
+		if (std::isnan(p) || p < 0.0 || p > 1.0) {
+			throw InvalidInputException("plink_clump: P value %g for '%s' is not in [0, 1]", p,
+			                            struct_vals[id_idx].ToString());
+		}
+		if (p > bind_data.p2) {
+			continue;
+		}
+		uint32_t vidx = 0;
+		if (!TryResolveVariantString(struct_vals[id_idx].GetValue<string>(), bind_data.variants, id_to_idx, vidx)) {
+			continue;
+		}
+		if (vidx < range_start || vidx >= range_end) {
+			continue;
+		}
+		bind_data.candidates.push_back({vidx, p});
+	}
+
+	std::sort(bind_data.candidates.begin(), bind_data.candidates.end(),
+	          [](const ClumpCandidate &a, const ClumpCandidate &b) {
+		          return a.vidx != b.vidx ? a.vidx < b.vidx : a.p < b.p;
+	          });
+	bind_data.candidates.erase(std::unique(bind_data.candidates.begin(), bind_data.candidates.end(),
+	                                       [](const ClumpCandidate &a, const ClumpCandidate &b) {
+		                                       return a.vidx == b.vidx;
+	                                       }),
+	                           bind_data.candidates.end());
+}
+
+//! Split candidates at chromosome boundaries (keeping chromosomes with an index
+//! variant) and find the widest window, in candidates.
+static void PlanClumpChromosomes(PlinkClumpBindData &bind_data) {
+	auto &variants = bind_data.variants;
+	auto &candidates = bind_data.candidates;
+	uint32_t cand_ct = static_cast<uint32_t>(candidates.size());
+
+	uint32_t chrom_start = 0;
+	for (uint32_t c = 1; c <= cand_ct; c++) {
+		if (c < cand_ct && variants.GetChrom(candidates[c].vidx) == variants.GetChrom(candidates[chrom_start].vidx)) {
+			continue;
+		}
+		bool has_index = false;
+		for (uint32_t k = chrom_start; k < c; k++) {
+			has_index |= candidates[k].p <= bind_data.p1;
+		}
+		if (has_index) {
+			bind_data.chrom_ranges.emplace_back(chrom_start, c);
+
+			// Two-pointer sweep: candidates within window_bp after each one
+			uint32_t hi = chrom_start;
+			for (uint32_t lo = chrom_start; lo < c; lo++) {
+				int64_t pos = variants.GetPos(candidates[lo].vidx);
+				hi = MaxValue(hi, lo);
+				while (hi < c && static_cast<int64_t>(variants.GetPos(candidates[hi].vidx)) - pos <=
+				                     bind_data.window_bp) {
+					hi++;
+				}
+				bind_data.max_window_ct = MaxValue(bind_data.max_window_ct, hi - lo);
+			}
+		}
+		chrom_start = c;
+	}
+}
+
+static unique_ptr<FunctionData> PlinkClumpBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<PlinkClumpBindData>();
+	bind_data->pgen_path = input.inputs[0].GetValue<string>();
+
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	// --- Collect named parameters ---
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "pvar") {
+			bind_data->pvar_path = kv.second.GetValue<string>();
+		} else if (kv.first == "psam") {
+			bind_data->psam_path = kv.second.GetValue<string>();
+		} else if (kv.first == "p1") {
+			bind_data->p1 = kv.second.GetValue<double>();
+		} else if (kv.first == "p2") {
+			bind_data->p2 = kv.second.GetValue<double>();
+		} else if (kv.first == "r2_threshold") {
+			bind_data->r2_threshold = kv.second.GetValue<double>();
+			if (bind_data->r2_threshold < 0.0 || bind_data->r2_threshold > 1.0) {
+				throw InvalidInputException("plink_clump: r2_threshold must be between 0.0 and 1.0");
+			}
+		} else if (kv.first == "window_kb") {
+			auto kb = kv.second.GetValue<int64_t>();
+			if (kb < 0) {
+				throw InvalidInputException("plink_clump: window_kb must be non-negative");
+			}
+			bind_data->window_bp = kb * 1000;
+		} else if (kv.first == "results" || kv.first == "samples" || kv.first == "region") {
+			// Handled after pgenlib init
+		}
+	}
+
+	if (!(bind_data->p1 > 0.0 && bind_data->p1 <= 1.0)) {
+		throw InvalidInputException("plink_clump: p1 must be in (0, 1], got %g", bind_data->p1);
+	}
+	if (!(bind_data->p2 >= bind_data->p1 && bind_data->p2 <= 1.0)) {
+		throw InvalidInputException("plink_clump: p2 must be in [p1, 1], got %g", bind_data->p2);
+	}
+
+	auto results_it = input.named_parameters.find("results");
+	if (results_it == input.named_parameters.end()) {
+		throw InvalidInputException("plink_clump: results parameter is required "
+		                            "(e.g. results := (SELECT list({'id': ID, 'p': P}) FROM gwas))");
+	}
+
+	bind_data->ld_kernel = ResolveLdKernel(context, "plink_clump");
+
+	// --- Auto-discover companion files ---
+	if (bind_data->pvar_path.empty()) {
+		bind_data->pvar_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".pvar", ".bim"});
+		if (bind_data->pvar_path.empty()) {
+			throw InvalidInputException("plink_clump: cannot find .pvar or .bim companion for '%s' "
+			                            "(use pvar := 'path' to specify explicitly)",
+			                            bind_data->pgen_path);
+		}
+	}
+
+	if (bind_data->psam_path.empty()) {
+		bind_data->psam_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".psam", ".fam"});
+		// .psam is optional — only needed if samples parameter uses VARCHAR IDs
+	}
+
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
+	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
+	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
+	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
+
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_clump");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
+
+	// --- Load variant metadata ---
+	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_clump");
+
+	if (bind_data->variants.variant_ct != bind_data->raw_variant_ct) {
+		throw InvalidInputException("plink_clump: variant count mismatch: .pgen has %u variants, "
+		                            ".pvar/.bim '%s' has %llu variants",
+		                            bind_data->raw_variant_ct, bind_data->pvar_path,
+		                            static_cast<unsigned long long>(bind_data->variants.variant_ct));
+	}
+
+	// --- Load sample info (optional) ---
+	if (!bind_data->psam_path.empty()) {
+		bind_data->sample_info = LoadSampleMetadata(context, bind_data->psam_path);
+		bind_data->has_sample_info = true;
+
+		if (static_cast<uint32_t>(bind_data->sample_info.sample_ct) != bind_data->raw_sample_ct) {
+			throw InvalidInputException("plink_clump: sample count mismatch: .pgen has %u samples, "
+			                            ".psam/.fam '%s' has %llu samples",
+			                            bind_data->raw_sample_ct, bind_data->psam_path,
+			                            static_cast<unsigned long long>(bind_data->sample_info.sample_ct));
+		}
+	}
+
+	// --- Process samples parameter ---
+	bind_data->effective_sample_ct = bind_data->raw_sample_ct;
+
+	auto samples_it = input.named_parameters.find("samples");
+	if (samples_it != input.named_parameters.end()) {
+		auto indices =
+		    ResolveSampleIndices(samples_it->second, bind_data->raw_sample_ct,
+		                         bind_data->has_sample_info ? &bind_data->sample_info : nullptr, "plink_clump");
+
+		bind_data->sample_subset = make_uniq<SampleSubset>(BuildSampleSubset(bind_data->raw_sample_ct, indices));
+		bind_data->has_sample_subset = true;
+		bind_data->effective_sample_ct = bind_data->sample_subset->subset_sample_ct;
+	}
+
+	// --- Process region parameter ---
+	auto region_it = input.named_parameters.find("region");
+	if (region_it != input.named_parameters.end()) {
+		bind_data->variant_range =
+		    ParseRegion(region_it->second.GetValue<string>(), bind_data->variants, "plink_clump");
+	}
+
+	// --- Resolve results and plan per-chromosome work ---
+	ResolveClumpResults(results_it->second, *bind_data);
+	PlanClumpChromosomes(*bind_data);
+
+	// --- Register output columns ---
+	names = {"CHROM", "POS", "ID", "P", "TOTAL", "SP2"};
+	return_types = {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::VARCHAR,
+	                LogicalType::DOUBLE,  LogicalType::INTEGER, LogicalType::LIST(LogicalType::VARCHAR)};
+
+	return std::move(bind_data);
+}
+
+// ---------------------------------------------------------------------------
+// Init global
+// ---------------------------------------------------------------------------
+
+static unique_ptr<GlobalTableFunctionState> PlinkClumpInitGlobal(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PlinkClumpBindData>();
+	auto state = make_uniq<PlinkClumpGlobalState>();
+	state->chrom_ct = bind_data.chrom_ranges.size();
+	state->max_threads_config = GetPlinkingMaxThreads(context);
+
+	if (!bind_data.chrom_ranges.empty()) {
+		state->pgen_index = bind_data.pgen_index;
+	}
+
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Init local (per-thread PgenReader)
+// ---------------------------------------------------------------------------
+
+static unique_ptr<LocalTableFunctionState> PlinkClumpInitLocal(ExecutionContext &context,
+                                                               TableFunctionInitInput &input,
+                                                               GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<PlinkClumpBindData>();
+	auto &gstate = global_state->Cast<PlinkClumpGlobalState>();
+	auto state = make_uniq<PlinkClumpLocalState>();
+
+	if (bind_data.chrom_ranges.empty()) {
+		return std::move(state);
+	}
+
+	// --- Per-thread PgenReader on the query's shared index ---
+	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_clump");
+
+	// Set up sample subsetting
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		plink2::PgrSetSampleSubsetIndex(bind_data.sample_subset->CumulativePopcounts(), &state->pgr, &state->pssi);
+	} else {
+		plink2::PgrClearSampleSubsetIndex(&state->pgr, &state->pssi);
+	}
+
+	// Decode buffer, scratch genotypes and the candidate cache. A window reaches
+	// max_window_ct candidates on either side of its index variant.
+	uintptr_t genovec_word_ct = plink2::NypCtToAlignedWordCt(bind_data.effective_sample_ct);
+	uintptr_t genovec_bytes = genovec_word_ct * sizeof(uintptr_t);
+	state->genovec_buf.Allocate(genovec_bytes);
+	std::memset(state->genovec_buf.ptr, 0, genovec_bytes);
+	state->anchor_geno.Allocate(bind_data.effective_sample_ct, bind_data.ld_kernel);
+	state->partner_geno.Allocate(bind_data.effective_sample_ct, bind_data.ld_kernel);
+
+	uint32_t slot_ct = LdWindowCache::SlotCountForBudget(GetLdWindowCacheBytes(context.client),
+	                                                     bind_data.effective_sample_ct, bind_data.ld_kernel,
+	                                                     2 * bind_data.max_window_ct + 1);
+	state->window_cache.Init(slot_ct, bind_data.effective_sample_ct, bind_data.ld_kernel);
+
+	state->initialized = true;
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Clumping
+// ---------------------------------------------------------------------------
+
+//! Candidate `cand` in kernel form: from the cache when it is within SlotCount()
+//! positions of `anchor` on either side (so it cannot evict the anchor's slot),
+//! else decoded into `scratch`.
+static const LdVariantGenotypes &FetchCandidate(PlinkClumpLocalState &lstate, const PlinkClumpBindData &bind_data,
+                                                uint32_t cand, uint32_t anchor, LdVariantGenotypes &scratch) {
+	auto &cache = lstate.window_cache;
+	LdVariantGenotypes *out = &scratch;
+	uint32_t distance = cand > anchor ? cand - anchor : anchor - cand;
+	if (cache.Enabled() && distance < cache.SlotCount()) {
+		if (cache.Lookup(cand, out)) {
+			return *out;
+		}
+	}
+
+	uint32_t vidx = bind_data.candidates[cand].vidx;
+	const uintptr_t *sample_include = nullptr;
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		sample_include = bind_data.sample_subset->SampleInclude();
+	}
+	auto *genovec = lstate.genovec_buf.As<uintptr_t>();
+	plink2::PglErr err =
+	    plink2::PgrGet(sample_include, lstate.pssi, bind_data.effective_sample_ct, vidx, &lstate.pgr, genovec);
+	if (err != plink2::kPglRetSuccess) {
+		throw IOException("plink_clump: PgrGet failed for variant %u", vidx);
+	}
+	out->Assign(genovec);
+	return *out;
+}
+
+//! Clump the candidates [cand_start, cand_end) of one chromosome into lstate.clumps.
+static void ClumpChromosome(const PlinkClumpBindData &bind_data, PlinkClumpLocalState &lstate, uint32_t cand_start,
+                            uint32_t cand_end) {
+	auto &variants = bind_data.variants;
+	auto &candidates = bind_data.candidates;
+
+	// Index variants in ascending P (file order on ties)
+	vector<uint32_t> index_order;
+	for (uint32_t c = cand_start; c < cand_end; c++) {
+		if (candidates[c].p <= bind_data.p1) {
+			index_order.push_back(c);
+		}
+	}
+	std::stable_sort(index_order.begin(), index_order.end(),
+	                 [&](uint32_t a, uint32_t b) { return candidates[a].p < candidates[b].p; });
+
+	vector<bool> assigned(cand_end - cand_start, false);
+	lstate.clumps.clear();
+	lstate.clumps_emitted = 0;
+
+	for (auto index : index_order) {
+		if (assigned[index - cand_start]) {
+			continue; // already clumped under a stronger index variant
+		}
+		assigned[index - cand_start] = true;
+
+		ClumpRow row;
+		row.index = index;
+
+		// Window [lo, hi) of candidates within window_bp of the index variant
+		int64_t index_pos = variants.GetPos(candidates[index].vidx);
+		uint32_t lo = index;
+		while (lo > cand_start &&
+		       index_pos - static_cast<int64_t>(variants.GetPos(candidates[lo - 1].vidx)) <= bind_data.window_bp) {
+			lo--;
+		}
+		uint32_t hi = index + 1;
+		while (hi < cand_end &&
+		       static_cast<int64_t>(variants.GetPos(candidates[hi].vidx)) - index_pos <= bind_data.window_bp) {
+			hi++;
+		}
+
+		const LdVariantGenotypes *index_geno = nullptr;
+		for (uint32_t c = lo; c < hi; c++) {
+			if (assigned[c - cand_start]) {
+				continue;
+			}
+			if (!index_geno) {
+				index_geno = &FetchCandidate(lstate, bind_data, index, index, lstate.anchor_geno);
+			}
+			auto &geno = FetchCandidate(lstate, bind_data, c, index, lstate.partner_geno);
+			auto result = ComputeLdStats(*index_geno, geno);
+			if (result.is_valid && result.r2 >= bind_data.r2_threshold) {
+				assigned[c - cand_start] = true;
+				row.members.push_back(c);
+			}
+		}
+		lstate.clumps.push_back(std::move(row));
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Scan function
+// ---------------------------------------------------------------------------
+
+static void PlinkClumpScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<PlinkClumpBindData>();
+	auto &gstate = data_p.global_state->Cast<PlinkClumpGlobalState>();
+	auto &lstate = data_p.local_state->Cast<PlinkClumpLocalState>();
+
+	if (!lstate.initialized) {
+		CompatSetOutputCardinality(output, 0);
+		return;
+	}
+
+	auto &variants = bind_data.variants;
+	auto &candidates = bind_data.candidates;
+	auto &sp2_vec = output.data[COL_SP2];
+	idx_t rows_emitted = 0;
+
+	while (rows_emitted < STANDARD_VECTOR_SIZE) {
+		if (lstate.clumps_emitted >= lstate.clumps.size()) {
+			uint32_t chrom_idx = gstate.next_chrom.fetch_add(1);
+			if (chrom_idx >= bind_data.chrom_ranges.size()) {
+				break;
+			}
+			auto &range = bind_data.chrom_ranges[chrom_idx];
+			ClumpChromosome(bind_data, lstate, range.first, range.second);
+			continue;
+		}
+
+		auto &row = lstate.clumps[lstate.clumps_emitted++];
+		uint32_t vidx = candidates[row.index].vidx;
+
+		FlatVector::GetData<string_t>(output.data[COL_CHROM])[rows_emitted] =
+		    StringVector::AddString(output.data[COL_CHROM], variants.GetChrom(vidx));
+		FlatVector::GetData<int32_t>(output.data[COL_POS])[rows_emitted] = variants.GetPos(vidx);
+		auto &id = variants.GetId(vidx);
+		if (id.empty()) {
+			FlatVector::SetNull(output.data[COL_ID], rows_emitted, true);
+		} else {
+			FlatVector::GetData<string_t>(output.data[COL_ID])[rows_emitted] =
+			    StringVector::AddString(output.data[COL_ID], id);
+		}
+		FlatVector::GetData<double>(output.data[COL_P])[rows_emitted] = candidates[row.index].p;
+		FlatVector::GetData<int32_t>(output.data[COL_TOTAL])[rows_emitted] = static_cast<int32_t>(row.members.size());
+
+		auto list_offset = ListVector::GetListSize(sp2_vec);
+		ListVector::Reserve(sp2_vec, list_offset + row.members.size());
+		auto &child = ListVector::GetEntry(sp2_vec);
+		for (idx_t m = 0; m < row.members.size(); m++) {
+			auto &member_id = variants.GetId(candidates[row.members[m]].vidx);
+			if (member_id.empty()) {
+				FlatVector::SetNull(child, list_offset + m, true);
+			} else {
+				FlatVector::GetData<string_t>(child)[list_offset + m] = StringVector::AddString(child, member_id);
+			}
+		}
+		auto *list_data = FlatVector::GetData<list_entry_t>(sp2_vec);
+		list_data[rows_emitted].offset = list_offset;
+		list_data[rows_emitted].length = row.members.size();
+		ListVector::SetListSize(sp2_vec, list_offset + row.members.size());
+
+		rows_emitted++;
+	}
+
+	CompatSetOutputCardinality(output, rows_emitted);
+}
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+void RegisterPlinkClump(ExtensionLoader &loader) {
+	TableFunction plink_clump("plink_clump", {LogicalType::VARCHAR}, PlinkClumpScan, PlinkClumpBind,
+	                          PlinkClumpInitGlobal, PlinkClumpInitLocal);
+
+	plink_clump.named_parameters["results"] = LogicalType::ANY;
+	plink_clump.named_parameters["pvar"] = LogicalType::VARCHAR;
+	plink_clump.named_parameters["psam"] = LogicalType::VARCHAR;
+	plink_clump.named_parameters["p1"] = LogicalType::DOUBLE;
+	plink_clump.named_parameters["p2"] = LogicalType::DOUBLE;
+	plink_clump.named_parameters["r2_threshold"] = LogicalType::DOUBLE;
+	plink_clump.named_parameters["window_kb"] = LogicalType::INTEGER;
+	plink_clump.named_parameters["samples"] = LogicalType::ANY;
+	plink_clump.named_parameters["region"] = LogicalType::VARCHAR;
+
+	loader.RegisterFunction(plink_clump);
+}
+
+} // namespace duckdb
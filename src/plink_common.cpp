@@ -1,10 +1,12 @@
 #include "plink_common.hpp"
 #include "plink_profile.hpp"
+#include "plinking_pgen_vfs.hpp"
 
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/main/connection.hpp"
 #include "duckdb/main/database.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 #include <algorithm>
 
@@ -374,6 +376,106 @@ VariantMetadataIndex LoadVariantMetadataIndex(ClientContext &context, const stri
 	return idx;
 }
 
+// ---------------------------------------------------------------------------
+// Memory-limit-tracked buffers
+// ---------------------------------------------------------------------------
+
+void TrackedBuffer::Allocate(ClientContext &context, idx_t size) {
+	Reset();
+	auto &allocator = BufferManager::GetBufferManager(context).GetBufferAllocator();
+	data = allocator.Allocate(size + plink2::kCacheline);
+	auto addr = reinterpret_cast<uintptr_t>(data.get());
+	ptr = reinterpret_cast<void *>((addr + plink2::kCacheline - 1) & ~static_cast<uintptr_t>(plink2::kCacheline - 1));
+}
+
+// ---------------------------------------------------------------------------
+// Shared .pgen index
+// ---------------------------------------------------------------------------
+
+PgenIndex::PgenIndex() {
+	plink2::PreinitPgfi(&pgfi);
+}
+
+PgenIndex::~PgenIndex() {
+	plink2::PglErr reterr = plink2::kPglRetSuccess;
+	plink2::CleanupPgfi(&pgfi, &reterr);
+}
+
+shared_ptr<PgenIndex> LoadPgenIndex(const string &pgen_path, uint32_t raw_variant_ct, uint32_t raw_sample_ct,
+                                    const string &func_name) {
+	auto index = make_shared_ptr<PgenIndex>();
+
+	char errstr_buf[plink2::kPglErrstrBufBlen];
+	plink2::PgenHeaderCtrl header_ctrl;
+	uintptr_t pgfi_alloc_cacheline_ct = 0;
+
+	plink2::PglErr err = plink2::PgfiInitPhase1(pgen_path.c_str(), nullptr, raw_variant_ct, raw_sample_ct,
+	                                            &header_ctrl, &index->pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
+	if (err != plink2::kPglRetSuccess) {
+		throw IOException("%s: failed to open '%s' (phase 1): %s", func_name, pgen_path, errstr_buf);
+	}
+
+	if (pgfi_alloc_cacheline_ct > 0) {
+		index->pgfi_alloc_buf.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
+	}
+
+	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, index->pgfi.raw_variant_ct, &index->max_vrec_width,
+	                             &index->pgfi, index->pgfi_alloc_buf.As<unsigned char>(),
+	                             &index->pgr_alloc_cacheline_ct, errstr_buf);
+	if (err != plink2::kPglRetSuccess) {
+		throw IOException("%s: failed to load the index of '%s' (phase 2): %s", func_name, pgen_path, errstr_buf);
+	}
+
+	// Close the loading handle. With shared_ff set, PgrInit would move it into the
+	// first reader — a write to the shared struct racing the other threads' PgrInit.
+	plink2::CleanupPgfi(&index->pgfi, &err);
+	return index;
+}
+
+void InitPgenReader(const PgenIndex &index, const string &pgen_path, plink2::PgenReader &pgr,
+                    AlignedBuffer &pgr_alloc_buf, const string &func_name) {
+	plink2::PreinitPgr(&pgr);
+	if (index.pgr_alloc_cacheline_ct > 0) {
+		pgr_alloc_buf.Allocate(index.pgr_alloc_cacheline_ct * plink2::kCacheline);
+	} else {
+		pgr_alloc_buf.Reset();
+	}
+
+	// PgrInit only reads the PgenFileInfo once shared_ff is closed (see LoadPgenIndex)
+	auto &pgfi = const_cast<plink2::PgenFileInfo &>(index.pgfi);
+	plink2::PglErr err = plink2::PgrInit(pgen_path.c_str(), index.max_vrec_width, &pgfi, &pgr,
+	                                     pgr_alloc_buf.As<unsigned char>());
+	if (err != plink2::kPglRetSuccess) {
+		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
+		plink2::CleanupPgr(&pgr, &cleanup_err);
+		throw IOException("%s: PgrInit failed for '%s'", func_name, pgen_path);
+	}
+}
+
+void PrefetchPgenBatch(const PgenIndex &index, plink2::PgenReader &pgr, const vector<uint32_t> *effective,
+                       uint32_t start, uint32_t end) {
+	if (start >= end) {
+		return;
+	}
+	uint32_t vidx_start = start;
+	uint32_t vidx_end = end;
+	if (effective) {
+		vidx_start = (*effective)[start];
+		uint32_t vidx_last = (*effective)[end - 1];
+		if (vidx_last < vidx_start || vidx_last - vidx_start >= 2 * (end - start)) {
+			return;
+		}
+		vidx_end = vidx_last + 1;
+	}
+	vidx_end = std::min(vidx_end, index.pgfi.raw_variant_ct);
+	if (vidx_start >= vidx_end) {
+		return;
+	}
+	uint64_t fpos_start = plink2::GetPgfiFpos(&index.pgfi, vidx_start);
+	uint64_t fpos_end = plink2::GetPgfiFpos(&index.pgfi, vidx_end);
+	plinking_pgen_prefetch(plink2::GetPgrp(&pgr)->ff, fpos_start, fpos_end - fpos_start);
+}
+
 // ---------------------------------------------------------------------------
 // File utilities
 // ---------------------------------------------------------------------------
@@ -1597,16 +1699,16 @@ unordered_map<string, uint32_t> BuildVariantIdIndex(const VariantMetadataIndex &
 }
 
 //! Lookup by (chrom, pos[, ref, alt]) using chrom_offsets + binary search on POS.
-//! Returns the file-row vidx. Falls back to linear scan if chrom_offsets unavailable.
-static uint32_t ResolveByCpra(const VariantMetadataIndex &variants, const string &chrom, int32_t pos,
-                              const string *ref_match, const string *alt_match, const string &desc,
-                              const string &func_name) {
+//! Sets the file-row vidx and returns true on a match. Falls back to linear scan if
+//! chrom_offsets unavailable.
+static bool FindByCpra(const VariantMetadataIndex &variants, const string &chrom, int32_t pos, const string *ref_match,
+                       const string *alt_match, uint32_t &vidx) {
 	idx_t lo_local = 0;
 	idx_t hi_local = variants.chroms.size();
 	if (!variants.chrom_offsets.empty()) {
 		auto it = variants.chrom_offsets.find(chrom);
 		if (it == variants.chrom_offsets.end()) {
-			throw InvalidInputException("%s: variant '%s' not found", func_name, desc);
+			return false;
 		}
 		lo_local = it->second.first;
 		hi_local = it->second.second;
@@ -1629,18 +1731,30 @@ static uint32_t ResolveByCpra(const VariantMetadataIndex &variants, const string
 		}
 		if (ref_match && alt_match) {
 			if (variants.refs[i] == *ref_match && variants.alts[i] == *alt_match) {
-				return variants.VidxForLocal(i);
+				vidx = variants.VidxForLocal(i);
+				return true;
 			}
 		} else {
-			return variants.VidxForLocal(i);
+			vidx = variants.VidxForLocal(i);
+			return true;
 		}
 	}
+	return false;
+}
 
-	throw InvalidInputException("%s: variant '%s' not found", func_name, desc);
+//! FindByCpra, throwing "variant not found" on a miss.
+static uint32_t ResolveByCpra(const VariantMetadataIndex &variants, const string &chrom, int32_t pos,
+                              const string *ref_match, const string *alt_match, const string &desc,
+                              const string &func_name) {
+	uint32_t vidx = 0;
+	if (!FindByCpra(variants, chrom, pos, ref_match, alt_match, vidx)) {
+		throw InvalidInputException("%s: variant '%s' not found", func_name, desc);
+	}
+	return vidx;
 }
 
-//! Resolve a single CPRA string (chrom:pos or chrom:pos:ref:alt) to a variant index.
-static uint32_t ResolveCpraString(const string &cpra, const VariantMetadataIndex &variants, const string &func_name) {
+//! Split a CPRA string on ':'.
+static vector<string> SplitCpra(const string &cpra) {
 	vector<string> parts;
 	size_t start = 0;
 	for (size_t i = 0; i <= cpra.size(); i++) {
@@ -1649,6 +1763,12 @@ static uint32_t ResolveCpraString(const string &cpra, const VariantMetadataIndex
 			start = i + 1;
 		}
 	}
+	return parts;
+}
+
+//! Resolve a single CPRA string (chrom:pos or chrom:pos:ref:alt) to a variant index.
+static uint32_t ResolveCpraString(const string &cpra, const VariantMetadataIndex &variants, const string &func_name) {
+	auto parts = SplitCpra(cpra);
 
 	if (parts.size() != 2 && parts.size() != 4) {
 		throw InvalidInputException("%s: invalid CPRA format '%s' (expected CHROM:POS or CHROM:POS:REF:ALT)", func_name,
@@ -1683,6 +1803,32 @@ static uint32_t ResolveVariantString(const string &id, const VariantMetadataInde
 	return it->second;
 }
 
+bool TryResolveVariantString(const string &id, const VariantMetadataIndex &variants,
+                             const unordered_map<string, uint32_t> &id_to_idx, uint32_t &vidx) {
+	auto it = id_to_idx.find(id);
+	if (it != id_to_idx.end()) {
+		vidx = it->second;
+		return true;
+	}
+	if (id.find(':') == string::npos) {
+		return false;
+	}
+
+	auto parts = SplitCpra(id);
+	if (parts.size() != 2 && parts.size() != 4) {
+		return false;
+	}
+	char *end_ptr;
+	errno = 0;
+	long pos = std::strtol(parts[1].c_str(), &end_ptr, 10);
+	if (parts[1].empty() || *end_ptr != '\0' || errno != 0) {
+		return false;
+	}
+	bool match_alleles = (parts.size() == 4);
+	return FindByCpra(variants, parts[0], static_cast<int32_t>(pos), match_alleles ? &parts[2] : nullptr,
+	                  match_alleles ? &parts[3] : nullptr, vidx);
+}
+
 //! Resolve a CPRA struct ({chrom, pos} or {chrom, pos, ref, alt}) to a variant index.
 static uint32_t ResolveCpraStruct(const Value &val, const VariantMetadataIndex &variants, const string &func_name) {
 	auto &child_types = StructType::GetChildTypes(val.type());
@@ -1890,6 +2036,17 @@ idx_t ApplyMaxThreadsCap(idx_t computed, uint32_t config_max_threads) {
 	return MinValue<idx_t>(computed, 16);
 }
 
+// ---------------------------------------------------------------------------
+// Parallel merge of per-thread accumulators
+// ---------------------------------------------------------------------------
+
+void StripedReduction::Init(idx_t element_ct_p, idx_t stripe_elements_p) {
+	element_ct = element_ct_p;
+	stripe_elements = MaxValue<idx_t>(stripe_elements_p, 1);
+	stripe_ct = (element_ct + stripe_elements - 1) / stripe_elements;
+	stripe_locks = unique_ptr<std::mutex[]>(new std::mutex[MaxValue<idx_t>(stripe_ct, 1)]);
+}
+
 // ---------------------------------------------------------------------------
 // Ploidy- and sex-aware statistics (chrX/Y/MT)
 // ---------------------------------------------------------------------------
@@ -37,6 +37,7 @@ struct PlinkFreqBindData : public TableFunctionData {
 	string pgen_path;
 	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
 	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
 	string pvar_path;
 	string psam_path;
 
@@ -81,6 +82,9 @@ struct PlinkFreqGlobalState : public GlobalTableFunctionState {
 	bool need_frequencies = false; // true if any freq/count column is projected
 	uint32_t max_threads_config = 0;
 
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
 	idx_t MaxThreads() const override {
 		uint32_t range = end_variant_idx - start_variant_idx;
 		return ApplyMaxThreadsCap(range / 500 + 1, max_threads_config);
@@ -92,8 +96,7 @@ struct PlinkFreqGlobalState : public GlobalTableFunctionState {
 // ---------------------------------------------------------------------------
 
 struct PlinkFreqLocalState : public LocalTableFunctionState {
-	plink2::PgenFileInfo pgfi;
-	AlignedBuffer pgfi_alloc_buf;
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
 
 	plink2::PgenReader pgr;
 	AlignedBuffer pgr_alloc_buf;
@@ -110,7 +113,6 @@ struct PlinkFreqLocalState : public LocalTableFunctionState {
 		if (initialized) {
 			plink2::PglErr reterr = plink2::kPglRetSuccess;
 			plink2::CleanupPgr(&pgr, &reterr);
-			plink2::CleanupPgfi(&pgfi, &reterr);
 		}
 	}
 };
@@ -160,52 +162,18 @@ static unique_ptr<FunctionData> PlinkFreqBind(ClientContext &context, TableFunct
 		// .psam is optional for plink_freq — frequency computation only needs sample count
 	}
 
-	// --- Initialize pgenlib (Phase 1) to get counts ---
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
 	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
 	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
 	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
 
-	plink2::PgenFileInfo pgfi;
-	plink2::PreinitPgfi(&pgfi);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err = plink2::PgfiInitPhase1(bind_data->pgen_path.c_str(), nullptr, UINT32_MAX, UINT32_MAX,
-	                                            &header_ctrl, &pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("plink_freq: failed to open '%s': %s", bind_data->pgen_path, errstr_buf);
-	}
-
-	bind_data->raw_variant_ct = pgfi.raw_variant_ct;
-	bind_data->raw_sample_ct = pgfi.raw_sample_ct;
-
-	// Phase 2 (needed to validate the file, but per-thread readers will re-init)
-	AlignedBuffer pgfi_alloc;
-	if (pgfi_alloc_cacheline_ct > 0) {
-		pgfi_alloc.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, pgfi.raw_variant_ct, &max_vrec_width, &pgfi,
-	                             pgfi_alloc.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_freq");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
 
-	// Check gflags after Phase 2 — variable-width pgen files only set
+	// gflags is final only after Phase 2 — variable-width pgen files only set
 	// kfPgenGlobalDosagePresent during Phase 2's vrtype scan
-	bind_data->file_has_dosage = (pgfi.gflags & plink2::kfPgenGlobalDosagePresent) != 0;
-
-	plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-	plink2::CleanupPgfi(&pgfi, &cleanup_err);
-
-	if (err != plink2::kPglRetSuccess) {
-		throw IOException("plink_freq: failed to initialize '%s' (phase 2): %s", bind_data->pgen_path, errstr_buf);
-	}
+	bind_data->file_has_dosage = (bind_data->pgen_index->pgfi.gflags & plink2::kfPgenGlobalDosagePresent) != 0;
 
 	// --- Load variant metadata ---
 	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_freq");
@@ -322,6 +290,10 @@ static unique_ptr<GlobalTableFunctionState> PlinkFreqInitGlobal(ClientContext &c
 		}
 	}
 
+	if (state->need_frequencies) {
+		state->pgen_index = bind_data.pgen_index;
+	}
+
 	return std::move(state);
 }
 
@@ -339,55 +311,10 @@ static unique_ptr<LocalTableFunctionState> PlinkFreqInitLocal(ExecutionContext &
 		return std::move(state);
 	}
 
-	// --- Initialize per-thread PgenFileInfo + PgenReader ---
+	// --- Per-thread PgenReader on the query's shared index ---
 	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
-	plink2::PreinitPgfi(&state->pgfi);
-	plink2::PreinitPgr(&state->pgr);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err =
-	    plink2::PgfiInitPhase1(bind_data.pgen_path.c_str(), nullptr, bind_data.raw_variant_ct, bind_data.raw_sample_ct,
-	                           &header_ctrl, &state->pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_freq: thread init failed (phase 1): %s", errstr_buf);
-	}
-
-	if (pgfi_alloc_cacheline_ct > 0) {
-		state->pgfi_alloc_buf.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, state->pgfi.raw_variant_ct, &max_vrec_width, &state->pgfi,
-	                             state->pgfi_alloc_buf.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_freq: thread init failed (phase 2): %s", errstr_buf);
-	}
-
-	if (pgr_alloc_cacheline_ct > 0) {
-		state->pgr_alloc_buf.Allocate(pgr_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	err = plink2::PgrInit(bind_data.pgen_path.c_str(), max_vrec_width, &state->pgfi, &state->pgr,
-	                      state->pgr_alloc_buf.As<unsigned char>());
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgr(&state->pgr, &cleanup_err);
-		cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_freq: PgrInit failed for '%s'", bind_data.pgen_path);
-	}
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_freq");
 
 	// Set up sample subsetting
 	if (bind_data.has_sample_subset && bind_data.sample_subset) {
@@ -439,6 +366,10 @@ static void PlinkFreqScan(ClientContext &context, TableFunctionInput &data_p, Da
 			break;
 		}
 		uint32_t batch_end = std::min(batch_start + claim_size, end_idx);
+		if (gstate.need_frequencies && lstate.initialized) {
+			PrefetchPgenBatch(*lstate.pgen_index, lstate.pgr, nullptr, batch_end,
+			                  std::min(batch_end + claim_size, end_idx));
+		}
 
 		for (uint32_t vidx = batch_start; vidx < batch_end; vidx++) {
 			// Classify ploidy from the chromosome (and X position vs PAR). Autosomes
@@ -1,12 +1,15 @@
 #include "plink_glm.hpp"
 #include "duckdb_compat.hpp"
 #include "plink_common.hpp"
+#include "plink_glm_linear.hpp"
+#include "plink_glm_score.hpp"
 #include "pgen_vfs_opener.hpp"
 #include "psam_reader.hpp"
 #include "plink2_glm_logistic_math.hpp"
 
 #include "plink2_stats.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <cstring>
@@ -114,6 +117,13 @@ static constexpr idx_t COL_P = 12;
 static constexpr idx_t COL_ERRCODE = 13;
 static constexpr idx_t COL_OR = 14;
 static constexpr idx_t COL_FIRTH_YN = 15;
+static constexpr idx_t COL_PHENO = 16; // multi-phenotype runs only
+
+//! Variants claimed and decoded together; each thread fits the whole block before emitting.
+static constexpr uint32_t GLM_BATCH_SIZE = 64;
+
+//! Upper bound on a thread's decoded dosage block (block variants × samples), in doubles.
+static constexpr idx_t GLM_BLOCK_DOSAGE_DOUBLES = idx_t(1) << 22;
 
 // ---------------------------------------------------------------------------
 // P-value / distribution layer — wrappers over plink2's own routines
@@ -170,10 +180,39 @@ using plink2::RoundUpPow2;
 // Bind data
 // ---------------------------------------------------------------------------
 
+struct GlmPhenotype {
+	string name;
+	vector<double> values; // aligned with effective samples (NaN = missing); released once projected
+	bool is_logistic = false;
+	bool projected = false; // fitted by a GlmProjectionGroup
+	vector<float> values_f32; // precision := 'float', linear without covariates: centered values
+
+	// Logistic with score_prefilter: covariate-only model the score test runs against
+	bool has_null_model = false;
+	LogisticNullModel null_model;
+};
+
+//! Linear phenotypes missing on the same samples, fitted together by the
+//! covariate-projected engine: phenotypes[c] is trait column c of `projection`.
+struct GlmProjectionGroup {
+	CovariateProjection projection;
+	vector<idx_t> phenotypes;
+};
+
+static bool SameMissingSamples(const vector<double> &a, const vector<double> &b) {
+	for (idx_t i = 0; i < a.size(); i++) {
+		if (std::isnan(a[i]) != std::isnan(b[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
 struct PlinkGlmBindData : public TableFunctionData {
 	string pgen_path;
 	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
 	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
 	string pvar_path;
 	string psam_path;
 
@@ -190,20 +229,44 @@ struct PlinkGlmBindData : public TableFunctionData {
 	// Region filtering
 	VariantRange variant_range;
 
-	// Phenotype values aligned with effective samples (NaN = missing)
-	vector<double> phenotype;
+	// Explicit variant list (variants := ...), sorted and already intersected with region
+	bool has_variant_list = false;
+	vector<uint32_t> variant_indices;
+
+	// Phenotypes to test. A LIST(VARCHAR) or STRUCT phenotype gives several traits,
+	// decoded once per variant, and adds the PHENO output column.
+	vector<GlmPhenotype> phenotypes;
+	bool multi_phenotype = false;
 
 	// Covariates: covariate_values[covar_idx][sample_idx] for effective samples
 	vector<string> covariate_names;
 	vector<vector<double>> covariate_values;
 
-	// Model
-	bool is_logistic = false;
+	// Model (is_logistic is per phenotype)
+	bool any_logistic = false;
 	bool use_firth = true;
 	uint32_t predictor_ct = 0; // intercept + genotype + covariates
 
+	// Linear phenotypes with covariates, or several phenotypes: covariates factored
+	// once per missingness pattern (plinking_glm_linear_engine)
+	vector<GlmProjectionGroup> projection_groups;
+
+	// Sparse (difflist) reads of rare variants (plinking_glm_sparse). Hardcall-only
+	// files with every phenotype projected: carriers feed the projected engine directly.
+	bool use_sparse = false;
+	uint32_t max_difflist_len = 0;
+
+	// precision := 'float': linear fits take single-precision SIMD kernels
+	bool single_precision = false;
+
+	// Variants per claimed block
+	uint32_t block_variant_ct = GLM_BATCH_SIZE;
+
 	// P-value threshold filter (NaN = no filter)
 	double p_threshold = std::numeric_limits<double>::quiet_NaN();
+
+	// Logistic score-test prefilter: full fit only where the score p < cutoff (NaN = off)
+	double score_prefilter = std::numeric_limits<double>::quiet_NaN();
 };
 
 // ---------------------------------------------------------------------------
@@ -211,6 +274,7 @@ struct PlinkGlmBindData : public TableFunctionData {
 // ---------------------------------------------------------------------------
 
 struct PlinkGlmGlobalState : public GlobalTableFunctionState {
+	// Scan cursor: a vidx, or a position in bind_data.variant_indices when has_variant_list
 	std::atomic<uint32_t> next_variant_idx {0};
 	uint32_t start_variant_idx = 0;
 	uint32_t end_variant_idx = 0;
@@ -218,12 +282,40 @@ struct PlinkGlmGlobalState : public GlobalTableFunctionState {
 	bool need_regression = false;
 	uint32_t max_threads_config = 0;
 
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
 	idx_t MaxThreads() const override {
 		uint32_t range = end_variant_idx - start_variant_idx;
 		return ApplyMaxThreadsCap(range / 500 + 1, max_threads_config);
 	}
 };
 
+// ---------------------------------------------------------------------------
+// Per-variant regression results
+// ---------------------------------------------------------------------------
+
+struct GlmResult {
+	double beta = NAN;
+	double se = NAN;
+	double t_stat = NAN;
+	double p_value = NAN;
+	double a1_freq = NAN;
+	double odds_ratio = NAN;
+	uint32_t obs_ct = 0;
+	const char *errcode = nullptr;
+	bool firth_applied = false;
+	bool is_logistic = false;
+	bool score_test = false; // score_prefilter result, no full fit (TEST = 'SCORE')
+};
+
+//! One output row: a variant × phenotype result, buffered until the scan emits it.
+struct GlmPendingRow {
+	uint32_t vidx = 0;
+	uint32_t pheno_idx = 0;
+	GlmResult result;
+};
+
 // ---------------------------------------------------------------------------
 // Local state (per-thread)
 // ---------------------------------------------------------------------------
@@ -259,6 +351,9 @@ struct LogisticBuffers {
 	// Non-missing sample indices scratch
 	vector<uint32_t> nm_indices;
 
+	// Score-test prefilter scratch: 2 * predictor_ct
+	vector<double> score_scratch;
+
 	bool allocated = false;
 
 	void Allocate(uint32_t max_sample_ct, uint32_t predictor_ct, bool use_firth) {
@@ -291,6 +386,7 @@ struct LogisticBuffers {
 		}
 
 		nm_indices.resize(max_sample_ct);
+		score_scratch.resize(2 * p);
 
 		allocated = true;
 	}
@@ -313,8 +409,7 @@ struct LogisticBuffers {
 };
 
 struct PlinkGlmLocalState : public LocalTableFunctionState {
-	plink2::PgenFileInfo pgfi;
-	AlignedBuffer pgfi_alloc_buf;
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
 
 	plink2::PgenReader pgr;
 	AlignedBuffer pgr_alloc_buf;
@@ -325,18 +420,36 @@ struct PlinkGlmLocalState : public LocalTableFunctionState {
 	AlignedBuffer genovec_buf;
 	AlignedBuffer dosage_present_buf;
 	AlignedBuffer dosage_main_buf;
-	vector<double> dosage_doubles;
+	vector<double> dosage_doubles; // block_variant_ct rows of effective_sample_ct
+	vector<float> dosage_floats;   // same rows in single precision (precision := 'float')
+
+	// Sparse path: difflist read buffers (sample_ids needs one extra slot, pgenlib
+	// appends sample_ct), and the block's difflist variants as (sample, dosage) runs
+	AlignedBuffer raregeno_buf;
+	vector<uint32_t> difflist_sample_ids;
+	vector<bool> variant_sparse;        // per block variant
+	vector<uint32_t> sparse_sample_ids; // concatenated over the block's sparse variants
+	vector<double> sparse_dosages;
+	vector<idx_t> sparse_end; // per block variant: end offset into sparse_sample_ids
 
 	// Pre-allocated logistic regression scratch buffers
 	LogisticBuffers logistic_bufs;
 
+	// Covariate-projected linear engine: per projection group, block scratch +
+	// missingness-pattern cache; results of the group's traits for one block
+	vector<LinearProjectionWorkspace> linear_ws;
+	vector<LinearAssocResult> linear_results;
+
+	// Rows of the current block not yet emitted
+	vector<GlmPendingRow> pending;
+	idx_t pending_pos = 0;
+
 	bool initialized = false;
 
 	~PlinkGlmLocalState() {
 		if (initialized) {
 			plink2::PglErr reterr = plink2::kPglRetSuccess;
 			plink2::CleanupPgr(&pgr, &reterr);
-			plink2::CleanupPgfi(&pgfi, &reterr);
 		}
 	}
 };
@@ -370,6 +483,18 @@ static unique_ptr<FunctionData> PlinkGlmBind(ClientContext &context, TableFuncti
 				throw InvalidInputException("plink_glm: p_threshold must be in (0, 1], got %g", pt);
 			}
 			bind_data->p_threshold = pt;
+		} else if (kv.first == "score_prefilter") {
+			double cutoff = kv.second.GetValue<double>();
+			if (cutoff <= 0.0 || cutoff > 1.0) {
+				throw InvalidInputException("plink_glm: score_prefilter must be in (0, 1], got %g", cutoff);
+			}
+			bind_data->score_prefilter = cutoff;
+		} else if (kv.first == "precision") {
+			string precision = StringUtil::Lower(kv.second.GetValue<string>());
+			if (precision != "double" && precision != "float") {
+				throw InvalidInputException("plink_glm: precision must be 'double' or 'float', got '%s'", precision);
+			}
+			bind_data->single_precision = precision == "float";
 		}
 	}
 
@@ -419,48 +544,18 @@ static unique_ptr<FunctionData> PlinkGlmBind(ClientContext &context, TableFuncti
 		}
 	}
 
-	// --- Initialize pgenlib (Phase 1) to get counts ---
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
 	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
 	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
 	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
 
-	plink2::PgenFileInfo pgfi;
-	plink2::PreinitPgfi(&pgfi);
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_glm");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
 
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err = plink2::PgfiInitPhase1(bind_data->pgen_path.c_str(), nullptr, UINT32_MAX, UINT32_MAX,
-	                                            &header_ctrl, &pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("plink_glm: failed to open '%s': %s", bind_data->pgen_path, errstr_buf);
-	}
-
-	bind_data->raw_variant_ct = pgfi.raw_variant_ct;
-	bind_data->raw_sample_ct = pgfi.raw_sample_ct;
-
-	// Phase 2
-	AlignedBuffer pgfi_alloc;
-	if (pgfi_alloc_cacheline_ct > 0) {
-		pgfi_alloc.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, pgfi.raw_variant_ct, &max_vrec_width, &pgfi,
-	                             pgfi_alloc.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-	plink2::CleanupPgfi(&pgfi, &cleanup_err);
-
-	if (err != plink2::kPglRetSuccess) {
-		throw IOException("plink_glm: failed to initialize '%s' (phase 2): %s", bind_data->pgen_path, errstr_buf);
-	}
+	// gflags is final only after Phase 2 — variable-width pgen files only set
+	// kfPgenGlobalDosagePresent during Phase 2's vrtype scan
+	bool file_has_dosage = (bind_data->pgen_index->pgfi.gflags & plink2::kfPgenGlobalDosagePresent) != 0;
 
 	// --- Load variant metadata ---
 	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_glm");
@@ -493,6 +588,22 @@ static unique_ptr<FunctionData> PlinkGlmBind(ClientContext &context, TableFuncti
 		bind_data->variant_range = ParseRegion(region_it->second.GetValue<string>(), bind_data->variants, "plink_glm");
 	}
 
+	// --- Process variants parameter (intersected with region) ---
+	auto variants_it = input.named_parameters.find("variants");
+	if (variants_it != input.named_parameters.end()) {
+		auto indices =
+		    ResolveVariantsParameter(variants_it->second, bind_data->variants, bind_data->raw_variant_ct, "plink_glm");
+		for (auto vidx : indices) {
+			if (!bind_data->variant_range.has_filter ||
+			    (vidx >= bind_data->variant_range.start_idx && vidx < bind_data->variant_range.end_idx)) {
+				bind_data->variant_indices.push_back(vidx);
+			}
+		}
+		// Lists arrive in any order (e.g. list(ID) over plink_prune); read in pgen order
+		std::sort(bind_data->variant_indices.begin(), bind_data->variant_indices.end());
+		bind_data->has_variant_list = true;
+	}
+
 	// --- Process phenotype parameter ---
 	auto pheno_it = input.named_parameters.find("phenotype");
 	if (pheno_it == input.named_parameters.end()) {
@@ -514,90 +625,121 @@ static unique_ptr<FunctionData> PlinkGlmBind(ClientContext &context, TableFuncti
 		}
 	};
 
-	// Type dispatch: VARCHAR → psam column name, LIST → direct values
-	if (pheno_val.type().id() == LogicalTypeId::VARCHAR) {
-		// --- Phenotype from psam column ---
+	// Restrict per-sample values in .pgen order to the effective samples
+	auto ApplySampleSubset = [&](vector<double> raw_values) {
+		if (!bind_data->has_sample_subset) {
+			return raw_values;
+		}
+		vector<double> values(bind_data->effective_sample_ct);
+		const uintptr_t *sample_include = bind_data->sample_subset->SampleInclude();
+		uint32_t out_idx = 0;
+		for (uint32_t raw_idx = 0; raw_idx < bind_data->raw_sample_ct; raw_idx++) {
+			if (plink2::IsSet(sample_include, raw_idx)) {
+				values[out_idx] = raw_values[raw_idx];
+				out_idx++;
+			}
+		}
+		return values;
+	};
+
+	// --- Phenotype from psam column ---
+	auto AddPsamPhenotype = [&](const string &pheno_col) {
 		if (bind_data->psam_path.empty()) {
 			throw InvalidInputException("plink_glm: phenotype as column name requires a .psam/.fam file");
 		}
 		EnsurePsamLoaded();
-		string pheno_col = pheno_val.GetValue<string>();
 		auto raw_values = LoadPsamColumnAsDouble(psam_lines, psam_header, bind_data->psam_path, pheno_col);
 		if (static_cast<uint32_t>(raw_values.size()) != bind_data->raw_sample_ct) {
 			throw InvalidInputException("plink_glm: psam has %llu samples but .pgen has %u",
 			                            static_cast<unsigned long long>(raw_values.size()), bind_data->raw_sample_ct);
 		}
+		GlmPhenotype pheno;
+		pheno.name = pheno_col;
+		pheno.values = ApplySampleSubset(std::move(raw_values));
+		bind_data->phenotypes.push_back(std::move(pheno));
+	};
 
-		bind_data->phenotype.resize(bind_data->effective_sample_ct);
-		if (bind_data->has_sample_subset) {
-			const uintptr_t *sample_include = bind_data->sample_subset->SampleInclude();
-			uint32_t out_idx = 0;
-			for (uint32_t raw_idx = 0; raw_idx < bind_data->raw_sample_ct; raw_idx++) {
-				if (plink2::IsSet(sample_include, raw_idx)) {
-					bind_data->phenotype[out_idx] = raw_values[raw_idx];
-					out_idx++;
-				}
-			}
-		} else {
-			bind_data->phenotype = std::move(raw_values);
-		}
-	} else if (pheno_val.type().id() == LogicalTypeId::LIST) {
-		// --- Phenotype from direct LIST(DOUBLE) ---
-		auto &pheno_children = ListValue::GetChildren(pheno_val);
-
+	// --- Phenotype from direct LIST(DOUBLE) ---
+	auto AddListPhenotype = [&](const Value &list_val, const string &name) {
+		auto &pheno_children = ListValue::GetChildren(list_val);
 		if (static_cast<uint32_t>(pheno_children.size()) != bind_data->raw_sample_ct) {
-			throw InvalidInputException("plink_glm: phenotype length (%llu) must match sample count (%u)",
+			if (!bind_data->multi_phenotype) {
+				throw InvalidInputException("plink_glm: phenotype length (%llu) must match sample count (%u)",
+				                            static_cast<unsigned long long>(pheno_children.size()),
+				                            bind_data->raw_sample_ct);
+			}
+			throw InvalidInputException("plink_glm: phenotype '%s' length (%llu) must match sample count (%u)", name,
 			                            static_cast<unsigned long long>(pheno_children.size()),
 			                            bind_data->raw_sample_ct);
 		}
+		vector<double> raw_values(bind_data->raw_sample_ct);
+		for (uint32_t i = 0; i < bind_data->raw_sample_ct; i++) {
+			raw_values[i] = pheno_children[i].IsNull() ? NAN : pheno_children[i].GetValue<double>();
+		}
+		GlmPhenotype pheno;
+		pheno.name = name;
+		pheno.values = ApplySampleSubset(std::move(raw_values));
+		bind_data->phenotypes.push_back(std::move(pheno));
+	};
 
-		bind_data->phenotype.resize(bind_data->effective_sample_ct);
-		if (bind_data->has_sample_subset) {
-			const uintptr_t *sample_include = bind_data->sample_subset->SampleInclude();
-			uint32_t out_idx = 0;
-			for (uint32_t raw_idx = 0; raw_idx < bind_data->raw_sample_ct; raw_idx++) {
-				if (plink2::IsSet(sample_include, raw_idx)) {
-					if (pheno_children[raw_idx].IsNull()) {
-						bind_data->phenotype[out_idx] = NAN;
-					} else {
-						bind_data->phenotype[out_idx] = pheno_children[raw_idx].GetValue<double>();
-					}
-					out_idx++;
-				}
-			}
-		} else {
-			for (uint32_t i = 0; i < bind_data->raw_sample_ct; i++) {
-				if (pheno_children[i].IsNull()) {
-					bind_data->phenotype[i] = NAN;
-				} else {
-					bind_data->phenotype[i] = pheno_children[i].GetValue<double>();
-				}
+	// Type dispatch: VARCHAR → psam column name, LIST(DOUBLE) → direct values,
+	// LIST(VARCHAR) → several psam columns, STRUCT of LIST(DOUBLE) → several named traits
+	auto &pheno_type = pheno_val.type();
+	if (pheno_type.id() == LogicalTypeId::VARCHAR) {
+		AddPsamPhenotype(pheno_val.GetValue<string>());
+	} else if (pheno_type.id() == LogicalTypeId::LIST &&
+	           ListType::GetChildType(pheno_type).id() == LogicalTypeId::VARCHAR) {
+		bind_data->multi_phenotype = true;
+		for (auto &col : ListValue::GetChildren(pheno_val)) {
+			AddPsamPhenotype(col.GetValue<string>());
+		}
+	} else if (pheno_type.id() == LogicalTypeId::LIST) {
+		AddListPhenotype(pheno_val, "PHENO1");
+	} else if (pheno_type.id() == LogicalTypeId::STRUCT) {
+		bind_data->multi_phenotype = true;
+		auto &struct_children = StructType::GetChildTypes(pheno_type);
+		auto &struct_vals = StructValue::GetChildren(pheno_val);
+		for (idx_t pi = 0; pi < struct_children.size(); pi++) {
+			auto &name = struct_children[pi].first;
+			if (struct_vals[pi].type().id() != LogicalTypeId::LIST) {
+				throw InvalidInputException("plink_glm: phenotype '%s' must be a LIST, got %s", name,
+				                            struct_vals[pi].type().ToString());
 			}
+			AddListPhenotype(struct_vals[pi], name);
 		}
 	} else {
-		throw InvalidInputException("plink_glm: phenotype must be a LIST(DOUBLE) or a VARCHAR column name");
+		throw InvalidInputException("plink_glm: phenotype must be a LIST(DOUBLE) or a VARCHAR column name "
+		                            "(or, for several phenotypes, a LIST(VARCHAR) of column names or a STRUCT "
+		                            "of named LIST(DOUBLE))");
+	}
+	if (bind_data->phenotypes.empty()) {
+		throw InvalidInputException("plink_glm: phenotype list is empty");
 	}
 
-	// Validate phenotype
-	uint32_t non_missing_ct = 0;
-	double min_val = std::numeric_limits<double>::infinity();
-	double max_val = -std::numeric_limits<double>::infinity();
+	// Validate phenotypes
+	for (auto &pheno : bind_data->phenotypes) {
+		uint32_t non_missing_ct = 0;
+		double min_val = std::numeric_limits<double>::infinity();
+		double max_val = -std::numeric_limits<double>::infinity();
 
-	for (uint32_t i = 0; i < bind_data->effective_sample_ct; i++) {
-		double v = bind_data->phenotype[i];
-		if (!std::isnan(v)) {
-			min_val = std::min(min_val, v);
-			max_val = std::max(max_val, v);
-			non_missing_ct++;
+		for (uint32_t i = 0; i < bind_data->effective_sample_ct; i++) {
+			double v = pheno.values[i];
+			if (!std::isnan(v)) {
+				min_val = std::min(min_val, v);
+				max_val = std::max(max_val, v);
+				non_missing_ct++;
+			}
 		}
-	}
 
-	if (non_missing_ct < 3) {
-		throw InvalidInputException("plink_glm: need at least 3 non-missing phenotype values, got %u", non_missing_ct);
-	}
+		string which = bind_data->multi_phenotype ? StringUtil::Format(" (phenotype '%s')", pheno.name) : "";
+		if (non_missing_ct < 3) {
+			throw InvalidInputException("plink_glm: need at least 3 non-missing phenotype values, got %u%s",
+			                            non_missing_ct, which);
+		}
 
-	if (min_val == max_val) {
-		throw InvalidInputException("plink_glm: constant phenotype (all values are %g)", min_val);
+		if (min_val == max_val) {
+			throw InvalidInputException("plink_glm: constant phenotype (all values are %g)%s", min_val, which);
+		}
 	}
 
 	// --- Process covariates parameter ---
@@ -705,44 +847,155 @@ static unique_ptr<FunctionData> PlinkGlmBind(ClientContext &context, TableFuncti
 		}
 	}
 
-	// --- Model detection ---
-	if (model_str == "linear") {
-		bind_data->is_logistic = false;
-	} else if (model_str == "logistic") {
-		bind_data->is_logistic = true;
-	} else if (model_str == "auto") {
-		// Auto-detect: binary if all non-missing values are 0/1 or 1/2
-		bool all_binary_01 = true;
-		bool all_binary_12 = true;
-		for (uint32_t i = 0; i < bind_data->effective_sample_ct; i++) {
-			double v = bind_data->phenotype[i];
-			if (std::isnan(v)) {
+	// --- Model detection (per phenotype) ---
+	if (model_str != "auto" && model_str != "linear" && model_str != "logistic") {
+		throw InvalidInputException("plink_glm: model must be 'auto', 'linear', or 'logistic', got '%s'", model_str);
+	}
+	for (auto &pheno : bind_data->phenotypes) {
+		if (model_str == "linear") {
+			pheno.is_logistic = false;
+		} else if (model_str == "logistic") {
+			pheno.is_logistic = true;
+		} else {
+			// Auto-detect: binary if all non-missing values are 0/1 or 1/2
+			bool all_binary_01 = true;
+			bool all_binary_12 = true;
+			for (uint32_t i = 0; i < bind_data->effective_sample_ct; i++) {
+				double v = pheno.values[i];
+				if (std::isnan(v)) {
+					continue;
+				}
+				if (v != 0.0 && v != 1.0) {
+					all_binary_01 = false;
+				}
+				if (v != 1.0 && v != 2.0) {
+					all_binary_12 = false;
+				}
+			}
+
+			if (all_binary_01) {
+				pheno.is_logistic = true;
+			} else if (all_binary_12) {
+				// Recode 1/2 → 0/1
+				pheno.is_logistic = true;
+				for (uint32_t i = 0; i < bind_data->effective_sample_ct; i++) {
+					if (!std::isnan(pheno.values[i])) {
+						pheno.values[i] -= 1.0;
+					}
+				}
+			}
+		}
+		bind_data->any_logistic = bind_data->any_logistic || pheno.is_logistic;
+	}
+
+	bind_data->predictor_ct = static_cast<uint32_t>(2 + bind_data->covariate_values.size());
+
+	// --- Logistic phenotypes with score_prefilter: fit the null model once ---
+	// If it does not converge, every variant of that phenotype gets the full fit.
+	if (!std::isnan(bind_data->score_prefilter)) {
+		for (auto &pheno : bind_data->phenotypes) {
+			if (pheno.is_logistic) {
+				pheno.has_null_model = pheno.null_model.Fit(pheno.values, bind_data->covariate_values);
+			}
+		}
+	}
+
+	// --- Linear phenotypes: factor the covariates once for all variants ---
+	// Phenotypes missing on the same samples share one projection, so their x'y
+	// terms come out of a single variant block × trait product. The sparse path
+	// needs the projected engine even for a single covariate-free phenotype.
+	Value sparse_val;
+	bool want_sparse = context.TryGetCurrentSetting("plinking_glm_sparse", sparse_val) && !sparse_val.IsNull() &&
+	                   sparse_val.GetValue<bool>() && !file_has_dosage;
+	bool any_linear = false;
+	for (auto &pheno : bind_data->phenotypes) {
+		any_linear = any_linear || !pheno.is_logistic;
+	}
+	if (any_linear && (!bind_data->covariate_values.empty() || bind_data->multi_phenotype || want_sparse) &&
+	    ResolveGlmLinearEngine(context) == GlmLinearEngine::PROJECTED) {
+		auto &phenotypes = bind_data->phenotypes;
+		auto &groups = bind_data->projection_groups;
+		for (idx_t pi = 0; pi < phenotypes.size(); pi++) {
+			if (phenotypes[pi].is_logistic) {
 				continue;
 			}
-			if (v != 0.0 && v != 1.0) {
-				all_binary_01 = false;
+			idx_t g = 0;
+			while (g < groups.size() && !SameMissingSamples(phenotypes[groups[g].phenotypes[0]].values,
+			                                                phenotypes[pi].values)) {
+				g++;
+			}
+			if (g == groups.size()) {
+				groups.emplace_back();
+			}
+			groups[g].phenotypes.push_back(pi);
+			phenotypes[pi].projected = true;
+		}
+		for (auto &group : groups) {
+			vector<const vector<double> *> values;
+			for (auto pi : group.phenotypes) {
+				values.push_back(&phenotypes[pi].values);
 			}
-			if (v != 1.0 && v != 2.0) {
-				all_binary_12 = false;
+			group.projection.Init(values, bind_data->covariate_values);
+			// The projection keeps its own centered copy
+			for (auto pi : group.phenotypes) {
+				vector<double>().swap(phenotypes[pi].values);
 			}
 		}
+	}
 
-		if (all_binary_01) {
-			bind_data->is_logistic = true;
-		} else if (all_binary_12) {
-			// Recode 1/2 → 0/1
-			bind_data->is_logistic = true;
-			for (uint32_t i = 0; i < bind_data->effective_sample_ct; i++) {
-				if (!std::isnan(bind_data->phenotype[i])) {
-					bind_data->phenotype[i] -= 1.0;
+	// --- precision := 'float': single-precision copies of the linear inputs ---
+	// Phenotypes are centered first so their float products keep their precision.
+	// Linear phenotypes with covariates outside a projection (engine 'full') stay double.
+	if (bind_data->single_precision) {
+		for (auto &group : bind_data->projection_groups) {
+			group.projection.EnableSinglePrecision();
+		}
+		if (bind_data->covariate_values.empty()) {
+			for (auto &pheno : bind_data->phenotypes) {
+				if (pheno.is_logistic || pheno.projected) {
+					continue;
+				}
+				double sum = 0.0;
+				idx_t n = 0;
+				for (auto v : pheno.values) {
+					if (!std::isnan(v)) {
+						sum += v;
+						n++;
+					}
+				}
+				double mean = n ? sum / static_cast<double>(n) : 0.0;
+				pheno.values_f32.resize(pheno.values.size());
+				for (idx_t i = 0; i < pheno.values.size(); i++) {
+					pheno.values_f32[i] = static_cast<float>(pheno.values[i] - mean);
 				}
 			}
 		}
-	} else {
-		throw InvalidInputException("plink_glm: model must be 'auto', 'linear', or 'logistic', got '%s'", model_str);
+		// Nothing to do in single precision (logistic only, or every linear fit stays double)
+		bool any_f32 = !bind_data->projection_groups.empty();
+		for (auto &pheno : bind_data->phenotypes) {
+			any_f32 = any_f32 || !pheno.values_f32.empty();
+		}
+		bind_data->single_precision = any_f32;
 	}
 
-	bind_data->predictor_ct = static_cast<uint32_t>(2 + bind_data->covariate_values.size());
+	// --- Sparse path: opt-in via plinking_glm_sparse ---
+	// Rare variants are read as a difflist, and only their carriers and missing
+	// samples are touched; common variants fall back to the dense decode. Any
+	// phenotype fitted per variant needs the dense row anyway.
+	if (want_sparse) {
+		bool all_projected = true;
+		for (auto &pheno : bind_data->phenotypes) {
+			all_projected = all_projected && pheno.projected;
+		}
+		if (all_projected) {
+			bind_data->use_sparse = true;
+			bind_data->max_difflist_len = MaxValue<uint32_t>(1, bind_data->effective_sample_ct / 8);
+		}
+	}
+
+	bind_data->block_variant_ct = static_cast<uint32_t>(
+	    MaxValue<idx_t>(1, MinValue<idx_t>(GLM_BATCH_SIZE, GLM_BLOCK_DOSAGE_DOUBLES /
+	                                                          MaxValue<idx_t>(bind_data->effective_sample_ct, 1))));
 
 	// --- Output columns ---
 	names = {"CHROM",  "POS",  "ID", "REF",    "ALT", "A1",      "A1_FREQ", "TEST",
@@ -751,6 +1004,10 @@ static unique_ptr<FunctionData> PlinkGlmBind(ClientContext &context, TableFuncti
 	                LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::DOUBLE,  LogicalType::VARCHAR,
 	                LogicalType::INTEGER, LogicalType::DOUBLE,  LogicalType::DOUBLE,  LogicalType::DOUBLE,
 	                LogicalType::DOUBLE,  LogicalType::VARCHAR, LogicalType::DOUBLE,  LogicalType::VARCHAR};
+	if (bind_data->multi_phenotype) {
+		names.push_back("PHENO");
+		return_types.push_back(LogicalType::VARCHAR);
+	}
 
 	return std::move(bind_data);
 }
@@ -763,7 +1020,10 @@ static unique_ptr<GlobalTableFunctionState> PlinkGlmInitGlobal(ClientContext &co
 	auto &bind_data = input.bind_data->Cast<PlinkGlmBindData>();
 	auto state = make_uniq<PlinkGlmGlobalState>();
 
-	if (bind_data.variant_range.has_filter) {
+	if (bind_data.has_variant_list) {
+		state->start_variant_idx = 0;
+		state->end_variant_idx = static_cast<uint32_t>(bind_data.variant_indices.size());
+	} else if (bind_data.variant_range.has_filter) {
 		state->start_variant_idx = bind_data.variant_range.start_idx;
 		state->end_variant_idx = bind_data.variant_range.end_idx;
 	} else {
@@ -781,12 +1041,16 @@ static unique_ptr<GlobalTableFunctionState> PlinkGlmInitGlobal(ClientContext &co
 		if (col_id == COLUMN_IDENTIFIER_ROW_ID) {
 			continue;
 		}
-		if (col_id >= COL_A1_FREQ) {
+		if (col_id >= COL_A1_FREQ && col_id != COL_PHENO) {
 			state->need_regression = true;
 			break;
 		}
 	}
 
+	if (state->need_regression) {
+		state->pgen_index = bind_data.pgen_index;
+	}
+
 	return std::move(state);
 }
 
@@ -804,55 +1068,10 @@ static unique_ptr<LocalTableFunctionState> PlinkGlmInitLocal(ExecutionContext &c
 		return std::move(state);
 	}
 
-	// --- Initialize per-thread PgenFileInfo + PgenReader ---
+	// --- Per-thread PgenReader on the query's shared index ---
 	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
-	plink2::PreinitPgfi(&state->pgfi);
-	plink2::PreinitPgr(&state->pgr);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err =
-	    plink2::PgfiInitPhase1(bind_data.pgen_path.c_str(), nullptr, bind_data.raw_variant_ct, bind_data.raw_sample_ct,
-	                           &header_ctrl, &state->pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_glm: thread init failed (phase 1): %s", errstr_buf);
-	}
-
-	if (pgfi_alloc_cacheline_ct > 0) {
-		state->pgfi_alloc_buf.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, state->pgfi.raw_variant_ct, &max_vrec_width, &state->pgfi,
-	                             state->pgfi_alloc_buf.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_glm: thread init failed (phase 2): %s", errstr_buf);
-	}
-
-	if (pgr_alloc_cacheline_ct > 0) {
-		state->pgr_alloc_buf.Allocate(pgr_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	err = plink2::PgrInit(bind_data.pgen_path.c_str(), max_vrec_width, &state->pgfi, &state->pgr,
-	                      state->pgr_alloc_buf.As<unsigned char>());
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgr(&state->pgr, &cleanup_err);
-		cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_glm: PgrInit failed for '%s'", bind_data.pgen_path);
-	}
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_glm");
 
 	// Set up sample subsetting
 	if (bind_data.has_sample_subset && bind_data.sample_subset) {
@@ -874,34 +1093,32 @@ static unique_ptr<LocalTableFunctionState> PlinkGlmInitLocal(ExecutionContext &c
 	state->dosage_main_buf.Allocate(raw_sample_ct * sizeof(uint16_t));
 	std::memset(state->dosage_main_buf.ptr, 0, raw_sample_ct * sizeof(uint16_t));
 
-	state->dosage_doubles.resize(bind_data.effective_sample_ct, 0.0);
+	state->dosage_doubles.resize(static_cast<idx_t>(bind_data.block_variant_ct) * bind_data.effective_sample_ct, 0.0);
+	if (bind_data.single_precision) {
+		state->dosage_floats.resize(state->dosage_doubles.size(), 0.0f);
+	}
+
+	if (bind_data.use_sparse) {
+		uint32_t mdl = bind_data.max_difflist_len;
+		state->raregeno_buf.Allocate(plink2::NypCtToAlignedWordCt(mdl) * sizeof(uintptr_t));
+		state->difflist_sample_ids.resize(mdl + 2);
+		state->variant_sparse.assign(bind_data.block_variant_ct, false);
+		state->sparse_end.assign(bind_data.block_variant_ct, 0);
+	}
 
 	// Pre-allocate logistic regression scratch buffers (once per thread)
-	if (bind_data.is_logistic) {
+	if (bind_data.any_logistic) {
 		state->logistic_bufs.Allocate(bind_data.effective_sample_ct, bind_data.predictor_ct, bind_data.use_firth);
 	}
+	state->linear_ws.resize(bind_data.projection_groups.size());
+	for (idx_t g = 0; g < bind_data.projection_groups.size(); g++) {
+		state->linear_ws[g].Init(bind_data.projection_groups[g].projection, bind_data.block_variant_ct);
+	}
 
 	state->initialized = true;
 	return std::move(state);
 }
 
-// ---------------------------------------------------------------------------
-// Per-variant regression results
-// ---------------------------------------------------------------------------
-
-struct GlmResult {
-	double beta = NAN;
-	double se = NAN;
-	double t_stat = NAN;
-	double p_value = NAN;
-	double a1_freq = NAN;
-	double odds_ratio = NAN;
-	uint32_t obs_ct = 0;
-	const char *errcode = nullptr;
-	bool firth_applied = false;
-	bool is_logistic = false;
-};
-
 // ---------------------------------------------------------------------------
 // Linear regression (OLS)
 //
@@ -910,6 +1127,38 @@ struct GlmResult {
 // per-variant, so OBS_CT may vary across variants.
 // ---------------------------------------------------------------------------
 
+//! No-covariate fit from its sums (shared by the double and single-precision paths).
+//! result.obs_ct and a1_freq are already set and n >= 3.
+static void FinishSimpleLinearRegression(const SimpleLinearSums &sums, GlmResult &result) {
+	double nd = static_cast<double>(sums.n);
+	double sxx = sums.sum_xx - sums.sum_x * sums.sum_x / nd;
+	double sxy = sums.sum_xy - sums.sum_x * sums.sum_y / nd;
+	double syy = sums.sum_yy - sums.sum_y * sums.sum_y / nd;
+
+	if (sxx < 1e-20) {
+		result.errcode = "CONST_ALLELE";
+		return;
+	}
+
+	result.beta = sxy / sxx;
+	double rss = syy - sxy * sxy / sxx;
+	if (rss < 0.0) {
+		rss = 0.0;
+	}
+
+	double df = nd - 2.0;
+	double mse = rss / df;
+	double se_sq = mse / sxx;
+	if (se_sq < 1e-30) {
+		result.errcode = "ZERO_VARIANCE";
+		return;
+	}
+
+	result.se = std::sqrt(se_sq);
+	result.t_stat = result.beta / result.se;
+	result.p_value = TstatToPvalue(result.t_stat, df);
+}
+
 static GlmResult ComputeLinearRegression(const double *dosages, const double *phenotype,
                                          const vector<vector<double>> &covariates, uint32_t sample_ct) {
 	GlmResult result;
@@ -952,33 +1201,14 @@ static GlmResult ComputeLinearRegression(const double *dosages, const double *ph
 			sum_yy += y * y;
 		}
 
-		double nd = static_cast<double>(n);
-		double sxx = sum_xx - sum_x * sum_x / nd;
-		double sxy = sum_xy - sum_x * sum_y / nd;
-		double syy = sum_yy - sum_y * sum_y / nd;
-
-		if (sxx < 1e-20) {
-			result.errcode = "CONST_ALLELE";
-			return result;
-		}
-
-		result.beta = sxy / sxx;
-		double rss = syy - sxy * sxy / sxx;
-		if (rss < 0.0) {
-			rss = 0.0;
-		}
-
-		double df = nd - 2.0;
-		double mse = rss / df;
-		double se_sq = mse / sxx;
-		if (se_sq < 1e-30) {
-			result.errcode = "ZERO_VARIANCE";
-			return result;
-		}
-
-		result.se = std::sqrt(se_sq);
-		result.t_stat = result.beta / result.se;
-		result.p_value = TstatToPvalue(result.t_stat, df);
+		SimpleLinearSums sums;
+		sums.n = n;
+		sums.sum_x = sum_x;
+		sums.sum_xx = sum_xx;
+		sums.sum_y = sum_y;
+		sums.sum_yy = sum_yy;
+		sums.sum_xy = sum_xy;
+		FinishSimpleLinearRegression(sums, result);
 		return result;
 	}
 
@@ -1064,6 +1294,21 @@ static GlmResult ComputeLinearRegression(const double *dosages, const double *ph
 	return result;
 }
 
+//! precision := 'float' form of the no-covariate case: `dosages` and the centered
+//! `phenotype` are float rows, summed by the masked SIMD kernel.
+static GlmResult ComputeLinearRegressionF32(const float *dosages, const float *phenotype, uint32_t sample_ct) {
+	GlmResult result;
+	auto sums = ComputeSimpleLinearSumsF32(dosages, phenotype, sample_ct);
+	result.obs_ct = sums.n;
+	if (sums.n < 3) {
+		result.errcode = "TOO_FEW_SAMPLES";
+		return result;
+	}
+	result.a1_freq = sums.sum_x / (2.0 * static_cast<double>(sums.n));
+	FinishSimpleLinearRegression(sums, result);
+	return result;
+}
+
 // ---------------------------------------------------------------------------
 // Logistic regression (IRLS with optional Firth correction)
 // ---------------------------------------------------------------------------
@@ -1208,199 +1453,377 @@ static GlmResult ComputeLogisticRegression(const double *dosages, const double *
 // Scan function
 // ---------------------------------------------------------------------------
 
-static constexpr uint32_t GLM_BATCH_SIZE = 64;
+//! Score test against the phenotype's null model. Returns true (with `lr` filled
+//! from the score statistic) when its p-value is at or above the cutoff, so the
+//! full IRLS / Firth fit can be skipped.
+static bool TryLogisticScoreTest(const GlmPhenotype &pheno, double cutoff, const double *dosages,
+                                 LogisticBuffers &bufs, GlmResult &lr) {
+	auto score = ComputeLogisticScore(pheno.null_model, dosages, bufs.score_scratch.data());
+	if (!score.valid) {
+		return false;
+	}
+	double p_value = ZstatToPvalue(score.z_stat);
+	if (!(p_value >= cutoff)) {
+		return false;
+	}
+	lr.is_logistic = true;
+	lr.score_test = true;
+	lr.obs_ct = score.obs_ct;
+	lr.a1_freq = score.a1_freq;
+	lr.beta = score.beta;
+	lr.se = score.se;
+	lr.t_stat = score.z_stat;
+	lr.p_value = p_value;
+	lr.odds_ratio = std::exp(score.beta);
+	return true;
+}
 
-static void PlinkGlmScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
-	auto &bind_data = data_p.bind_data->Cast<PlinkGlmBindData>();
-	auto &gstate = data_p.global_state->Cast<PlinkGlmGlobalState>();
-	auto &lstate = data_p.local_state->Cast<PlinkGlmLocalState>();
+//! p-value from a projected-engine fit, in plink_glm's result type.
+static GlmResult ToGlmResult(const LinearAssocResult &fit) {
+	GlmResult lr;
+	lr.obs_ct = fit.obs_ct;
+	lr.a1_freq = fit.a1_freq;
+	lr.errcode = fit.errcode;
+	if (!fit.errcode) {
+		lr.beta = fit.beta;
+		lr.se = fit.se;
+		lr.t_stat = fit.t_stat;
+		lr.p_value = TstatToPvalue(fit.t_stat, fit.df);
+	}
+	return lr;
+}
 
-	auto &column_ids = gstate.column_ids;
+//! Dense decode of one variant's dosages (-9.0 = missing) into `dosages`.
+static void DecodeGlmDosages(const PlinkGlmBindData &bind_data, PlinkGlmLocalState &lstate,
+                             const uintptr_t *sample_include, uint32_t vidx, double *dosages) {
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	uint32_t dosage_ct = 0;
+	plink2::PglErr err =
+	    plink2::PgrGetD(sample_include, lstate.pssi, sample_ct, vidx, &lstate.pgr, lstate.genovec_buf.As<uintptr_t>(),
+	                    lstate.dosage_present_buf.As<uintptr_t>(), lstate.dosage_main_buf.As<uint16_t>(), &dosage_ct);
+	if (err != plink2::kPglRetSuccess) {
+		throw IOException("plink_glm: PgrGetD failed for variant %u", vidx);
+	}
+	plink2::Dosage16ToDoublesMinus9(lstate.genovec_buf.As<uintptr_t>(), lstate.dosage_present_buf.As<uintptr_t>(),
+	                                lstate.dosage_main_buf.As<uint16_t>(), sample_ct, dosage_ct, dosages);
+}
+
+//! Sparse path read: returns true with the variant's difflist (carriers and missing
+//! samples of a hom_ref-majority variant) appended to lstate.sparse_sample_ids /
+//! sparse_dosages. Otherwise decodes densely into `dosages` and returns false.
+static bool ReadGlmDifflist(const PlinkGlmBindData &bind_data, PlinkGlmLocalState &lstate,
+                            const uintptr_t *sample_include, uint32_t vidx, double *dosages) {
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	uint32_t common_geno = 0;
+	uint32_t difflist_len = 0;
+	auto *genovec = lstate.genovec_buf.As<uintptr_t>();
+	const uintptr_t *raregeno = lstate.raregeno_buf.As<uintptr_t>();
+	plink2::PglErr err = plink2::PgrGetDifflistOrGenovec(
+	    sample_include, lstate.pssi, sample_ct, bind_data.max_difflist_len, vidx, &lstate.pgr, genovec, &common_geno,
+	    lstate.raregeno_buf.As<uintptr_t>(), lstate.difflist_sample_ids.data(), &difflist_len);
+	if (err != plink2::kPglRetSuccess) {
+		throw IOException("plink_glm: PgrGetDifflistOrGenovec failed for variant %u", vidx);
+	}
+	if (common_geno == 0) {
+		// raregeno holds 2-bit codes 1 / 2 / 3 (= missing) in sample order
+		for (uint32_t j = 0; j < difflist_len; j++) {
+			uint32_t geno = (raregeno[j / plink2::kBitsPerWordD2] >> (2 * (j % plink2::kBitsPerWordD2))) & 3;
+			lstate.sparse_sample_ids.push_back(lstate.difflist_sample_ids[j]);
+			lstate.sparse_dosages.push_back(geno == 3 ? -9.0 : static_cast<double>(geno));
+		}
+		return true;
+	}
+	if (common_geno != UINT32_MAX) {
+		// A difflist whose majority is not hom_ref (ALT/missing-major): re-read
+		// densely. Such variants are uncommon, so the second read is negligible.
+		DecodeGlmDosages(bind_data, lstate, sample_include, vidx, dosages);
+		return false;
+	}
+	// Dense genovec returned; the file has no dosages, so hardcalls are the dosages
+	plink2::Dosage16ToDoublesMinus9(genovec, lstate.dosage_present_buf.As<uintptr_t>(),
+	                                lstate.dosage_main_buf.As<uint16_t>(), sample_ct, 0, dosages);
+	return false;
+}
+
+//! Claim the next block of variants and fit every phenotype against it, filling
+//! lstate.pending (variant-major, phenotypes in bind order). Each variant is
+//! decoded once however many phenotypes there are. Returns false once the variant
+//! range is exhausted.
+static bool ComputeNextGlmBlock(const PlinkGlmBindData &bind_data, PlinkGlmGlobalState &gstate,
+                                PlinkGlmLocalState &lstate) {
 	uint32_t end_idx = gstate.end_variant_idx;
+	uint32_t block_start = gstate.next_variant_idx.fetch_add(bind_data.block_variant_ct);
+	if (block_start >= end_idx) {
+		return false;
+	}
+	uint32_t block_end = std::min(block_start + bind_data.block_variant_ct, end_idx);
+	uint32_t block_ct = block_end - block_start;
 	uint32_t sample_ct = bind_data.effective_sample_ct;
+	idx_t pheno_ct = bind_data.phenotypes.size();
+
+	lstate.pending.assign(static_cast<idx_t>(block_ct) * pheno_ct, GlmPendingRow());
+	lstate.pending_pos = 0;
+	for (uint32_t b = 0; b < block_ct; b++) {
+		uint32_t pos = block_start + b;
+		uint32_t vidx = bind_data.has_variant_list ? bind_data.variant_indices[pos] : pos;
+		for (idx_t pi = 0; pi < pheno_ct; pi++) {
+			auto &row = lstate.pending[b * pheno_ct + pi];
+			row.vidx = vidx;
+			row.pheno_idx = static_cast<uint32_t>(pi);
+		}
+	}
+	if (!gstate.need_regression || !lstate.initialized) {
+		return true;
+	}
 
 	const uintptr_t *sample_include = nullptr;
 	if (bind_data.has_sample_subset && bind_data.sample_subset) {
 		sample_include = bind_data.sample_subset->SampleInclude();
 	}
 
-	idx_t rows_emitted = 0;
+	lstate.sparse_sample_ids.clear();
+	lstate.sparse_dosages.clear();
+	for (uint32_t b = 0; b < block_ct; b++) {
+		uint32_t vidx = lstate.pending[b * pheno_ct].vidx;
+		double *dosages = lstate.dosage_doubles.data() + static_cast<idx_t>(b) * sample_ct;
+		if (bind_data.use_sparse) {
+			lstate.variant_sparse[b] = ReadGlmDifflist(bind_data, lstate, sample_include, vidx, dosages);
+			lstate.sparse_end[b] = lstate.sparse_sample_ids.size();
+		} else {
+			DecodeGlmDosages(bind_data, lstate, sample_include, vidx, dosages);
+		}
+		if (bind_data.single_precision && !(bind_data.use_sparse && lstate.variant_sparse[b])) {
+			float *floats = lstate.dosage_floats.data() + static_cast<idx_t>(b) * sample_ct;
+			for (uint32_t i = 0; i < sample_ct; i++) {
+				floats[i] = static_cast<float>(dosages[i]);
+			}
+		}
+	}
 
-	while (rows_emitted < STANDARD_VECTOR_SIZE) {
-		uint32_t remaining_capacity = static_cast<uint32_t>(STANDARD_VECTOR_SIZE - rows_emitted);
-		uint32_t claim_size = std::min(GLM_BATCH_SIZE, remaining_capacity);
-		uint32_t batch_start = gstate.next_variant_idx.fetch_add(claim_size);
-		if (batch_start >= end_idx) {
-			break;
+	// Phenotypes fitted one variant at a time: logistic, and linear outside a projection
+	for (idx_t pi = 0; pi < pheno_ct; pi++) {
+		auto &pheno = bind_data.phenotypes[pi];
+		if (pheno.projected) {
+			continue;
 		}
-		uint32_t batch_end = std::min(batch_start + claim_size, end_idx);
-
-		for (uint32_t vidx = batch_start; vidx < batch_end; vidx++) {
-			// Compute regression if needed
-			GlmResult lr;
-			if (gstate.need_regression && lstate.initialized) {
-				uint32_t dosage_ct = 0;
-				plink2::PglErr err = plink2::PgrGetD(
-				    sample_include, lstate.pssi, sample_ct, vidx, &lstate.pgr, lstate.genovec_buf.As<uintptr_t>(),
-				    lstate.dosage_present_buf.As<uintptr_t>(), lstate.dosage_main_buf.As<uint16_t>(), &dosage_ct);
-				if (err != plink2::kPglRetSuccess) {
-					throw IOException("plink_glm: PgrGetD failed for variant %u", vidx);
+		for (uint32_t b = 0; b < block_ct; b++) {
+			const double *dosages = lstate.dosage_doubles.data() + static_cast<idx_t>(b) * sample_ct;
+			auto &lr = lstate.pending[b * pheno_ct + pi].result;
+			if (pheno.is_logistic) {
+				if (pheno.has_null_model &&
+				    TryLogisticScoreTest(pheno, bind_data.score_prefilter, dosages, lstate.logistic_bufs, lr)) {
+					continue;
 				}
+				lr = ComputeLogisticRegression(dosages, pheno.values.data(), bind_data.covariate_values, sample_ct,
+				                               bind_data.use_firth, lstate.logistic_bufs);
+			} else if (!pheno.values_f32.empty()) {
+				lr = ComputeLinearRegressionF32(lstate.dosage_floats.data() + static_cast<idx_t>(b) * sample_ct,
+				                                pheno.values_f32.data(), sample_ct);
+			} else {
+				lr = ComputeLinearRegression(dosages, pheno.values.data(), bind_data.covariate_values, sample_ct);
+			}
+		}
+	}
 
-				plink2::Dosage16ToDoublesMinus9(
-				    lstate.genovec_buf.As<uintptr_t>(), lstate.dosage_present_buf.As<uintptr_t>(),
-				    lstate.dosage_main_buf.As<uint16_t>(), sample_ct, dosage_ct, lstate.dosage_doubles.data());
+	// Projected linear phenotypes: one block × trait product per projection group
+	for (idx_t g = 0; g < bind_data.projection_groups.size(); g++) {
+		auto &group = bind_data.projection_groups[g];
+		idx_t trait_ct = group.phenotypes.size();
+		auto &ws = lstate.linear_ws[g];
+		lstate.linear_results.resize(block_ct * trait_ct);
+		ws.BeginBlock();
+		idx_t sparse_begin = 0;
+		for (uint32_t b = 0; b < block_ct; b++) {
+			if (bind_data.use_sparse && lstate.variant_sparse[b]) {
+				idx_t sparse_ct = lstate.sparse_end[b] - sparse_begin;
+				AddSparseVariant(group.projection, lstate.sparse_sample_ids.data() + sparse_begin,
+				                 lstate.sparse_dosages.data() + sparse_begin, sparse_ct, ws);
+				sparse_begin = lstate.sparse_end[b];
+			} else if (bind_data.single_precision) {
+				AddDenseVariantF32(group.projection, lstate.dosage_floats.data() + static_cast<idx_t>(b) * sample_ct,
+				                   ws);
+			} else {
+				AddDenseVariant(group.projection, lstate.dosage_doubles.data() + static_cast<idx_t>(b) * sample_ct,
+				                ws);
+			}
+		}
+		FinishProjectedLinear(group.projection, ws, lstate.linear_results.data());
+		for (uint32_t b = 0; b < block_ct; b++) {
+			for (idx_t c = 0; c < trait_ct; c++) {
+				lstate.pending[b * pheno_ct + group.phenotypes[c]].result =
+				    ToGlmResult(lstate.linear_results[b * trait_ct + c]);
+			}
+		}
+	}
+	return true;
+}
 
-				if (bind_data.is_logistic) {
-					lr = ComputeLogisticRegression(lstate.dosage_doubles.data(), bind_data.phenotype.data(),
-					                               bind_data.covariate_values, sample_ct, bind_data.use_firth,
-					                               lstate.logistic_bufs);
-				} else {
-					lr = ComputeLinearRegression(lstate.dosage_doubles.data(), bind_data.phenotype.data(),
-					                             bind_data.covariate_values, sample_ct);
-				}
+static void PlinkGlmScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<PlinkGlmBindData>();
+	auto &gstate = data_p.global_state->Cast<PlinkGlmGlobalState>();
+	auto &lstate = data_p.local_state->Cast<PlinkGlmLocalState>();
+
+	auto &column_ids = gstate.column_ids;
+
+	idx_t rows_emitted = 0;
+
+	while (rows_emitted < STANDARD_VECTOR_SIZE) {
+		if (lstate.pending_pos >= lstate.pending.size()) {
+			if (!ComputeNextGlmBlock(bind_data, gstate, lstate)) {
+				break;
 			}
+			continue;
+		}
 
-			// Apply p-value threshold filter: skip variants with errors, NaN p-values,
-			// or p-values exceeding the threshold
-			if (!std::isnan(bind_data.p_threshold)) {
-				if (lr.errcode != nullptr || std::isnan(lr.p_value) || lr.p_value > bind_data.p_threshold) {
-					continue; // skip this variant, don't emit row
-				}
+		auto &row = lstate.pending[lstate.pending_pos++];
+		uint32_t vidx = row.vidx;
+		auto &lr = row.result;
+
+		// Apply p-value threshold filter: skip rows with errors, NaN p-values,
+		// or p-values exceeding the threshold
+		if (!std::isnan(bind_data.p_threshold)) {
+			if (lr.errcode != nullptr || std::isnan(lr.p_value) || lr.p_value > bind_data.p_threshold) {
+				continue; // skip this row, don't emit it
 			}
+		}
 
-			// Fill projected columns
-			for (idx_t out_col = 0; out_col < column_ids.size(); out_col++) {
-				auto file_col = column_ids[out_col];
-				if (file_col == COLUMN_IDENTIFIER_ROW_ID) {
-					continue;
-				}
+		// Fill projected columns
+		for (idx_t out_col = 0; out_col < column_ids.size(); out_col++) {
+			auto file_col = column_ids[out_col];
+			if (file_col == COLUMN_IDENTIFIER_ROW_ID) {
+				continue;
+			}
 
-				auto &vec = output.data[out_col];
+			auto &vec = output.data[out_col];
 
-				switch (file_col) {
-				case COL_CHROM: {
-					auto val = bind_data.variants.GetChrom(vidx);
+			switch (file_col) {
+			case COL_CHROM: {
+				auto val = bind_data.variants.GetChrom(vidx);
+				FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
+				break;
+			}
+			case COL_POS: {
+				FlatVector::GetData<int32_t>(vec)[rows_emitted] = bind_data.variants.GetPos(vidx);
+				break;
+			}
+			case COL_ID: {
+				auto val = bind_data.variants.GetId(vidx);
+				if (val.empty()) {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
 					FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
-					break;
-				}
-				case COL_POS: {
-					FlatVector::GetData<int32_t>(vec)[rows_emitted] = bind_data.variants.GetPos(vidx);
-					break;
 				}
-				case COL_ID: {
-					auto val = bind_data.variants.GetId(vidx);
-					if (val.empty()) {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					} else {
-						FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
-					}
-					break;
-				}
-				case COL_REF: {
-					auto val = bind_data.variants.GetRef(vidx);
+				break;
+			}
+			case COL_REF: {
+				auto val = bind_data.variants.GetRef(vidx);
+				FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
+				break;
+			}
+			case COL_ALT: {
+				auto val = bind_data.variants.GetAlt(vidx);
+				if (val.empty() || val == ".") {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
 					FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
-					break;
-				}
-				case COL_ALT: {
-					auto val = bind_data.variants.GetAlt(vidx);
-					if (val.empty() || val == ".") {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					} else {
-						FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
-					}
-					break;
-				}
-				case COL_A1: {
-					// Tested allele is ALT (same as plink2)
-					auto val = bind_data.variants.GetAlt(vidx);
-					if (val.empty() || val == ".") {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					} else {
-						FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
-					}
-					break;
-				}
-				case COL_A1_FREQ: {
-					if (std::isnan(lr.a1_freq)) {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					} else {
-						FlatVector::GetData<double>(vec)[rows_emitted] = lr.a1_freq;
-					}
-					break;
 				}
-				case COL_TEST: {
-					FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, "ADD");
-					break;
-				}
-				case COL_OBS_CT: {
-					FlatVector::GetData<int32_t>(vec)[rows_emitted] = static_cast<int32_t>(lr.obs_ct);
-					break;
+				break;
+			}
+			case COL_A1: {
+				// Tested allele is ALT (same as plink2)
+				auto val = bind_data.variants.GetAlt(vidx);
+				if (val.empty() || val == ".") {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
+					FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
 				}
-				case COL_BETA: {
-					if (lr.errcode != nullptr) {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					} else {
-						FlatVector::GetData<double>(vec)[rows_emitted] = lr.beta;
-					}
-					break;
+				break;
+			}
+			case COL_A1_FREQ: {
+				if (std::isnan(lr.a1_freq)) {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
+					FlatVector::GetData<double>(vec)[rows_emitted] = lr.a1_freq;
 				}
-				case COL_SE: {
-					if (lr.errcode != nullptr) {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					} else {
-						FlatVector::GetData<double>(vec)[rows_emitted] = lr.se;
-					}
-					break;
+				break;
+			}
+			case COL_TEST: {
+				FlatVector::GetData<string_t>(vec)[rows_emitted] =
+				    StringVector::AddString(vec, lr.score_test ? "SCORE" : "ADD");
+				break;
+			}
+			case COL_OBS_CT: {
+				FlatVector::GetData<int32_t>(vec)[rows_emitted] = static_cast<int32_t>(lr.obs_ct);
+				break;
+			}
+			case COL_BETA: {
+				if (lr.errcode != nullptr) {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
+					FlatVector::GetData<double>(vec)[rows_emitted] = lr.beta;
 				}
-				case COL_T_STAT: {
-					if (lr.errcode != nullptr) {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					} else {
-						FlatVector::GetData<double>(vec)[rows_emitted] = lr.t_stat;
-					}
-					break;
+				break;
+			}
+			case COL_SE: {
+				if (lr.errcode != nullptr) {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
+					FlatVector::GetData<double>(vec)[rows_emitted] = lr.se;
 				}
-				case COL_P: {
-					if (lr.errcode != nullptr) {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					} else {
-						FlatVector::GetData<double>(vec)[rows_emitted] = lr.p_value;
-					}
-					break;
+				break;
+			}
+			case COL_T_STAT: {
+				if (lr.errcode != nullptr) {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
+					FlatVector::GetData<double>(vec)[rows_emitted] = lr.t_stat;
 				}
-				case COL_ERRCODE: {
-					if (lr.errcode != nullptr) {
-						FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, lr.errcode);
-					} else {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					}
-					break;
+				break;
+			}
+			case COL_P: {
+				if (lr.errcode != nullptr) {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
+					FlatVector::GetData<double>(vec)[rows_emitted] = lr.p_value;
 				}
-				case COL_OR: {
-					if (lr.is_logistic && lr.errcode == nullptr) {
-						FlatVector::GetData<double>(vec)[rows_emitted] = lr.odds_ratio;
-					} else {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					}
-					break;
+				break;
+			}
+			case COL_ERRCODE: {
+				if (lr.errcode != nullptr) {
+					FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, lr.errcode);
+				} else {
+					FlatVector::SetNull(vec, rows_emitted, true);
 				}
-				case COL_FIRTH_YN: {
-					if (lr.is_logistic && lr.errcode == nullptr) {
-						FlatVector::GetData<string_t>(vec)[rows_emitted] =
-						    StringVector::AddString(vec, lr.firth_applied ? "Y" : "N");
-					} else {
-						FlatVector::SetNull(vec, rows_emitted, true);
-					}
-					break;
+				break;
+			}
+			case COL_OR: {
+				if (lr.is_logistic && lr.errcode == nullptr) {
+					FlatVector::GetData<double>(vec)[rows_emitted] = lr.odds_ratio;
+				} else {
+					FlatVector::SetNull(vec, rows_emitted, true);
 				}
-				default:
-					break;
+				break;
+			}
+			case COL_FIRTH_YN: {
+				if (lr.is_logistic && lr.errcode == nullptr && !lr.score_test) {
+					FlatVector::GetData<string_t>(vec)[rows_emitted] =
+					    StringVector::AddString(vec, lr.firth_applied ? "Y" : "N");
+				} else {
+					FlatVector::SetNull(vec, rows_emitted, true);
 				}
+				break;
+			}
+			case COL_PHENO: {
+				FlatVector::GetData<string_t>(vec)[rows_emitted] =
+				    StringVector::AddString(vec, bind_data.phenotypes[row.pheno_idx].name);
+				break;
+			}
+			default:
+				break;
 			}
-
-			rows_emitted++;
 		}
+
+		rows_emitted++;
 	}
 
 	CompatSetOutputCardinality(output, rows_emitted);
@@ -1422,9 +1845,12 @@ void RegisterPlinkGlm(ExtensionLoader &loader) {
 	plink_glm.named_parameters["covariates"] = LogicalType::ANY;
 	plink_glm.named_parameters["samples"] = LogicalType::ANY;
 	plink_glm.named_parameters["region"] = LogicalType::VARCHAR;
+	plink_glm.named_parameters["variants"] = LogicalType::ANY;
 	plink_glm.named_parameters["model"] = LogicalType::VARCHAR;
 	plink_glm.named_parameters["firth"] = LogicalType::BOOLEAN;
 	plink_glm.named_parameters["p_threshold"] = LogicalType::DOUBLE;
+	plink_glm.named_parameters["score_prefilter"] = LogicalType::DOUBLE;
+	plink_glm.named_parameters["precision"] = LogicalType::VARCHAR;
 
 	loader.RegisterFunction(plink_glm);
 }
@@ -0,0 +1,515 @@
+#include "plink_glm_linear.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace duckdb {
+
+// ---------------------------------------------------------------------------
+// Engine selection
+// ---------------------------------------------------------------------------
+
+GlmLinearEngine ResolveGlmLinearEngine(ClientContext &context) {
+	string engine = "projected";
+	Value v;
+	if (context.TryGetCurrentSetting("plinking_glm_linear_engine", v) && !v.IsNull()) {
+		engine = StringUtil::Lower(v.ToString());
+	}
+	if (engine == "projected") {
+		return GlmLinearEngine::PROJECTED;
+	}
+	if (engine == "full") {
+		return GlmLinearEngine::FULL;
+	}
+	throw InvalidInputException("plink_glm: unknown plinking_glm_linear_engine '%s' (expected 'projected', 'full')",
+	                            engine);
+}
+
+// ---------------------------------------------------------------------------
+// Covariate factorization
+// ---------------------------------------------------------------------------
+
+//! Relative pivot below which Z'Z (or the genotype residual) counts as singular.
+static constexpr double LINEAR_SINGULAR_TOL = 1e-10;
+
+void BuildCovariateDesign(const vector<uint32_t> &active, const vector<vector<double>> &covariates, vector<double> &z) {
+	idx_t q = 1 + covariates.size();
+	idx_t n = active.size();
+	z.assign(n * q, 0.0);
+	for (idx_t j = 0; j < n; j++) {
+		z[j * q] = 1.0;
+	}
+	for (idx_t c = 0; c + 1 < q; c++) {
+		auto &col = covariates[c];
+		double mean = 0.0;
+		for (auto s : active) {
+			mean += col[s];
+		}
+		mean = n ? mean / static_cast<double>(n) : 0.0;
+		double ss = 0.0;
+		for (auto s : active) {
+			ss += (col[s] - mean) * (col[s] - mean);
+		}
+		// A constant covariate stays an all-zero column, so Z'Z is reported singular
+		double scale = ss > 0.0 ? 1.0 / std::sqrt(ss / static_cast<double>(n)) : 0.0;
+		for (idx_t j = 0; j < n; j++) {
+			z[j * q + 1 + c] = (col[active[j]] - mean) * scale;
+		}
+	}
+}
+
+//! Cholesky of the q×q Gram matrix, then V = L^-1 Z'Y and the residual y sums of squares.
+static void FactorGram(vector<double> gram, vector<double> zy, const vector<double> &yy, uint32_t q, idx_t trait_ct,
+                       CovariateFactor &out) {
+	out.chol.assign(static_cast<idx_t>(q) * q, 0.0);
+	out.v.assign(q * trait_ct, 0.0);
+	out.y_resid_ss.assign(trait_ct, 0.0);
+	out.singular = false;
+	auto &l = out.chol;
+	for (uint32_t j = 0; j < q; j++) {
+		double diag = gram[j * q + j];
+		for (uint32_t k = 0; k < j; k++) {
+			diag -= l[j * q + k] * l[j * q + k];
+		}
+		if (!(diag > LINEAR_SINGULAR_TOL * gram[j * q + j])) {
+			out.singular = true;
+			return;
+		}
+		double ljj = std::sqrt(diag);
+		l[j * q + j] = ljj;
+		for (uint32_t i = j + 1; i < q; i++) {
+			double s = gram[i * q + j];
+			for (uint32_t k = 0; k < j; k++) {
+				s -= l[i * q + k] * l[j * q + k];
+			}
+			l[i * q + j] = s / ljj;
+		}
+	}
+	for (idx_t t = 0; t < trait_ct; t++) {
+		double vv = 0.0;
+		for (uint32_t i = 0; i < q; i++) {
+			double s = zy[i * trait_ct + t];
+			for (uint32_t k = 0; k < i; k++) {
+				s -= l[i * q + k] * out.v[k * trait_ct + t];
+			}
+			double vi = s / l[i * q + i];
+			out.v[i * trait_ct + t] = vi;
+			vv += vi * vi;
+		}
+		out.y_resid_ss[t] = MaxValue(yy[t] - vv, 0.0);
+	}
+}
+
+void CovariateProjection::Init(const vector<const vector<double> *> &phenotypes,
+                               const vector<vector<double>> &covariates) {
+	D_ASSERT(!phenotypes.empty());
+	q = static_cast<uint32_t>(1 + covariates.size());
+	trait_ct = phenotypes.size();
+	auto &first = *phenotypes[0];
+	active.clear();
+	for (uint32_t s = 0; s < first.size(); s++) {
+		if (!std::isnan(first[s])) {
+			active.push_back(s);
+		}
+	}
+	idx_t n = active.size();
+	active_pos.assign(first.size(), INACTIVE);
+	for (idx_t j = 0; j < n; j++) {
+		active_pos[active[j]] = static_cast<uint32_t>(j);
+	}
+
+	y.resize(n * trait_ct);
+	for (idx_t t = 0; t < trait_ct; t++) {
+		auto &pheno = *phenotypes[t];
+		double y_mean = 0.0;
+		for (auto s : active) {
+			y_mean += pheno[s];
+		}
+		y_mean = n ? y_mean / static_cast<double>(n) : 0.0;
+		for (idx_t j = 0; j < n; j++) {
+			y[j * trait_ct + t] = pheno[active[j]] - y_mean;
+		}
+	}
+
+	BuildCovariateDesign(active, covariates, z);
+
+	gram.assign(static_cast<idx_t>(q) * q, 0.0);
+	zy.assign(q * trait_ct, 0.0);
+	yy.assign(trait_ct, 0.0);
+	for (idx_t j = 0; j < n; j++) {
+		const double *zr = z.data() + j * q;
+		const double *yr = y.data() + j * trait_ct;
+		for (uint32_t a = 0; a < q; a++) {
+			for (uint32_t b = 0; b <= a; b++) {
+				gram[a * q + b] += zr[a] * zr[b];
+			}
+			for (idx_t t = 0; t < trait_ct; t++) {
+				zy[a * trait_ct + t] += zr[a] * yr[t];
+			}
+		}
+		for (idx_t t = 0; t < trait_ct; t++) {
+			yy[t] += yr[t] * yr[t];
+		}
+	}
+	for (uint32_t a = 0; a < q; a++) {
+		for (uint32_t b = 0; b < a; b++) {
+			gram[b * q + a] = gram[a * q + b];
+		}
+	}
+	FactorGram(gram, zy, yy, q, trait_ct, full);
+}
+
+void CovariateProjection::FactorWithout(const vector<uint32_t> &missing, CovariateFactor &out) const {
+	vector<double> g = gram;
+	vector<double> zy_m = zy;
+	vector<double> yy_m = yy;
+	for (auto j : missing) {
+		const double *zr = z.data() + static_cast<idx_t>(j) * q;
+		const double *yr = y.data() + static_cast<idx_t>(j) * trait_ct;
+		for (uint32_t a = 0; a < q; a++) {
+			for (uint32_t b = 0; b < q; b++) {
+				g[a * q + b] -= zr[a] * zr[b];
+			}
+			for (idx_t t = 0; t < trait_ct; t++) {
+				zy_m[a * trait_ct + t] -= zr[a] * yr[t];
+			}
+		}
+		for (idx_t t = 0; t < trait_ct; t++) {
+			yy_m[t] -= yr[t] * yr[t];
+		}
+	}
+	FactorGram(std::move(g), std::move(zy_m), yy_m, q, trait_ct, out);
+}
+
+void LinearProjectionWorkspace::Init(const CovariateProjection &proj, idx_t block_capacity_p) {
+	block_capacity = block_capacity_p;
+	idx_t q = proj.ZColumnCount();
+	x.assign(block_capacity * proj.ActiveCount(), 0.0);
+	xy.assign(block_capacity * proj.TraitCount(), 0.0);
+	zx.assign(block_capacity * q, 0.0);
+	sum_x.assign(block_capacity, 0.0);
+	xx.assign(block_capacity, 0.0);
+	kind.assign(block_capacity, RowKind::DENSE);
+	missing_end.assign(block_capacity, 0);
+	carrier_end.assign(block_capacity, 0);
+	BeginBlock();
+	u.assign(q, 0.0);
+	uv.assign(proj.TraitCount(), 0.0);
+	if (!proj.cols_f32.empty()) {
+		x_f32.assign(proj.ActiveCount(), 0.0f);
+		dots.assign(q + proj.TraitCount(), 0.0);
+	}
+	patterns.clear();
+}
+
+//! Distinct missingness patterns kept per thread before the cache is reset.
+static constexpr idx_t LINEAR_PATTERN_CACHE_MAX = 256;
+
+static const CovariateFactor &FactorForPattern(const CovariateProjection &proj, LinearProjectionWorkspace &ws,
+                                               const uint32_t *missing, idx_t missing_ct) {
+	if (missing_ct == 0) {
+		return proj.full;
+	}
+	uint64_t h = 1469598103934665603ULL; // FNV-1a over the positions
+	for (idx_t i = 0; i < missing_ct; i++) {
+		h = (h ^ missing[i]) * 1099511628211ULL;
+	}
+	auto it = ws.patterns.find(h);
+	if (it != ws.patterns.end()) {
+		auto &cached = it->second.missing;
+		if (cached.size() == missing_ct && std::equal(cached.begin(), cached.end(), missing)) {
+			return it->second.factor;
+		}
+		ws.patterns.erase(it);
+	}
+	if (ws.patterns.size() >= LINEAR_PATTERN_CACHE_MAX) {
+		ws.patterns.clear();
+	}
+	auto &entry = ws.patterns[h];
+	entry.missing.assign(missing, missing + missing_ct);
+	proj.FactorWithout(entry.missing, entry.factor);
+	return entry.factor;
+}
+
+// ---------------------------------------------------------------------------
+// Variant block × trait product
+// ---------------------------------------------------------------------------
+
+//! Target size (doubles) of the Y tile kept hot while every block variant streams over it.
+static constexpr idx_t LINEAR_Y_TILE_DOUBLES = 32768;
+
+//! xy[b][t] = sum_j x[b][j] * y[j][t] over the block's dense variants. Samples are
+//! tiled so a slab of Y stays in cache across the whole variant block; the inner
+//! loop runs over contiguous traits, and hom-ref (zero) dosages are skipped. Each
+//! output still sums its samples in ascending order, so the result does not depend
+//! on the block size.
+static void AccumulateGenotypeTraitProducts(const LinearProjectionWorkspace &ws, idx_t n, const double *y,
+                                            idx_t trait_ct, double *xy) {
+	idx_t tile = MaxValue<idx_t>(16, LINEAR_Y_TILE_DOUBLES / trait_ct);
+	for (idx_t j0 = 0; j0 < n; j0 += tile) {
+		idx_t j1 = MinValue(n, j0 + tile);
+		for (idx_t b = 0; b < ws.block_ct; b++) {
+			if (ws.kind[b] != LinearProjectionWorkspace::RowKind::DENSE) {
+				continue;
+			}
+			const double *xb = ws.x.data() + b * n;
+			double *out = xy + b * trait_ct;
+			for (idx_t j = j0; j < j1; j++) {
+				double xv = xb[j];
+				if (xv == 0.0) {
+					continue;
+				}
+				const double *yr = y + j * trait_ct;
+				for (idx_t t = 0; t < trait_ct; t++) {
+					out[t] += xv * yr[t];
+				}
+			}
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Per-variant fit
+// ---------------------------------------------------------------------------
+
+void LinearProjectionWorkspace::BeginBlock() {
+	block_ct = 0;
+	missing.clear();
+	carrier_pos.clear();
+	carrier_x.clear();
+}
+
+//! Start the next block variant: zeroed Z'x (returned for accumulation) and x'y.
+static double *BeginVariant(const CovariateProjection &proj, LinearProjectionWorkspace &ws) {
+	D_ASSERT(ws.block_ct < ws.block_capacity);
+	uint32_t q = proj.ZColumnCount();
+	idx_t trait_ct = proj.TraitCount();
+	double *zx = ws.zx.data() + ws.block_ct * q;
+	std::fill(zx, zx + q, 0.0);
+	std::fill(ws.xy.begin() + ws.block_ct * trait_ct, ws.xy.begin() + (ws.block_ct + 1) * trait_ct, 0.0);
+	return zx;
+}
+
+static void EndVariant(LinearProjectionWorkspace &ws, LinearProjectionWorkspace::RowKind kind, double sum_x,
+                       double xx) {
+	idx_t b = ws.block_ct++;
+	ws.kind[b] = kind;
+	ws.sum_x[b] = sum_x;
+	ws.xx[b] = xx;
+	ws.missing_end[b] = ws.missing.size();
+	ws.carrier_end[b] = ws.carrier_pos.size();
+}
+
+void AddDenseVariant(const CovariateProjection &proj, const double *dosages, LinearProjectionWorkspace &ws) {
+	uint32_t q = proj.ZColumnCount();
+	uint32_t n_active = proj.ActiveCount();
+	double *zx = BeginVariant(proj, ws);
+	double *xb = ws.x.data() + ws.block_ct * n_active;
+
+	// x'Z, x'x, sum x and the missing positions; x is compacted onto the active
+	// samples for the trait product. Hom-ref calls add nothing.
+	double sum_x = 0.0, xx = 0.0;
+	for (uint32_t j = 0; j < n_active; j++) {
+		double x = dosages[proj.active[j]];
+		if (x == -9.0) {
+			ws.missing.push_back(j);
+			xb[j] = 0.0;
+			continue;
+		}
+		xb[j] = x;
+		if (x == 0.0) {
+			continue;
+		}
+		sum_x += x;
+		xx += x * x;
+		const double *zr = proj.z.data() + static_cast<idx_t>(j) * q;
+		for (uint32_t c = 0; c < q; c++) {
+			zx[c] += x * zr[c];
+		}
+	}
+	EndVariant(ws, LinearProjectionWorkspace::RowKind::DENSE, sum_x, xx);
+}
+
+void AddSparseVariant(const CovariateProjection &proj, const uint32_t *sample_ids, const double *x_vals,
+                      idx_t entry_ct, LinearProjectionWorkspace &ws) {
+	uint32_t q = proj.ZColumnCount();
+	double *zx = BeginVariant(proj, ws);
+
+	// Same sums as the dense pass, over the listed samples only (ascending, so the
+	// additions happen in the same order and the results are identical)
+	double sum_x = 0.0, xx = 0.0;
+	for (idx_t i = 0; i < entry_ct; i++) {
+		uint32_t j = proj.active_pos[sample_ids[i]];
+		if (j == CovariateProjection::INACTIVE) {
+			continue;
+		}
+		double x = x_vals[i];
+		if (x == -9.0) {
+			ws.missing.push_back(j);
+			continue;
+		}
+		if (x == 0.0) {
+			continue;
+		}
+		ws.carrier_pos.push_back(j);
+		ws.carrier_x.push_back(x);
+		sum_x += x;
+		xx += x * x;
+		const double *zr = proj.z.data() + static_cast<idx_t>(j) * q;
+		for (uint32_t c = 0; c < q; c++) {
+			zx[c] += x * zr[c];
+		}
+	}
+	EndVariant(ws, LinearProjectionWorkspace::RowKind::SPARSE, sum_x, xx);
+}
+
+void AddDenseVariantF32(const CovariateProjection &proj, const float *dosages, LinearProjectionWorkspace &ws) {
+	D_ASSERT(!proj.cols_f32.empty());
+	uint32_t q = proj.ZColumnCount();
+	uint32_t n_active = proj.ActiveCount();
+	idx_t trait_ct = proj.TraitCount();
+	double *zx = BeginVariant(proj, ws);
+
+	float *xf = ws.x_f32.data();
+	for (uint32_t j = 0; j < n_active; j++) {
+		xf[j] = dosages[proj.active[j]];
+	}
+	std::fill(ws.dots.begin(), ws.dots.end(), 0.0);
+	double sum_x = 0.0, xx = 0.0;
+	uint32_t missing_ct =
+	    ComputeMaskedDotsF32(xf, n_active, proj.cols_f32.data(), q + trait_ct, n_active, ws.dots.data(), sum_x, xx);
+	if (missing_ct > 0) {
+		for (uint32_t j = 0; j < n_active; j++) {
+			if (xf[j] == -9.0f) {
+				ws.missing.push_back(j);
+			}
+		}
+	}
+	std::copy(ws.dots.begin(), ws.dots.begin() + q, zx);
+	std::copy(ws.dots.begin() + q, ws.dots.end(), ws.xy.begin() + ws.block_ct * trait_ct);
+	EndVariant(ws, LinearProjectionWorkspace::RowKind::PRECOMPUTED, sum_x, xx);
+}
+
+static void SetVariantError(LinearAssocResult *results, idx_t trait_ct, const char *errcode) {
+	for (idx_t t = 0; t < trait_ct; t++) {
+		results[t].errcode = errcode;
+	}
+}
+
+void FinishProjectedLinear(const CovariateProjection &proj, LinearProjectionWorkspace &ws,
+                           LinearAssocResult *results) {
+	uint32_t q = proj.ZColumnCount();
+	uint32_t p = q + 1; // + genotype
+	uint32_t n_active = proj.ActiveCount();
+	idx_t trait_ct = proj.TraitCount();
+	idx_t variant_ct = ws.block_ct;
+
+	// x'y for the whole block against every trait: dense variants through the tiled
+	// product, sparse ones straight from their carriers
+	AccumulateGenotypeTraitProducts(ws, n_active, proj.y.data(), trait_ct, ws.xy.data());
+	idx_t carrier_begin = 0;
+	for (idx_t b = 0; b < variant_ct; b++) {
+		if (ws.kind[b] == LinearProjectionWorkspace::RowKind::SPARSE) {
+			double *out = ws.xy.data() + b * trait_ct;
+			for (idx_t i = carrier_begin; i < ws.carrier_end[b]; i++) {
+				double xv = ws.carrier_x[i];
+				const double *yr = proj.y.data() + static_cast<idx_t>(ws.carrier_pos[i]) * trait_ct;
+				for (idx_t t = 0; t < trait_ct; t++) {
+					out[t] += xv * yr[t];
+				}
+			}
+		}
+		carrier_begin = ws.carrier_end[b];
+	}
+
+	// Per variant: residualize x on Z (u = L^-1 Z'x, so x_r'x_r = x'x - u'u and
+	// x_r'y_r = x'y - u'v) and finish each trait
+	idx_t missing_begin = 0;
+	for (idx_t b = 0; b < variant_ct; b++) {
+		LinearAssocResult *out = results + b * trait_ct;
+		idx_t missing_ct = ws.missing_end[b] - missing_begin;
+		const uint32_t *missing = ws.missing.data() + missing_begin;
+		missing_begin = ws.missing_end[b];
+
+		uint32_t n = n_active - static_cast<uint32_t>(missing_ct);
+		for (idx_t t = 0; t < trait_ct; t++) {
+			out[t] = LinearAssocResult();
+			out[t].obs_ct = n;
+		}
+		if (n < p + 1) {
+			SetVariantError(out, trait_ct, "TOO_FEW_SAMPLES");
+			continue;
+		}
+		double nd = static_cast<double>(n);
+		double a1_freq = ws.sum_x[b] / (2.0 * nd);
+		for (idx_t t = 0; t < trait_ct; t++) {
+			out[t].a1_freq = a1_freq;
+		}
+
+		double xx = ws.xx[b];
+		double sxx = xx - ws.sum_x[b] * ws.sum_x[b] / nd;
+		if (sxx < 1e-20) {
+			SetVariantError(out, trait_ct, "CONST_ALLELE");
+			continue;
+		}
+
+		auto &factor = FactorForPattern(proj, ws, missing, missing_ct);
+		if (factor.singular) {
+			SetVariantError(out, trait_ct, "SINGULAR_MATRIX");
+			continue;
+		}
+
+		auto &l = factor.chol;
+		const double *zx = ws.zx.data() + b * q;
+		double uu = 0.0;
+		std::fill(ws.uv.begin(), ws.uv.end(), 0.0);
+		for (uint32_t i = 0; i < q; i++) {
+			double s = zx[i];
+			for (uint32_t k = 0; k < i; k++) {
+				s -= l[i * q + k] * ws.u[k];
+			}
+			double ui = s / l[i * q + i];
+			ws.u[i] = ui;
+			uu += ui * ui;
+			const double *vi = factor.v.data() + i * trait_ct;
+			for (idx_t t = 0; t < trait_ct; t++) {
+				ws.uv[t] += ui * vi[t];
+			}
+		}
+		double sxx_r = xx - uu;
+		if (!(sxx_r > LINEAR_SINGULAR_TOL * sxx)) {
+			// Genotype lies in the span of the covariates
+			SetVariantError(out, trait_ct, "SINGULAR_MATRIX");
+			continue;
+		}
+
+		double df = nd - static_cast<double>(p);
+		const double *xy = ws.xy.data() + b * trait_ct;
+		for (idx_t t = 0; t < trait_ct; t++) {
+			auto &r = out[t];
+			double sxy_r = xy[t] - ws.uv[t];
+			r.beta = sxy_r / sxx_r;
+			double rss = MaxValue(factor.y_resid_ss[t] - r.beta * sxy_r, 0.0);
+			r.df = df;
+			double se_sq = rss / df / sxx_r;
+			if (se_sq < 1e-30) {
+				r.beta = NAN;
+				r.errcode = "ZERO_VARIANCE";
+				continue;
+			}
+			r.se = std::sqrt(se_sq);
+			r.t_stat = r.beta / r.se;
+		}
+	}
+}
+
+void ComputeProjectedLinear(const CovariateProjection &proj, const double *dosages, idx_t dosage_stride,
+                            idx_t variant_ct, LinearProjectionWorkspace &ws, LinearAssocResult *results) {
+	ws.BeginBlock();
+	for (idx_t b = 0; b < variant_ct; b++) {
+		AddDenseVariant(proj, dosages + b * dosage_stride, ws);
+	}
+	FinishProjectedLinear(proj, ws, results);
+}
+
+} // namespace duckdb
@@ -0,0 +1,215 @@
+#include "plink_glm_score.hpp"
+
+#include <cmath>
+
+namespace duckdb {
+
+// ---------------------------------------------------------------------------
+// Null model
+// ---------------------------------------------------------------------------
+
+static constexpr uint32_t LOGISTIC_NULL_MAX_ITER = 25;
+static constexpr double LOGISTIC_NULL_TOL = 1e-10;
+
+//! Relative pivot below which Z'WZ (or the genotype's score variance) counts as singular.
+static constexpr double LOGISTIC_SCORE_SINGULAR_TOL = 1e-10;
+
+//! Lower Cholesky factor of the symmetric q×q matrix `a`; false if not positive definite.
+static bool CholeskyLower(const vector<double> &a, uint32_t q, vector<double> &l) {
+	l.assign(static_cast<idx_t>(q) * q, 0.0);
+	for (uint32_t j = 0; j < q; j++) {
+		double diag = a[j * q + j];
+		for (uint32_t k = 0; k < j; k++) {
+			diag -= l[j * q + k] * l[j * q + k];
+		}
+		if (!(diag > LOGISTIC_SCORE_SINGULAR_TOL * a[j * q + j])) {
+			return false;
+		}
+		double ljj = std::sqrt(diag);
+		l[j * q + j] = ljj;
+		for (uint32_t i = j + 1; i < q; i++) {
+			double s = a[i * q + j];
+			for (uint32_t k = 0; k < j; k++) {
+				s -= l[i * q + k] * l[j * q + k];
+			}
+			l[i * q + j] = s / ljj;
+		}
+	}
+	return true;
+}
+
+bool LogisticNullModel::Fit(const vector<double> &phenotype, const vector<vector<double>> &covariates) {
+	q = static_cast<uint32_t>(1 + covariates.size());
+	active.clear();
+	for (uint32_t s = 0; s < phenotype.size(); s++) {
+		if (!std::isnan(phenotype[s])) {
+			active.push_back(s);
+		}
+	}
+	idx_t n = active.size();
+	if (n <= q) {
+		return false;
+	}
+	BuildCovariateDesign(active, covariates, z);
+
+	double y_mean = 0.0;
+	for (auto s : active) {
+		y_mean += phenotype[s];
+	}
+	y_mean /= static_cast<double>(n);
+	if (!(y_mean > 0.0 && y_mean < 1.0)) {
+		return false;
+	}
+
+	vector<double> beta(q, 0.0);
+	beta[0] = std::log(y_mean / (1.0 - y_mean));
+	resid.resize(n);
+	weight.resize(n);
+	vector<double> hess(static_cast<idx_t>(q) * q);
+	vector<double> grad(q);
+	vector<double> step(q);
+
+	// Each iteration evaluates mu, W and Z'WZ at the current beta, so the state left
+	// behind on convergence (resid, weight, chol) belongs to the final estimate.
+	for (uint32_t iter = 0; iter <= LOGISTIC_NULL_MAX_ITER; iter++) {
+		std::fill(hess.begin(), hess.end(), 0.0);
+		std::fill(grad.begin(), grad.end(), 0.0);
+		for (idx_t j = 0; j < n; j++) {
+			const double *zr = z.data() + j * q;
+			double eta = 0.0;
+			for (uint32_t c = 0; c < q; c++) {
+				eta += zr[c] * beta[c];
+			}
+			double mu = 1.0 / (1.0 + std::exp(-eta));
+			resid[j] = phenotype[active[j]] - mu;
+			weight[j] = mu * (1.0 - mu);
+			for (uint32_t a = 0; a < q; a++) {
+				grad[a] += zr[a] * resid[j];
+				for (uint32_t b = 0; b <= a; b++) {
+					hess[a * q + b] += weight[j] * zr[a] * zr[b];
+				}
+			}
+		}
+		for (uint32_t a = 0; a < q; a++) {
+			for (uint32_t b = 0; b < a; b++) {
+				hess[b * q + a] = hess[a * q + b];
+			}
+		}
+		if (!CholeskyLower(hess, q, chol)) {
+			return false;
+		}
+		if (iter == LOGISTIC_NULL_MAX_ITER) {
+			return false;
+		}
+
+		// Newton step: L L' step = grad
+		for (uint32_t i = 0; i < q; i++) {
+			double s = grad[i];
+			for (uint32_t k = 0; k < i; k++) {
+				s -= chol[i * q + k] * step[k];
+			}
+			step[i] = s / chol[i * q + i];
+		}
+		double max_step = 0.0;
+		for (uint32_t i = q; i-- > 0;) {
+			double s = step[i];
+			for (uint32_t k = i + 1; k < q; k++) {
+				s -= chol[k * q + i] * step[k];
+			}
+			step[i] = s / chol[i * q + i];
+			max_step = MaxValue(max_step, std::fabs(step[i]));
+		}
+		if (!std::isfinite(max_step)) {
+			return false;
+		}
+		if (max_step < LOGISTIC_NULL_TOL) {
+			return true;
+		}
+		for (uint32_t c = 0; c < q; c++) {
+			beta[c] += step[c];
+		}
+	}
+	return false;
+}
+
+// ---------------------------------------------------------------------------
+// Per-variant score test
+// ---------------------------------------------------------------------------
+
+LogisticScoreResult ComputeLogisticScore(const LogisticNullModel &null_model, const double *dosages,
+                                         double *scratch) {
+	LogisticScoreResult result;
+	uint32_t q = null_model.q;
+	auto n = static_cast<uint32_t>(null_model.active.size());
+	double *zwx = scratch;            // Z'Wx, then L^-1 Z'Wx
+	double *zw_missing = scratch + q; // Z'W over the missing-genotype samples
+	std::fill(scratch, scratch + 2 * q, 0.0);
+
+	// One pass: U = x'r, x'Wx and Z'Wx over the called genotypes; the missing ones
+	// are mean-imputed afterwards from their r / W / Z'W sums. Hom-ref adds nothing.
+	double u = 0.0, xwx = 0.0, sum_x = 0.0;
+	double r_missing = 0.0, w_missing = 0.0;
+	uint32_t missing_ct = 0;
+	for (uint32_t j = 0; j < n; j++) {
+		double x = dosages[null_model.active[j]];
+		double w = null_model.weight[j];
+		const double *zr = null_model.z.data() + static_cast<idx_t>(j) * q;
+		if (x == -9.0) {
+			missing_ct++;
+			r_missing += null_model.resid[j];
+			w_missing += w;
+			for (uint32_t c = 0; c < q; c++) {
+				zw_missing[c] += w * zr[c];
+			}
+			continue;
+		}
+		if (x == 0.0) {
+			continue;
+		}
+		sum_x += x;
+		u += x * null_model.resid[j];
+		double wx = w * x;
+		xwx += wx * x;
+		for (uint32_t c = 0; c < q; c++) {
+			zwx[c] += wx * zr[c];
+		}
+	}
+
+	result.obs_ct = n - missing_ct;
+	if (result.obs_ct < q + 2) {
+		return result;
+	}
+	double x_mean = sum_x / static_cast<double>(result.obs_ct);
+	result.a1_freq = x_mean / 2.0;
+	if (missing_ct > 0) {
+		u += x_mean * r_missing;
+		xwx += x_mean * x_mean * w_missing;
+		for (uint32_t c = 0; c < q; c++) {
+			zwx[c] += x_mean * zw_missing[c];
+		}
+	}
+
+	// V = x'Wx - (Z'Wx)' (Z'WZ)^-1 (Z'Wx) = x'Wx - |L^-1 Z'Wx|^2
+	auto &l = null_model.chol;
+	double projected = 0.0;
+	for (uint32_t i = 0; i < q; i++) {
+		double s = zwx[i];
+		for (uint32_t k = 0; k < i; k++) {
+			s -= l[i * q + k] * zwx[k];
+		}
+		zwx[i] = s / l[i * q + i];
+		projected += zwx[i] * zwx[i];
+	}
+	double v = xwx - projected;
+	if (!(v > LOGISTIC_SCORE_SINGULAR_TOL * xwx)) {
+		return result;
+	}
+
+	result.beta = u / v;
+	result.se = 1.0 / std::sqrt(v);
+	result.z_stat = u * result.se;
+	result.valid = true;
+	return result;
+}
+
+} // namespace duckdb
@@ -0,0 +1,584 @@
+// plink_grm.cpp — genomic relationship matrix (plink2 --make-rel) as a
+// lower-triangle pair stream.
+//
+// GRM = Xᵀ X / M over the M non-monomorphic variants, where X holds the
+// genotypes normalized exactly as plink_pca normalizes them (ComputeVariantNorm /
+// NormalizeGenotypes, missing calls mean-imputed). The N × N matrix is never
+// materialized: the sample axis is cut into bands of rows, a thread claims one
+// band, streams every variant through panels and accumulates the band's
+// lower-triangle block (band rows × columns up to the band's last row) with one
+// Eigen GEMM per panel, then emits that band's pairs before claiming the next.
+// Memory is one band accumulator plus one panel per thread, whatever N is.
+
+#include "plink_grm.hpp"
+#include "duckdb_compat.hpp"
+#include "plink_common.hpp"
+#include "pgen_vfs_opener.hpp"
+
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace duckdb {
+
+// ---------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------
+
+static constexpr uint32_t GRM_BATCH_SIZE = 240;
+
+// Per-thread cap on the normalized-genotype panel (variants × samples doubles)
+static constexpr idx_t GRM_PANEL_MAX_DOUBLES = idx_t(1) << 23;
+
+// Per-thread cap on the band accumulator (band rows × samples doubles, 128 MiB).
+// Every band re-reads the variants, so bands are as tall as this allows.
+static constexpr idx_t GRM_BAND_MAX_DOUBLES = idx_t(1) << 24;
+
+using GrmRowMajorMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+// ---------------------------------------------------------------------------
+// Column indices
+// ---------------------------------------------------------------------------
+
+static constexpr idx_t COL_FID1 = 0;
+static constexpr idx_t COL_IID1 = 1;
+static constexpr idx_t COL_FID2 = 2;
+static constexpr idx_t COL_IID2 = 3;
+static constexpr idx_t COL_GRM = 4;
+
+// ---------------------------------------------------------------------------
+// Effective variant (pgen index + normalization)
+// ---------------------------------------------------------------------------
+
+struct GrmVariant {
+	uint32_t pgen_idx;
+	VariantNorm norm;
+};
+
+// ---------------------------------------------------------------------------
+// Bind data
+// ---------------------------------------------------------------------------
+
+struct PlinkGrmBindData : public TableFunctionData {
+	string pgen_path;
+	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
+	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
+	string pvar_path;
+	string psam_path;
+
+	VariantMetadataIndex variants;
+	SampleInfo sample_info;
+
+	uint32_t raw_variant_ct = 0;
+	uint32_t raw_sample_ct = 0;
+
+	// Sample subsetting
+	bool has_sample_subset = false;
+	unique_ptr<SampleSubset> sample_subset;
+	uint32_t effective_sample_ct = 0;
+
+	// Region filtering
+	VariantRange variant_range;
+
+	// Non-monomorphic variants, in pgen order
+	vector<GrmVariant> grm_variants;
+
+	// Sparse output: off-diagonal pairs with GRM > cutoff
+	bool has_cutoff = false;
+	double cutoff = 0.0;
+
+	// Sample output order (maps emit index → original sample index)
+	vector<uint32_t> sample_output_order;
+};
+
+// ---------------------------------------------------------------------------
+// Global state
+// ---------------------------------------------------------------------------
+
+struct PlinkGrmGlobalState : public GlobalTableFunctionState {
+	// Bands of band_rows samples; claimed last band first, since band b covers
+	// (b + 1) * band_rows columns and the largest bands should not run last
+	uint32_t band_rows = 1;
+	uint32_t band_ct = 0;
+	std::atomic<uint32_t> next_band {0};
+
+	vector<column_t> column_ids;
+
+	// Threading
+	uint32_t db_thread_count = 1;
+	uint32_t max_threads_config = 0;
+
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
+	idx_t MaxThreads() const override {
+		idx_t computed = std::min<idx_t>(MaxValue<uint32_t>(band_ct, 1), db_thread_count);
+		return ApplyMaxThreadsCap(computed, max_threads_config);
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Local state (per-thread)
+// ---------------------------------------------------------------------------
+
+struct PlinkGrmLocalState : public LocalTableFunctionState {
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
+
+	plink2::PgenReader pgr;
+	AlignedBuffer pgr_alloc_buf;
+
+	plink2::PgrSampleSubsetIndex pssi;
+
+	AlignedBuffer genovec_buf;
+	vector<int8_t> geno_bytes;
+
+	// Normalized genotypes of up to panel_variant_ct variants (panel_variant_ct x N,
+	// row-major)
+	vector<double> panel;
+	uint32_t panel_variant_ct = 1;
+
+	// Current band: rows [band_start, band_end) × columns [0, band_end), row-major
+	// with stride band_end
+	vector<double> band;
+	uint32_t band_start = 0;
+	uint32_t band_end = 0;
+
+	// Emission cursor within the current band (emit_row == band_end when drained)
+	uint32_t emit_row = 0;
+	uint32_t emit_col = 0;
+
+	bool initialized = false;
+
+	~PlinkGrmLocalState() {
+		if (initialized) {
+			plink2::PglErr reterr = plink2::kPglRetSuccess;
+			plink2::CleanupPgr(&pgr, &reterr);
+		}
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Bind
+// ---------------------------------------------------------------------------
+
+static unique_ptr<FunctionData> PlinkGrmBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<PlinkGrmBindData>();
+	bind_data->pgen_path = input.inputs[0].GetValue<string>();
+
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	// --- Named parameters (first pass) ---
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "pvar") {
+			bind_data->pvar_path = kv.second.GetValue<string>();
+		} else if (kv.first == "psam") {
+			bind_data->psam_path = kv.second.GetValue<string>();
+		} else if (kv.first == "cutoff") {
+			if (kv.second.IsNull()) {
+				throw InvalidInputException("plink_grm: cutoff cannot be NULL");
+			}
+			bind_data->has_cutoff = true;
+			bind_data->cutoff = kv.second.GetValue<double>();
+		} else if (kv.first == "samples" || kv.first == "region" || kv.first == "variants") {
+			// Handled below
+		}
+	}
+
+	// --- Auto-discover companion files ---
+	if (bind_data->pvar_path.empty()) {
+		bind_data->pvar_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".pvar", ".bim"});
+		if (bind_data->pvar_path.empty()) {
+			throw InvalidInputException("plink_grm: cannot find .pvar or .bim companion for '%s' "
+			                            "(use pvar := 'path' to specify explicitly)",
+			                            bind_data->pgen_path);
+		}
+	}
+
+	if (bind_data->psam_path.empty()) {
+		bind_data->psam_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".psam", ".fam"});
+		if (bind_data->psam_path.empty()) {
+			throw InvalidInputException("plink_grm: cannot find .psam or .fam companion for '%s' "
+			                            "(use psam := 'path' to specify explicitly)",
+			                            bind_data->pgen_path);
+		}
+	}
+
+	// --- Load the .pgen index (counts and allele freqs now; the scan reuses it) ---
+	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
+	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
+	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
+
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_grm");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
+
+	// --- Load variant metadata ---
+	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_grm");
+
+	if (bind_data->variants.variant_ct != bind_data->raw_variant_ct) {
+		throw InvalidInputException("plink_grm: variant count mismatch: .pgen has %u variants, "
+		                            ".pvar/.bim '%s' has %llu variants",
+		                            bind_data->raw_variant_ct, bind_data->pvar_path,
+		                            static_cast<unsigned long long>(bind_data->variants.variant_ct));
+	}
+
+	// --- Load sample info ---
+	bind_data->sample_info = LoadSampleMetadata(context, bind_data->psam_path);
+
+	if (static_cast<uint32_t>(bind_data->sample_info.sample_ct) != bind_data->raw_sample_ct) {
+		throw InvalidInputException("plink_grm: sample count mismatch: .pgen has %u samples, "
+		                            ".psam/.fam '%s' has %llu samples",
+		                            bind_data->raw_sample_ct, bind_data->psam_path,
+		                            static_cast<unsigned long long>(bind_data->sample_info.sample_ct));
+	}
+
+	// --- Process samples parameter ---
+	bind_data->effective_sample_ct = bind_data->raw_sample_ct;
+
+	auto samples_it = input.named_parameters.find("samples");
+	if (samples_it != input.named_parameters.end()) {
+		auto indices =
+		    ResolveSampleIndices(samples_it->second, bind_data->raw_sample_ct, &bind_data->sample_info, "plink_grm");
+
+		bind_data->sample_subset = make_uniq<SampleSubset>(BuildSampleSubset(bind_data->raw_sample_ct, indices));
+		bind_data->has_sample_subset = true;
+		bind_data->effective_sample_ct = bind_data->sample_subset->subset_sample_ct;
+
+		auto sorted_indices = indices;
+		std::sort(sorted_indices.begin(), sorted_indices.end());
+		bind_data->sample_output_order = std::move(sorted_indices);
+	} else {
+		bind_data->sample_output_order.resize(bind_data->raw_sample_ct);
+		for (uint32_t i = 0; i < bind_data->raw_sample_ct; i++) {
+			bind_data->sample_output_order[i] = i;
+		}
+	}
+
+	// --- Process region parameter ---
+	auto region_it = input.named_parameters.find("region");
+	if (region_it != input.named_parameters.end()) {
+		bind_data->variant_range = ParseRegion(region_it->second.GetValue<string>(), bind_data->variants, "plink_grm");
+	}
+
+	// --- Process variants parameter (intersected with region) ---
+	uint32_t range_start = bind_data->variant_range.has_filter ? bind_data->variant_range.start_idx : 0;
+	uint32_t range_end =
+	    bind_data->variant_range.has_filter ? bind_data->variant_range.end_idx : bind_data->raw_variant_ct;
+
+	vector<uint32_t> candidate_variants;
+	auto variants_it = input.named_parameters.find("variants");
+	if (variants_it != input.named_parameters.end()) {
+		auto indices =
+		    ResolveVariantsParameter(variants_it->second, bind_data->variants, bind_data->raw_variant_ct, "plink_grm");
+		for (auto vidx : indices) {
+			if (vidx >= range_start && vidx < range_end) {
+				candidate_variants.push_back(vidx);
+			}
+		}
+		std::sort(candidate_variants.begin(), candidate_variants.end());
+	} else {
+		candidate_variants.reserve(range_end - range_start);
+		for (uint32_t vidx = range_start; vidx < range_end; vidx++) {
+			candidate_variants.push_back(vidx);
+		}
+	}
+
+	// --- Compute per-variant allele frequencies and keep non-monomorphic variants ---
+	// Need a full PgenReader for PgrGetCounts
+	plink2::PgenReader pgr_temp;
+	plink2::PreinitPgr(&pgr_temp);
+	AlignedBuffer pgr_alloc_temp;
+	InitPgenReader(*bind_data->pgen_index, bind_data->pgen_path, pgr_temp, pgr_alloc_temp, "plink_grm");
+
+	// Set up sample subsetting on the temporary reader
+	plink2::PgrSampleSubsetIndex pssi_temp;
+	const uintptr_t *sample_include_temp = nullptr;
+	const uintptr_t *interleaved_vec_temp = nullptr;
+	uint32_t count_sample_ct = bind_data->effective_sample_ct;
+
+	if (bind_data->has_sample_subset && bind_data->sample_subset) {
+		plink2::PgrSetSampleSubsetIndex(bind_data->sample_subset->CumulativePopcounts(), &pgr_temp, &pssi_temp);
+		sample_include_temp = bind_data->sample_subset->SampleInclude();
+		interleaved_vec_temp = bind_data->sample_subset->InterleavedVec();
+	} else {
+		plink2::PgrClearSampleSubsetIndex(&pgr_temp, &pssi_temp);
+	}
+
+	for (auto vidx : candidate_variants) {
+		STD_ARRAY_DECL(uint32_t, 4, genocounts);
+		plink2::PglErr err = plink2::PgrGetCounts(sample_include_temp, interleaved_vec_temp, pssi_temp,
+		                                          count_sample_ct, vidx, &pgr_temp, genocounts);
+		if (err != plink2::kPglRetSuccess) {
+			plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
+			plink2::CleanupPgr(&pgr_temp, &cleanup_err);
+			throw IOException("plink_grm: PgrGetCounts failed for variant %u", vidx);
+		}
+
+		uint32_t obs = genocounts[0] + genocounts[1] + genocounts[2];
+		if (obs == 0) {
+			continue; // all missing
+		}
+
+		double alt_freq = (static_cast<double>(genocounts[1]) + 2.0 * static_cast<double>(genocounts[2])) /
+		                  (2.0 * static_cast<double>(obs));
+		VariantNorm norm = ComputeVariantNorm(alt_freq);
+		if (norm.skip) {
+			continue; // monomorphic
+		}
+
+		bind_data->grm_variants.push_back({vidx, norm});
+	}
+
+	// Clean up temporary reader
+	{
+		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
+		plink2::CleanupPgr(&pgr_temp, &cleanup_err);
+	}
+
+	// --- Validate dimensions ---
+	if (bind_data->effective_sample_ct == 0) {
+		throw InvalidInputException("plink_grm: no samples selected");
+	}
+
+	if (bind_data->grm_variants.empty()) {
+		throw InvalidInputException("plink_grm: no non-monomorphic variants in '%s' for the selected samples",
+		                            bind_data->pgen_path);
+	}
+
+	// --- Register output schema ---
+	names = {"FID1", "IID1", "FID2", "IID2", "GRM"};
+	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                LogicalType::DOUBLE};
+
+	return std::move(bind_data);
+}
+
+// ---------------------------------------------------------------------------
+// Init global
+// ---------------------------------------------------------------------------
+
+static unique_ptr<GlobalTableFunctionState> PlinkGrmInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PlinkGrmBindData>();
+	auto state = make_uniq<PlinkGrmGlobalState>();
+
+	state->column_ids = input.column_ids;
+	state->db_thread_count = static_cast<uint32_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
+	state->max_threads_config = GetPlinkingMaxThreads(context);
+
+	// One band per thread where the accumulator budget allows, smaller bands otherwise
+	idx_t sample_ct = bind_data.effective_sample_ct;
+	idx_t thread_ct = ApplyMaxThreadsCap(state->db_thread_count, state->max_threads_config);
+	idx_t band_rows = (sample_ct + thread_ct - 1) / MaxValue<idx_t>(thread_ct, 1);
+	band_rows = MaxValue<idx_t>(1, MinValue<idx_t>(band_rows, GRM_BAND_MAX_DOUBLES / sample_ct));
+	state->band_rows = static_cast<uint32_t>(band_rows);
+	state->band_ct = static_cast<uint32_t>((sample_ct + band_rows - 1) / band_rows);
+
+	state->pgen_index = bind_data.pgen_index;
+
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Init local (per-thread PgenReader)
+// ---------------------------------------------------------------------------
+
+static unique_ptr<LocalTableFunctionState> PlinkGrmInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                                                             GlobalTableFunctionState *gstate) {
+	auto &bind_data = input.bind_data->Cast<PlinkGrmBindData>();
+	auto &gs = gstate->Cast<PlinkGrmGlobalState>();
+	auto state = make_uniq<PlinkGrmLocalState>();
+
+	// --- Per-thread PgenReader on the query's shared index ---
+	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
+	state->pgen_index = gs.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_grm");
+
+	// Set up sample subsetting
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		plink2::PgrSetSampleSubsetIndex(bind_data.sample_subset->CumulativePopcounts(), &state->pgr, &state->pssi);
+	} else {
+		plink2::PgrClearSampleSubsetIndex(&state->pgr, &state->pssi);
+	}
+
+	// Allocate genotype decode buffer
+	uintptr_t genovec_word_ct = plink2::NypCtToAlignedWordCt(bind_data.raw_sample_ct);
+	state->genovec_buf.Allocate(genovec_word_ct * sizeof(uintptr_t));
+	std::memset(state->genovec_buf.ptr, 0, genovec_word_ct * sizeof(uintptr_t));
+
+	// Allocate panel; the band accumulator is sized per claimed band
+	idx_t sample_ct = bind_data.effective_sample_ct;
+	state->geno_bytes.resize(sample_ct);
+	state->panel_variant_ct =
+	    static_cast<uint32_t>(MaxValue<idx_t>(1, MinValue<idx_t>(GRM_BATCH_SIZE, GRM_PANEL_MAX_DOUBLES / sample_ct)));
+	state->panel.resize(static_cast<idx_t>(state->panel_variant_ct) * sample_ct);
+	state->band.reserve(static_cast<idx_t>(gs.band_rows) * sample_ct);
+
+	state->initialized = true;
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Scan function
+// ---------------------------------------------------------------------------
+
+//! band (rows x band_end) += P[:, band_start:band_end]ᵀ × P[:, 0:band_end]
+static void AccumulateGrmPanel(const PlinkGrmBindData &bind_data, PlinkGrmLocalState &ls, uint32_t panel_ct) {
+	idx_t sample_ct = bind_data.effective_sample_ct;
+	uint32_t row_ct = ls.band_end - ls.band_start;
+	Eigen::Map<const GrmRowMajorMatrix> p(ls.panel.data(), panel_ct, sample_ct);
+	Eigen::Map<GrmRowMajorMatrix> band(ls.band.data(), row_ct, ls.band_end);
+	band.noalias() += p.middleCols(ls.band_start, row_ct).transpose() * p.leftCols(ls.band_end);
+}
+
+//! Stream every GRM variant through the panel and accumulate the claimed band. The
+//! band only reads samples [0, band_end), so only those are normalized into the panel.
+static void ComputeGrmBand(const PlinkGrmBindData &bind_data, PlinkGrmLocalState &ls) {
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	const uintptr_t *sample_include = nullptr;
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		sample_include = bind_data.sample_subset->SampleInclude();
+	}
+
+	ls.band.assign(static_cast<idx_t>(ls.band_end - ls.band_start) * ls.band_end, 0.0);
+
+	uint32_t panel_ct = 0;
+	for (auto &gv : bind_data.grm_variants) {
+		plink2::PglErr err =
+		    plink2::PgrGet(sample_include, ls.pssi, sample_ct, gv.pgen_idx, &ls.pgr, ls.genovec_buf.As<uintptr_t>());
+		if (err != plink2::kPglRetSuccess) {
+			throw IOException("plink_grm: PgrGet failed for variant %u", gv.pgen_idx);
+		}
+		plink2::GenoarrToBytesMinus9(ls.genovec_buf.As<uintptr_t>(), ls.band_end, ls.geno_bytes.data());
+		NormalizeGenotypes(ls.geno_bytes.data(), ls.band_end, gv.norm,
+		                   ls.panel.data() + static_cast<idx_t>(panel_ct) * sample_ct);
+
+		if (++panel_ct == ls.panel_variant_ct) {
+			AccumulateGrmPanel(bind_data, ls, panel_ct);
+			panel_ct = 0;
+		}
+	}
+	if (panel_ct > 0) {
+		AccumulateGrmPanel(bind_data, ls, panel_ct);
+	}
+
+	double inv_variant_ct = 1.0 / static_cast<double>(bind_data.grm_variants.size());
+	for (auto &val : ls.band) {
+		val *= inv_variant_ct;
+	}
+}
+
+static void SetSampleId(Vector &vec, idx_t row, const PlinkGrmBindData &bind_data, bool fid, uint32_t sidx) {
+	uint32_t orig_idx = bind_data.sample_output_order[sidx];
+	if (!fid) {
+		FlatVector::GetData<string_t>(vec)[row] = StringVector::AddString(vec, bind_data.sample_info.iids[orig_idx]);
+	} else if (!bind_data.sample_info.fids.empty()) {
+		FlatVector::GetData<string_t>(vec)[row] = StringVector::AddString(vec, bind_data.sample_info.fids[orig_idx]);
+	} else {
+		FlatVector::SetNull(vec, row, true);
+	}
+}
+
+static void PlinkGrmScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<PlinkGrmBindData>();
+	auto &gs = data_p.global_state->Cast<PlinkGrmGlobalState>();
+	auto &ls = data_p.local_state->Cast<PlinkGrmLocalState>();
+	auto &column_ids = gs.column_ids;
+
+	if (!ls.initialized) {
+		CompatSetOutputCardinality(output, 0);
+		return;
+	}
+
+	idx_t rows_emitted = 0;
+	while (rows_emitted < STANDARD_VECTOR_SIZE) {
+		// Claim and compute the next band once the current one is drained
+		if (ls.emit_row == ls.band_end) {
+			if (rows_emitted > 0) {
+				break;
+			}
+			uint32_t claimed = gs.next_band.fetch_add(1);
+			if (claimed >= gs.band_ct) {
+				break;
+			}
+			uint32_t band_idx = gs.band_ct - 1 - claimed;
+			ls.band_start = band_idx * gs.band_rows;
+			ls.band_end = std::min(ls.band_start + gs.band_rows, bind_data.effective_sample_ct);
+			ComputeGrmBand(bind_data, ls);
+			ls.emit_row = ls.band_start;
+			ls.emit_col = 0;
+		}
+
+		// Lower triangle (col <= row) of the band, row by row
+		uint32_t i = ls.emit_row;
+		uint32_t j = ls.emit_col;
+		double grm = ls.band[static_cast<idx_t>(i - ls.band_start) * ls.band_end + j];
+		if (j == i) {
+			ls.emit_row++;
+			ls.emit_col = 0;
+		} else {
+			ls.emit_col++;
+			if (bind_data.has_cutoff && !(grm > bind_data.cutoff)) {
+				continue;
+			}
+		}
+
+		for (idx_t out_col = 0; out_col < column_ids.size(); out_col++) {
+			auto file_col = column_ids[out_col];
+			if (file_col == COLUMN_IDENTIFIER_ROW_ID) {
+				continue;
+			}
+
+			auto &vec = output.data[out_col];
+
+			switch (file_col) {
+			case COL_FID1:
+				SetSampleId(vec, rows_emitted, bind_data, true, i);
+				break;
+			case COL_IID1:
+				SetSampleId(vec, rows_emitted, bind_data, false, i);
+				break;
+			case COL_FID2:
+				SetSampleId(vec, rows_emitted, bind_data, true, j);
+				break;
+			case COL_IID2:
+				SetSampleId(vec, rows_emitted, bind_data, false, j);
+				break;
+			case COL_GRM:
+				FlatVector::GetData<double>(vec)[rows_emitted] = grm;
+				break;
+			default:
+				break;
+			}
+		}
+		rows_emitted++;
+	}
+	CompatSetOutputCardinality(output, rows_emitted);
+}
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+void RegisterPlinkGrm(ExtensionLoader &loader) {
+	TableFunction plink_grm("plink_grm", {LogicalType::VARCHAR}, PlinkGrmScan, PlinkGrmBind, PlinkGrmInitGlobal,
+	                        PlinkGrmInitLocal);
+
+	plink_grm.projection_pushdown = true;
+
+	plink_grm.named_parameters["pvar"] = LogicalType::VARCHAR;
+	plink_grm.named_parameters["psam"] = LogicalType::VARCHAR;
+	plink_grm.named_parameters["samples"] = LogicalType::ANY;
+	plink_grm.named_parameters["region"] = LogicalType::VARCHAR;
+	plink_grm.named_parameters["variants"] = LogicalType::ANY;
+	plink_grm.named_parameters["cutoff"] = LogicalType::DOUBLE;
+
+	loader.RegisterFunction(plink_grm);
+}
+
+} // namespace duckdb
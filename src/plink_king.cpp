@@ -0,0 +1,709 @@
+// plink_king.cpp — KING-robust kinship (plink2 --make-king-table) as a sample-pair
+// stream.
+//
+// For a pair of samples over their jointly called variants, KING-robust needs the
+// HETHET, IBS0 (opposite homozygotes), HET1_HOM2 / HET2_HOM1 and HOM/HOM counts:
+//
+//   KINSHIP = 1/2 - (4 IBS0 + HET1_HOM2 + HET2_HOM1) / (4 (HETHET + min(HET1_HOM2, HET2_HOM1)))
+//
+// Phase 1 transposes the variant-major genovecs into a sample-major layout: each
+// sample gets the two bitplanes of its 2-bit genotypes over all variants (lo and hi
+// bit; 0=hom_ref, 1=het, 2=hom_alt, 3=missing), 2 bits per genotype like the .pgen
+// itself. Threads claim runs of variants and fill whole cache lines of every
+// sample's planes. Phase 2 tiles the lower triangle of sample pairs into
+// KING_TILE x KING_TILE blocks claimed by the threads; a block walks the variant
+// words in chunks whose planes stay in cache and gathers every count of a pair
+// with five AND + popcounts per 64 variants. The kinship cutoff is applied in the
+// block, so only related pairs are ever materialized.
+
+#include "plink_king.hpp"
+#include "duckdb_compat.hpp"
+#include "plink_common.hpp"
+#include "pgen_vfs_opener.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace duckdb {
+
+// ---------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------
+
+// Samples per tile edge of the pair triangle
+static constexpr uint32_t KING_TILE = 64;
+
+// Variant words (64 variants each) per chunk of a tile's walk: two tiles of
+// samples x two planes x 128 words is 256 KiB, an L2's worth
+static constexpr uint32_t KING_WORD_CHUNK = 128;
+
+// Variant words claimed per transpose block: one cache line of each sample's planes
+static constexpr uint32_t KING_TRANSPOSE_WORDS = 8;
+
+static constexpr uint32_t KING_VARIANTS_PER_WORD = 64;
+
+// ---------------------------------------------------------------------------
+// Column indices
+// ---------------------------------------------------------------------------
+
+static constexpr idx_t COL_FID1 = 0;
+static constexpr idx_t COL_IID1 = 1;
+static constexpr idx_t COL_FID2 = 2;
+static constexpr idx_t COL_IID2 = 3;
+static constexpr idx_t COL_NSNP = 4;
+static constexpr idx_t COL_HETHET = 5;
+static constexpr idx_t COL_IBS0 = 6;
+static constexpr idx_t COL_KINSHIP = 7;
+
+// ---------------------------------------------------------------------------
+// Pair counts
+// ---------------------------------------------------------------------------
+
+struct KingCounts {
+	uint32_t hethet = 0;
+	uint32_t ibs0 = 0;
+	uint32_t het1_hom2 = 0;
+	uint32_t het2_hom1 = 0;
+	uint32_t homhom = 0;
+
+	uint32_t Nsnp() const {
+		return hethet + het1_hom2 + het2_hom1 + homhom;
+	}
+
+	//! KING-robust kinship; false when neither sample has a het call in the pair's
+	//! jointly called variants (undefined).
+	bool Kinship(double &kinship) const {
+		uint32_t smaller_het_ct = hethet + MinValue(het1_hom2, het2_hom1);
+		if (smaller_het_ct == 0) {
+			return false;
+		}
+		kinship = 0.5 - (4.0 * ibs0 + het1_hom2 + het2_hom1) / (4.0 * smaller_het_ct);
+		return true;
+	}
+};
+
+//! Sample indices (id1 < id2, in emit order) and counts of one emitted pair.
+struct KingPair {
+	uint32_t id1;
+	uint32_t id2;
+	KingCounts counts;
+};
+
+// ---------------------------------------------------------------------------
+// Bind data
+// ---------------------------------------------------------------------------
+
+struct PlinkKingBindData : public TableFunctionData {
+	string pgen_path;
+	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
+	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
+	string pvar_path;
+	string psam_path;
+
+	VariantMetadataIndex variants;
+	SampleInfo sample_info;
+
+	uint32_t raw_variant_ct = 0;
+	uint32_t raw_sample_ct = 0;
+
+	// Sample subsetting
+	bool has_sample_subset = false;
+	unique_ptr<SampleSubset> sample_subset;
+	uint32_t effective_sample_ct = 0;
+
+	// Region filtering
+	VariantRange variant_range;
+
+	// Variants in the kinship computation, in pgen order
+	vector<uint32_t> king_variants;
+
+	// Pairs with KINSHIP >= cutoff only (plink2 --king-table-filter)
+	bool has_cutoff = false;
+	double cutoff = 0.0;
+
+	// Sample output order (maps emit index → original sample index)
+	vector<uint32_t> sample_output_order;
+};
+
+// ---------------------------------------------------------------------------
+// Global state
+// ---------------------------------------------------------------------------
+
+struct PlinkKingGlobalState : public GlobalTableFunctionState {
+	// Sample-major bitplanes: sample s holds lo words at [s * 2W, s * 2W + W) and hi
+	// words at [s * 2W + W, (s + 1) * 2W), W = plane_word_ct (a whole number of cache
+	// lines). Bits past the last variant are set in both planes (missing).
+	TrackedBuffer planes;
+	uint32_t plane_word_ct = 0;
+
+	// Phase 1: transpose blocks of KING_TRANSPOSE_WORDS words. Threads wait for the
+	// blocks still being filled by other (running, never-blocking) threads.
+	uint32_t transpose_block_ct = 0;
+	std::atomic<uint32_t> next_transpose_block {0};
+	std::atomic<uint32_t> transposed_block_ct {0};
+	std::atomic<bool> transpose_failed {false};
+
+	// Phase 2: lower-triangle tiles (tile_row, tile_col <= tile_row), row-major
+	uint32_t tile_ct = 0; // per axis
+	uint32_t tile_pair_ct = 0;
+	std::atomic<uint32_t> next_tile_pair {0};
+
+	vector<column_t> column_ids;
+
+	// Threading
+	uint32_t db_thread_count = 1;
+	uint32_t max_threads_config = 0;
+
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
+	idx_t MaxThreads() const override {
+		idx_t work_ct = MaxValue<idx_t>(1, MaxValue(transpose_block_ct, tile_pair_ct));
+		idx_t computed = std::min<idx_t>(work_ct, db_thread_count);
+		return ApplyMaxThreadsCap(computed, max_threads_config);
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Local state (per-thread)
+// ---------------------------------------------------------------------------
+
+struct PlinkKingLocalState : public LocalTableFunctionState {
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
+
+	plink2::PgenReader pgr;
+	AlignedBuffer pgr_alloc_buf;
+
+	plink2::PgrSampleSubsetIndex pssi;
+
+	AlignedBuffer genovec_buf;
+
+	// Transpose scratch: one block's lo / hi words for every sample (N x KING_TRANSPOSE_WORDS)
+	vector<uintptr_t> block_lo;
+	vector<uintptr_t> block_hi;
+
+	// Tile accumulators (KING_TILE x KING_TILE) and the current tile's kept pairs
+	vector<KingCounts> tile_counts;
+	vector<KingPair> pairs;
+	idx_t pair_pos = 0;
+
+	bool planes_ready = false;
+	bool initialized = false;
+
+	~PlinkKingLocalState() {
+		if (initialized) {
+			plink2::PglErr reterr = plink2::kPglRetSuccess;
+			plink2::CleanupPgr(&pgr, &reterr);
+		}
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Bind
+// ---------------------------------------------------------------------------
+
+static unique_ptr<FunctionData> PlinkKingBind(ClientContext &context, TableFunctionBindInput &input,
+                                              vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<PlinkKingBindData>();
+	bind_data->pgen_path = input.inputs[0].GetValue<string>();
+
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	// --- Named parameters (first pass) ---
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "pvar") {
+			bind_data->pvar_path = kv.second.GetValue<string>();
+		} else if (kv.first == "psam") {
+			bind_data->psam_path = kv.second.GetValue<string>();
+		} else if (kv.first == "cutoff") {
+			if (kv.second.IsNull()) {
+				throw InvalidInputException("plink_king: cutoff cannot be NULL");
+			}
+			bind_data->has_cutoff = true;
+			bind_data->cutoff = kv.second.GetValue<double>();
+		} else if (kv.first == "samples" || kv.first == "region" || kv.first == "variants") {
+			// Handled below
+		}
+	}
+
+	// --- Auto-discover companion files ---
+	if (bind_data->pvar_path.empty()) {
+		bind_data->pvar_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".pvar", ".bim"});
+		if (bind_data->pvar_path.empty()) {
+			throw InvalidInputException("plink_king: cannot find .pvar or .bim companion for '%s' "
+			                            "(use pvar := 'path' to specify explicitly)",
+			                            bind_data->pgen_path);
+		}
+	}
+
+	if (bind_data->psam_path.empty()) {
+		bind_data->psam_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".psam", ".fam"});
+		if (bind_data->psam_path.empty()) {
+			throw InvalidInputException("plink_king: cannot find .psam or .fam companion for '%s' "
+			                            "(use psam := 'path' to specify explicitly)",
+			                            bind_data->pgen_path);
+		}
+	}
+
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
+	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
+	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
+	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
+
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_king");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
+
+	// --- Load variant metadata ---
+	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_king");
+
+	if (bind_data->variants.variant_ct != bind_data->raw_variant_ct) {
+		throw InvalidInputException("plink_king: variant count mismatch: .pgen has %u variants, "
+		                            ".pvar/.bim '%s' has %llu variants",
+		                            bind_data->raw_variant_ct, bind_data->pvar_path,
+		                            static_cast<unsigned long long>(bind_data->variants.variant_ct));
+	}
+
+	// --- Load sample info ---
+	bind_data->sample_info = LoadSampleMetadata(context, bind_data->psam_path);
+
+	if (static_cast<uint32_t>(bind_data->sample_info.sample_ct) != bind_data->raw_sample_ct) {
+		throw InvalidInputException("plink_king: sample count mismatch: .pgen has %u samples, "
+		                            ".psam/.fam '%s' has %llu samples",
+		                            bind_data->raw_sample_ct, bind_data->psam_path,
+		                            static_cast<unsigned long long>(bind_data->sample_info.sample_ct));
+	}
+
+	// --- Process samples parameter ---
+	bind_data->effective_sample_ct = bind_data->raw_sample_ct;
+
+	auto samples_it = input.named_parameters.find("samples");
+	if (samples_it != input.named_parameters.end()) {
+		auto indices =
+		    ResolveSampleIndices(samples_it->second, bind_data->raw_sample_ct, &bind_data->sample_info, "plink_king");
+
+		bind_data->sample_subset = make_uniq<SampleSubset>(BuildSampleSubset(bind_data->raw_sample_ct, indices));
+		bind_data->has_sample_subset = true;
+		bind_data->effective_sample_ct = bind_data->sample_subset->subset_sample_ct;
+
+		auto sorted_indices = indices;
+		std::sort(sorted_indices.begin(), sorted_indices.end());
+		bind_data->sample_output_order = std::move(sorted_indices);
+	} else {
+		bind_data->sample_output_order.resize(bind_data->raw_sample_ct);
+		for (uint32_t i = 0; i < bind_data->raw_sample_ct; i++) {
+			bind_data->sample_output_order[i] = i;
+		}
+	}
+
+	if (bind_data->effective_sample_ct < 2) {
+		throw InvalidInputException("plink_king: need at least 2 samples (got %u)", bind_data->effective_sample_ct);
+	}
+
+	// --- Process region parameter ---
+	auto region_it = input.named_parameters.find("region");
+	if (region_it != input.named_parameters.end()) {
+		bind_data->variant_range = ParseRegion(region_it->second.GetValue<string>(), bind_data->variants, "plink_king");
+	}
+
+	// --- Process variants parameter (intersected with region) ---
+	uint32_t range_start = bind_data->variant_range.has_filter ? bind_data->variant_range.start_idx : 0;
+	uint32_t range_end =
+	    bind_data->variant_range.has_filter ? bind_data->variant_range.end_idx : bind_data->raw_variant_ct;
+
+	auto variants_it = input.named_parameters.find("variants");
+	if (variants_it != input.named_parameters.end()) {
+		auto indices =
+		    ResolveVariantsParameter(variants_it->second, bind_data->variants, bind_data->raw_variant_ct, "plink_king");
+		for (auto vidx : indices) {
+			if (vidx >= range_start && vidx < range_end) {
+				bind_data->king_variants.push_back(vidx);
+			}
+		}
+		std::sort(bind_data->king_variants.begin(), bind_data->king_variants.end());
+	} else {
+		bind_data->king_variants.reserve(range_end - range_start);
+		for (uint32_t vidx = range_start; vidx < range_end; vidx++) {
+			bind_data->king_variants.push_back(vidx);
+		}
+	}
+
+	if (bind_data->king_variants.empty()) {
+		throw InvalidInputException("plink_king: no variants selected from '%s'", bind_data->pgen_path);
+	}
+
+	// --- Register output schema ---
+	names = {"FID1", "IID1", "FID2", "IID2", "NSNP", "HETHET", "IBS0", "KINSHIP"};
+	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                LogicalType::INTEGER, LogicalType::DOUBLE,  LogicalType::DOUBLE,  LogicalType::DOUBLE};
+
+	return std::move(bind_data);
+}
+
+// ---------------------------------------------------------------------------
+// Init global
+// ---------------------------------------------------------------------------
+
+static unique_ptr<GlobalTableFunctionState> PlinkKingInitGlobal(ClientContext &context,
+                                                                TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PlinkKingBindData>();
+	auto state = make_uniq<PlinkKingGlobalState>();
+
+	state->column_ids = input.column_ids;
+	state->db_thread_count = static_cast<uint32_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
+	state->max_threads_config = GetPlinkingMaxThreads(context);
+
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	idx_t variant_ct = bind_data.king_variants.size();
+	idx_t word_ct = (variant_ct + KING_VARIANTS_PER_WORD - 1) / KING_VARIANTS_PER_WORD;
+	state->transpose_block_ct = static_cast<uint32_t>((word_ct + KING_TRANSPOSE_WORDS - 1) / KING_TRANSPOSE_WORDS);
+	state->plane_word_ct = state->transpose_block_ct * KING_TRANSPOSE_WORDS;
+
+	// Blocks fill every word they own, padding included, so no zeroing here. The
+	// planes hold every selected variant at once, so they are checked against (and
+	// counted in) memory_limit.
+	idx_t plane_bytes = static_cast<idx_t>(sample_ct) * 2 * state->plane_word_ct * sizeof(uintptr_t);
+	try {
+		state->planes.Allocate(context, plane_bytes);
+	} catch (OutOfMemoryException &) {
+		throw OutOfMemoryException("plink_king: the genotype bitplanes for %u samples x %llu variants need %s, more "
+		                           "than memory_limit has free. Select fewer variants with variants := (e.g. an "
+		                           "LD-pruned set from plink_prune) or region :=, or raise memory_limit.",
+		                           sample_ct, static_cast<unsigned long long>(variant_ct),
+		                           StringUtil::BytesToHumanReadableString(plane_bytes));
+	}
+
+	state->tile_ct = (sample_ct + KING_TILE - 1) / KING_TILE;
+	state->tile_pair_ct = state->tile_ct * (state->tile_ct + 1) / 2;
+
+	state->pgen_index = bind_data.pgen_index;
+
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Init local (per-thread PgenReader)
+// ---------------------------------------------------------------------------
+
+static unique_ptr<LocalTableFunctionState> PlinkKingInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                                                              GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<PlinkKingBindData>();
+	auto &gstate = global_state->Cast<PlinkKingGlobalState>();
+	auto state = make_uniq<PlinkKingLocalState>();
+
+	// --- Per-thread PgenReader on the query's shared index ---
+	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_king");
+
+	// Set up sample subsetting
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		plink2::PgrSetSampleSubsetIndex(bind_data.sample_subset->CumulativePopcounts(), &state->pgr, &state->pssi);
+	} else {
+		plink2::PgrClearSampleSubsetIndex(&state->pgr, &state->pssi);
+	}
+
+	// Allocate genotype decode buffer
+	uintptr_t genovec_word_ct = plink2::NypCtToAlignedWordCt(bind_data.raw_sample_ct);
+	state->genovec_buf.Allocate(genovec_word_ct * sizeof(uintptr_t));
+	std::memset(state->genovec_buf.ptr, 0, genovec_word_ct * sizeof(uintptr_t));
+
+	state->tile_counts.resize(static_cast<idx_t>(KING_TILE) * KING_TILE);
+
+	state->initialized = true;
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Phase 1: transpose genovecs into sample-major bitplanes
+// ---------------------------------------------------------------------------
+
+//! Decode the variants of transpose block `block` and write its words of every
+//! sample's lo / hi planes. Positions past the last variant are marked missing.
+static void TransposeKingBlock(const PlinkKingBindData &bind_data, PlinkKingGlobalState &gs, PlinkKingLocalState &ls,
+                               uint32_t block) {
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	const uintptr_t *sample_include = nullptr;
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		sample_include = bind_data.sample_subset->SampleInclude();
+	}
+
+	idx_t block_words = static_cast<idx_t>(sample_ct) * KING_TRANSPOSE_WORDS;
+	ls.block_lo.assign(block_words, ~uintptr_t(0));
+	ls.block_hi.assign(block_words, ~uintptr_t(0));
+
+	idx_t variant_ct = bind_data.king_variants.size();
+	idx_t first = static_cast<idx_t>(block) * KING_TRANSPOSE_WORDS * KING_VARIANTS_PER_WORD;
+	idx_t last = MinValue<idx_t>(first + KING_TRANSPOSE_WORDS * KING_VARIANTS_PER_WORD, variant_ct);
+	const uintptr_t *genovec = ls.genovec_buf.As<uintptr_t>();
+
+	for (idx_t v = first; v < last; v++) {
+		uint32_t vidx = bind_data.king_variants[v];
+		plink2::PglErr err =
+		    plink2::PgrGet(sample_include, ls.pssi, sample_ct, vidx, &ls.pgr, ls.genovec_buf.As<uintptr_t>());
+		if (err != plink2::kPglRetSuccess) {
+			throw IOException("plink_king: PgrGet failed for variant %u", vidx);
+		}
+
+		idx_t word = (v - first) / KING_VARIANTS_PER_WORD;
+		uint32_t bit = static_cast<uint32_t>((v - first) % KING_VARIANTS_PER_WORD);
+		uintptr_t clear = ~(uintptr_t(1) << bit);
+		for (uint32_t s = 0; s < sample_ct; s++) {
+			uintptr_t geno = (genovec[s / plink2::kBitsPerWordD2] >> (2 * (s % plink2::kBitsPerWordD2))) & 3;
+			idx_t pos = static_cast<idx_t>(s) * KING_TRANSPOSE_WORDS + word;
+			ls.block_lo[pos] = (ls.block_lo[pos] & clear) | ((geno & 1) << bit);
+			ls.block_hi[pos] = (ls.block_hi[pos] & clear) | ((geno >> 1) << bit);
+		}
+	}
+
+	uintptr_t *planes = gs.planes.As<uintptr_t>();
+	idx_t sample_stride = 2 * static_cast<idx_t>(gs.plane_word_ct);
+	idx_t word_start = static_cast<idx_t>(block) * KING_TRANSPOSE_WORDS;
+	for (uint32_t s = 0; s < sample_ct; s++) {
+		uintptr_t *lo = planes + s * sample_stride + word_start;
+		std::copy_n(ls.block_lo.data() + static_cast<idx_t>(s) * KING_TRANSPOSE_WORDS, KING_TRANSPOSE_WORDS, lo);
+		std::copy_n(ls.block_hi.data() + static_cast<idx_t>(s) * KING_TRANSPOSE_WORDS, KING_TRANSPOSE_WORDS,
+		            lo + gs.plane_word_ct);
+	}
+}
+
+//! Claim and transpose blocks until none are left, then wait for the blocks other
+//! threads are still filling.
+static void BuildKingPlanes(const PlinkKingBindData &bind_data, PlinkKingGlobalState &gs, PlinkKingLocalState &ls) {
+	while (true) {
+		uint32_t block = gs.next_transpose_block.fetch_add(1);
+		if (block >= gs.transpose_block_ct) {
+			break;
+		}
+		try {
+			TransposeKingBlock(bind_data, gs, ls, block);
+		} catch (...) {
+			gs.transpose_failed.store(true, std::memory_order_release);
+			throw;
+		}
+		gs.transposed_block_ct.fetch_add(1, std::memory_order_acq_rel);
+	}
+	while (gs.transposed_block_ct.load(std::memory_order_acquire) < gs.transpose_block_ct) {
+		if (gs.transpose_failed.load(std::memory_order_acquire)) {
+			throw IOException("plink_king: failed to read '%s'", bind_data.pgen_path);
+		}
+		std::this_thread::yield();
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Phase 2: pair tiles
+// ---------------------------------------------------------------------------
+
+//! Add the counts of one sample pair over `word_ct` plane words. With lo/hi the
+//! genotype bits, hom = ~lo, het = lo & ~hi and hom_alt = hi & ~lo; padding and
+//! missing calls (lo = hi = 1) are neither.
+static inline void KingPairWords(const uintptr_t *lo_a, const uintptr_t *hi_a, const uintptr_t *lo_b,
+                                 const uintptr_t *hi_b, uint32_t word_ct, KingCounts &counts) {
+	uint32_t hethet = 0;
+	uint32_t ibs0 = 0;
+	uint32_t het1_hom2 = 0;
+	uint32_t het2_hom1 = 0;
+	uint32_t homhom = 0;
+	for (uint32_t w = 0; w < word_ct; w++) {
+		uintptr_t het_a = lo_a[w] & ~hi_a[w];
+		uintptr_t het_b = lo_b[w] & ~hi_b[w];
+		uintptr_t hom_both = ~(lo_a[w] | lo_b[w]);
+		hethet += plink2::PopcountWord(het_a & het_b);
+		het1_hom2 += plink2::PopcountWord(het_a & ~lo_b[w]);
+		het2_hom1 += plink2::PopcountWord(het_b & ~lo_a[w]);
+		homhom += plink2::PopcountWord(hom_both);
+		ibs0 += plink2::PopcountWord(hom_both & (hi_a[w] ^ hi_b[w]));
+	}
+	counts.hethet += hethet;
+	counts.ibs0 += ibs0;
+	counts.het1_hom2 += het1_hom2;
+	counts.het2_hom1 += het2_hom1;
+	counts.homhom += homhom;
+}
+
+//! Compute tile pair `tile_pair` (row-major over the lower triangle of tiles) and
+//! keep its pairs that pass the cutoff in ls.pairs.
+static void ComputeKingTile(const PlinkKingBindData &bind_data, const PlinkKingGlobalState &gs,
+                            PlinkKingLocalState &ls, uint32_t tile_pair) {
+	// tile_pair = row * (row + 1) / 2 + col, col <= row
+	auto tile_row = static_cast<uint32_t>((std::sqrt(8.0 * tile_pair + 1.0) - 1.0) / 2.0);
+	while (static_cast<uint64_t>(tile_row) * (tile_row + 1) / 2 > tile_pair) {
+		tile_row--;
+	}
+	while (static_cast<uint64_t>(tile_row + 1) * (tile_row + 2) / 2 <= tile_pair) {
+		tile_row++;
+	}
+	uint32_t tile_col = tile_pair - tile_row * (tile_row + 1) / 2;
+
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	uint32_t row_start = tile_row * KING_TILE;
+	uint32_t row_end = MinValue(row_start + KING_TILE, sample_ct);
+	uint32_t col_start = tile_col * KING_TILE;
+	uint32_t col_end = MinValue(col_start + KING_TILE, sample_ct);
+	bool diagonal = tile_row == tile_col;
+
+	std::fill(ls.tile_counts.begin(), ls.tile_counts.end(), KingCounts());
+
+	const uintptr_t *planes = gs.planes.As<uintptr_t>();
+	idx_t sample_stride = 2 * static_cast<idx_t>(gs.plane_word_ct);
+	for (uint32_t chunk_start = 0; chunk_start < gs.plane_word_ct; chunk_start += KING_WORD_CHUNK) {
+		uint32_t chunk_ct = MinValue(KING_WORD_CHUNK, gs.plane_word_ct - chunk_start);
+		for (uint32_t i = row_start; i < row_end; i++) {
+			const uintptr_t *lo_i = planes + i * sample_stride + chunk_start;
+			const uintptr_t *hi_i = lo_i + gs.plane_word_ct;
+			uint32_t j_end = diagonal ? i : col_end;
+			KingCounts *row_counts = &ls.tile_counts[static_cast<idx_t>(i - row_start) * KING_TILE];
+			for (uint32_t j = col_start; j < j_end; j++) {
+				const uintptr_t *lo_j = planes + j * sample_stride + chunk_start;
+				KingPairWords(lo_j, lo_j + gs.plane_word_ct, lo_i, hi_i, chunk_ct, row_counts[j - col_start]);
+			}
+		}
+	}
+
+	// Cutoff pushdown: only pairs that will be emitted leave the tile
+	ls.pairs.clear();
+	ls.pair_pos = 0;
+	for (uint32_t i = row_start; i < row_end; i++) {
+		uint32_t j_end = diagonal ? i : col_end;
+		for (uint32_t j = col_start; j < j_end; j++) {
+			auto &counts = ls.tile_counts[static_cast<idx_t>(i - row_start) * KING_TILE + (j - col_start)];
+			if (bind_data.has_cutoff) {
+				double kinship;
+				if (!counts.Kinship(kinship) || kinship < bind_data.cutoff) {
+					continue;
+				}
+			}
+			ls.pairs.push_back({j, i, counts});
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Scan function
+// ---------------------------------------------------------------------------
+
+static void SetSampleId(Vector &vec, idx_t row, const PlinkKingBindData &bind_data, bool fid, uint32_t sidx) {
+	uint32_t orig_idx = bind_data.sample_output_order[sidx];
+	if (!fid) {
+		FlatVector::GetData<string_t>(vec)[row] = StringVector::AddString(vec, bind_data.sample_info.iids[orig_idx]);
+	} else if (!bind_data.sample_info.fids.empty()) {
+		FlatVector::GetData<string_t>(vec)[row] = StringVector::AddString(vec, bind_data.sample_info.fids[orig_idx]);
+	} else {
+		FlatVector::SetNull(vec, row, true);
+	}
+}
+
+static void PlinkKingScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<PlinkKingBindData>();
+	auto &gs = data_p.global_state->Cast<PlinkKingGlobalState>();
+	auto &ls = data_p.local_state->Cast<PlinkKingLocalState>();
+	auto &column_ids = gs.column_ids;
+
+	if (!ls.initialized) {
+		CompatSetOutputCardinality(output, 0);
+		return;
+	}
+
+	if (!ls.planes_ready) {
+		BuildKingPlanes(bind_data, gs, ls);
+		ls.planes_ready = true;
+	}
+
+	idx_t rows_emitted = 0;
+	while (rows_emitted < STANDARD_VECTOR_SIZE) {
+		// Claim tiles until one has pairs to emit
+		if (ls.pair_pos == ls.pairs.size()) {
+			if (rows_emitted > 0) {
+				break;
+			}
+			uint32_t tile_pair = gs.next_tile_pair.fetch_add(1);
+			if (tile_pair >= gs.tile_pair_ct) {
+				break;
+			}
+			ComputeKingTile(bind_data, gs, ls, tile_pair);
+			continue;
+		}
+
+		auto &pair = ls.pairs[ls.pair_pos++];
+		uint32_t nsnp = pair.counts.Nsnp();
+		double kinship = 0.0;
+		bool has_kinship = pair.counts.Kinship(kinship);
+
+		for (idx_t out_col = 0; out_col < column_ids.size(); out_col++) {
+			auto file_col = column_ids[out_col];
+			if (file_col == COLUMN_IDENTIFIER_ROW_ID) {
+				continue;
+			}
+
+			auto &vec = output.data[out_col];
+
+			switch (file_col) {
+			case COL_FID1:
+				SetSampleId(vec, rows_emitted, bind_data, true, pair.id1);
+				break;
+			case COL_IID1:
+				SetSampleId(vec, rows_emitted, bind_data, false, pair.id1);
+				break;
+			case COL_FID2:
+				SetSampleId(vec, rows_emitted, bind_data, true, pair.id2);
+				break;
+			case COL_IID2:
+				SetSampleId(vec, rows_emitted, bind_data, false, pair.id2);
+				break;
+			case COL_NSNP:
+				FlatVector::GetData<int32_t>(vec)[rows_emitted] = static_cast<int32_t>(nsnp);
+				break;
+			case COL_HETHET:
+			case COL_IBS0:
+				if (nsnp == 0) {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
+					uint32_t ct = file_col == COL_HETHET ? pair.counts.hethet : pair.counts.ibs0;
+					FlatVector::GetData<double>(vec)[rows_emitted] = static_cast<double>(ct) / nsnp;
+				}
+				break;
+			case COL_KINSHIP:
+				if (has_kinship) {
+					FlatVector::GetData<double>(vec)[rows_emitted] = kinship;
+				} else {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		rows_emitted++;
+	}
+	CompatSetOutputCardinality(output, rows_emitted);
+}
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+void RegisterPlinkKing(ExtensionLoader &loader) {
+	TableFunction plink_king("plink_king", {LogicalType::VARCHAR}, PlinkKingScan, PlinkKingBind, PlinkKingInitGlobal,
+	                         PlinkKingInitLocal);
+
+	plink_king.projection_pushdown = true;
+
+	plink_king.named_parameters["pvar"] = LogicalType::VARCHAR;
+	plink_king.named_parameters["psam"] = LogicalType::VARCHAR;
+	plink_king.named_parameters["samples"] = LogicalType::ANY;
+	plink_king.named_parameters["region"] = LogicalType::VARCHAR;
+	plink_king.named_parameters["variants"] = LogicalType::ANY;
+	plink_king.named_parameters["cutoff"] = LogicalType::DOUBLE;
+
+	loader.RegisterFunction(plink_king);
+}
+
+} // namespace duckdb
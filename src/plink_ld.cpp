@@ -6,17 +6,22 @@
 // entangled and pruning/console-oriented, so no per-pair r2/D' function is linkable. r2 here
 // is a genotype-level Pearson correlation (cov^2 / (varA*varB)) and D' uses the Weir-1979
 // composite estimator; these are numerically DIFFERENT from plink2's haplotype-based values.
-// Consequence, by design and noted at the D' computation below: D' can exceed 1.0 when the
+// Consequence, by design and noted at the D' computation (plink_ld_kernel.cpp): D' can exceed 1.0 when the
 // samples deviate from Hardy-Weinberg equilibrium. This is a conscious estimator choice, not
 // a bug. Cross-check against `plink2 --r2` before relying on exact-match semantics.
 
 #include "plink_ld.hpp"
 #include "duckdb_compat.hpp"
 #include "plink_common.hpp"
+#include "plink_ld_kernel.hpp"
 #include "pgen_vfs_opener.hpp"
 
+#include "duckdb/common/string_util.hpp"
+
 #include <atomic>
 #include <cmath>
+#include <cstring>
+#include <thread>
 
 namespace duckdb {
 
@@ -34,104 +39,27 @@ static constexpr idx_t COL_R2 = 6;
 static constexpr idx_t COL_D_PRIME = 7;
 static constexpr idx_t COL_OBS_CT = 8;
 
-// ---------------------------------------------------------------------------
-// LD computation
-// ---------------------------------------------------------------------------
-
-enum class LdMode : uint8_t { PAIRWISE, WINDOWED };
-
-struct LdResult {
-	double r2;
-	double d_prime;
-	uint32_t obs_ct;
-	bool is_valid; // false if monomorphic, < 2 obs, etc.
-};
-
-//! Compute LD statistics from two packed 2-bit genotype arrays.
-//! Genotype encoding: 0=hom_ref, 1=het, 2=hom_alt, 3=missing.
-static LdResult ComputeLdStats(const uintptr_t *genovec_a, const uintptr_t *genovec_b, uint32_t sample_ct) {
-	double sum_a = 0, sum_b = 0, sum_ab = 0, sum_a2 = 0, sum_b2 = 0;
-	uint32_t n = 0;
-
-	uint32_t word_ct = plink2::DivUp(sample_ct, plink2::kBitsPerWordD2);
-	for (uint32_t widx = 0; widx < word_ct; widx++) {
-		uintptr_t word_a = genovec_a[widx];
-		uintptr_t word_b = genovec_b[widx];
-
-		uint32_t samples_remaining = sample_ct - widx * plink2::kBitsPerWordD2;
-		uint32_t samples_in_word = std::min(samples_remaining, static_cast<uint32_t>(plink2::kBitsPerWordD2));
-
-		for (uint32_t sidx = 0; sidx < samples_in_word; sidx++) {
-			uint32_t geno_a = word_a & 3;
-			uint32_t geno_b = word_b & 3;
-			word_a >>= 2;
-			word_b >>= 2;
-
-			if (geno_a == 3 || geno_b == 3) {
-				continue;
-			}
-
-			double ga = static_cast<double>(geno_a);
-			double gb = static_cast<double>(geno_b);
-			sum_a += ga;
-			sum_b += gb;
-			sum_ab += ga * gb;
-			sum_a2 += ga * ga;
-			sum_b2 += gb * gb;
-			n++;
-		}
-	}
-
-	LdResult result;
-	result.obs_ct = n;
-	result.is_valid = false;
-	result.r2 = 0;
-	result.d_prime = 0;
-
-	if (n < 2) {
-		return result;
-	}
-
-	double dn = static_cast<double>(n);
-	double mean_a = sum_a / dn;
-	double mean_b = sum_b / dn;
-	double cov_ab = sum_ab / dn - mean_a * mean_b;
-	double var_a = sum_a2 / dn - mean_a * mean_a;
-	double var_b = sum_b2 / dn - mean_b * mean_b;
-
-	// Monomorphic variant — correlation undefined
-	if (var_a < 1e-15 || var_b < 1e-15) {
-		return result;
-	}
-
-	result.is_valid = true;
-	result.r2 = (cov_ab * cov_ab) / (var_a * var_b);
+// output := 'matrix': one row per locus variant
+static constexpr idx_t MCOL_CHROM = 0;
+static constexpr idx_t MCOL_POS = 1;
+static constexpr idx_t MCOL_ID = 2;
+static constexpr idx_t MCOL_IDX = 3;
+static constexpr idx_t MCOL_VALUES = 4;
 
-	// D' via composite LD estimator (Weir 1979):
-	//   D = cov(gA, gB) / 4
-	//   D' = D / D_max where D_max depends on sign of D
-	// Note: this estimator uses genotype-level (not haplotype-level) statistics,
-	// so D' can exceed 1.0 when samples deviate from Hardy-Weinberg equilibrium.
-	double D = cov_ab / 4.0;
-	double p_a = sum_a / (2.0 * dn);
-	double p_b = sum_b / (2.0 * dn);
+// output := 'triangle': CHROM_A..ID_B as above, then the statistic
+static constexpr idx_t TCOL_VALUE = 6;
 
-	double D_max;
-	if (D >= 0) {
-		D_max = std::min(p_a * (1.0 - p_b), (1.0 - p_a) * p_b);
-	} else {
-		D_max = std::max(-p_a * p_b, -(1.0 - p_a) * (1.0 - p_b));
-	}
+// ---------------------------------------------------------------------------
+// Mode
+// ---------------------------------------------------------------------------
 
-	if (std::abs(D_max) < 1e-15) {
-		result.d_prime = 0.0;
-	} else {
-		// D/D_max is always non-negative with this formula
-		result.d_prime = D / D_max;
-	}
+//! PAIRWISE / WINDOWED emit pair rows through the genotype-pair kernel (output := 'pairs').
+//! MATRIX / TRIANGLE standardize the locus into one block and compute r as a tiled
+//! matrix product: one ARRAY row per variant, or every upper-triangle pair.
+enum class LdMode : uint8_t { PAIRWISE, WINDOWED, MATRIX, TRIANGLE };
 
-	return result;
-}
+//! Statistic reported by the matrix modes.
+enum class LdStat : uint8_t { R2, R };
 
 // ---------------------------------------------------------------------------
 // Bind data
@@ -141,6 +69,7 @@ struct PlinkLdBindData : public TableFunctionData {
 	string pgen_path;
 	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
 	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
 	string pvar_path;
 	string psam_path;
 
@@ -170,6 +99,19 @@ struct PlinkLdBindData : public TableFunctionData {
 	int64_t window_bp = 1000000; // window_kb * 1000
 	double r2_threshold = 0.2;
 	bool inter_chr = false;
+
+	// Pair kernel (plinking_ld_kernel)
+	LdKernel ld_kernel = LdKernel::AUTO;
+
+	// Matrix modes: the locus is the region (or the whole file)
+	LdStat stat = LdStat::R2;
+	bool has_r2_threshold = false; // matrix modes filter only when r2_threshold is given
+	uint32_t locus_start = 0;
+	uint32_t locus_ct = 0;
+
+	bool IsMatrixMode() const {
+		return mode == LdMode::MATRIX || mode == LdMode::TRIANGLE;
+	}
 };
 
 // ---------------------------------------------------------------------------
@@ -184,14 +126,37 @@ struct PlinkLdGlobalState : public GlobalTableFunctionState {
 	// Pairwise mode
 	std::atomic<bool> pair_emitted {false};
 
-	// Windowed mode
+	// Matrix modes: standardized locus block, decoded lazily one LD_TILE row block
+	// at a time by whichever thread first needs it (block_state: 0 = pending,
+	// 1 = decoding, 2 = ready, 3 = failed). Rows past locus_ct are zero padding.
+	uint32_t block_ct = 0;
+	idx_t padded_ct = 0;     // block_ct * LD_TILE
+	TrackedBuffer std_geno; // padded_ct x effective_sample_ct doubles, row-major
+	vector<uint8_t> row_valid;
+	unique_ptr<std::atomic<uint8_t>[]> block_state;
+	vector<std::pair<uint32_t, uint32_t>> tiles; // TRIANGLE: upper-triangle (bi <= bj) tiles
+	std::atomic<uint32_t> next_unit {0};        // MATRIX: row block; TRIANGLE: tile
+
+	// Windowed mode: anchors are claimed in contiguous runs of `anchor_run` so a
+	// thread's consecutive anchors share (mostly) the same partner window
 	std::atomic<uint32_t> next_anchor_idx {0};
+	uint32_t anchor_run = 1;
+	uint32_t window_variant_ct = 0; // most partners any anchor has (sizes the window cache)
 	uint32_t max_threads_config = 0;
 
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
 	idx_t MaxThreads() const override {
 		if (mode == LdMode::PAIRWISE) {
 			return 1;
 		}
+		if (mode == LdMode::MATRIX) {
+			return ApplyMaxThreadsCap(MaxValue<idx_t>(block_ct, 1), max_threads_config);
+		}
+		if (mode == LdMode::TRIANGLE) {
+			return ApplyMaxThreadsCap(MaxValue<idx_t>(tiles.size(), 1), max_threads_config);
+		}
 		uint32_t range = end_variant_idx - start_variant_idx;
 		return ApplyMaxThreadsCap(range / 50 + 1, max_threads_config);
 	}
@@ -202,21 +167,35 @@ struct PlinkLdGlobalState : public GlobalTableFunctionState {
 // ---------------------------------------------------------------------------
 
 struct PlinkLdLocalState : public LocalTableFunctionState {
-	plink2::PgenFileInfo pgfi;
-	AlignedBuffer pgfi_alloc_buf;
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
 
 	plink2::PgenReader pgr;
 	AlignedBuffer pgr_alloc_buf;
 
 	plink2::PgrSampleSubsetIndex pssi;
 
-	AlignedBuffer genovec_a_buf; // anchor variant genotypes
-	AlignedBuffer genovec_b_buf; // partner variant genotypes
+	AlignedBuffer genovec_buf;      // PgrGet decode target
+	LdVariantGenotypes anchor_geno;  // anchor variant, in kernel form (uncached path)
+	LdVariantGenotypes partner_geno; // partner variant, in kernel form (uncached path)
+
+	// Windowed mode: decoded variants of the current window, keyed by vidx
+	LdWindowCache window_cache;
+
+	// Matrix modes
+	vector<int8_t> geno_bytes;
+	vector<double> tile_out; // MATRIX: LD_TILE x padded_ct strip; TRIANGLE: one tile
+	bool in_tile = false;    // TRIANGLE: tile_out holds tile `tile_idx`, resume at (tile_i, tile_j)
+	uint32_t tile_idx = 0;
+	uint32_t tile_i = 0;
+	uint32_t tile_j = 0;
 
 	// Windowed mode: state preservation across scan calls
 	bool in_window = false;
 	uint32_t anchor_idx = 0;
 	uint32_t next_j = 0;
+	const LdVariantGenotypes *anchor = nullptr; // anchor_geno or its window_cache slot
+	uint32_t run_next = 0;                      // next anchor of the claimed run
+	uint32_t run_end = 0;                       // past-the-end of the claimed run
 
 	bool initialized = false;
 
@@ -224,7 +203,6 @@ struct PlinkLdLocalState : public LocalTableFunctionState {
 		if (initialized) {
 			plink2::PglErr reterr = plink2::kPglRetSuccess;
 			plink2::CleanupPgr(&pgr, &reterr);
-			plink2::CleanupPgfi(&pgfi, &reterr);
 		}
 	}
 };
@@ -242,6 +220,8 @@ static unique_ptr<FunctionData> PlinkLdBind(ClientContext &context, TableFunctio
 
 	// --- Collect named parameters ---
 	string variant1_id, variant2_id;
+	string output_str = "pairs";
+	string stat_str;
 
 	for (auto &kv : input.named_parameters) {
 		if (kv.first == "pvar") {
@@ -260,18 +240,44 @@ static unique_ptr<FunctionData> PlinkLdBind(ClientContext &context, TableFunctio
 			bind_data->window_bp = kb * 1000;
 		} else if (kv.first == "r2_threshold") {
 			bind_data->r2_threshold = kv.second.GetValue<double>();
+			bind_data->has_r2_threshold = true;
 			if (bind_data->r2_threshold < 0.0 || bind_data->r2_threshold > 1.0) {
 				throw InvalidInputException("plink_ld: r2_threshold must be between 0.0 and 1.0");
 			}
 		} else if (kv.first == "inter_chr") {
 			bind_data->inter_chr = kv.second.GetValue<bool>();
+		} else if (kv.first == "output") {
+			output_str = StringUtil::Lower(kv.second.GetValue<string>());
+		} else if (kv.first == "stat") {
+			stat_str = StringUtil::Lower(kv.second.GetValue<string>());
 		} else if (kv.first == "samples" || kv.first == "region") {
 			// Handled after pgenlib init
 		}
 	}
 
+	bind_data->ld_kernel = ResolveLdKernel(context, "plink_ld");
+
 	// --- Determine mode ---
-	if (!variant1_id.empty() && !variant2_id.empty()) {
+	if (output_str == "matrix" || output_str == "triangle") {
+		if (!variant1_id.empty() || !variant2_id.empty()) {
+			throw InvalidInputException("plink_ld: variant1/variant2 cannot be combined with output := '%s' "
+			                            "(use region := to select the locus)",
+			                            output_str);
+		}
+		bind_data->mode = output_str == "matrix" ? LdMode::MATRIX : LdMode::TRIANGLE;
+		if (stat_str == "r") {
+			bind_data->stat = LdStat::R;
+		} else if (stat_str.empty() || stat_str == "r2") {
+			bind_data->stat = LdStat::R2;
+		} else {
+			throw InvalidInputException("plink_ld: invalid stat '%s' (expected 'r2' or 'r')", stat_str);
+		}
+	} else if (output_str != "pairs") {
+		throw InvalidInputException("plink_ld: invalid output '%s' (expected 'pairs', 'matrix', or 'triangle')",
+		                            output_str);
+	} else if (!stat_str.empty()) {
+		throw InvalidInputException("plink_ld: stat requires output := 'matrix' or 'triangle'");
+	} else if (!variant1_id.empty() && !variant2_id.empty()) {
 		bind_data->mode = LdMode::PAIRWISE;
 	} else if (!variant1_id.empty() || !variant2_id.empty()) {
 		throw InvalidInputException("plink_ld: both variant1 and variant2 must be specified for pairwise mode");
@@ -294,48 +300,14 @@ static unique_ptr<FunctionData> PlinkLdBind(ClientContext &context, TableFunctio
 		// .psam is optional for plink_ld — only needed if samples parameter uses VARCHAR IDs
 	}
 
-	// --- Initialize pgenlib (Phase 1) to get counts ---
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
 	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
 	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
 	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
 
-	plink2::PgenFileInfo pgfi;
-	plink2::PreinitPgfi(&pgfi);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err = plink2::PgfiInitPhase1(bind_data->pgen_path.c_str(), nullptr, UINT32_MAX, UINT32_MAX,
-	                                            &header_ctrl, &pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("plink_ld: failed to open '%s': %s", bind_data->pgen_path, errstr_buf);
-	}
-
-	bind_data->raw_variant_ct = pgfi.raw_variant_ct;
-	bind_data->raw_sample_ct = pgfi.raw_sample_ct;
-
-	// Phase 2
-	AlignedBuffer pgfi_alloc;
-	if (pgfi_alloc_cacheline_ct > 0) {
-		pgfi_alloc.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, pgfi.raw_variant_ct, &max_vrec_width, &pgfi,
-	                             pgfi_alloc.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-	plink2::CleanupPgfi(&pgfi, &cleanup_err);
-
-	if (err != plink2::kPglRetSuccess) {
-		throw IOException("plink_ld: failed to initialize '%s' (phase 2): %s", bind_data->pgen_path, errstr_buf);
-	}
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_ld");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
 
 	// --- Load variant metadata ---
 	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_ld");
@@ -397,7 +369,56 @@ static unique_ptr<FunctionData> PlinkLdBind(ClientContext &context, TableFunctio
 		bind_data->pairwise_vidx_b = it_b->second;
 	}
 
+	// --- Matrix modes: size the locus block ---
+	if (bind_data->IsMatrixMode()) {
+		if (bind_data->variant_range.has_filter) {
+			bind_data->locus_start = bind_data->variant_range.start_idx;
+			bind_data->locus_ct = bind_data->variant_range.end_idx - bind_data->variant_range.start_idx;
+		} else {
+			bind_data->locus_ct = bind_data->raw_variant_ct;
+		}
+		if (bind_data->locus_ct == 0) {
+			throw InvalidInputException("plink_ld: output := '%s' found no variants in the locus", output_str);
+		}
+		if (bind_data->mode == LdMode::MATRIX && bind_data->locus_ct > ArrayType::MAX_ARRAY_SIZE) {
+			throw InvalidInputException("plink_ld: output := 'matrix' returns one ARRAY of %u values per variant, "
+			                            "more than DuckDB's ARRAY limit of %u. Narrow the locus with region := "
+			                            "(e.g. region := '1:1000000-1500000'), or use output := 'triangle'.",
+			                            bind_data->locus_ct, static_cast<uint32_t>(ArrayType::MAX_ARRAY_SIZE));
+		}
+
+		uint64_t block_elements =
+		    static_cast<uint64_t>(bind_data->locus_ct) * static_cast<uint64_t>(bind_data->effective_sample_ct);
+		int64_t max_elements = 16LL * 1024 * 1024 * 1024; // default 16G
+		Value max_elements_val;
+		if (context.TryGetCurrentSetting("plinking_max_matrix_elements", max_elements_val)) {
+			max_elements = max_elements_val.GetValue<int64_t>();
+		}
+		if (block_elements > static_cast<uint64_t>(max_elements)) {
+			throw InvalidInputException("plink_ld: output := '%s' would standardize %llu genotype values "
+			                            "(%u variants x %u samples, limit: %lld). "
+			                            "Use region := or samples := to reduce, "
+			                            "or SET plinking_max_matrix_elements = <higher value>.",
+			                            output_str, static_cast<unsigned long long>(block_elements),
+			                            bind_data->locus_ct, bind_data->effective_sample_ct,
+			                            static_cast<long long>(max_elements));
+		}
+	}
+
 	// --- Register output columns ---
+	auto stat_name = bind_data->stat == LdStat::R ? "R" : "R2";
+	if (bind_data->mode == LdMode::MATRIX) {
+		names = {"CHROM", "POS", "ID", "IDX", stat_name};
+		return_types = {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::VARCHAR, LogicalType::INTEGER,
+		                LogicalType::ARRAY(LogicalType::DOUBLE, bind_data->locus_ct)};
+		return std::move(bind_data);
+	}
+	if (bind_data->mode == LdMode::TRIANGLE) {
+		names = {"CHROM_A", "POS_A", "ID_A", "CHROM_B", "POS_B", "ID_B", stat_name};
+		return_types = {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::VARCHAR, LogicalType::VARCHAR,
+		                LogicalType::INTEGER, LogicalType::VARCHAR, LogicalType::DOUBLE};
+		return std::move(bind_data);
+	}
 	names = {"CHROM_A", "POS_A", "ID_A", "CHROM_B", "POS_B", "ID_B", "R2", "D_PRIME", "OBS_CT"};
 	return_types = {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::VARCHAR,
 	                LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::VARCHAR,
@@ -410,6 +431,20 @@ static unique_ptr<FunctionData> PlinkLdBind(ClientContext &context, TableFunctio
 // Init global
 // ---------------------------------------------------------------------------
 
+static constexpr uint32_t MAX_ANCHOR_RUN = 4096;
+
+//! Most partners any anchor in [start, end) has (sizes the window cache). inter_chr
+//! windows extend to the end of the range.
+static uint32_t MaxWindowVariantCount(const PlinkLdBindData &bind_data, uint32_t start, uint32_t end) {
+	if (start >= end) {
+		return 0;
+	}
+	if (bind_data.inter_chr) {
+		return end - start - 1;
+	}
+	return LdMaxWindowVariantCount(bind_data.variants, start, end, bind_data.window_bp);
+}
+
 static unique_ptr<GlobalTableFunctionState> PlinkLdInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
 	auto &bind_data = input.bind_data->Cast<PlinkLdBindData>();
 	auto state = make_uniq<PlinkLdGlobalState>();
@@ -425,10 +460,49 @@ static unique_ptr<GlobalTableFunctionState> PlinkLdInitGlobal(ClientContext &con
 		state->end_variant_idx = bind_data.raw_variant_ct;
 	}
 
+	if (bind_data.IsMatrixMode()) {
+		state->block_ct = static_cast<uint32_t>(plink2::DivUp(bind_data.locus_ct, LD_TILE));
+		state->padded_ct = static_cast<idx_t>(state->block_ct) * LD_TILE;
+		// Rows past locus_ct stay zero: they pad the last tile
+		idx_t block_bytes = state->padded_ct * bind_data.effective_sample_ct * sizeof(double);
+		try {
+			state->std_geno.Allocate(context, block_bytes);
+		} catch (OutOfMemoryException &) {
+			throw OutOfMemoryException("plink_ld: output := '%s' standardizes %u variants x %u samples into %s, "
+			                           "more than memory_limit has free. Narrow the locus with region :=, select "
+			                           "fewer samples with samples :=, or raise memory_limit.",
+			                           state->mode == LdMode::MATRIX ? "matrix" : "triangle",
+			                           bind_data.locus_ct, bind_data.effective_sample_ct,
+			                           StringUtil::BytesToHumanReadableString(block_bytes));
+		}
+		std::memset(state->std_geno.ptr, 0, block_bytes);
+		state->row_valid.assign(state->padded_ct, 0);
+		state->block_state = unique_ptr<std::atomic<uint8_t>[]>(new std::atomic<uint8_t>[state->block_ct]);
+		for (uint32_t b = 0; b < state->block_ct; b++) {
+			state->block_state[b].store(0);
+		}
+		if (state->mode == LdMode::TRIANGLE) {
+			for (uint32_t bi = 0; bi < state->block_ct; bi++) {
+				for (uint32_t bj = bi; bj < state->block_ct; bj++) {
+					state->tiles.emplace_back(bi, bj);
+				}
+			}
+		}
+	}
+
 	if (state->mode == LdMode::WINDOWED) {
 		state->next_anchor_idx.store(state->start_variant_idx);
+		state->window_variant_ct = MaxWindowVariantCount(bind_data, state->start_variant_idx, state->end_variant_idx);
+
+		// A run re-decodes its first window cold, so longer runs amortize better; keep
+		// ~4 runs per thread for load balance near the end of the scan.
+		uint32_t range = state->end_variant_idx - state->start_variant_idx;
+		idx_t runs = MaxValue<idx_t>(state->MaxThreads() * 4, 1);
+		state->anchor_run = static_cast<uint32_t>(MaxValue<idx_t>(MinValue<idx_t>(range / runs, MAX_ANCHOR_RUN), 1));
 	}
 
+	state->pgen_index = bind_data.pgen_index;
+
 	return std::move(state);
 }
 
@@ -439,57 +513,13 @@ static unique_ptr<GlobalTableFunctionState> PlinkLdInitGlobal(ClientContext &con
 static unique_ptr<LocalTableFunctionState> PlinkLdInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
                                                             GlobalTableFunctionState *global_state) {
 	auto &bind_data = input.bind_data->Cast<PlinkLdBindData>();
+	auto &gstate = global_state->Cast<PlinkLdGlobalState>();
 	auto state = make_uniq<PlinkLdLocalState>();
 
-	// --- Initialize per-thread PgenFileInfo + PgenReader ---
+	// --- Per-thread PgenReader on the query's shared index ---
 	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
-	plink2::PreinitPgfi(&state->pgfi);
-	plink2::PreinitPgr(&state->pgr);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err =
-	    plink2::PgfiInitPhase1(bind_data.pgen_path.c_str(), nullptr, bind_data.raw_variant_ct, bind_data.raw_sample_ct,
-	                           &header_ctrl, &state->pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_ld: thread init failed (phase 1): %s", errstr_buf);
-	}
-
-	if (pgfi_alloc_cacheline_ct > 0) {
-		state->pgfi_alloc_buf.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, state->pgfi.raw_variant_ct, &max_vrec_width, &state->pgfi,
-	                             state->pgfi_alloc_buf.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_ld: thread init failed (phase 2): %s", errstr_buf);
-	}
-
-	if (pgr_alloc_cacheline_ct > 0) {
-		state->pgr_alloc_buf.Allocate(pgr_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	err = plink2::PgrInit(bind_data.pgen_path.c_str(), max_vrec_width, &state->pgfi, &state->pgr,
-	                      state->pgr_alloc_buf.As<unsigned char>());
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgr(&state->pgr, &cleanup_err);
-		cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_ld: PgrInit failed for '%s'", bind_data.pgen_path);
-	}
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_ld");
 
 	// Set up sample subsetting
 	if (bind_data.has_sample_subset && bind_data.sample_subset) {
@@ -498,13 +528,27 @@ static unique_ptr<LocalTableFunctionState> PlinkLdInitLocal(ExecutionContext &co
 		plink2::PgrClearSampleSubsetIndex(&state->pgr, &state->pssi);
 	}
 
-	// Allocate two genovec buffers (anchor + partner)
+	// Decode buffer + anchor/partner genotypes in the kernel's layout
 	uintptr_t genovec_word_ct = plink2::NypCtToAlignedWordCt(bind_data.effective_sample_ct);
 	uintptr_t genovec_bytes = genovec_word_ct * sizeof(uintptr_t);
-	state->genovec_a_buf.Allocate(genovec_bytes);
-	state->genovec_b_buf.Allocate(genovec_bytes);
-	std::memset(state->genovec_a_buf.ptr, 0, genovec_bytes);
-	std::memset(state->genovec_b_buf.ptr, 0, genovec_bytes);
+	state->genovec_buf.Allocate(genovec_bytes);
+	std::memset(state->genovec_buf.ptr, 0, genovec_bytes);
+	state->anchor_geno.Allocate(bind_data.effective_sample_ct, bind_data.ld_kernel);
+	state->partner_geno.Allocate(bind_data.effective_sample_ct, bind_data.ld_kernel);
+
+	if (bind_data.IsMatrixMode()) {
+		state->geno_bytes.resize(bind_data.effective_sample_ct);
+		idx_t tile_cols = bind_data.mode == LdMode::MATRIX ? gstate.padded_ct : LD_TILE;
+		state->tile_out.resize(LD_TILE * tile_cols);
+	}
+
+	// Window cache: anchor + every partner of its window, within the per-thread budget
+	if (bind_data.mode == LdMode::WINDOWED) {
+		uint32_t useful = gstate.window_variant_ct + 1;
+		uint32_t slot_ct = LdWindowCache::SlotCountForBudget(GetLdWindowCacheBytes(context.client),
+		                                                     bind_data.effective_sample_ct, bind_data.ld_kernel, useful);
+		state->window_cache.Init(slot_ct, bind_data.effective_sample_ct, bind_data.ld_kernel);
+	}
 
 	state->initialized = true;
 	return std::move(state);
@@ -514,8 +558,9 @@ static unique_ptr<LocalTableFunctionState> PlinkLdInitLocal(ExecutionContext &co
 // Helpers: emit an output row and read genotypes
 // ---------------------------------------------------------------------------
 
-static void EmitRow(DataChunk &output, idx_t row_idx, const PlinkLdBindData &bind_data, uint32_t vidx_a,
-                    uint32_t vidx_b, const LdResult &result) {
+//! CHROM_A, POS_A, ID_A, CHROM_B, POS_B, ID_B for a pair row (pairs and triangle output).
+static void EmitPairVariants(DataChunk &output, idx_t row_idx, const PlinkLdBindData &bind_data, uint32_t vidx_a,
+                             uint32_t vidx_b) {
 	auto &variants = bind_data.variants;
 
 	// CHROM_A
@@ -549,6 +594,11 @@ static void EmitRow(DataChunk &output, idx_t row_idx, const PlinkLdBindData &bin
 		FlatVector::GetData<string_t>(output.data[COL_ID_B])[row_idx] =
 		    StringVector::AddString(output.data[COL_ID_B], id_b);
 	}
+}
+
+static void EmitRow(DataChunk &output, idx_t row_idx, const PlinkLdBindData &bind_data, uint32_t vidx_a,
+                    uint32_t vidx_b, const LdResult &result) {
+	EmitPairVariants(output, row_idx, bind_data, vidx_a, vidx_b);
 
 	// R2, D_PRIME, OBS_CT
 	if (result.is_valid) {
@@ -561,19 +611,227 @@ static void EmitRow(DataChunk &output, idx_t row_idx, const PlinkLdBindData &bin
 	FlatVector::GetData<int32_t>(output.data[COL_OBS_CT])[row_idx] = static_cast<int32_t>(result.obs_ct);
 }
 
-static void ReadGenovec(PlinkLdLocalState &lstate, const PlinkLdBindData &bind_data, uint32_t vidx,
-                        uintptr_t *genovec_out) {
+//! Decode variant `vidx` into lstate.genovec_buf.
+static const uintptr_t *DecodeGenovec(PlinkLdLocalState &lstate, const PlinkLdBindData &bind_data, uint32_t vidx) {
 	const uintptr_t *sample_include = nullptr;
 	if (bind_data.has_sample_subset && bind_data.sample_subset) {
 		sample_include = bind_data.sample_subset->SampleInclude();
 	}
 
+	auto *genovec = lstate.genovec_buf.As<uintptr_t>();
 	plink2::PglErr err =
-	    plink2::PgrGet(sample_include, lstate.pssi, bind_data.effective_sample_ct, vidx, &lstate.pgr, genovec_out);
+	    plink2::PgrGet(sample_include, lstate.pssi, bind_data.effective_sample_ct, vidx, &lstate.pgr, genovec);
 
 	if (err != plink2::kPglRetSuccess) {
 		throw IOException("plink_ld: PgrGet failed for variant %u", vidx);
 	}
+	return genovec;
+}
+
+//! Decode variant `vidx` and load it into `out` in the kernel's layout.
+static void ReadVariant(PlinkLdLocalState &lstate, const PlinkLdBindData &bind_data, uint32_t vidx,
+                        LdVariantGenotypes &out) {
+	out.Assign(DecodeGenovec(lstate, bind_data, vidx));
+}
+
+//! Windowed mode: variant `vidx` in kernel form, served from the window cache when
+//! it is within `SlotCount()` of the current anchor (so it cannot evict the anchor's
+//! slot), else decoded into `scratch`.
+static const LdVariantGenotypes &FetchVariant(PlinkLdLocalState &lstate, const PlinkLdBindData &bind_data,
+                                              uint32_t vidx, LdVariantGenotypes &scratch) {
+	auto &cache = lstate.window_cache;
+	if (cache.Enabled() && vidx - lstate.anchor_idx < cache.SlotCount()) {
+		LdVariantGenotypes *slot;
+		if (!cache.Lookup(vidx, slot)) {
+			ReadVariant(lstate, bind_data, vidx, *slot);
+		}
+		return *slot;
+	}
+	ReadVariant(lstate, bind_data, vidx, scratch);
+	return scratch;
+}
+
+// ---------------------------------------------------------------------------
+// Matrix modes
+// ---------------------------------------------------------------------------
+
+//! Make sure row block `b` of the standardized locus is decoded. The first thread to
+//! need it decodes it; others wait for that (running, never-blocking) thread.
+static void EnsureLdBlock(PlinkLdGlobalState &gstate, PlinkLdLocalState &lstate, const PlinkLdBindData &bind_data,
+                          uint32_t b) {
+	auto &state = gstate.block_state[b];
+	uint8_t expected = 0;
+	if (state.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)) {
+		try {
+			uint32_t sample_ct = bind_data.effective_sample_ct;
+			uint32_t row_end = MinValue((b + 1) * LD_TILE, bind_data.locus_ct);
+			for (uint32_t r = b * LD_TILE; r < row_end; r++) {
+				auto *genovec = DecodeGenovec(lstate, bind_data, bind_data.locus_start + r);
+				plink2::GenoarrToBytesMinus9(genovec, sample_ct, lstate.geno_bytes.data());
+				double *row = gstate.std_geno.As<double>() + static_cast<idx_t>(r) * sample_ct;
+				gstate.row_valid[r] = StandardizeLdRow(lstate.geno_bytes.data(), sample_ct, row) ? 1 : 0;
+			}
+		} catch (...) {
+			state.store(3, std::memory_order_release);
+			throw;
+		}
+		state.store(2, std::memory_order_release);
+		return;
+	}
+	while (true) {
+		auto s = state.load(std::memory_order_acquire);
+		if (s == 2) {
+			return;
+		}
+		if (s == 3) {
+			throw IOException("plink_ld: failed to decode variant block %u", b);
+		}
+		std::this_thread::yield();
+	}
+}
+
+//! Reported value for locus rows r, c from their dot product; false → NULL.
+static bool LdMatrixValue(const PlinkLdBindData &bind_data, const PlinkLdGlobalState &gstate, idx_t r, idx_t c,
+                          double dot, double &value) {
+	if (!gstate.row_valid[r] || !gstate.row_valid[c]) {
+		return false;
+	}
+	double rho = r == c ? 1.0 : MaxValue(-1.0, MinValue(1.0, dot));
+	value = bind_data.stat == LdStat::R ? rho : rho * rho;
+	return true;
+}
+
+static const double *LdBlockRows(const PlinkLdGlobalState &gstate, const PlinkLdBindData &bind_data, uint32_t b) {
+	return gstate.std_geno.As<double>() + static_cast<idx_t>(b) * LD_TILE * bind_data.effective_sample_ct;
+}
+
+//! output := 'matrix': claim one LD_TILE row block, compute its full strip of the
+//! r matrix and emit one row per variant.
+static void LdMatrixScan(const PlinkLdBindData &bind_data, PlinkLdGlobalState &gstate, PlinkLdLocalState &lstate,
+                         DataChunk &output) {
+	uint32_t bi = gstate.next_unit.fetch_add(1);
+	if (bi >= gstate.block_ct) {
+		CompatSetOutputCardinality(output, 0);
+		return;
+	}
+
+	idx_t sample_ct = bind_data.effective_sample_ct;
+	idx_t padded_ct = gstate.padded_ct;
+	EnsureLdBlock(gstate, lstate, bind_data, bi);
+	for (uint32_t bj = 0; bj < gstate.block_ct; bj++) {
+		EnsureLdBlock(gstate, lstate, bind_data, bj);
+		LdDotTile(LdBlockRows(gstate, bind_data, bi), LdBlockRows(gstate, bind_data, bj), sample_ct, sample_ct,
+		          &lstate.tile_out[static_cast<idx_t>(bj) * LD_TILE], padded_ct);
+	}
+
+	auto &variants = bind_data.variants;
+	auto &values_vec = output.data[MCOL_VALUES];
+	auto &child = ArrayVector::GetEntry(values_vec);
+	auto *child_data = FlatVector::GetData<double>(child);
+	auto &child_validity = FlatVector::Validity(child);
+	idx_t locus_ct = bind_data.locus_ct;
+
+	idx_t row_end = MinValue<idx_t>((static_cast<idx_t>(bi) + 1) * LD_TILE, locus_ct);
+	idx_t rows_emitted = 0;
+	for (idx_t r = static_cast<idx_t>(bi) * LD_TILE; r < row_end; r++) {
+		auto vidx = static_cast<uint32_t>(bind_data.locus_start + r);
+		FlatVector::GetData<string_t>(output.data[MCOL_CHROM])[rows_emitted] =
+		    StringVector::AddString(output.data[MCOL_CHROM], variants.GetChrom(vidx));
+		FlatVector::GetData<int32_t>(output.data[MCOL_POS])[rows_emitted] = variants.GetPos(vidx);
+		auto &id = variants.GetId(vidx);
+		if (id.empty()) {
+			FlatVector::SetNull(output.data[MCOL_ID], rows_emitted, true);
+		} else {
+			FlatVector::GetData<string_t>(output.data[MCOL_ID])[rows_emitted] =
+			    StringVector::AddString(output.data[MCOL_ID], id);
+		}
+		FlatVector::GetData<int32_t>(output.data[MCOL_IDX])[rows_emitted] = static_cast<int32_t>(r + 1);
+
+		const double *strip_row = &lstate.tile_out[(r - static_cast<idx_t>(bi) * LD_TILE) * padded_ct];
+		idx_t base = rows_emitted * locus_ct;
+		for (idx_t c = 0; c < locus_ct; c++) {
+			double value;
+			if (LdMatrixValue(bind_data, gstate, r, c, strip_row[c], value)) {
+				child_data[base + c] = value;
+			} else {
+				child_data[base + c] = 0.0;
+				child_validity.SetInvalid(base + c);
+			}
+		}
+		rows_emitted++;
+	}
+	CompatSetOutputCardinality(output, rows_emitted);
+}
+
+//! output := 'triangle': claim upper-triangle tiles and emit their i < j pairs,
+//! resuming mid-tile when the chunk fills.
+static void LdTriangleScan(const PlinkLdBindData &bind_data, PlinkLdGlobalState &gstate, PlinkLdLocalState &lstate,
+                           DataChunk &output) {
+	idx_t sample_ct = bind_data.effective_sample_ct;
+	idx_t locus_ct = bind_data.locus_ct;
+	auto *value_data = FlatVector::GetData<double>(output.data[TCOL_VALUE]);
+	idx_t rows_emitted = 0;
+
+	while (rows_emitted < STANDARD_VECTOR_SIZE) {
+		if (!lstate.in_tile) {
+			uint32_t t = gstate.next_unit.fetch_add(1);
+			if (t >= gstate.tiles.size()) {
+				break;
+			}
+			uint32_t bi = gstate.tiles[t].first;
+			uint32_t bj = gstate.tiles[t].second;
+			EnsureLdBlock(gstate, lstate, bind_data, bi);
+			EnsureLdBlock(gstate, lstate, bind_data, bj);
+			LdDotTile(LdBlockRows(gstate, bind_data, bi), LdBlockRows(gstate, bind_data, bj), sample_ct, sample_ct,
+			          lstate.tile_out.data(), LD_TILE);
+			lstate.in_tile = true;
+			lstate.tile_idx = t;
+			lstate.tile_i = 0;
+			lstate.tile_j = bi == bj ? 1 : 0;
+		}
+
+		uint32_t bi = gstate.tiles[lstate.tile_idx].first;
+		uint32_t bj = gstate.tiles[lstate.tile_idx].second;
+		uint32_t i = lstate.tile_i;
+		uint32_t j = lstate.tile_j;
+		while (i < LD_TILE && rows_emitted < STANDARD_VECTOR_SIZE) {
+			idx_t r = static_cast<idx_t>(bi) * LD_TILE + i;
+			idx_t c = static_cast<idx_t>(bj) * LD_TILE + j;
+			if (r >= locus_ct) {
+				i = LD_TILE;
+				break;
+			}
+			if (j >= LD_TILE || c >= locus_ct) {
+				i++;
+				j = bi == bj ? i + 1 : 0;
+				continue;
+			}
+
+			double value = 0.0;
+			bool valid = LdMatrixValue(bind_data, gstate, r, c, lstate.tile_out[i * LD_TILE + j], value);
+			j++;
+			if (bind_data.has_r2_threshold) {
+				double r2 = bind_data.stat == LdStat::R ? value * value : value;
+				if (!valid || r2 < bind_data.r2_threshold) {
+					continue;
+				}
+			}
+			EmitPairVariants(output, rows_emitted, bind_data, static_cast<uint32_t>(bind_data.locus_start + r),
+			                 static_cast<uint32_t>(bind_data.locus_start + c));
+			if (valid) {
+				value_data[rows_emitted] = value;
+			} else {
+				FlatVector::SetNull(output.data[TCOL_VALUE], rows_emitted, true);
+			}
+			rows_emitted++;
+		}
+		lstate.tile_i = i;
+		lstate.tile_j = j;
+		if (i >= LD_TILE) {
+			lstate.in_tile = false;
+		}
+	}
+	CompatSetOutputCardinality(output, rows_emitted);
 }
 
 // ---------------------------------------------------------------------------
@@ -590,9 +848,17 @@ static void PlinkLdScan(ClientContext &context, TableFunctionInput &data_p, Data
 		return;
 	}
 
-	uint32_t sample_ct = bind_data.effective_sample_ct;
-	auto *genovec_a = lstate.genovec_a_buf.As<uintptr_t>();
-	auto *genovec_b = lstate.genovec_b_buf.As<uintptr_t>();
+	if (gstate.mode == LdMode::MATRIX) {
+		LdMatrixScan(bind_data, gstate, lstate, output);
+		return;
+	}
+	if (gstate.mode == LdMode::TRIANGLE) {
+		LdTriangleScan(bind_data, gstate, lstate, output);
+		return;
+	}
+
+	auto &anchor_geno = lstate.anchor_geno;
+	auto &partner_geno = lstate.partner_geno;
 
 	idx_t rows_emitted = 0;
 
@@ -606,14 +872,14 @@ static void PlinkLdScan(ClientContext &context, TableFunctionInput &data_p, Data
 		uint32_t vidx_a = bind_data.pairwise_vidx_a;
 		uint32_t vidx_b = bind_data.pairwise_vidx_b;
 
-		ReadGenovec(lstate, bind_data, vidx_a, genovec_a);
+		ReadVariant(lstate, bind_data, vidx_a, anchor_geno);
 		if (vidx_a == vidx_b) {
 			// Self-LD: use same buffer for both
-			auto result = ComputeLdStats(genovec_a, genovec_a, sample_ct);
+			auto result = ComputeLdStats(anchor_geno, anchor_geno);
 			EmitRow(output, 0, bind_data, vidx_a, vidx_b, result);
 		} else {
-			ReadGenovec(lstate, bind_data, vidx_b, genovec_b);
-			auto result = ComputeLdStats(genovec_a, genovec_b, sample_ct);
+			ReadVariant(lstate, bind_data, vidx_b, partner_geno);
+			auto result = ComputeLdStats(anchor_geno, partner_geno);
 			EmitRow(output, 0, bind_data, vidx_a, vidx_b, result);
 		}
 		CompatSetOutputCardinality(output, 1);
@@ -664,8 +930,8 @@ static void PlinkLdScan(ClientContext &context, TableFunctionInput &data_p, Data
 					// Inter-chr: no distance filter
 				}
 
-				ReadGenovec(lstate, bind_data, j, genovec_b);
-				auto result = ComputeLdStats(genovec_a, genovec_b, sample_ct);
+				auto &partner = FetchVariant(lstate, bind_data, j, partner_geno);
+				auto result = ComputeLdStats(*lstate.anchor, partner);
 
 				if (result.is_valid && result.r2 >= bind_data.r2_threshold) {
 					EmitRow(output, rows_emitted, bind_data, ai, j, result);
@@ -673,7 +939,7 @@ static void PlinkLdScan(ClientContext &context, TableFunctionInput &data_p, Data
 
 					if (rows_emitted >= STANDARD_VECTOR_SIZE) {
 						lstate.next_j = j + 1;
-						// genovec_a still has anchor data
+						// lstate.anchor still holds the anchor's genotypes
 						goto done;
 					}
 				}
@@ -685,16 +951,21 @@ static void PlinkLdScan(ClientContext &context, TableFunctionInput &data_p, Data
 			lstate.in_window = false;
 		}
 
-		// Claim a new anchor variant
-		uint32_t anchor_idx = gstate.next_anchor_idx.fetch_add(1);
-		if (anchor_idx >= end_idx) {
-			break;
+		// Next anchor: continue the claimed run, else claim a new one
+		if (lstate.run_next >= lstate.run_end) {
+			uint32_t run_start = gstate.next_anchor_idx.fetch_add(gstate.anchor_run);
+			if (run_start >= end_idx) {
+				break;
+			}
+			lstate.run_next = run_start;
+			lstate.run_end = MinValue(run_start + gstate.anchor_run, end_idx);
 		}
+		uint32_t anchor_idx = lstate.run_next++;
 
-		// Load anchor genotypes
-		ReadGenovec(lstate, bind_data, anchor_idx, genovec_a);
-
+		// Load anchor genotypes (usually a cache hit: it was the previous anchor's partner)
 		lstate.anchor_idx = anchor_idx;
+		lstate.anchor = &FetchVariant(lstate, bind_data, anchor_idx, anchor_geno);
+
 		lstate.next_j = anchor_idx + 1;
 		lstate.in_window = true;
 		anchor_chrom = variants.GetChrom(anchor_idx);
@@ -723,6 +994,8 @@ void RegisterPlinkLd(ExtensionLoader &loader) {
 	plink_ld.named_parameters["region"] = LogicalType::VARCHAR;
 	plink_ld.named_parameters["samples"] = LogicalType::ANY;
 	plink_ld.named_parameters["inter_chr"] = LogicalType::BOOLEAN;
+	plink_ld.named_parameters["output"] = LogicalType::VARCHAR;
+	plink_ld.named_parameters["stat"] = LogicalType::VARCHAR;
 
 	loader.RegisterFunction(plink_ld);
 }
@@ -0,0 +1,631 @@
+// plink_ld_kernel.cpp — word-parallel genotype-pair LD kernel.
+//
+// The reference kernel walks every sample two bits at a time and does five
+// double multiply-adds per sample. The popcount kernel instead splits each genovec
+// once into three 1-bit planes and gathers the same sums from AND + popcount:
+//
+//   g ∈ {0,1,2} with alt = [g ≥ 1], hom = [g = 2]  →  g = alt + hom,  g² = alt + 3·hom
+//   Σ gA·gB = pc(altA&altB) + pc(altA&homB) + pc(homA&altB) + pc(homA&homB)
+//
+// with the marginal sums restricted to the partner's non-missing plane. Every sum is
+// an exact integer, so r²/D'/OBS_CT match the reference kernel bit-for-bit (both
+// finish through FinishLdStats). The popcount loops have portable, AVX2 (nibble-LUT
+// popcount) and AVX-512 VPOPCNTDQ variants, chosen once at runtime from the CPU.
+
+#include "plink_ld_kernel.hpp"
+
+#include "duckdb/common/string_util.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PLINKING_LD_X86_DISPATCH 1
+#include <immintrin.h>
+#if defined(__clang__) || __GNUC__ >= 8
+#define PLINKING_LD_HAVE_AVX512 1
+#endif
+#endif
+
+namespace duckdb {
+
+static_assert(sizeof(uintptr_t) == 8, "LD bitplanes assume 64-bit words");
+
+// ---------------------------------------------------------------------------
+// Shared finish
+// ---------------------------------------------------------------------------
+
+LdResult FinishLdStats(uint32_t n, double sum_a, double sum_b, double sum_ab, double sum_a2, double sum_b2) {
+	LdResult result;
+	result.obs_ct = n;
+	result.is_valid = false;
+	result.r2 = 0;
+	result.d_prime = 0;
+
+	if (n < 2) {
+		return result;
+	}
+
+	double dn = static_cast<double>(n);
+	double mean_a = sum_a / dn;
+	double mean_b = sum_b / dn;
+	double cov_ab = sum_ab / dn - mean_a * mean_b;
+	double var_a = sum_a2 / dn - mean_a * mean_a;
+	double var_b = sum_b2 / dn - mean_b * mean_b;
+
+	// Monomorphic variant — correlation undefined
+	if (var_a < 1e-15 || var_b < 1e-15) {
+		return result;
+	}
+
+	result.is_valid = true;
+	result.r2 = (cov_ab * cov_ab) / (var_a * var_b);
+
+	// D' via composite LD estimator (Weir 1979):
+	//   D = cov(gA, gB) / 4
+	//   D' = D / D_max where D_max depends on sign of D
+	// Note: this estimator uses genotype-level (not haplotype-level) statistics,
+	// so D' can exceed 1.0 when samples deviate from Hardy-Weinberg equilibrium.
+	double D = cov_ab / 4.0;
+	double p_a = sum_a / (2.0 * dn);
+	double p_b = sum_b / (2.0 * dn);
+
+	double D_max;
+	if (D >= 0) {
+		D_max = std::min(p_a * (1.0 - p_b), (1.0 - p_a) * p_b);
+	} else {
+		D_max = std::max(-p_a * p_b, -(1.0 - p_a) * (1.0 - p_b));
+	}
+
+	if (std::abs(D_max) < 1e-15) {
+		result.d_prime = 0.0;
+	} else {
+		// D/D_max is always non-negative with this formula
+		result.d_prime = D / D_max;
+	}
+
+	return result;
+}
+
+// ---------------------------------------------------------------------------
+// Reference kernel
+// ---------------------------------------------------------------------------
+
+LdResult ComputeLdStatsScalar(const uintptr_t *genovec_a, const uintptr_t *genovec_b, uint32_t sample_ct) {
+	double sum_a = 0, sum_b = 0, sum_ab = 0, sum_a2 = 0, sum_b2 = 0;
+	uint32_t n = 0;
+
+	uint32_t word_ct = plink2::DivUp(sample_ct, plink2::kBitsPerWordD2);
+	for (uint32_t widx = 0; widx < word_ct; widx++) {
+		uintptr_t word_a = genovec_a[widx];
+		uintptr_t word_b = genovec_b[widx];
+
+		uint32_t samples_remaining = sample_ct - widx * plink2::kBitsPerWordD2;
+		uint32_t samples_in_word = std::min(samples_remaining, static_cast<uint32_t>(plink2::kBitsPerWordD2));
+
+		for (uint32_t sidx = 0; sidx < samples_in_word; sidx++) {
+			uint32_t geno_a = word_a & 3;
+			uint32_t geno_b = word_b & 3;
+			word_a >>= 2;
+			word_b >>= 2;
+
+			if (geno_a == 3 || geno_b == 3) {
+				continue;
+			}
+
+			double ga = static_cast<double>(geno_a);
+			double gb = static_cast<double>(geno_b);
+			sum_a += ga;
+			sum_b += gb;
+			sum_ab += ga * gb;
+			sum_a2 += ga * ga;
+			sum_b2 += gb * gb;
+			n++;
+		}
+	}
+
+	return FinishLdStats(n, sum_a, sum_b, sum_ab, sum_a2, sum_b2);
+}
+
+// ---------------------------------------------------------------------------
+// Bitplane construction
+// ---------------------------------------------------------------------------
+
+static constexpr uint64_t kMask5555 = 0x5555555555555555ULL;
+
+//! Gather the even bits of a word into its low 32 bits.
+static inline uint64_t PackEvenBits(uint64_t x) {
+	x &= kMask5555;
+	x = (x | (x >> 1)) & 0x3333333333333333ULL;
+	x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+	x = (x | (x >> 4)) & 0x00ff00ff00ff00ffULL;
+	x = (x | (x >> 8)) & 0x0000ffff0000ffffULL;
+	x = (x | (x >> 16)) & 0x00000000ffffffffULL;
+	return x;
+}
+
+static uint32_t PlaneWordCt(uint32_t sample_ct) {
+	auto words = static_cast<uint32_t>(plink2::DivUp(sample_ct, plink2::kBitsPerWord));
+	return static_cast<uint32_t>(plink2::DivUp(words, 8) * 8);
+}
+
+idx_t LdVariantGenotypes::BytesPerVariant(uint32_t sample_ct, LdKernel kernel) {
+	if (kernel == LdKernel::SCALAR) {
+		return plink2::NypCtToAlignedWordCt(sample_ct) * sizeof(uintptr_t);
+	}
+	return 3 * static_cast<idx_t>(PlaneWordCt(sample_ct)) * sizeof(uintptr_t);
+}
+
+void LdVariantGenotypes::Allocate(uint32_t sample_ct_p, LdKernel kernel_p) {
+	if (buf.ptr && sample_ct == sample_ct_p && kernel == kernel_p) {
+		return;
+	}
+	sample_ct = sample_ct_p;
+	kernel = kernel_p;
+	plane_word_ct = PlaneWordCt(sample_ct);
+	auto bytes = BytesPerVariant(sample_ct, kernel);
+	buf.Allocate(bytes);
+	std::memset(buf.ptr, 0, bytes);
+}
+
+void LdVariantGenotypes::Assign(const uintptr_t *genovec) {
+	if (kernel == LdKernel::SCALAR) {
+		uint32_t word_ct = static_cast<uint32_t>(plink2::DivUp(sample_ct, plink2::kBitsPerWordD2));
+		std::memcpy(buf.ptr, genovec, word_ct * sizeof(uintptr_t));
+		// Counts only (PgrGet zeroes the nyps past sample_ct, i.e. hom_ref)
+		uint64_t alt_total = 0, hom_total = 0, missing_total = 0;
+		for (uint32_t widx = 0; widx < word_ct; widx++) {
+			uint64_t lo = genovec[widx] & kMask5555;
+			uint64_t hi = (genovec[widx] >> 1) & kMask5555;
+			alt_total += plink2::PopcountWord(lo ^ hi);
+			hom_total += plink2::PopcountWord(hi & ~lo);
+			missing_total += plink2::PopcountWord(lo & hi);
+		}
+		alt_ct = static_cast<uint32_t>(alt_total);
+		hom_alt_ct = static_cast<uint32_t>(hom_total);
+		nonmissing_ct = sample_ct - static_cast<uint32_t>(missing_total);
+		return;
+	}
+	auto *alt = buf.As<uintptr_t>();
+	auto *hom = alt + plane_word_ct;
+	auto *nonmissing = hom + plane_word_ct;
+	uint32_t genovec_word_ct = static_cast<uint32_t>(plink2::DivUp(sample_ct, plink2::kBitsPerWordD2));
+	uint32_t used_word_ct = static_cast<uint32_t>(plink2::DivUp(sample_ct, plink2::kBitsPerWord));
+	uint64_t alt_total = 0, hom_total = 0, nonmissing_total = 0;
+	for (uint32_t widx = 0; widx < used_word_ct; widx++) {
+		uint64_t alt_word = 0, hom_word = 0, nonmissing_word = 0;
+		for (uint32_t half = 0; half < 2; half++) {
+			uint32_t gidx = 2 * widx + half;
+			if (gidx >= genovec_word_ct) {
+				break;
+			}
+			uint64_t geno = genovec[gidx];
+			uint64_t lo = geno & kMask5555;
+			uint64_t hi = (geno >> 1) & kMask5555;
+			uint32_t shift = 32 * half;
+			alt_word |= PackEvenBits(lo ^ hi) << shift;
+			hom_word |= PackEvenBits(hi & ~lo) << shift;
+			nonmissing_word |= PackEvenBits(~(lo & hi) & kMask5555) << shift;
+		}
+		// Samples past sample_ct decode as hom_ref (zero nyps) — clear them so they
+		// never count as observed.
+		uint32_t remaining = sample_ct - widx * plink2::kBitsPerWord;
+		if (remaining < plink2::kBitsPerWord) {
+			uint64_t keep = (1ULL << remaining) - 1;
+			alt_word &= keep;
+			hom_word &= keep;
+			nonmissing_word &= keep;
+		}
+		alt[widx] = alt_word;
+		hom[widx] = hom_word;
+		nonmissing[widx] = nonmissing_word;
+		alt_total += plink2::PopcountWord(alt_word);
+		hom_total += plink2::PopcountWord(hom_word);
+		nonmissing_total += plink2::PopcountWord(nonmissing_word);
+	}
+	alt_ct = static_cast<uint32_t>(alt_total);
+	hom_alt_ct = static_cast<uint32_t>(hom_total);
+	nonmissing_ct = static_cast<uint32_t>(nonmissing_total);
+}
+
+// ---------------------------------------------------------------------------
+// Popcount pair loops
+// ---------------------------------------------------------------------------
+
+//! Integer sums for one pair over jointly observed samples.
+struct LdPairCounts {
+	uint64_t n = 0;
+	uint64_t alt_a = 0; //!< Σ altA over jointly observed samples
+	uint64_t hom_a = 0;
+	uint64_t alt_b = 0;
+	uint64_t hom_b = 0;
+	uint64_t dot = 0; //!< Σ gA·gB
+};
+
+//! `complete` = neither variant has a missing call: only the cross term is gathered
+//! (the marginals are the per-variant totals).
+using LdPairLoop = void (*)(const uintptr_t *a, const uintptr_t *b, uint32_t plane_word_ct, bool complete,
+                            LdPairCounts &out);
+
+static void LdPairLoopPortable(const uintptr_t *a, const uintptr_t *b, uint32_t plane_word_ct, bool complete,
+                               LdPairCounts &out) {
+	const uintptr_t *alt_a = a, *hom_a = a + plane_word_ct, *nm_a = a + 2 * plane_word_ct;
+	const uintptr_t *alt_b = b, *hom_b = b + plane_word_ct, *nm_b = b + 2 * plane_word_ct;
+	uint64_t dot = 0;
+	if (complete) {
+		for (uint32_t w = 0; w < plane_word_ct; w++) {
+			dot += plink2::PopcountWord(alt_a[w] & alt_b[w]) + plink2::PopcountWord(alt_a[w] & hom_b[w]) +
+			       plink2::PopcountWord(hom_a[w] & alt_b[w]) + plink2::PopcountWord(hom_a[w] & hom_b[w]);
+		}
+		out.dot = dot;
+		return;
+	}
+	uint64_t n = 0, sa1 = 0, sa2 = 0, sb1 = 0, sb2 = 0;
+	for (uint32_t w = 0; w < plane_word_ct; w++) {
+		n += plink2::PopcountWord(nm_a[w] & nm_b[w]);
+		sa1 += plink2::PopcountWord(alt_a[w] & nm_b[w]);
+		sa2 += plink2::PopcountWord(hom_a[w] & nm_b[w]);
+		sb1 += plink2::PopcountWord(alt_b[w] & nm_a[w]);
+		sb2 += plink2::PopcountWord(hom_b[w] & nm_a[w]);
+		dot += plink2::PopcountWord(alt_a[w] & alt_b[w]) + plink2::PopcountWord(alt_a[w] & hom_b[w]) +
+		       plink2::PopcountWord(hom_a[w] & alt_b[w]) + plink2::PopcountWord(hom_a[w] & hom_b[w]);
+	}
+	out.n = n;
+	out.alt_a = sa1;
+	out.hom_a = sa2;
+	out.alt_b = sb1;
+	out.hom_b = sb2;
+	out.dot = dot;
+}
+
+#ifdef PLINKING_LD_X86_DISPATCH
+
+// --- AVX2: nibble-LUT popcount (Muła), byte counts summed into u64 lanes ---
+
+__attribute__((target("avx2"))) static inline __m256i PopcountAvx2(__m256i v) {
+	const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2,
+	                                     2, 3, 2, 3, 3, 4);
+	const __m256i low_mask = _mm256_set1_epi8(0x0f);
+	__m256i lo = _mm256_and_si256(v, low_mask);
+	__m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+	__m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+	return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2"))) static inline uint64_t HsumAvx2(__m256i v) {
+	alignas(32) uint64_t lanes[4];
+	_mm256_store_si256(reinterpret_cast<__m256i *>(lanes), v);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+__attribute__((target("avx2"))) static void LdPairLoopAvx2(const uintptr_t *a, const uintptr_t *b,
+                                                           uint32_t plane_word_ct, bool complete,
+                                                           LdPairCounts &out) {
+	auto *alt_a = reinterpret_cast<const __m256i *>(a);
+	auto *hom_a = reinterpret_cast<const __m256i *>(a + plane_word_ct);
+	auto *nm_a = reinterpret_cast<const __m256i *>(a + 2 * plane_word_ct);
+	auto *alt_b = reinterpret_cast<const __m256i *>(b);
+	auto *hom_b = reinterpret_cast<const __m256i *>(b + plane_word_ct);
+	auto *nm_b = reinterpret_cast<const __m256i *>(b + 2 * plane_word_ct);
+	uint32_t vec_ct = plane_word_ct / 4;
+
+	__m256i dot = _mm256_setzero_si256();
+	__m256i n = dot, sa1 = dot, sa2 = dot, sb1 = dot, sb2 = dot;
+	for (uint32_t v = 0; v < vec_ct; v++) {
+		__m256i aa = _mm256_loadu_si256(alt_a + v);
+		__m256i ha = _mm256_loadu_si256(hom_a + v);
+		__m256i ab = _mm256_loadu_si256(alt_b + v);
+		__m256i hb = _mm256_loadu_si256(hom_b + v);
+		dot = _mm256_add_epi64(dot, PopcountAvx2(_mm256_and_si256(aa, ab)));
+		dot = _mm256_add_epi64(dot, PopcountAvx2(_mm256_and_si256(aa, hb)));
+		dot = _mm256_add_epi64(dot, PopcountAvx2(_mm256_and_si256(ha, ab)));
+		dot = _mm256_add_epi64(dot, PopcountAvx2(_mm256_and_si256(ha, hb)));
+		if (!complete) {
+			__m256i ma = _mm256_loadu_si256(nm_a + v);
+			__m256i mb = _mm256_loadu_si256(nm_b + v);
+			n = _mm256_add_epi64(n, PopcountAvx2(_mm256_and_si256(ma, mb)));
+			sa1 = _mm256_add_epi64(sa1, PopcountAvx2(_mm256_and_si256(aa, mb)));
+			sa2 = _mm256_add_epi64(sa2, PopcountAvx2(_mm256_and_si256(ha, mb)));
+			sb1 = _mm256_add_epi64(sb1, PopcountAvx2(_mm256_and_si256(ab, ma)));
+			sb2 = _mm256_add_epi64(sb2, PopcountAvx2(_mm256_and_si256(hb, ma)));
+		}
+	}
+	out.dot = HsumAvx2(dot);
+	if (!complete) {
+		out.n = HsumAvx2(n);
+		out.alt_a = HsumAvx2(sa1);
+		out.hom_a = HsumAvx2(sa2);
+		out.alt_b = HsumAvx2(sb1);
+		out.hom_b = HsumAvx2(sb2);
+	}
+}
+
+#ifdef PLINKING_LD_HAVE_AVX512
+
+// --- AVX-512: native VPOPCNTQ ---
+
+__attribute__((target("avx512f"))) static inline uint64_t HsumAvx512(__m512i v) {
+	alignas(64) uint64_t lanes[8];
+	_mm512_store_si512(lanes, v);
+	uint64_t total = 0;
+	for (uint32_t i = 0; i < 8; i++) {
+		total += lanes[i];
+	}
+	return total;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) static void LdPairLoopAvx512(const uintptr_t *a,
+                                                                                const uintptr_t *b,
+                                                                                uint32_t plane_word_ct,
+                                                                                bool complete, LdPairCounts &out) {
+	const uintptr_t *alt_a = a, *hom_a = a + plane_word_ct, *nm_a = a + 2 * plane_word_ct;
+	const uintptr_t *alt_b = b, *hom_b = b + plane_word_ct, *nm_b = b + 2 * plane_word_ct;
+
+	__m512i dot = _mm512_setzero_si512();
+	__m512i n = dot, sa1 = dot, sa2 = dot, sb1 = dot, sb2 = dot;
+	for (uint32_t w = 0; w < plane_word_ct; w += 8) {
+		__m512i aa = _mm512_loadu_si512(alt_a + w);
+		__m512i ha = _mm512_loadu_si512(hom_a + w);
+		__m512i ab = _mm512_loadu_si512(alt_b + w);
+		__m512i hb = _mm512_loadu_si512(hom_b + w);
+		dot = _mm512_add_epi64(dot, _mm512_popcnt_epi64(_mm512_and_si512(aa, ab)));
+		dot = _mm512_add_epi64(dot, _mm512_popcnt_epi64(_mm512_and_si512(aa, hb)));
+		dot = _mm512_add_epi64(dot, _mm512_popcnt_epi64(_mm512_and_si512(ha, ab)));
+		dot = _mm512_add_epi64(dot, _mm512_popcnt_epi64(_mm512_and_si512(ha, hb)));
+		if (!complete) {
+			__m512i ma = _mm512_loadu_si512(nm_a + w);
+			__m512i mb = _mm512_loadu_si512(nm_b + w);
+			n = _mm512_add_epi64(n, _mm512_popcnt_epi64(_mm512_and_si512(ma, mb)));
+			sa1 = _mm512_add_epi64(sa1, _mm512_popcnt_epi64(_mm512_and_si512(aa, mb)));
+			sa2 = _mm512_add_epi64(sa2, _mm512_popcnt_epi64(_mm512_and_si512(ha, mb)));
+			sb1 = _mm512_add_epi64(sb1, _mm512_popcnt_epi64(_mm512_and_si512(ab, ma)));
+			sb2 = _mm512_add_epi64(sb2, _mm512_popcnt_epi64(_mm512_and_si512(hb, ma)));
+		}
+	}
+	out.dot = HsumAvx512(dot);
+	if (!complete) {
+		out.n = HsumAvx512(n);
+		out.alt_a = HsumAvx512(sa1);
+		out.hom_a = HsumAvx512(sa2);
+		out.alt_b = HsumAvx512(sb1);
+		out.hom_b = HsumAvx512(sb2);
+	}
+}
+
+#endif // PLINKING_LD_HAVE_AVX512
+#endif // PLINKING_LD_X86_DISPATCH
+
+// ---------------------------------------------------------------------------
+// Runtime dispatch
+// ---------------------------------------------------------------------------
+
+struct LdPairLoopChoice {
+	LdPairLoop loop;
+	const char *name;
+};
+
+static LdPairLoopChoice DetectLdPairLoop() {
+#ifdef PLINKING_LD_X86_DISPATCH
+	__builtin_cpu_init();
+#ifdef PLINKING_LD_HAVE_AVX512
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq")) {
+		return {LdPairLoopAvx512, "avx512"};
+	}
+#endif
+	if (__builtin_cpu_supports("avx2")) {
+		return {LdPairLoopAvx2, "avx2"};
+	}
+#endif
+	return {LdPairLoopPortable, "portable"};
+}
+
+static const LdPairLoopChoice &BestLdPairLoop() {
+	static const LdPairLoopChoice choice = DetectLdPairLoop();
+	return choice;
+}
+
+const char *LdPopcountVariantName() {
+	return BestLdPairLoop().name;
+}
+
+LdKernel ResolveLdKernel(ClientContext &context, const string &func_name) {
+	string kernel = "auto";
+	Value v;
+	if (context.TryGetCurrentSetting("plinking_ld_kernel", v) && !v.IsNull()) {
+		kernel = StringUtil::Lower(v.ToString());
+	}
+	if (kernel == "auto") {
+		return LdKernel::AUTO;
+	}
+	if (kernel == "popcount") {
+		return LdKernel::POPCOUNT;
+	}
+	if (kernel == "scalar") {
+		return LdKernel::SCALAR;
+	}
+	throw InvalidInputException("%s: unknown plinking_ld_kernel '%s' (expected 'auto', 'popcount', 'scalar')",
+	                            func_name, kernel);
+}
+
+// ---------------------------------------------------------------------------
+// Standardized-block kernel
+// ---------------------------------------------------------------------------
+
+bool StandardizeLdRow(const int8_t *genotypes, uint32_t sample_ct, double *out) {
+	uint32_t n = 0;
+	double sum = 0;
+	for (uint32_t s = 0; s < sample_ct; s++) {
+		if (genotypes[s] != -9) {
+			sum += genotypes[s];
+			n++;
+		}
+	}
+	double mean = n > 0 ? sum / n : 0.0;
+	double ss = 0;
+	for (uint32_t s = 0; s < sample_ct; s++) {
+		if (genotypes[s] != -9) {
+			double d = genotypes[s] - mean;
+			ss += d * d;
+		}
+	}
+	if (n < 2 || ss < 1e-15) {
+		std::fill(out, out + sample_ct, 0.0);
+		return false;
+	}
+
+	VariantNorm norm;
+	norm.center = mean;
+	norm.inv_stdev = 1.0 / std::sqrt(ss);
+	norm.skip = false;
+	NormalizeGenotypes(genotypes, sample_ct, norm, out);
+	return true;
+}
+
+//! Sample chunk for LdDotTile: 2 x LD_TILE rows x 256 doubles = 128 KiB stays in L2.
+static constexpr idx_t LD_TILE_SAMPLE_CHUNK = 256;
+
+void LdDotTile(const double *a, const double *b, idx_t row_stride, idx_t len, double *out, idx_t out_stride) {
+	for (uint32_t i = 0; i < LD_TILE; i++) {
+		std::fill(out + i * out_stride, out + i * out_stride + LD_TILE, 0.0);
+	}
+	for (idx_t k0 = 0; k0 < len; k0 += LD_TILE_SAMPLE_CHUNK) {
+		idx_t k1 = MinValue(k0 + LD_TILE_SAMPLE_CHUNK, len);
+		for (uint32_t i = 0; i < LD_TILE; i += 4) {
+			const double *a0 = a + i * row_stride, *a1 = a0 + row_stride, *a2 = a1 + row_stride, *a3 = a2 + row_stride;
+			for (uint32_t j = 0; j < LD_TILE; j += 4) {
+				const double *b0 = b + j * row_stride, *b1 = b0 + row_stride, *b2 = b1 + row_stride,
+				             *b3 = b2 + row_stride;
+				double c00 = 0, c01 = 0, c02 = 0, c03 = 0, c10 = 0, c11 = 0, c12 = 0, c13 = 0;
+				double c20 = 0, c21 = 0, c22 = 0, c23 = 0, c30 = 0, c31 = 0, c32 = 0, c33 = 0;
+				for (idx_t k = k0; k < k1; k++) {
+					double x0 = a0[k], x1 = a1[k], x2 = a2[k], x3 = a3[k];
+					double y0 = b0[k], y1 = b1[k], y2 = b2[k], y3 = b3[k];
+					c00 += x0 * y0;
+					c01 += x0 * y1;
+					c02 += x0 * y2;
+					c03 += x0 * y3;
+					c10 += x1 * y0;
+					c11 += x1 * y1;
+					c12 += x1 * y2;
+					c13 += x1 * y3;
+					c20 += x2 * y0;
+					c21 += x2 * y1;
+					c22 += x2 * y2;
+					c23 += x2 * y3;
+					c30 += x3 * y0;
+					c31 += x3 * y1;
+					c32 += x3 * y2;
+					c33 += x3 * y3;
+				}
+				double *o = out + i * out_stride + j;
+				o[0] += c00;
+				o[1] += c01;
+				o[2] += c02;
+				o[3] += c03;
+				o += out_stride;
+				o[0] += c10;
+				o[1] += c11;
+				o[2] += c12;
+				o[3] += c13;
+				o += out_stride;
+				o[0] += c20;
+				o[1] += c21;
+				o[2] += c22;
+				o[3] += c23;
+				o += out_stride;
+				o[0] += c30;
+				o[1] += c31;
+				o[2] += c32;
+				o[3] += c33;
+			}
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Window cache
+// ---------------------------------------------------------------------------
+
+void LdWindowCache::Init(uint32_t slot_ct, uint32_t sample_ct_p, LdKernel kernel_p) {
+	sample_ct = sample_ct_p;
+	kernel = kernel_p;
+	slots.clear();
+	slots.resize(slot_ct);
+	slot_vidx.assign(slot_ct, UINT32_MAX);
+}
+
+bool LdWindowCache::Lookup(uint32_t vidx, LdVariantGenotypes *&slot) {
+	D_ASSERT(Enabled());
+	uint32_t slot_idx = vidx % SlotCount();
+	slot = &slots[slot_idx];
+	if (slot_vidx[slot_idx] == vidx) {
+		return true;
+	}
+	slot->Allocate(sample_ct, kernel);
+	slot_vidx[slot_idx] = vidx;
+	return false;
+}
+
+uint32_t LdWindowCache::SlotCountForBudget(idx_t budget_bytes, uint32_t sample_ct, LdKernel kernel,
+                                           uint32_t max_useful) {
+	idx_t per_variant = LdVariantGenotypes::BytesPerVariant(sample_ct, kernel);
+	idx_t affordable = per_variant == 0 ? 0 : budget_bytes / per_variant;
+	return static_cast<uint32_t>(MinValue<idx_t>(affordable, max_useful));
+}
+
+idx_t GetLdWindowCacheBytes(ClientContext &context) {
+	Value v;
+	if (context.TryGetCurrentSetting("plinking_ld_window_cache_bytes", v) && !v.IsNull()) {
+		auto bytes = v.GetValue<int64_t>();
+		return bytes > 0 ? static_cast<idx_t>(bytes) : 0;
+	}
+	return 64ULL * 1024 * 1024; // default
+}
+
+uint32_t LdMaxWindowVariantCount(const VariantMetadataIndex &variants, uint32_t start, uint32_t end,
+                                 int64_t window_bp) {
+	uint32_t max_ct = 0;
+	uint32_t hi = start;
+	for (uint32_t i = start; i < end; i++) {
+		hi = MaxValue(hi, i + 1);
+		auto &chrom = variants.GetChrom(i);
+		int64_t pos = variants.GetPos(i);
+		while (hi < end && variants.GetChrom(hi) == chrom &&
+		       static_cast<int64_t>(variants.GetPos(hi)) - pos <= window_bp) {
+			hi++;
+		}
+		max_ct = MaxValue(max_ct, hi - i - 1);
+	}
+	return max_ct;
+}
+
+// ---------------------------------------------------------------------------
+// Pair entry point
+// ---------------------------------------------------------------------------
+
+LdResult ComputeLdStats(const LdVariantGenotypes &a, const LdVariantGenotypes &b) {
+	D_ASSERT(a.kernel == b.kernel && a.sample_ct == b.sample_ct);
+	if (a.kernel == LdKernel::SCALAR) {
+		return ComputeLdStatsScalar(a.Genovec(), b.Genovec(), a.sample_ct);
+	}
+
+	LdPairLoop loop = a.kernel == LdKernel::AUTO ? BestLdPairLoop().loop : LdPairLoopPortable;
+	bool complete = a.nonmissing_ct == a.sample_ct && b.nonmissing_ct == b.sample_ct;
+	LdPairCounts c;
+	loop(a.Planes(), b.Planes(), a.plane_word_ct, complete, c);
+	if (complete) {
+		c.n = a.sample_ct;
+		c.alt_a = a.alt_ct;
+		c.hom_a = a.hom_alt_ct;
+		c.alt_b = b.alt_ct;
+		c.hom_b = b.hom_alt_ct;
+	}
+
+	double sum_a = static_cast<double>(c.alt_a + c.hom_a);
+	double sum_b = static_cast<double>(c.alt_b + c.hom_b);
+	double sum_a2 = static_cast<double>(c.alt_a + 3 * c.hom_a);
+	double sum_b2 = static_cast<double>(c.alt_b + 3 * c.hom_b);
+	return FinishLdStats(static_cast<uint32_t>(c.n), sum_a, sum_b, static_cast<double>(c.dot), sum_a2, sum_b2);
+}
+
+} // namespace duckdb
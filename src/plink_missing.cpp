@@ -43,6 +43,7 @@ struct PlinkMissingBindData : public TableFunctionData {
 	string pgen_path;
 	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
 	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
 	string pvar_path;
 	string psam_path;
 
@@ -87,7 +88,7 @@ struct PlinkMissingGlobalState : public GlobalTableFunctionState {
 
 	// Sample mode: per-sample accumulation (merged from thread-local accumulators)
 	vector<uint32_t> sample_missing_counts;
-	std::mutex merge_mutex;
+	StripedReduction merge; // stripe-parallel merge of thread-local counts
 	std::atomic<uint32_t> phase1_active {0};
 	std::atomic<bool> variant_scan_done {false};
 	std::atomic<uint32_t> next_sample_idx {0};
@@ -100,6 +101,9 @@ struct PlinkMissingGlobalState : public GlobalTableFunctionState {
 	// In sample mode, MaxThreads > 1 enables parallel Phase 1 (variant scanning
 	// into per-thread accumulators). The formula matches variant mode's batch
 	// granularity but drives Phase 1 parallelism rather than row emission.
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
 	idx_t MaxThreads() const override {
 		uint32_t range = end_variant_idx - start_variant_idx;
 		idx_t computed = std::min<idx_t>(range / 500 + 1, db_thread_count);
@@ -112,8 +116,7 @@ struct PlinkMissingGlobalState : public GlobalTableFunctionState {
 // ---------------------------------------------------------------------------
 
 struct PlinkMissingLocalState : public LocalTableFunctionState {
-	plink2::PgenFileInfo pgfi;
-	AlignedBuffer pgfi_alloc_buf;
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
 
 	plink2::PgenReader pgr;
 	AlignedBuffer pgr_alloc_buf;
@@ -134,7 +137,6 @@ struct PlinkMissingLocalState : public LocalTableFunctionState {
 		if (initialized) {
 			plink2::PglErr reterr = plink2::kPglRetSuccess;
 			plink2::CleanupPgr(&pgr, &reterr);
-			plink2::CleanupPgfi(&pgfi, &reterr);
 		}
 	}
 };
@@ -190,48 +192,14 @@ static unique_ptr<FunctionData> PlinkMissingBind(ClientContext &context, TableFu
 		                            "(use psam := 'path' to specify explicitly)");
 	}
 
-	// --- Initialize pgenlib (Phase 1) to get counts ---
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
 	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
 	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
 	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
 
-	plink2::PgenFileInfo pgfi;
-	plink2::PreinitPgfi(&pgfi);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err = plink2::PgfiInitPhase1(bind_data->pgen_path.c_str(), nullptr, UINT32_MAX, UINT32_MAX,
-	                                            &header_ctrl, &pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("plink_missing: failed to open '%s': %s", bind_data->pgen_path, errstr_buf);
-	}
-
-	bind_data->raw_variant_ct = pgfi.raw_variant_ct;
-	bind_data->raw_sample_ct = pgfi.raw_sample_ct;
-
-	// Phase 2 (validate file; per-thread readers re-init later)
-	AlignedBuffer pgfi_alloc;
-	if (pgfi_alloc_cacheline_ct > 0) {
-		pgfi_alloc.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, pgfi.raw_variant_ct, &max_vrec_width, &pgfi,
-	                             pgfi_alloc.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-	plink2::CleanupPgfi(&pgfi, &cleanup_err);
-
-	if (err != plink2::kPglRetSuccess) {
-		throw IOException("plink_missing: failed to initialize '%s' (phase 2): %s", bind_data->pgen_path, errstr_buf);
-	}
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_missing");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
 
 	// --- Load variant metadata ---
 	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_missing");
@@ -344,9 +312,14 @@ static unique_ptr<GlobalTableFunctionState> PlinkMissingInitGlobal(ClientContext
 		state->total_variant_ct = state->end_variant_idx - state->start_variant_idx;
 		if (state->need_missingness) {
 			state->sample_missing_counts.resize(bind_data.effective_sample_ct, 0);
+			state->merge.Init(bind_data.effective_sample_ct);
 		}
 	}
 
+	if (state->need_missingness) {
+		state->pgen_index = bind_data.pgen_index;
+	}
+
 	return std::move(state);
 }
 
@@ -365,55 +338,10 @@ static unique_ptr<LocalTableFunctionState> PlinkMissingInitLocal(ExecutionContex
 		return std::move(state);
 	}
 
-	// --- Initialize per-thread PgenFileInfo + PgenReader ---
+	// --- Per-thread PgenReader on the query's shared index ---
 	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
-	plink2::PreinitPgfi(&state->pgfi);
-	plink2::PreinitPgr(&state->pgr);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err =
-	    plink2::PgfiInitPhase1(bind_data.pgen_path.c_str(), nullptr, bind_data.raw_variant_ct, bind_data.raw_sample_ct,
-	                           &header_ctrl, &state->pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_missing: thread init failed (phase 1): %s", errstr_buf);
-	}
-
-	if (pgfi_alloc_cacheline_ct > 0) {
-		state->pgfi_alloc_buf.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, state->pgfi.raw_variant_ct, &max_vrec_width, &state->pgfi,
-	                             state->pgfi_alloc_buf.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_missing: thread init failed (phase 2): %s", errstr_buf);
-	}
-
-	if (pgr_alloc_cacheline_ct > 0) {
-		state->pgr_alloc_buf.Allocate(pgr_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	err = plink2::PgrInit(bind_data.pgen_path.c_str(), max_vrec_width, &state->pgfi, &state->pgr,
-	                      state->pgr_alloc_buf.As<unsigned char>());
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgr(&state->pgr, &cleanup_err);
-		cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_missing: PgrInit failed for '%s'", bind_data.pgen_path);
-	}
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_missing");
 
 	// Set up sample subsetting
 	if (bind_data.has_sample_subset && bind_data.sample_subset) {
@@ -468,6 +396,10 @@ static void PlinkMissingScanVariant(const PlinkMissingBindData &bind_data, Plink
 			break;
 		}
 		uint32_t batch_end = std::min(batch_start + claim_size, end_idx);
+		if (gstate.need_missingness && lstate.initialized) {
+			PrefetchPgenBatch(*lstate.pgen_index, lstate.pgr, nullptr, batch_end,
+			                  std::min(batch_end + claim_size, end_idx));
+		}
 
 		for (uint32_t vidx = batch_start; vidx < batch_end; vidx++) {
 			uint32_t missing_ct = 0;
@@ -588,6 +520,8 @@ static void PlinkMissingScanSample(const PlinkMissingBindData &bind_data, PlinkM
 				break;
 			}
 			uint32_t batch_end = std::min(batch_start + MISSING_BATCH_SIZE, end_idx);
+			PrefetchPgenBatch(*lstate.pgen_index, lstate.pgr, nullptr, batch_end,
+			                  std::min(batch_end + MISSING_BATCH_SIZE, end_idx));
 
 			for (uint32_t vidx = batch_start; vidx < batch_end; vidx++) {
 				plink2::PglErr err = plink2::PgrGetMissingness(sample_include, lstate.pssi, sample_ct, vidx,
@@ -611,12 +545,11 @@ static void PlinkMissingScanSample(const PlinkMissingBindData &bind_data, PlinkM
 		}
 
 		// Merge thread-local accumulator into global state
-		{
-			std::lock_guard<std::mutex> lock(gstate.merge_mutex);
-			for (uint32_t s = 0; s < sample_ct; s++) {
+		gstate.merge.Merge([&](idx_t begin, idx_t end) {
+			for (idx_t s = begin; s < end; s++) {
 				gstate.sample_missing_counts[s] += lstate.local_missing_counts[s];
 			}
-		}
+		});
 		lstate.phase1_done = true;
 
 		// Last thread to finish Phase 1 transitions to Phase 2
@@ -2,13 +2,27 @@
 // randomized subspace iteration; per-sample PC output.
 //
 // FORCED-REIMPLEMENTATION CAVEAT (see docs/planning/plink2-wrapping-audit.md, YELLOW #5):
-// This is a hand-rolled randomized SVD (Eigen BDCSVD) plus a bespoke DuckDB-threaded
-// subspace accumulator, NOT a wrap of plink2. plink2's CalcPca (plink2_matrix_calc.cc) is
+// This is a hand-rolled randomized SVD (Eigen tall-skinny QR + small SVD) plus a bespoke
+// DuckDB-threaded subspace accumulator, NOT a wrap of plink2. plink2's CalcPca (plink2_matrix_calc.cc) is
 // saturated with g_bigstack_* / PgenMtLoadInit / SetThreadFuncAndData and is not compiled,
 // so no callable equivalent exists — reimplementation is forced, not a smell. The approach
 // mirrors `plink2 --pca approx` (randomized subspace iteration) but the numerics are
 // independent and carry drift risk: cross-check eigenvalues/vectors against
 // `plink2 --pca approx` on a fixture before relying on exact agreement.
+//
+// Between passes no thread works alone on anything of size N or M: each thread adds its
+// partial into the pass total by row stripes as it runs out of blocks, and QQ / BB are
+// orthogonalized by a tall-skinny QR whose row blocks are factored and applied by all
+// threads in barrier generations of their own. Only the stacked R factors (about
+// threads x qq_col_ct rows) and a qq_col_ct-square SVD are left to one thread.
+//
+// algorithm := 'sketch' reads the .pgen once: each row of an in-memory float sketch
+// is a random-sign sum of a run of consecutive effective variants, sized so the
+// sketch fits plinking_pca_sketch_max_bytes (one variant per row when it can, which
+// is the approx algorithm in single precision). The subspace passes then run on the
+// sketch rows instead of the .pgen, with float per-thread partials folded pairwise.
+// The signs cancel in expectation, so the sketch's Gram matrix estimates the GRM
+// (E[SᵀS] = XᵀX); coarser sketches trade accuracy on the weaker PCs for memory.
 
 #include "plink_pca.hpp"
 #include "duckdb_compat.hpp"
@@ -16,6 +30,7 @@
 #include "pgen_vfs_opener.hpp"
 
 #include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 #include <Eigen/Dense>
 #include <Eigen/SVD>
@@ -24,6 +39,7 @@
 #include <atomic>
 #include <cmath>
 #include <cstring>
+#include <limits>
 #include <mutex>
 #include <random>
 
@@ -35,11 +51,49 @@ namespace duckdb {
 
 static constexpr uint32_t PCA_VARIANT_BLOCK_SIZE = 240;
 
+// Per-thread cap on the normalized-genotype panel (variants × samples doubles). At
+// large N the panel holds fewer than PCA_VARIANT_BLOCK_SIZE variants.
+static constexpr idx_t PCA_PANEL_MAX_DOUBLES = idx_t(1) << 23;
+
+using PcaRowMajorMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+using PcaRowMajorMatrixF = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+// Seed of the per-variant signs folded into a sketch row
+static constexpr uint64_t PCA_SKETCH_SEED = 0x5ca1ab1e5eed0001ULL;
+
+// Seed of the per-sample probe that fixes each eigenvector's sign
+static constexpr uint64_t PCA_SIGN_PROBE_SEED = 0x5167a1b0be5eed02ULL;
+
+// Variant rows per loadings block in the final QR generation
+static constexpr uint32_t PCA_LOADINGS_BLOCK_SIZE = 4096;
+
+// splitmix64 finalizer: sketch signs and the sign probe
+static inline uint64_t PcaSketchHash(uint64_t x) {
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+// ---------------------------------------------------------------------------
+// Barrier schedule
+// ---------------------------------------------------------------------------
+
+// One generation of the pass barrier. PASS runs subspace pass `pass` (over the .pgen,
+// or over the sketch rows); QR_FACTOR / QR_APPLY orthogonalize QQ after pass n_pcs
+// and BB after the final pass (pass = n_pcs + 1).
+enum class PcaStage : uint8_t { SKETCH_BUILD, PASS, QR_FACTOR, QR_APPLY };
+
+struct PcaStep {
+	PcaStage stage;
+	uint32_t pass;
+};
+
 // ---------------------------------------------------------------------------
 // Output modes
 // ---------------------------------------------------------------------------
 
-enum class PcaMode : uint8_t { SAMPLES, PCS, BOTH };
+enum class PcaMode : uint8_t { SAMPLES, PCS, BOTH, LOADINGS };
 
 static PcaMode ParsePcaMode(const string &mode_str) {
 	auto lower = StringUtil::Lower(mode_str);
@@ -49,8 +103,27 @@ static PcaMode ParsePcaMode(const string &mode_str) {
 		return PcaMode::PCS;
 	} else if (lower == "both") {
 		return PcaMode::BOTH;
+	} else if (lower == "loadings") {
+		return PcaMode::LOADINGS;
 	}
-	throw InvalidInputException("plink_pca: invalid mode '%s' (expected 'samples', 'pcs', or 'both')", mode_str);
+	throw InvalidInputException("plink_pca: invalid mode '%s' (expected 'samples', 'pcs', 'both', or 'loadings')",
+	                            mode_str);
+}
+
+// ---------------------------------------------------------------------------
+// Algorithms
+// ---------------------------------------------------------------------------
+
+enum class PcaAlgorithm : uint8_t { APPROX, SKETCH };
+
+static PcaAlgorithm ParsePcaAlgorithm(const string &algorithm_str) {
+	auto lower = StringUtil::Lower(algorithm_str);
+	if (lower == "approx") {
+		return PcaAlgorithm::APPROX;
+	} else if (lower == "sketch") {
+		return PcaAlgorithm::SKETCH;
+	}
+	throw InvalidInputException("plink_pca: invalid algorithm '%s' (expected 'approx' or 'sketch')", algorithm_str);
 }
 
 // ---------------------------------------------------------------------------
@@ -70,12 +143,25 @@ static constexpr idx_t PCOL_EIGENVALUE = 1;
 static constexpr idx_t PCOL_VARIANCE_PROPORTION = 2;
 static constexpr idx_t PCOL_CUMULATIVE_VARIANCE = 3;
 
+// ---------------------------------------------------------------------------
+// Column indices — loadings mode
+// ---------------------------------------------------------------------------
+
+static constexpr idx_t LCOL_CHROM = 0;
+static constexpr idx_t LCOL_POS = 1;
+static constexpr idx_t LCOL_ID = 2;
+static constexpr idx_t LCOL_REF = 3;
+static constexpr idx_t LCOL_ALT = 4;
+static constexpr idx_t LCOL_ALT_FREQ = 5;
+static constexpr idx_t LCOL_PC_START = 6; // PC1..PCk start at column 6
+
 // ---------------------------------------------------------------------------
 // Effective variant (pgen index + normalization)
 // ---------------------------------------------------------------------------
 
 struct EffectiveVariant {
 	uint32_t pgen_idx;
+	double alt_freq; // over the PCA samples; reported in loadings mode
 	VariantNorm norm;
 };
 
@@ -87,6 +173,7 @@ struct PlinkPcaBindData : public TableFunctionData {
 	string pgen_path;
 	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
 	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
 	string pvar_path;
 	string psam_path;
 
@@ -111,11 +198,17 @@ struct PlinkPcaBindData : public TableFunctionData {
 	// Output
 	PcaMode mode = PcaMode::SAMPLES;
 	uint32_t n_pcs = 10;
+	PcaAlgorithm algorithm = PcaAlgorithm::APPROX;
 
 	// Derived algorithm constants
 	uint32_t pc_ct_x2 = 0;  // 2 * n_pcs
 	uint32_t qq_col_ct = 0; // (n_pcs + 1) * pc_ct_x2
 
+	// Sketch sizing (algorithm := 'sketch'), from plinking_pca_sketch_max_bytes
+	uint32_t sketch_group_ct = 1;    // consecutive effective variants folded into each row
+	uint32_t sketch_row_ct = 0;      // ceil(effective_variant_ct / sketch_group_ct)
+	uint32_t sketch_max_threads = 0; // threads whose partials fit next to the sketch
+
 	// Sample output order (maps emit index → original sample index)
 	vector<uint32_t> sample_output_order;
 };
@@ -131,25 +224,67 @@ struct PlinkPcaGlobalState : public GlobalTableFunctionState {
 	uint32_t n_pcs = 0;
 	uint32_t pc_ct_x2 = 0;
 	uint32_t qq_col_ct = 0;
+	uint32_t row_ct = 0; // rows the subspace passes run over: M, or the sketch rows
 
 	// Shared algorithm matrices (row-major)
 	vector<double> G1; // N x pc_ct_x2
-	vector<double> QQ; // M x qq_col_ct
+	vector<double> QQ; // row_ct x qq_col_ct
+
+	// Sketch (algorithm := 'sketch'): row_ct x N floats, built by generation 0; the
+	// passes then read it instead of the .pgen. Per-thread partials are N x qq_col_ct
+	// floats, folded pairwise as threads finish (sketch_merge_ready holds the one
+	// partial waiting for a partner; after the barrier it holds the pass total).
+	// The sketch and partials come from DuckDB's buffer allocator (memory_limit).
+	bool sketch = false;
+	uint32_t sketch_group_ct = 1;
+	uint32_t sketch_max_threads = 0;
+	TrackedBuffer sketch_rows;
+	vector<float> G1_f; // G1 in single precision
+	vector<TrackedBuffer> sketch_partials;
+	std::mutex sketch_merge_lock;
+	vector<uint32_t> sketch_merge_ready;
+
+	// Genovec cache: every effective variant's packed 2-bit genovec, filled by pass 0
+	// and read by every later pass instead of the .pgen (plinking_pca_genotype_cache).
+	// Row eff_idx starts at eff_idx * genovec_cache_stride words.
+	bool use_genovec_cache = false;
+	bool genovec_cache_ready = false; // set by the pass-0 merge, before the generation advances
+	idx_t genovec_cache_stride = 0;
+	TrackedBuffer genovec_cache;
 
 	// Per-thread partial accumulation buffers
 	// thread_partials[tid] is N x qq_col_ct doubles
 	uint32_t thread_count = 0;
 	vector<vector<double>> thread_partials;
 
+	// Pass total (N x qq_col_ct): threads add their partial's pass columns by row
+	// stripes when they run out of blocks. After the final pass it holds BB.
+	vector<double> pass_sum;
+	StripedReduction pass_merge;
+
+	// Tall-skinny QR of qr_data (qr_row_ct x qq_col_ct, row-major), in place: row block
+	// i is factored A_i = Q_i R_i in parallel, the stacked R_i are factored once
+	// ([R_1; ...; R_k] = Q' R, Q' kept in qr_r), and block i becomes Q_i Q'_i.
+	double *qr_data = nullptr;
+	const float *qr_src_f32 = nullptr; // sketch BB: blocks are read from here
+	uint32_t qr_row_ct = 0;
+	uint32_t qr_block_ct = 0;
+	uint32_t qr_loadings_block_ct = 0; // final QR, loadings mode
+	vector<double> qr_r;               // qr_block_ct * qq_col_ct x qq_col_ct
+	vector<double> qr_probe;           // qr_block_ct x qq_col_ct: probeᵀ Q_i (final QR)
+	vector<double> qr_w;               // final: Q' U_R[:, :n_pcs], per block
+	vector<double> qr_v;               // final, loadings: V[:, :n_pcs] / S
+
 	// Pass coordination — generation-based barrier
 	//
 	// All threads participate in every pass. Each thread increments
 	// pass_active_threads on entry and decrements on finish. The last
-	// thread to finish (decrement returns 1) does the merge/SVD, resets
-	// next_block_idx, and increments pass_generation to release waiters.
-	// Non-last threads return empty chunks and check pass_generation on
-	// re-entry — if it has advanced, they join the new pass.
-	uint32_t total_passes = 0;                     // n_pcs + 2
+	// thread to finish (decrement returns 1) does the generation's serial
+	// step (FinishGeneration), resets next_block_idx, and increments
+	// pass_generation to release waiters. Non-last threads return empty
+	// chunks and check pass_generation on re-entry — if it has advanced,
+	// they join the new generation.
+	vector<PcaStep> schedule;                      // work of each generation
 	std::atomic<uint32_t> pass_generation {0};     // incremented after each pass completes
 	std::atomic<uint32_t> pass_active_threads {0}; // threads currently in a pass
 	std::atomic<uint32_t> next_block_idx {0};      // variant block claiming
@@ -161,6 +296,8 @@ struct PlinkPcaGlobalState : public GlobalTableFunctionState {
 	// Results
 	vector<double> eigenvectors; // N x n_pcs (row-major)
 	vector<double> eigenvalues;  // n_pcs
+	vector<double> loadings;     // M x n_pcs (row-major), loadings mode only
+	bool want_loadings = false;
 
 	// Emission
 	std::atomic<uint32_t> next_emit_idx {0};
@@ -170,11 +307,17 @@ struct PlinkPcaGlobalState : public GlobalTableFunctionState {
 	uint32_t db_thread_count = 1;
 	uint32_t max_threads_config = 0;
 
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
 	idx_t MaxThreads() const override {
-		if (M < PCA_VARIANT_BLOCK_SIZE) {
+		if (row_ct < PCA_VARIANT_BLOCK_SIZE) {
 			return 1;
 		}
-		idx_t computed = std::min<idx_t>(M / PCA_VARIANT_BLOCK_SIZE + 1, db_thread_count);
+		idx_t computed = std::min<idx_t>(row_ct / PCA_VARIANT_BLOCK_SIZE + 1, db_thread_count);
+		if (sketch) {
+			computed = std::min<idx_t>(computed, sketch_max_threads);
+		}
 		return ApplyMaxThreadsCap(computed, max_threads_config);
 	}
 };
@@ -184,8 +327,7 @@ struct PlinkPcaGlobalState : public GlobalTableFunctionState {
 // ---------------------------------------------------------------------------
 
 struct PlinkPcaLocalState : public LocalTableFunctionState {
-	plink2::PgenFileInfo pgfi;
-	AlignedBuffer pgfi_alloc_buf;
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
 
 	plink2::PgenReader pgr;
 	AlignedBuffer pgr_alloc_buf;
@@ -194,7 +336,11 @@ struct PlinkPcaLocalState : public LocalTableFunctionState {
 
 	AlignedBuffer genovec_buf;
 	vector<int8_t> geno_bytes;
-	vector<double> norm_geno;
+
+	// Normalized genotypes of up to panel_variant_ct variants, one row per variant
+	// (panel_variant_ct x N, row-major); the pass products run on whole panels
+	vector<double> panel;
+	uint32_t panel_variant_ct = 1;
 
 	uint32_t thread_id = 0;
 	uint32_t last_generation_seen = UINT32_MAX;
@@ -204,7 +350,6 @@ struct PlinkPcaLocalState : public LocalTableFunctionState {
 		if (initialized) {
 			plink2::PglErr reterr = plink2::kPglRetSuccess;
 			plink2::CleanupPgr(&pgr, &reterr);
-			plink2::CleanupPgfi(&pgfi, &reterr);
 		}
 	}
 };
@@ -228,17 +373,24 @@ static unique_ptr<FunctionData> PlinkPcaBind(ClientContext &context, TableFuncti
 			bind_data->psam_path = kv.second.GetValue<string>();
 		} else if (kv.first == "mode") {
 			bind_data->mode = ParsePcaMode(kv.second.GetValue<string>());
+		} else if (kv.first == "algorithm") {
+			bind_data->algorithm = ParsePcaAlgorithm(kv.second.GetValue<string>());
 		} else if (kv.first == "n_pcs") {
 			int32_t val = kv.second.GetValue<int32_t>();
 			if (val < 1) {
 				throw InvalidInputException("plink_pca: n_pcs must be >= 1 (got %d)", val);
 			}
 			bind_data->n_pcs = static_cast<uint32_t>(val);
-		} else if (kv.first == "samples" || kv.first == "region") {
+		} else if (kv.first == "samples" || kv.first == "region" || kv.first == "variants") {
 			// Handled below
 		}
 	}
 
+	if (bind_data->algorithm == PcaAlgorithm::SKETCH && bind_data->mode == PcaMode::LOADINGS) {
+		throw InvalidInputException("plink_pca: mode := 'loadings' is not supported with algorithm := 'sketch' "
+		                            "(sketch rows mix variants; use algorithm := 'approx')");
+	}
+
 	// Compute algorithm constants
 	bind_data->pc_ct_x2 = 2 * bind_data->n_pcs;
 	bind_data->qq_col_ct = (bind_data->n_pcs + 1) * bind_data->pc_ct_x2;
@@ -262,51 +414,19 @@ static unique_ptr<FunctionData> PlinkPcaBind(ClientContext &context, TableFuncti
 		}
 	}
 
-	// --- Initialize pgenlib (temporary, for header + allele freq counting) ---
+	// --- Load the .pgen index (counts and allele freqs now; the scan reuses it) ---
 	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
 	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
 	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
 
-	plink2::PgenFileInfo pgfi;
-	plink2::PreinitPgfi(&pgfi);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err = plink2::PgfiInitPhase1(bind_data->pgen_path.c_str(), nullptr, UINT32_MAX, UINT32_MAX,
-	                                            &header_ctrl, &pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("plink_pca: failed to open '%s': %s", bind_data->pgen_path, errstr_buf);
-	}
-
-	bind_data->raw_variant_ct = pgfi.raw_variant_ct;
-	bind_data->raw_sample_ct = pgfi.raw_sample_ct;
-
-	AlignedBuffer pgfi_alloc;
-	if (pgfi_alloc_cacheline_ct > 0) {
-		pgfi_alloc.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, pgfi.raw_variant_ct, &max_vrec_width, &pgfi,
-	                             pgfi_alloc.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("plink_pca: failed to initialize '%s' (phase 2): %s", bind_data->pgen_path, errstr_buf);
-	}
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_pca");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
 
 	// --- Load variant metadata ---
 	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_pca");
 
 	if (bind_data->variants.variant_ct != bind_data->raw_variant_ct) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
 		throw InvalidInputException("plink_pca: variant count mismatch: .pgen has %u variants, "
 		                            ".pvar/.bim '%s' has %llu variants",
 		                            bind_data->raw_variant_ct, bind_data->pvar_path,
@@ -317,8 +437,6 @@ static unique_ptr<FunctionData> PlinkPcaBind(ClientContext &context, TableFuncti
 	bind_data->sample_info = LoadSampleMetadata(context, bind_data->psam_path);
 
 	if (static_cast<uint32_t>(bind_data->sample_info.sample_ct) != bind_data->raw_sample_ct) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
 		throw InvalidInputException("plink_pca: sample count mismatch: .pgen has %u samples, "
 		                            ".psam/.fam '%s' has %llu samples",
 		                            bind_data->raw_sample_ct, bind_data->psam_path,
@@ -353,23 +471,36 @@ static unique_ptr<FunctionData> PlinkPcaBind(ClientContext &context, TableFuncti
 		bind_data->variant_range = ParseRegion(region_it->second.GetValue<string>(), bind_data->variants, "plink_pca");
 	}
 
+	// --- Process variants parameter (intersected with region) ---
+	uint32_t range_start = bind_data->variant_range.has_filter ? bind_data->variant_range.start_idx : 0;
+	uint32_t range_end =
+	    bind_data->variant_range.has_filter ? bind_data->variant_range.end_idx : bind_data->raw_variant_ct;
+
+	vector<uint32_t> candidate_variants;
+	auto variants_it = input.named_parameters.find("variants");
+	if (variants_it != input.named_parameters.end()) {
+		auto indices =
+		    ResolveVariantsParameter(variants_it->second, bind_data->variants, bind_data->raw_variant_ct, "plink_pca");
+		for (auto vidx : indices) {
+			if (vidx >= range_start && vidx < range_end) {
+				candidate_variants.push_back(vidx);
+			}
+		}
+		// pgen order: the randomized and sketch results must not depend on list order
+		std::sort(candidate_variants.begin(), candidate_variants.end());
+	} else {
+		candidate_variants.reserve(range_end - range_start);
+		for (uint32_t vidx = range_start; vidx < range_end; vidx++) {
+			candidate_variants.push_back(vidx);
+		}
+	}
+
 	// --- Compute per-variant allele frequencies and build effective variant list ---
 	// Need a full PgenReader for PgrGetCounts
 	plink2::PgenReader pgr_temp;
 	plink2::PreinitPgr(&pgr_temp);
 	AlignedBuffer pgr_alloc_temp;
-	if (pgr_alloc_cacheline_ct > 0) {
-		pgr_alloc_temp.Allocate(pgr_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	err = plink2::PgrInit(bind_data->pgen_path.c_str(), max_vrec_width, &pgfi, &pgr_temp,
-	                      pgr_alloc_temp.As<unsigned char>());
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgr(&pgr_temp, &cleanup_err);
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("plink_pca: PgrInit failed for '%s'", bind_data->pgen_path);
-	}
+	InitPgenReader(*bind_data->pgen_index, bind_data->pgen_path, pgr_temp, pgr_alloc_temp, "plink_pca");
 
 	// Set up sample subsetting on the temporary reader
 	plink2::PgrSampleSubsetIndex pssi_temp;
@@ -385,18 +516,13 @@ static unique_ptr<FunctionData> PlinkPcaBind(ClientContext &context, TableFuncti
 		plink2::PgrClearSampleSubsetIndex(&pgr_temp, &pssi_temp);
 	}
 
-	uint32_t range_start = bind_data->variant_range.has_filter ? bind_data->variant_range.start_idx : 0;
-	uint32_t range_end =
-	    bind_data->variant_range.has_filter ? bind_data->variant_range.end_idx : bind_data->raw_variant_ct;
-
-	for (uint32_t vidx = range_start; vidx < range_end; vidx++) {
+	for (auto vidx : candidate_variants) {
 		STD_ARRAY_DECL(uint32_t, 4, genocounts);
-		err = plink2::PgrGetCounts(sample_include_temp, interleaved_vec_temp, pssi_temp, count_sample_ct, vidx,
-		                           &pgr_temp, genocounts);
+		plink2::PglErr err = plink2::PgrGetCounts(sample_include_temp, interleaved_vec_temp, pssi_temp,
+		                                          count_sample_ct, vidx, &pgr_temp, genocounts);
 		if (err != plink2::kPglRetSuccess) {
 			plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
 			plink2::CleanupPgr(&pgr_temp, &cleanup_err);
-			plink2::CleanupPgfi(&pgfi, &cleanup_err);
 			throw IOException("plink_pca: PgrGetCounts failed for variant %u", vidx);
 		}
 
@@ -412,14 +538,13 @@ static unique_ptr<FunctionData> PlinkPcaBind(ClientContext &context, TableFuncti
 			continue; // monomorphic
 		}
 
-		bind_data->effective_variants.push_back({vidx, norm});
+		bind_data->effective_variants.push_back({vidx, alt_freq, norm});
 	}
 
 	// Clean up temporary reader
 	{
 		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
 		plink2::CleanupPgr(&pgr_temp, &cleanup_err);
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
 	}
 
 	bind_data->effective_variant_ct = static_cast<uint32_t>(bind_data->effective_variants.size());
@@ -446,8 +571,55 @@ static unique_ptr<FunctionData> PlinkPcaBind(ClientContext &context, TableFuncti
 		                            bind_data->effective_sample_ct, bind_data->n_pcs, bind_data->qq_col_ct);
 	}
 
+	// --- Sketch sizing ---
+	// Budget: the sketch (4N bytes per row) and QQ (8 qq_col_ct per row), G1 in both
+	// precisions, the final BB, and one float partial (4N qq_col_ct) per thread. The
+	// partials for every scan thread are set aside before the rows; otherwise a sketch
+	// that has to fold variants fills the budget and leaves room for one thread only.
+	uint32_t pass_row_ct = bind_data->effective_variant_ct;
+	if (bind_data->algorithm == PcaAlgorithm::SKETCH) {
+		uint64_t max_bytes = 16ULL * 1024 * 1024 * 1024; // default
+		Value max_bytes_val;
+		if (context.TryGetCurrentSetting("plinking_pca_sketch_max_bytes", max_bytes_val) && !max_bytes_val.IsNull()) {
+			auto val = max_bytes_val.GetValue<int64_t>();
+			max_bytes = val > 0 ? static_cast<uint64_t>(val) : 0;
+		}
+		uint64_t N = bind_data->effective_sample_ct;
+		uint64_t row_bytes = N * sizeof(float) + static_cast<uint64_t>(bind_data->qq_col_ct) * sizeof(double);
+		uint64_t thread_bytes = N * bind_data->qq_col_ct * sizeof(float);
+		uint64_t fixed_bytes = N * bind_data->pc_ct_x2 * (sizeof(double) + sizeof(float)) +
+		                       N * bind_data->qq_col_ct * sizeof(double);
+		uint64_t min_bytes = fixed_bytes + thread_bytes + (bind_data->qq_col_ct + 1ULL) * row_bytes;
+		uint64_t want_threads = ApplyMaxThreadsCap(TaskScheduler::GetScheduler(context).NumberOfThreads(),
+		                                           GetPlinkingMaxThreads(context));
+		uint64_t reserved_bytes = thread_bytes;
+		if (max_bytes >= min_bytes + (want_threads - 1) * thread_bytes) {
+			reserved_bytes = want_threads * thread_bytes;
+		}
+		uint64_t max_rows = 0;
+		if (max_bytes >= fixed_bytes + reserved_bytes) {
+			max_rows = (max_bytes - fixed_bytes - reserved_bytes) / row_bytes;
+		}
+		uint64_t M = bind_data->effective_variant_ct;
+		uint64_t group_ct = max_rows > 0 ? (M + max_rows - 1) / max_rows : 0;
+		uint64_t row_ct = group_ct > 0 ? (M + group_ct - 1) / group_ct : 0;
+		if (row_ct <= bind_data->qq_col_ct) {
+			throw InvalidInputException("plink_pca: plinking_pca_sketch_max_bytes (%llu MB) is too small for %u samples "
+			                            "and %u PCs with algorithm := 'sketch' (need at least %llu MB)",
+			                            static_cast<unsigned long long>(max_bytes / (1024 * 1024)),
+			                            bind_data->effective_sample_ct, bind_data->n_pcs,
+			                            static_cast<unsigned long long>((min_bytes + 1024 * 1024 - 1) / (1024 * 1024)));
+		}
+		bind_data->sketch_group_ct = static_cast<uint32_t>(group_ct);
+		bind_data->sketch_row_ct = static_cast<uint32_t>(row_ct);
+		bind_data->sketch_max_threads =
+		    static_cast<uint32_t>(MinValue<uint64_t>((max_bytes - fixed_bytes - row_ct * row_bytes) / thread_bytes,
+		                                             std::numeric_limits<uint32_t>::max()));
+		pass_row_ct = bind_data->sketch_row_ct;
+	}
+
 	// --- Memory guard ---
-	uint64_t qq_elements = static_cast<uint64_t>(bind_data->effective_variant_ct) * bind_data->qq_col_ct;
+	uint64_t qq_elements = static_cast<uint64_t>(pass_row_ct) * bind_data->qq_col_ct;
 	Value max_elements_val;
 	uint64_t max_elements = 16ULL * 1024 * 1024 * 1024; // default
 	if (context.TryGetCurrentSetting("plinking_max_matrix_elements", max_elements_val)) {
@@ -467,6 +639,14 @@ static unique_ptr<FunctionData> PlinkPcaBind(ClientContext &context, TableFuncti
 	if (bind_data->mode == PcaMode::PCS) {
 		names = {"PC", "EIGENVALUE", "VARIANCE_PROPORTION", "CUMULATIVE_VARIANCE"};
 		return_types = {LogicalType::INTEGER, LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::DOUBLE};
+	} else if (bind_data->mode == PcaMode::LOADINGS) {
+		names = {"CHROM", "POS", "ID", "REF", "ALT", "ALT_FREQ"};
+		return_types = {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::VARCHAR,
+		                LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::DOUBLE};
+		for (uint32_t i = 0; i < bind_data->n_pcs; i++) {
+			names.push_back("PC" + std::to_string(i + 1));
+			return_types.push_back(LogicalType::DOUBLE);
+		}
 	} else if (bind_data->mode == PcaMode::SAMPLES) {
 		names = {"FID", "IID"};
 		return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR};
@@ -507,7 +687,20 @@ static unique_ptr<GlobalTableFunctionState> PlinkPcaInitGlobal(ClientContext &co
 	state->n_pcs = bind_data.n_pcs;
 	state->pc_ct_x2 = bind_data.pc_ct_x2;
 	state->qq_col_ct = bind_data.qq_col_ct;
-	state->total_passes = bind_data.n_pcs + 2;
+	state->sketch = bind_data.algorithm == PcaAlgorithm::SKETCH;
+	state->row_ct = state->sketch ? bind_data.sketch_row_ct : state->M;
+	state->sketch_group_ct = bind_data.sketch_group_ct;
+	state->sketch_max_threads = bind_data.sketch_max_threads;
+	if (state->sketch) {
+		state->schedule.push_back({PcaStage::SKETCH_BUILD, 0});
+	}
+	for (uint32_t pass = 0; pass <= bind_data.n_pcs + 1; pass++) {
+		state->schedule.push_back({PcaStage::PASS, pass});
+		if (pass >= bind_data.n_pcs) {
+			state->schedule.push_back({PcaStage::QR_FACTOR, pass});
+			state->schedule.push_back({PcaStage::QR_APPLY, pass});
+		}
+	}
 
 	state->column_ids = input.column_ids;
 	state->db_thread_count = static_cast<uint32_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
@@ -522,18 +715,76 @@ static unique_ptr<GlobalTableFunctionState> PlinkPcaInitGlobal(ClientContext &co
 		val = dist(rng);
 	}
 
-	// Allocate QQ (M x qq_col_ct)
-	state->QQ.resize(static_cast<size_t>(state->M) * state->qq_col_ct, 0.0);
+	// Allocate QQ (row_ct x qq_col_ct)
+	state->QQ.resize(static_cast<size_t>(state->row_ct) * state->qq_col_ct, 0.0);
 
 	// Allocate per-thread partial buffers
-	state->thread_partials.resize(state->thread_count);
-	for (auto &partial : state->thread_partials) {
-		partial.resize(static_cast<size_t>(state->N) * state->qq_col_ct, 0.0);
+	if (state->sketch) {
+		state->G1_f.assign(state->G1.begin(), state->G1.end());
+		idx_t rows_bytes = static_cast<idx_t>(state->row_ct) * state->N * sizeof(float);
+		idx_t partial_bytes = static_cast<idx_t>(state->N) * state->qq_col_ct * sizeof(float);
+		state->sketch_partials.resize(state->thread_count);
+		try {
+			state->sketch_rows.Allocate(context, rows_bytes);
+			for (auto &partial : state->sketch_partials) {
+				partial.Allocate(context, partial_bytes);
+			}
+		} catch (OutOfMemoryException &) {
+			throw OutOfMemoryException(
+			    "plink_pca: algorithm := 'sketch' needs %s for %u sketch rows x %u samples and %u thread partials, "
+			    "more than memory_limit has free. Lower plinking_pca_sketch_max_bytes (more variants are folded into "
+			    "each row), select fewer variants with variants := or region :=, or raise memory_limit.",
+			    StringUtil::BytesToHumanReadableString(rows_bytes + state->thread_count * partial_bytes),
+			    state->row_ct, state->N, state->thread_count);
+		}
+		std::memset(state->sketch_rows.ptr, 0, rows_bytes);
+		for (auto &partial : state->sketch_partials) {
+			std::memset(partial.ptr, 0, partial_bytes);
+		}
+	} else {
+		state->thread_partials.resize(state->thread_count);
+		for (auto &partial : state->thread_partials) {
+			partial.resize(static_cast<size_t>(state->N) * state->qq_col_ct, 0.0);
+		}
+	}
+	state->pass_sum.resize(static_cast<size_t>(state->N) * state->qq_col_ct, 0.0);
+	state->pass_merge.Init(state->N, MaxValue<idx_t>(1, StripedReduction::DEFAULT_STRIPE_ELEMENTS / state->qq_col_ct));
+
+	// Genovec cache, when it fits in half of DuckDB's remaining memory budget;
+	// otherwise every pass re-reads the .pgen. The sketch reads the .pgen once anyway.
+	// It is allocated through the buffer manager, so concurrent queries see it as used
+	// memory; if memory_limit fills up between the check and the allocation, re-read.
+	Value cache_val;
+	bool want_cache = !context.TryGetCurrentSetting("plinking_pca_genotype_cache", cache_val) ||
+	                  cache_val.IsNull() || cache_val.GetValue<bool>();
+	if (want_cache && !state->sketch && state->M > 0) {
+		state->genovec_cache_stride = plink2::NypCtToAlignedWordCt(state->N);
+		idx_t cache_bytes = static_cast<idx_t>(state->M) * state->genovec_cache_stride * sizeof(uintptr_t);
+		auto &buffer_manager = BufferManager::GetBufferManager(context);
+		idx_t max_memory = buffer_manager.GetMaxMemory();
+		idx_t used_memory = buffer_manager.GetUsedMemory();
+		idx_t budget = max_memory > used_memory ? (max_memory - used_memory) / 2 : 0;
+		if (cache_bytes <= budget) {
+			try {
+				state->genovec_cache.Allocate(context, cache_bytes);
+				state->use_genovec_cache = true;
+			} catch (OutOfMemoryException &) {
+				state->genovec_cache.Reset();
+			}
+		}
 	}
 
 	// Allocate results
 	state->eigenvectors.resize(static_cast<size_t>(state->N) * state->n_pcs, 0.0);
 	state->eigenvalues.resize(state->n_pcs, 0.0);
+	if (bind_data.mode == PcaMode::LOADINGS) {
+		state->want_loadings = true;
+		state->loadings.resize(static_cast<size_t>(state->M) * state->n_pcs, 0.0);
+	}
+
+	if (!bind_data.effective_variants.empty()) {
+		state->pgen_index = bind_data.pgen_index;
+	}
 
 	return std::move(state);
 }
@@ -555,52 +806,10 @@ static unique_ptr<LocalTableFunctionState> PlinkPcaInitLocal(ExecutionContext &c
 	// Assign thread ID
 	state->thread_id = gstate.next_thread_id.fetch_add(1);
 
-	// --- Initialize per-thread PgenFileInfo + PgenReader ---
+	// --- Per-thread PgenReader on the query's shared index ---
 	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
-	plink2::PreinitPgfi(&state->pgfi);
-	plink2::PreinitPgr(&state->pgr);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err =
-	    plink2::PgfiInitPhase1(bind_data.pgen_path.c_str(), nullptr, bind_data.raw_variant_ct, bind_data.raw_sample_ct,
-	                           &header_ctrl, &state->pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_pca: thread init failed (phase 1): %s", errstr_buf);
-	}
-
-	if (pgfi_alloc_cacheline_ct > 0) {
-		state->pgfi_alloc_buf.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, state->pgfi.raw_variant_ct, &max_vrec_width, &state->pgfi,
-	                             state->pgfi_alloc_buf.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_pca: thread init failed (phase 2): %s", errstr_buf);
-	}
-
-	if (pgr_alloc_cacheline_ct > 0) {
-		state->pgr_alloc_buf.Allocate(pgr_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	err = plink2::PgrInit(bind_data.pgen_path.c_str(), max_vrec_width, &state->pgfi, &state->pgr,
-	                      state->pgr_alloc_buf.As<unsigned char>());
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgr(&state->pgr, &cleanup_err);
-		cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_pca: PgrInit failed for '%s'", bind_data.pgen_path);
-	}
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_pca");
 
 	// Set up sample subsetting
 	if (bind_data.has_sample_subset && bind_data.sample_subset) {
@@ -617,7 +826,14 @@ static unique_ptr<LocalTableFunctionState> PlinkPcaInitLocal(ExecutionContext &c
 
 	// Allocate genotype processing buffers
 	state->geno_bytes.resize(bind_data.effective_sample_ct);
-	state->norm_geno.resize(bind_data.effective_sample_ct);
+	idx_t sample_ct = MaxValue<idx_t>(bind_data.effective_sample_ct, 1);
+	// The sketch build normalizes one variant at a time; its passes read sketch rows
+	state->panel_variant_ct = static_cast<uint32_t>(
+	    MaxValue<idx_t>(1, MinValue<idx_t>(PCA_VARIANT_BLOCK_SIZE, PCA_PANEL_MAX_DOUBLES / sample_ct)));
+	if (gstate.sketch) {
+		state->panel_variant_ct = 1;
+	}
+	state->panel.resize(static_cast<idx_t>(state->panel_variant_ct) * bind_data.effective_sample_ct);
 
 	state->initialized = true;
 	return std::move(state);
@@ -627,100 +843,230 @@ static unique_ptr<LocalTableFunctionState> PlinkPcaInitLocal(ExecutionContext &c
 // Accumulation helpers
 // ---------------------------------------------------------------------------
 
-// Step A: qq_row = norm_geno (1 x N) × G1 (N x pc_ct_x2) → 1 x pc_ct_x2
-// Written into QQ at row eff_idx, columns [col_offset, col_offset + pc_ct_x2)
-static void AccumulateStepA(PlinkPcaGlobalState &gs, const double *norm_geno, uint32_t eff_idx, uint32_t col_offset) {
-	uint32_t N = gs.N;
-	uint32_t pc_ct_x2 = gs.pc_ct_x2;
-	double *qq_row = &gs.QQ[static_cast<size_t>(eff_idx) * gs.qq_col_ct + col_offset];
-	const double *g1 = gs.G1.data();
-
-	for (uint32_t c = 0; c < pc_ct_x2; c++) {
-		double sum = 0.0;
-		for (uint32_t s = 0; s < N; s++) {
-			sum += norm_geno[s] * g1[static_cast<size_t>(s) * pc_ct_x2 + c];
-		}
-		qq_row[c] = sum;
-	}
-}
+// Each helper takes a panel P of `panel_ct` normalized variants (panel_ct x N,
+// row-major) starting at effective variant `first_eff_idx`, and runs as one GEMM.
 
-// Step B: g2_part += norm_genoᵀ (N x 1) × qq_row (1 x pc_ct_x2) → rank-1 update N x pc_ct_x2
-// Accumulated into thread_partials[tid] at appropriate column offset
-static void AccumulateStepB(PlinkPcaGlobalState &gs, uint32_t tid, const double *norm_geno, const double *qq_row,
+// Step A: QQ rows of the panel, columns [col_offset, col_offset + pc_ct_x2)
+//         = P (panel_ct x N) × G1 (N x pc_ct_x2)
+static void AccumulateStepA(PlinkPcaGlobalState &gs, const double *panel, uint32_t panel_ct, uint32_t first_eff_idx,
                             uint32_t col_offset) {
-	uint32_t N = gs.N;
-	uint32_t pc_ct_x2 = gs.pc_ct_x2;
-	double *partial = gs.thread_partials[tid].data();
+	Eigen::Map<const PcaRowMajorMatrix> p(panel, panel_ct, gs.N);
+	Eigen::Map<const PcaRowMajorMatrix> g1(gs.G1.data(), gs.N, gs.pc_ct_x2);
+	Eigen::Map<PcaRowMajorMatrix> qq(gs.QQ.data(), gs.row_ct, gs.qq_col_ct);
+	qq.block(first_eff_idx, col_offset, panel_ct, gs.pc_ct_x2).noalias() = p * g1;
+}
 
-	for (uint32_t s = 0; s < N; s++) {
-		double g = norm_geno[s];
-		for (uint32_t c = 0; c < pc_ct_x2; c++) {
-			partial[static_cast<size_t>(s) * gs.qq_col_ct + col_offset + c] += g * qq_row[c];
-		}
-	}
+// Step B: g2_part += Pᵀ (N x panel_ct) × QQ panel rows (panel_ct x pc_ct_x2)
+// Accumulated into thread_partials[tid] at the pass's column offset
+static void AccumulateStepB(PlinkPcaGlobalState &gs, uint32_t tid, const double *panel, uint32_t panel_ct,
+                            uint32_t first_eff_idx, uint32_t col_offset) {
+	Eigen::Map<const PcaRowMajorMatrix> p(panel, panel_ct, gs.N);
+	Eigen::Map<const PcaRowMajorMatrix> qq(gs.QQ.data(), gs.row_ct, gs.qq_col_ct);
+	Eigen::Map<PcaRowMajorMatrix> partial(gs.thread_partials[tid].data(), gs.N, gs.qq_col_ct);
+	partial.middleCols(col_offset, gs.pc_ct_x2).noalias() +=
+	    p.transpose() * qq.block(first_eff_idx, col_offset, panel_ct, gs.pc_ct_x2);
 }
 
-// Phase 3: bb_part += norm_genoᵀ (N x 1) × qq_row (1 x qq_col_ct) → rank-1 update N x qq_col_ct
-static void AccumulatePhase3(PlinkPcaGlobalState &gs, uint32_t tid, const double *norm_geno, uint32_t eff_idx) {
-	uint32_t N = gs.N;
-	uint32_t qq_col_ct = gs.qq_col_ct;
-	const double *qq_row = &gs.QQ[static_cast<size_t>(eff_idx) * qq_col_ct];
-	double *partial = gs.thread_partials[tid].data();
+// Phase 3: bb_part += Pᵀ (N x panel_ct) × QQ panel rows (panel_ct x qq_col_ct)
+static void AccumulatePhase3(PlinkPcaGlobalState &gs, uint32_t tid, const double *panel, uint32_t panel_ct,
+                             uint32_t first_eff_idx) {
+	Eigen::Map<const PcaRowMajorMatrix> p(panel, panel_ct, gs.N);
+	Eigen::Map<const PcaRowMajorMatrix> qq(gs.QQ.data(), gs.row_ct, gs.qq_col_ct);
+	Eigen::Map<PcaRowMajorMatrix> partial(gs.thread_partials[tid].data(), gs.N, gs.qq_col_ct);
+	partial.noalias() += p.transpose() * qq.middleRows(first_eff_idx, panel_ct);
+}
 
-	for (uint32_t s = 0; s < N; s++) {
-		double g = norm_geno[s];
-		for (uint32_t c = 0; c < qq_col_ct; c++) {
-			partial[static_cast<size_t>(s) * qq_col_ct + c] += g * qq_row[c];
+// Sketch passes: the same three products on a block of sketch rows, in single
+// precision. The rows are read in place; QQ stays double and is narrowed per block.
+static void AccumulateSketchBlock(PlinkPcaGlobalState &gs, uint32_t tid, uint32_t first_row, uint32_t row_ct,
+                                  uint32_t pass, uint32_t n_pcs) {
+	bool is_phase3 = (pass == n_pcs + 1);
+	uint32_t col_offset = is_phase3 ? 0 : pass * gs.pc_ct_x2;
+	Eigen::Map<const PcaRowMajorMatrixF> p(gs.sketch_rows.As<float>() + static_cast<size_t>(first_row) * gs.N, row_ct,
+	                                       gs.N);
+	Eigen::Map<PcaRowMajorMatrix> qq(gs.QQ.data(), gs.row_ct, gs.qq_col_ct);
+	Eigen::Map<PcaRowMajorMatrixF> partial(gs.sketch_partials[tid].As<float>(), gs.N, gs.qq_col_ct);
+
+	if (is_phase3) {
+		PcaRowMajorMatrixF qq_block = qq.middleRows(first_row, row_ct).cast<float>();
+		partial.noalias() += p.transpose() * qq_block;
+		return;
+	}
+
+	Eigen::Map<const PcaRowMajorMatrixF> g1(gs.G1_f.data(), gs.N, gs.pc_ct_x2);
+	PcaRowMajorMatrixF qq_block = p * g1;
+	qq.block(first_row, col_offset, row_ct, gs.pc_ct_x2) = qq_block.cast<double>();
+	if (pass < n_pcs) {
+		partial.middleCols(col_offset, gs.pc_ct_x2).noalias() += p.transpose() * qq_block;
+	}
+}
+
+// Fold this thread's partial (columns [col_offset, col_offset + col_ct)) into the
+// reduction: pair it with a partial waiting in sketch_merge_ready, adding outside
+// the lock, and repeat with the sum until no partner is waiting. Threads finishing
+// together combine in parallel, so the sums form a tree rather than a serial chain.
+static void MergeSketchPartial(PlinkPcaGlobalState &gs, uint32_t tid, uint32_t col_offset, uint32_t col_ct) {
+	uint32_t current = tid;
+	while (true) {
+		uint32_t other;
+		{
+			std::lock_guard<std::mutex> guard(gs.sketch_merge_lock);
+			if (gs.sketch_merge_ready.empty()) {
+				gs.sketch_merge_ready.push_back(current);
+				return;
+			}
+			other = gs.sketch_merge_ready.back();
+			gs.sketch_merge_ready.pop_back();
 		}
+		Eigen::Map<PcaRowMajorMatrixF> dst(gs.sketch_partials[current].As<float>(), gs.N, gs.qq_col_ct);
+		Eigen::Map<const PcaRowMajorMatrixF> src(gs.sketch_partials[other].As<float>(), gs.N, gs.qq_col_ct);
+		dst.middleCols(col_offset, col_ct) += src.middleCols(col_offset, col_ct);
 	}
 }
 
 // ---------------------------------------------------------------------------
-// SVD helpers (single-threaded, Eigen3)
+// Orthogonalization (tall-skinny QR)
 // ---------------------------------------------------------------------------
 
-// Phase 2 SVD: QQ (M x qq_col_ct) → overwrite with left singular vectors
-static void RunKrylovSVD(PlinkPcaGlobalState &gs) {
-	Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> qq_map(gs.QQ.data(), gs.M,
-	                                                                                          gs.qq_col_ct);
+// Set up the QR generations for `data` (row_ct x qq_col_ct). One block per thread,
+// each at least 2 * qq_col_ct rows (the whole matrix when it is shorter).
+static void BeginQr(PlinkPcaGlobalState &gs, double *data, const float *src_f32, uint32_t row_ct, bool final_qr) {
+	uint32_t c = gs.qq_col_ct;
+	gs.qr_data = data;
+	gs.qr_src_f32 = src_f32;
+	gs.qr_row_ct = row_ct;
+	gs.qr_block_ct = MaxValue<uint32_t>(1, MinValue<uint32_t>(gs.thread_count, row_ct / (2 * c)));
+	gs.qr_loadings_block_ct = 0;
+	if (final_qr && gs.want_loadings) {
+		gs.qr_loadings_block_ct = (gs.M + PCA_LOADINGS_BLOCK_SIZE - 1) / PCA_LOADINGS_BLOCK_SIZE;
+	}
+	gs.qr_r.assign(static_cast<size_t>(gs.qr_block_ct) * c * c, 0.0);
+	gs.qr_probe.assign(final_qr ? static_cast<size_t>(gs.qr_block_ct) * c : 0, 0.0);
+}
 
-	Eigen::BDCSVD<Eigen::MatrixXd> svd(qq_map, Eigen::ComputeThinU);
+static void QrBlockRange(const PlinkPcaGlobalState &gs, uint32_t block, uint32_t &begin, uint32_t &end) {
+	begin = static_cast<uint32_t>(static_cast<uint64_t>(gs.qr_row_ct) * block / gs.qr_block_ct);
+	end = static_cast<uint32_t>(static_cast<uint64_t>(gs.qr_row_ct) * (block + 1) / gs.qr_block_ct);
+}
 
-	// Overwrite QQ with left singular vectors (M x qq_col_ct)
-	// Eigen BDCSVD returns column-major U; we need to write back row-major
-	auto &U = svd.matrixU();
-	for (uint32_t r = 0; r < gs.M; r++) {
-		for (uint32_t c = 0; c < gs.qq_col_ct; c++) {
-			gs.QQ[static_cast<size_t>(r) * gs.qq_col_ct + c] = U(r, c);
+// QR_FACTOR: A_i = Q_i R_i. Q_i (thin) replaces the block's rows, R_i goes to qr_r.
+static void FactorQrBlock(PlinkPcaGlobalState &gs, uint32_t block) {
+	uint32_t c = gs.qq_col_ct;
+	uint32_t begin, end;
+	QrBlockRange(gs, block, begin, end);
+	uint32_t row_ct = end - begin;
+
+	Eigen::Map<PcaRowMajorMatrix> dst(gs.qr_data + static_cast<size_t>(begin) * c, row_ct, c);
+	Eigen::MatrixXd a;
+	if (gs.qr_src_f32) {
+		a = Eigen::Map<const PcaRowMajorMatrixF>(gs.qr_src_f32 + static_cast<size_t>(begin) * c, row_ct, c)
+		        .cast<double>();
+	} else {
+		a = dst;
+	}
+	Eigen::HouseholderQR<Eigen::MatrixXd> qr(a);
+	dst = qr.householderQ() * Eigen::MatrixXd::Identity(row_ct, c);
+	Eigen::Map<PcaRowMajorMatrix> r(gs.qr_r.data() + static_cast<size_t>(block) * c * c, c, c);
+	r = qr.matrixQR().topRows(c).triangularView<Eigen::Upper>();
+
+	if (!gs.qr_probe.empty()) {
+		Eigen::VectorXd probe(row_ct);
+		for (uint32_t i = 0; i < row_ct; i++) {
+			probe(i) = (PcaSketchHash(PCA_SIGN_PROBE_SEED ^ (begin + i)) & 1) ? 1.0 : -1.0;
 		}
+		Eigen::Map<Eigen::RowVectorXd> out(gs.qr_probe.data() + static_cast<size_t>(block) * c, c);
+		out.noalias() = probe.transpose() * dst;
 	}
 }
 
-// Phase 3 SVD: BB (N x qq_col_ct) → eigenvectors and eigenvalues
-static void RunFinalSVD(PlinkPcaGlobalState &gs, const vector<double> &bb) {
-	Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> bb_map(bb.data(), gs.N,
-	                                                                                                gs.qq_col_ct);
-
-	Eigen::BDCSVD<Eigen::MatrixXd> svd(bb_map, Eigen::ComputeThinU);
+// Serial step between QR_FACTOR and QR_APPLY: factor the stacked R_i. For BB, also
+// take the small SVD R = U_R S Vᵀ, so BB = (Q_b U_R) S Vᵀ: the eigenvalues come from
+// S here and the eigenvectors Q_i Q'_i U_R from QR_APPLY.
+static void CombineQr(PlinkPcaGlobalState &gs, bool final_qr) {
+	uint32_t c = gs.qq_col_ct;
+	idx_t stack_rows = static_cast<idx_t>(gs.qr_block_ct) * c;
+	Eigen::Map<PcaRowMajorMatrix> stack(gs.qr_r.data(), stack_rows, c);
+	Eigen::HouseholderQR<Eigen::MatrixXd> qr(stack);
+	Eigen::MatrixXd r = qr.matrixQR().topRows(c).triangularView<Eigen::Upper>();
+	stack = qr.householderQ() * Eigen::MatrixXd::Identity(stack_rows, c);
+	if (!final_qr) {
+		return;
+	}
 
-	auto &U = svd.matrixU();
+	Eigen::BDCSVD<Eigen::MatrixXd> svd(r, Eigen::ComputeThinU | Eigen::ComputeThinV);
+	Eigen::MatrixXd u = svd.matrixU().leftCols(gs.n_pcs);
+	Eigen::MatrixXd v = svd.matrixV().leftCols(gs.n_pcs);
 	auto &S = svd.singularValues();
 
-	// Extract top n_pcs eigenvectors (columns of U) and eigenvalues (S²/M)
-	for (uint32_t s = 0; s < gs.N; s++) {
-		for (uint32_t pc = 0; pc < gs.n_pcs; pc++) {
-			gs.eigenvectors[static_cast<size_t>(s) * gs.n_pcs + pc] = U(s, pc);
+	// Eigenvector signs are arbitrary; fix each so its dot product with a hashed ±1
+	// probe over the samples is positive, whatever the block layout
+	Eigen::RowVectorXd probe_q = Eigen::RowVectorXd::Zero(c);
+	for (uint32_t block = 0; block < gs.qr_block_ct; block++) {
+		Eigen::Map<const Eigen::RowVectorXd> t(gs.qr_probe.data() + static_cast<size_t>(block) * c, c);
+		probe_q.noalias() += t * stack.middleRows(static_cast<idx_t>(block) * c, c);
+	}
+	for (uint32_t pc = 0; pc < gs.n_pcs; pc++) {
+		if (probe_q.dot(u.col(pc)) < 0.0) {
+			u.col(pc) *= -1.0;
+			v.col(pc) *= -1.0;
 		}
 	}
 
-	double total_variance = 0.0;
 	for (uint32_t pc = 0; pc < gs.n_pcs; pc++) {
 		gs.eigenvalues[pc] = S(pc) * S(pc) / static_cast<double>(gs.M);
-		total_variance += gs.eigenvalues[pc];
 	}
 
-	// Store total variance for proportion computation (store after eigenvalues)
-	// We'll compute proportions at emission time using the eigenvalues directly
+	gs.qr_w.resize(stack_rows * gs.n_pcs);
+	Eigen::Map<PcaRowMajorMatrix> w(gs.qr_w.data(), stack_rows, gs.n_pcs);
+	w.noalias() = stack * u;
+
+	// Variant loadings. BB = Xᵀ Q = U S Vᵀ (X = normalized genotypes, M x N), so
+	// XU ≈ Q V S. Each loading is (QV)_jk / S_k: summing a sample's normalized
+	// genotypes times the loadings, Xᵀ Q V / S = U, gives back its PC coordinates,
+	// which is what plink_pca_project does for new samples.
+	if (gs.want_loadings) {
+		for (uint32_t pc = 0; pc < gs.n_pcs; pc++) {
+			if (S(pc) > 0.0) {
+				v.col(pc) /= S(pc);
+			} else {
+				v.col(pc).setZero();
+			}
+		}
+		gs.qr_v.resize(static_cast<size_t>(c) * gs.n_pcs);
+		Eigen::Map<PcaRowMajorMatrix>(gs.qr_v.data(), c, gs.n_pcs) = v;
+	}
+}
+
+// QR_APPLY work item `item`: block i of QQ becomes Q_i Q'_i; for BB, block i gives
+// its samples' eigenvectors Q_i Q'_i U_R, and items past the blocks compute a range
+// of loadings rows QQ V / S.
+static void ApplyQrItem(PlinkPcaGlobalState &gs, uint32_t item, bool final_qr) {
+	uint32_t c = gs.qq_col_ct;
+	if (item >= gs.qr_block_ct) {
+		uint32_t first = (item - gs.qr_block_ct) * PCA_LOADINGS_BLOCK_SIZE;
+		uint32_t row_ct = MinValue<uint32_t>(PCA_LOADINGS_BLOCK_SIZE, gs.M - first);
+		Eigen::Map<const PcaRowMajorMatrix> qq(gs.QQ.data() + static_cast<size_t>(first) * c, row_ct, c);
+		Eigen::Map<const PcaRowMajorMatrix> v(gs.qr_v.data(), c, gs.n_pcs);
+		Eigen::Map<PcaRowMajorMatrix> loadings(gs.loadings.data() + static_cast<size_t>(first) * gs.n_pcs, row_ct,
+		                                       gs.n_pcs);
+		loadings.noalias() = qq * v;
+		return;
+	}
+
+	uint32_t begin, end;
+	QrBlockRange(gs, item, begin, end);
+	Eigen::Map<PcaRowMajorMatrix> q(gs.qr_data + static_cast<size_t>(begin) * c, end - begin, c);
+	if (final_qr) {
+		Eigen::Map<const PcaRowMajorMatrix> w(gs.qr_w.data() + static_cast<size_t>(item) * c * gs.n_pcs, c,
+		                                      gs.n_pcs);
+		Eigen::Map<PcaRowMajorMatrix> eigenvectors(gs.eigenvectors.data() + static_cast<size_t>(begin) * gs.n_pcs,
+		                                           end - begin, gs.n_pcs);
+		eigenvectors.noalias() = q * w;
+	} else {
+		Eigen::Map<const PcaRowMajorMatrix> q_prime(gs.qr_r.data() + static_cast<size_t>(item) * c * c, c, c);
+		PcaRowMajorMatrix rotated = q * q_prime;
+		q = rotated;
+	}
 }
 
 // ---------------------------------------------------------------------------
@@ -825,6 +1171,62 @@ static void EmitPcsMode(const PlinkPcaBindData &bind_data, PlinkPcaGlobalState &
 	CompatSetOutputCardinality(output, rows_emitted);
 }
 
+static void EmitLoadingsMode(const PlinkPcaBindData &bind_data, PlinkPcaGlobalState &gs, DataChunk &output) {
+	auto &column_ids = gs.column_ids;
+	idx_t rows_emitted = 0;
+
+	while (rows_emitted < STANDARD_VECTOR_SIZE) {
+		uint32_t eff_idx = gs.next_emit_idx.fetch_add(1);
+		if (eff_idx >= gs.M) {
+			break;
+		}
+
+		auto &ev = bind_data.effective_variants[eff_idx];
+		uint32_t vidx = ev.pgen_idx;
+
+		for (idx_t out_col = 0; out_col < column_ids.size(); out_col++) {
+			auto file_col = column_ids[out_col];
+			if (file_col == COLUMN_IDENTIFIER_ROW_ID) {
+				continue;
+			}
+
+			auto &vec = output.data[out_col];
+
+			if (file_col == LCOL_CHROM) {
+				FlatVector::GetData<string_t>(vec)[rows_emitted] =
+				    StringVector::AddString(vec, bind_data.variants.GetChrom(vidx));
+			} else if (file_col == LCOL_POS) {
+				FlatVector::GetData<int32_t>(vec)[rows_emitted] = bind_data.variants.GetPos(vidx);
+			} else if (file_col == LCOL_ID) {
+				auto &val = bind_data.variants.GetId(vidx);
+				if (val.empty()) {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
+					FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
+				}
+			} else if (file_col == LCOL_REF) {
+				FlatVector::GetData<string_t>(vec)[rows_emitted] =
+				    StringVector::AddString(vec, bind_data.variants.GetRef(vidx));
+			} else if (file_col == LCOL_ALT) {
+				auto val = bind_data.variants.GetAlt(vidx);
+				if (val.empty() || val == ".") {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				} else {
+					FlatVector::GetData<string_t>(vec)[rows_emitted] = StringVector::AddString(vec, val);
+				}
+			} else if (file_col == LCOL_ALT_FREQ) {
+				FlatVector::GetData<double>(vec)[rows_emitted] = ev.alt_freq;
+			} else if (file_col >= LCOL_PC_START && file_col < LCOL_PC_START + bind_data.n_pcs) {
+				uint32_t pc = static_cast<uint32_t>(file_col - LCOL_PC_START);
+				FlatVector::GetData<double>(vec)[rows_emitted] =
+				    gs.loadings[static_cast<size_t>(eff_idx) * gs.n_pcs + pc];
+			}
+		}
+		rows_emitted++;
+	}
+	CompatSetOutputCardinality(output, rows_emitted);
+}
+
 static void EmitBothMode(const PlinkPcaBindData &bind_data, PlinkPcaGlobalState &gs, DataChunk &output) {
 	// Single row with nested structures
 	uint32_t emit_idx = gs.next_emit_idx.fetch_add(1);
@@ -884,6 +1286,9 @@ static void ScanVariantPass(const PlinkPcaBindData &bind_data, PlinkPcaGlobalSta
 	uint32_t M = gs.M;
 	bool is_phase3 = (pass == bind_data.n_pcs + 1);
 	uint32_t col_offset = is_phase3 ? 0 : pass * gs.pc_ct_x2;
+	bool from_cache = gs.use_genovec_cache && gs.genovec_cache_ready;
+	bool fill_cache = gs.use_genovec_cache && !gs.genovec_cache_ready;
+	bool claimed = false;
 
 	while (true) {
 		uint32_t block_start = gs.next_block_idx.fetch_add(PCA_VARIANT_BLOCK_SIZE);
@@ -892,69 +1297,231 @@ static void ScanVariantPass(const PlinkPcaBindData &bind_data, PlinkPcaGlobalSta
 		}
 		uint32_t block_end = std::min(block_start + PCA_VARIANT_BLOCK_SIZE, M);
 
-		for (uint32_t eff_idx = block_start; eff_idx < block_end; eff_idx++) {
-			auto &ev = bind_data.effective_variants[eff_idx];
+		for (uint32_t panel_start = block_start; panel_start < block_end; panel_start += ls.panel_variant_ct) {
+			uint32_t panel_ct = std::min(ls.panel_variant_ct, block_end - panel_start);
+
+			// Decode and normalize the panel's variants, one row each
+			for (uint32_t i = 0; i < panel_ct; i++) {
+				uint32_t eff_idx = panel_start + i;
+				auto &ev = bind_data.effective_variants[eff_idx];
+				uintptr_t *cached = gs.use_genovec_cache
+				                        ? gs.genovec_cache.As<uintptr_t>() + eff_idx * gs.genovec_cache_stride
+				                        : nullptr;
+
+				const uintptr_t *genovec = cached;
+				if (!from_cache) {
+					plink2::PglErr err = plink2::PgrGet(sample_include, ls.pssi, sample_ct, ev.pgen_idx, &ls.pgr,
+					                                    ls.genovec_buf.As<uintptr_t>());
+					if (err != plink2::kPglRetSuccess) {
+						throw IOException("plink_pca: PgrGet failed for variant %u", ev.pgen_idx);
+					}
+					genovec = ls.genovec_buf.As<uintptr_t>();
+					if (fill_cache) {
+						std::memcpy(cached, genovec, gs.genovec_cache_stride * sizeof(uintptr_t));
+					}
+				}
 
-			plink2::PglErr err = plink2::PgrGet(sample_include, ls.pssi, sample_ct, ev.pgen_idx, &ls.pgr,
-			                                    ls.genovec_buf.As<uintptr_t>());
-			if (err != plink2::kPglRetSuccess) {
-				throw IOException("plink_pca: PgrGet failed for variant %u", ev.pgen_idx);
+				plink2::GenoarrToBytesMinus9(genovec, sample_ct, ls.geno_bytes.data());
+				NormalizeGenotypes(ls.geno_bytes.data(), sample_ct, ev.norm,
+				                   ls.panel.data() + static_cast<size_t>(i) * sample_ct);
 			}
 
-			plink2::GenoarrToBytesMinus9(ls.genovec_buf.As<uintptr_t>(), sample_ct, ls.geno_bytes.data());
-			NormalizeGenotypes(ls.geno_bytes.data(), sample_ct, ev.norm, ls.norm_geno.data());
-
 			if (is_phase3) {
-				AccumulatePhase3(gs, ls.thread_id, ls.norm_geno.data(), eff_idx);
+				AccumulatePhase3(gs, ls.thread_id, ls.panel.data(), panel_ct, panel_start);
 			} else {
-				AccumulateStepA(gs, ls.norm_geno.data(), eff_idx, col_offset);
+				AccumulateStepA(gs, ls.panel.data(), panel_ct, panel_start, col_offset);
 
 				if (pass < bind_data.n_pcs) {
-					const double *qq_row = &gs.QQ[static_cast<size_t>(eff_idx) * gs.qq_col_ct + col_offset];
-					AccumulateStepB(gs, ls.thread_id, ls.norm_geno.data(), qq_row, col_offset);
+					AccumulateStepB(gs, ls.thread_id, ls.panel.data(), panel_ct, panel_start, col_offset);
+				}
+			}
+		}
+		claimed = true;
+	}
+
+	// Add this thread's columns of the pass into pass_sum (pass n_pcs only fills QQ)
+	if (claimed && pass != bind_data.n_pcs) {
+		uint32_t col_ct = is_phase3 ? gs.qq_col_ct : gs.pc_ct_x2;
+		auto &partial = gs.thread_partials[ls.thread_id];
+		gs.pass_merge.Merge([&](idx_t begin, idx_t end) {
+			for (idx_t s = begin; s < end; s++) {
+				double *dst = gs.pass_sum.data() + s * gs.qq_col_ct + col_offset;
+				const double *src = partial.data() + s * gs.qq_col_ct + col_offset;
+				for (uint32_t c = 0; c < col_ct; c++) {
+					dst[c] += src[c];
+				}
+			}
+		});
+	}
+}
+
+// Sketch generation 0: one read of the .pgen. Row r is the sum of effective
+// variants [r * group_ct, (r + 1) * group_ct), each normalized and multiplied by a
+// hashed ±1 sign (all +1 when group_ct is 1, so the rows are the variants).
+static void BuildSketchRows(const PlinkPcaBindData &bind_data, PlinkPcaGlobalState &gs, PlinkPcaLocalState &ls,
+                            const uintptr_t *sample_include) {
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	uint32_t group_ct = gs.sketch_group_ct;
+
+	while (true) {
+		uint32_t block_start = gs.next_block_idx.fetch_add(PCA_VARIANT_BLOCK_SIZE);
+		if (block_start >= gs.row_ct) {
+			break;
+		}
+		uint32_t block_end = std::min(block_start + PCA_VARIANT_BLOCK_SIZE, gs.row_ct);
+
+		for (uint32_t row = block_start; row < block_end; row++) {
+			float *dst = gs.sketch_rows.As<float>() + static_cast<size_t>(row) * sample_ct;
+			uint32_t eff_end = static_cast<uint32_t>(
+			    std::min<uint64_t>(static_cast<uint64_t>(row + 1) * group_ct, gs.M));
+			for (uint32_t eff_idx = row * group_ct; eff_idx < eff_end; eff_idx++) {
+				auto &ev = bind_data.effective_variants[eff_idx];
+				plink2::PglErr err = plink2::PgrGet(sample_include, ls.pssi, sample_ct, ev.pgen_idx, &ls.pgr,
+				                                    ls.genovec_buf.As<uintptr_t>());
+				if (err != plink2::kPglRetSuccess) {
+					throw IOException("plink_pca: PgrGet failed for variant %u", ev.pgen_idx);
+				}
+				plink2::GenoarrToBytesMinus9(ls.genovec_buf.As<uintptr_t>(), sample_ct, ls.geno_bytes.data());
+				NormalizeGenotypes(ls.geno_bytes.data(), sample_ct, ev.norm, ls.panel.data());
+
+				double sign = 1.0;
+				if (group_ct > 1 && (PcaSketchHash(PCA_SKETCH_SEED ^ eff_idx) & 1)) {
+					sign = -1.0;
+				}
+				for (uint32_t s = 0; s < sample_ct; s++) {
+					dst[s] += static_cast<float>(sign * ls.panel[s]);
 				}
 			}
 		}
 	}
 }
 
-static void MergePass(const PlinkPcaBindData &bind_data, PlinkPcaGlobalState &gs, uint32_t pass) {
-	uint32_t N = gs.N;
+// Sketch generations 1..n_pcs + 2: subspace pass `pass` over the sketch rows
+static void ScanSketchPass(const PlinkPcaBindData &bind_data, PlinkPcaGlobalState &gs, PlinkPcaLocalState &ls,
+                           uint32_t pass) {
 	bool is_phase3 = (pass == bind_data.n_pcs + 1);
 	uint32_t col_offset = is_phase3 ? 0 : pass * gs.pc_ct_x2;
+	uint32_t col_ct = is_phase3 ? gs.qq_col_ct : gs.pc_ct_x2;
 
-	if (is_phase3) {
-		vector<double> bb(static_cast<size_t>(N) * gs.qq_col_ct, 0.0);
-		for (uint32_t t = 0; t < gs.thread_count; t++) {
-			auto &partial = gs.thread_partials[t];
-			for (size_t i = 0; i < bb.size(); i++) {
-				bb[i] += partial[i];
-			}
+	Eigen::Map<PcaRowMajorMatrixF> partial(gs.sketch_partials[ls.thread_id].As<float>(), gs.N, gs.qq_col_ct);
+	partial.middleCols(col_offset, col_ct).setZero();
+
+	while (true) {
+		uint32_t block_start = gs.next_block_idx.fetch_add(PCA_VARIANT_BLOCK_SIZE);
+		if (block_start >= gs.row_ct) {
+			break;
 		}
-		RunFinalSVD(gs, bb);
-		gs.algorithm_done.store(true, std::memory_order_release);
-		return;
+		uint32_t block_end = std::min(block_start + PCA_VARIANT_BLOCK_SIZE, gs.row_ct);
+		AccumulateSketchBlock(gs, ls.thread_id, block_start, block_end - block_start, pass, bind_data.n_pcs);
 	}
 
-	// Merge thread partials → G2, compute G1 = G2 / M
-	std::fill(gs.G1.begin(), gs.G1.end(), 0.0);
-	for (uint32_t t = 0; t < gs.thread_count; t++) {
-		auto &partial = gs.thread_partials[t];
-		for (uint32_t s = 0; s < N; s++) {
-			for (uint32_t c = 0; c < gs.pc_ct_x2; c++) {
-				gs.G1[static_cast<size_t>(s) * gs.pc_ct_x2 + c] +=
-				    partial[static_cast<size_t>(s) * gs.qq_col_ct + col_offset + c];
+	if (pass != bind_data.n_pcs) {
+		MergeSketchPartial(gs, ls.thread_id, col_offset, col_ct);
+	}
+}
+
+// Work of one barrier generation, run by every participating thread
+static void RunGeneration(const PlinkPcaBindData &bind_data, PlinkPcaGlobalState &gs, PlinkPcaLocalState &ls,
+                          const uintptr_t *sample_include, uint32_t gen) {
+	auto &step = gs.schedule[gen];
+	switch (step.stage) {
+	case PcaStage::SKETCH_BUILD:
+		BuildSketchRows(bind_data, gs, ls, sample_include);
+		return;
+	case PcaStage::PASS: {
+		if (gs.sketch) {
+			ScanSketchPass(bind_data, gs, ls, step.pass);
+			return;
+		}
+		bool is_phase3 = (step.pass == bind_data.n_pcs + 1);
+		Eigen::Map<PcaRowMajorMatrix> partial(gs.thread_partials[ls.thread_id].data(), gs.N, gs.qq_col_ct);
+		if (is_phase3) {
+			partial.setZero();
+		} else {
+			partial.middleCols(step.pass * gs.pc_ct_x2, gs.pc_ct_x2).setZero();
+		}
+		ScanVariantPass(bind_data, gs, ls, sample_include, step.pass);
+		return;
+	}
+	case PcaStage::QR_FACTOR:
+		while (true) {
+			uint32_t block = gs.next_block_idx.fetch_add(1);
+			if (block >= gs.qr_block_ct) {
+				return;
+			}
+			FactorQrBlock(gs, block);
+		}
+	case PcaStage::QR_APPLY:
+		while (true) {
+			uint32_t item = gs.next_block_idx.fetch_add(1);
+			if (item >= gs.qr_block_ct + gs.qr_loadings_block_ct) {
+				return;
 			}
+			ApplyQrItem(gs, item, step.pass == bind_data.n_pcs + 1);
 		}
 	}
+}
 
-	double inv_M = 1.0 / static_cast<double>(gs.M);
-	for (auto &val : gs.G1) {
-		val *= inv_M;
+// Last thread of a PASS generation: G1 = G2 / M from the pass total, or hand QQ
+// (after pass n_pcs) or BB (after the final pass) to the QR generations
+static void MergePass(const PlinkPcaBindData &bind_data, PlinkPcaGlobalState &gs, uint32_t pass) {
+	uint32_t N = gs.N;
+	bool is_phase3 = (pass == bind_data.n_pcs + 1);
+	uint32_t col_offset = is_phase3 ? 0 : pass * gs.pc_ct_x2;
+
+	// Every variant has passed through pass 0, so the genovec cache is complete
+	gs.genovec_cache_ready = gs.use_genovec_cache;
+
+	// Sketch partials were folded by the threads themselves; the total is the one
+	// left in sketch_merge_ready (pass n_pcs has no partials: QQ only)
+	const float *sketch_total = nullptr;
+	if (gs.sketch && pass != bind_data.n_pcs) {
+		D_ASSERT(gs.sketch_merge_ready.size() == 1);
+		sketch_total = gs.sketch_partials[gs.sketch_merge_ready[0]].As<float>();
+		gs.sketch_merge_ready.clear();
 	}
 
+	if (is_phase3) {
+		BeginQr(gs, gs.pass_sum.data(), sketch_total, N, true);
+		return;
+	}
 	if (pass == bind_data.n_pcs) {
-		RunKrylovSVD(gs);
+		BeginQr(gs, gs.QQ.data(), nullptr, gs.row_ct, false);
+		return;
+	}
+
+	// G1 = G2 / M; the pass's pass_sum columns are cleared for later passes
+	double inv_M = 1.0 / static_cast<double>(gs.M);
+	for (uint32_t s = 0; s < N; s++) {
+		size_t src = static_cast<size_t>(s) * gs.qq_col_ct + col_offset;
+		for (uint32_t c = 0; c < gs.pc_ct_x2; c++) {
+			double g2 = sketch_total ? sketch_total[src + c] : gs.pass_sum[src + c];
+			gs.G1[static_cast<size_t>(s) * gs.pc_ct_x2 + c] = g2 * inv_M;
+			gs.pass_sum[src + c] = 0.0;
+		}
+	}
+	if (gs.sketch) {
+		gs.G1_f.assign(gs.G1.begin(), gs.G1.end());
+	}
+}
+
+// Serial step of the last thread to finish generation `gen`
+static void FinishGeneration(const PlinkPcaBindData &bind_data, PlinkPcaGlobalState &gs, uint32_t gen) {
+	auto &step = gs.schedule[gen];
+	switch (step.stage) {
+	case PcaStage::SKETCH_BUILD:
+		return; // rows were written in place
+	case PcaStage::PASS:
+		MergePass(bind_data, gs, step.pass);
+		return;
+	case PcaStage::QR_FACTOR:
+		CombineQr(gs, step.pass == bind_data.n_pcs + 1);
+		return;
+	case PcaStage::QR_APPLY:
+		if (step.pass == bind_data.n_pcs + 1) {
+			gs.algorithm_done.store(true, std::memory_order_release);
+		}
+		return;
 	}
 }
 
@@ -975,6 +1542,9 @@ static void PlinkPcaScan(ClientContext &context, TableFunctionInput &data_p, Dat
 		case PcaMode::BOTH:
 			EmitBothMode(bind_data, gs, output);
 			return;
+		case PcaMode::LOADINGS:
+			EmitLoadingsMode(bind_data, gs, output);
+			return;
 		}
 	}
 
@@ -996,9 +1566,9 @@ static void PlinkPcaScan(ClientContext &context, TableFunctionInput &data_p, Dat
 
 	// pass_generation starts at 0 and the first Scan entry sees
 	// last_generation_seen == UINT32_MAX != 0, so it proceeds.
-	// gen maps directly to the pass number.
+	// gen indexes gs.schedule.
 	uint32_t pass = gen;
-	if (pass >= gs.total_passes) {
+	if (pass >= gs.schedule.size()) {
 		CompatSetOutputCardinality(output, 0);
 		return;
 	}
@@ -1011,9 +1581,8 @@ static void PlinkPcaScan(ClientContext &context, TableFunctionInput &data_p, Dat
 	// Register this thread as active in the current pass
 	gs.pass_active_threads.fetch_add(1, std::memory_order_acq_rel);
 
-	// Zero partial and scan variant blocks (parallel with other threads)
-	std::fill(gs.thread_partials[ls.thread_id].begin(), gs.thread_partials[ls.thread_id].end(), 0.0);
-	ScanVariantPass(bind_data, gs, ls, sample_include, pass);
+	// Zero partial and scan this generation's blocks (parallel with other threads)
+	RunGeneration(bind_data, gs, ls, sample_include, pass);
 
 	// --- Barrier ---
 	uint32_t remaining = gs.pass_active_threads.fetch_sub(1, std::memory_order_acq_rel);
@@ -1032,7 +1601,7 @@ static void PlinkPcaScan(ClientContext &context, TableFunctionInput &data_p, Dat
 	// only returning when it either emits rows (algorithm done) or yields
 	// to let other threads help with the next pass.
 	while (true) {
-		MergePass(bind_data, gs, pass);
+		FinishGeneration(bind_data, gs, pass);
 
 		if (gs.algorithm_done.load(std::memory_order_relaxed)) {
 			switch (bind_data.mode) {
@@ -1045,6 +1614,9 @@ static void PlinkPcaScan(ClientContext &context, TableFunctionInput &data_p, Dat
 			case PcaMode::BOTH:
 				EmitBothMode(bind_data, gs, output);
 				return;
+			case PcaMode::LOADINGS:
+				EmitLoadingsMode(bind_data, gs, output);
+				return;
 			}
 		}
 
@@ -1059,8 +1631,7 @@ static void PlinkPcaScan(ClientContext &context, TableFunctionInput &data_p, Dat
 		// the normal Scan entry path) so the barrier works correctly
 		// regardless of whether other threads have joined yet.
 		gs.pass_active_threads.fetch_add(1, std::memory_order_acq_rel);
-		std::fill(gs.thread_partials[ls.thread_id].begin(), gs.thread_partials[ls.thread_id].end(), 0.0);
-		ScanVariantPass(bind_data, gs, ls, sample_include, pass);
+		RunGeneration(bind_data, gs, ls, sample_include, pass);
 
 		// Decrement and check if we're still last
 		remaining = gs.pass_active_threads.fetch_sub(1, std::memory_order_acq_rel);
@@ -1092,9 +1663,11 @@ void RegisterPlinkPca(ExtensionLoader &loader) {
 	plink_pca.named_parameters["pvar"] = LogicalType::VARCHAR;
 	plink_pca.named_parameters["psam"] = LogicalType::VARCHAR;
 	plink_pca.named_parameters["mode"] = LogicalType::VARCHAR;
+	plink_pca.named_parameters["algorithm"] = LogicalType::VARCHAR;
 	plink_pca.named_parameters["n_pcs"] = LogicalType::INTEGER;
 	plink_pca.named_parameters["samples"] = LogicalType::ANY;
 	plink_pca.named_parameters["region"] = LogicalType::VARCHAR;
+	plink_pca.named_parameters["variants"] = LogicalType::ANY;
 
 	loader.RegisterFunction(plink_pca);
 }
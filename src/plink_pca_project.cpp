@@ -0,0 +1,593 @@
+// plink_pca_project.cpp — project samples onto the variant loadings saved from
+// plink_pca(mode := 'loadings'); per-sample PC output.
+//
+// Each loadings row carries the reference ALT frequency, so the target genotypes
+// are normalized exactly as plink_pca normalized the reference panel
+// (ComputeVariantNorm / NormalizeGenotypes, missing calls mean-imputed). A sample's
+// projection is then Σ_j x_j · loading_j, which for the reference samples gives
+// back their own PCs. That is a single streaming pass over the target .pgen:
+// threads claim variant batches and accumulate samples × PCs scores, merged
+// stripe-parallel at the end (the plink_score accumulator pattern).
+
+#include "plink_pca.hpp"
+#include "duckdb_compat.hpp"
+#include "plink_common.hpp"
+#include "pgen_vfs_opener.hpp"
+
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <unordered_map>
+
+namespace duckdb {
+
+// ---------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------
+
+static constexpr uint32_t PROJECT_BATCH_SIZE = 240;
+
+// Per-thread cap on the normalized-genotype panel (variants × samples doubles)
+static constexpr idx_t PROJECT_PANEL_MAX_DOUBLES = idx_t(1) << 23;
+
+using ProjectRowMajorMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+// ---------------------------------------------------------------------------
+// Column indices
+// ---------------------------------------------------------------------------
+
+static constexpr idx_t COL_FID = 0;
+static constexpr idx_t COL_IID = 1;
+static constexpr idx_t COL_PC_START = 2; // one column per loadings PC field
+
+// ---------------------------------------------------------------------------
+// Projected variant (target pgen index + reference normalization)
+// ---------------------------------------------------------------------------
+
+struct ProjectedVariant {
+	uint32_t pgen_idx;
+	uint32_t weight_row; // row of bind_data.weights (pc_ct loadings)
+	VariantNorm norm;    // reference normalization, in the target's ALT orientation
+};
+
+// ---------------------------------------------------------------------------
+// Bind data
+// ---------------------------------------------------------------------------
+
+struct PlinkPcaProjectBindData : public TableFunctionData {
+	string pgen_path;
+	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
+	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
+	string pvar_path;
+	string psam_path;
+
+	VariantMetadataIndex variants;
+	SampleInfo sample_info;
+
+	uint32_t raw_variant_ct = 0;
+	uint32_t raw_sample_ct = 0;
+
+	// Sample subsetting
+	bool has_sample_subset = false;
+	unique_ptr<SampleSubset> sample_subset;
+	uint32_t effective_sample_ct = 0;
+
+	// Loadings matched to the target, sorted by pgen index
+	vector<ProjectedVariant> projected_variants;
+	uint32_t pc_ct = 0;
+	vector<string> pc_names;
+	vector<double> weights; // one row of pc_ct loadings per matched variant
+
+	// Sample output order (maps emit index → original sample index)
+	vector<uint32_t> sample_output_order;
+};
+
+// ---------------------------------------------------------------------------
+// Global state
+// ---------------------------------------------------------------------------
+
+struct PlinkPcaProjectGlobalState : public GlobalTableFunctionState {
+	// Projected coordinates, samples × PCs (row-major)
+	vector<double> scores;
+
+	// Phase 1 synchronization; per-thread accumulators are merged stripe-parallel
+	// over the sample axis
+	StripedReduction merge;
+	std::atomic<bool> projection_done {false};
+	std::atomic<uint32_t> phase1_active {0};
+	std::atomic<uint32_t> next_variant_idx {0};
+	uint32_t variant_ct = 0;
+
+	// Phase 2 emission
+	std::atomic<uint32_t> next_emit_idx {0};
+	uint32_t total_samples = 0;
+
+	vector<column_t> column_ids;
+
+	// Threading
+	uint32_t db_thread_count = 1;
+	uint32_t max_threads_config = 0;
+
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
+	idx_t MaxThreads() const override {
+		if (variant_ct < PROJECT_BATCH_SIZE) {
+			return 1;
+		}
+		idx_t computed = std::min<idx_t>(variant_ct / PROJECT_BATCH_SIZE + 1, db_thread_count);
+		return ApplyMaxThreadsCap(computed, max_threads_config);
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Local state (per-thread)
+// ---------------------------------------------------------------------------
+
+struct PlinkPcaProjectLocalState : public LocalTableFunctionState {
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
+
+	plink2::PgenReader pgr;
+	AlignedBuffer pgr_alloc_buf;
+
+	plink2::PgrSampleSubsetIndex pssi;
+
+	AlignedBuffer genovec_buf;
+	vector<int8_t> geno_bytes;
+
+	// Normalized genotypes of up to panel_variant_ct variants (panel_variant_ct x N,
+	// row-major) and their loadings rows (panel_variant_ct x pc_ct)
+	vector<double> panel;
+	vector<double> weight_panel;
+	uint32_t panel_variant_ct = 1;
+
+	// Thread-local samples × PCs accumulator
+	vector<double> scores;
+	bool phase1_done = false;
+
+	bool initialized = false;
+
+	~PlinkPcaProjectLocalState() {
+		if (initialized) {
+			plink2::PglErr reterr = plink2::kPglRetSuccess;
+			plink2::CleanupPgr(&pgr, &reterr);
+		}
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Bind
+// ---------------------------------------------------------------------------
+
+//! Match the loadings rows to the target's variants by ID, in either allele
+//! orientation, and keep their reference normalization.
+static void ResolveLoadings(const Value &loadings_val, PlinkPcaProjectBindData &bind_data) {
+	auto &loadings_type = loadings_val.type();
+	if (loadings_type.id() != LogicalTypeId::LIST ||
+	    ListType::GetChildType(loadings_type).id() != LogicalTypeId::STRUCT) {
+		throw InvalidInputException("plink_pca_project: loadings must be LIST(STRUCT(ID, REF, ALT, ALT_FREQ, PC1, ...)), "
+		                            "e.g. (SELECT list(l) FROM plink_pca(..., mode := 'loadings') l)");
+	}
+
+	auto &struct_children = StructType::GetChildTypes(ListType::GetChildType(loadings_type));
+	bool has_id = false, has_ref = false, has_alt = false, has_freq = false;
+	idx_t id_idx = 0, ref_idx = 0, alt_idx = 0, freq_idx = 0;
+	vector<idx_t> pc_field_idx;
+	for (idx_t i = 0; i < struct_children.size(); i++) {
+		auto name = StringUtil::Lower(struct_children[i].first);
+		if (name == "id") {
+			has_id = true;
+			id_idx = i;
+		} else if (name == "ref") {
+			has_ref = true;
+			ref_idx = i;
+		} else if (name == "alt") {
+			has_alt = true;
+			alt_idx = i;
+		} else if (name == "alt_freq") {
+			has_freq = true;
+			freq_idx = i;
+		} else if (name.size() > 2 && StringUtil::StartsWith(name, "pc") &&
+		           std::all_of(name.begin() + 2, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+			if (!struct_children[i].second.IsNumeric()) {
+				throw InvalidInputException("plink_pca_project: loadings column '%s' must be numeric (got %s)",
+				                            struct_children[i].first, struct_children[i].second.ToString());
+			}
+			pc_field_idx.push_back(i);
+			bind_data.pc_names.push_back(struct_children[i].first);
+		}
+		// Other fields (CHROM, POS, ...) are ignored
+	}
+	if (!has_id || !has_ref || !has_alt || !has_freq || pc_field_idx.empty()) {
+		throw InvalidInputException("plink_pca_project: loadings need ID, REF, ALT, ALT_FREQ and at least one PC<k> "
+		                            "field, as produced by plink_pca(..., mode := 'loadings')");
+	}
+	bind_data.pc_ct = static_cast<uint32_t>(pc_field_idx.size());
+
+	unordered_map<string, uint32_t> variant_id_map;
+	for (idx_t local = 0; local < bind_data.variants.variant_ct; local++) {
+		const auto &vid = bind_data.variants.ids[local];
+		if (!vid.empty()) {
+			variant_id_map[vid] = bind_data.variants.VidxForLocal(local);
+		}
+	}
+
+	auto &children = ListValue::GetChildren(loadings_val);
+	for (auto &entry : children) {
+		if (entry.IsNull()) {
+			continue;
+		}
+		auto &fields = StructValue::GetChildren(entry);
+		if (fields[id_idx].IsNull() || fields[ref_idx].IsNull() || fields[alt_idx].IsNull() ||
+		    fields[freq_idx].IsNull()) {
+			continue;
+		}
+		auto it = variant_id_map.find(fields[id_idx].GetValue<string>());
+		if (it == variant_id_map.end()) {
+			continue;
+		}
+		uint32_t vidx = it->second;
+
+		// Loadings are for the reference ALT allele; a target with the alleles swapped
+		// has ALT dosage 2 - g, i.e. the same normalization mirrored
+		string ref = fields[ref_idx].GetValue<string>();
+		string alt = fields[alt_idx].GetValue<string>();
+		bool flip;
+		if (ref == bind_data.variants.GetRef(vidx) && alt == bind_data.variants.GetAlt(vidx)) {
+			flip = false;
+		} else if (ref == bind_data.variants.GetAlt(vidx) && alt == bind_data.variants.GetRef(vidx)) {
+			flip = true;
+		} else {
+			continue;
+		}
+
+		VariantNorm norm = ComputeVariantNorm(fields[freq_idx].GetValue<double>());
+		if (norm.skip) {
+			continue;
+		}
+		if (flip) {
+			norm.center = 2.0 - norm.center;
+			norm.inv_stdev = -norm.inv_stdev;
+		}
+
+		auto weight_row = static_cast<uint32_t>(bind_data.projected_variants.size());
+		for (auto i : pc_field_idx) {
+			bind_data.weights.push_back(fields[i].IsNull() ? 0.0 : fields[i].GetValue<double>());
+		}
+		bind_data.projected_variants.push_back({vidx, weight_row, norm});
+	}
+
+	if (bind_data.projected_variants.empty()) {
+		throw InvalidInputException("plink_pca_project: none of the %llu loadings variants match a variant of '%s' "
+		                            "by ID and alleles",
+		                            static_cast<unsigned long long>(children.size()), bind_data.pgen_path);
+	}
+
+	// Sort by variant index for sequential .pgen access
+	std::sort(bind_data.projected_variants.begin(), bind_data.projected_variants.end(),
+	          [](const ProjectedVariant &a, const ProjectedVariant &b) { return a.pgen_idx < b.pgen_idx; });
+}
+
+static unique_ptr<FunctionData> PlinkPcaProjectBind(ClientContext &context, TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<PlinkPcaProjectBindData>();
+	bind_data->pgen_path = input.inputs[0].GetValue<string>();
+
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	// --- Named parameters (first pass) ---
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "pvar") {
+			bind_data->pvar_path = kv.second.GetValue<string>();
+		} else if (kv.first == "psam") {
+			bind_data->psam_path = kv.second.GetValue<string>();
+		} else if (kv.first == "loadings" || kv.first == "samples") {
+			// Handled below
+		}
+	}
+
+	// --- Auto-discover companion files ---
+	if (bind_data->pvar_path.empty()) {
+		bind_data->pvar_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".pvar", ".bim"});
+		if (bind_data->pvar_path.empty()) {
+			throw InvalidInputException("plink_pca_project: cannot find .pvar or .bim companion for '%s' "
+			                            "(use pvar := 'path' to specify explicitly)",
+			                            bind_data->pgen_path);
+		}
+	}
+
+	if (bind_data->psam_path.empty()) {
+		bind_data->psam_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".psam", ".fam"});
+		if (bind_data->psam_path.empty()) {
+			throw InvalidInputException("plink_pca_project: cannot find .psam or .fam companion for '%s' "
+			                            "(use psam := 'path' to specify explicitly)",
+			                            bind_data->pgen_path);
+		}
+	}
+
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
+	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
+	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
+	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
+
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_pca_project");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
+
+	// --- Load variant metadata ---
+	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_pca_project");
+
+	if (bind_data->variants.variant_ct != bind_data->raw_variant_ct) {
+		throw InvalidInputException("plink_pca_project: variant count mismatch: .pgen has %u variants, "
+		                            ".pvar/.bim '%s' has %llu variants",
+		                            bind_data->raw_variant_ct, bind_data->pvar_path,
+		                            static_cast<unsigned long long>(bind_data->variants.variant_ct));
+	}
+
+	// --- Load sample info ---
+	bind_data->sample_info = LoadSampleMetadata(context, bind_data->psam_path);
+
+	if (static_cast<uint32_t>(bind_data->sample_info.sample_ct) != bind_data->raw_sample_ct) {
+		throw InvalidInputException("plink_pca_project: sample count mismatch: .pgen has %u samples, "
+		                            ".psam/.fam '%s' has %llu samples",
+		                            bind_data->raw_sample_ct, bind_data->psam_path,
+		                            static_cast<unsigned long long>(bind_data->sample_info.sample_ct));
+	}
+
+	// --- Process samples parameter ---
+	bind_data->effective_sample_ct = bind_data->raw_sample_ct;
+
+	auto samples_it = input.named_parameters.find("samples");
+	if (samples_it != input.named_parameters.end()) {
+		auto indices = ResolveSampleIndices(samples_it->second, bind_data->raw_sample_ct, &bind_data->sample_info,
+		                                    "plink_pca_project");
+
+		bind_data->sample_subset = make_uniq<SampleSubset>(BuildSampleSubset(bind_data->raw_sample_ct, indices));
+		bind_data->has_sample_subset = true;
+		bind_data->effective_sample_ct = bind_data->sample_subset->subset_sample_ct;
+
+		auto sorted_indices = indices;
+		std::sort(sorted_indices.begin(), sorted_indices.end());
+		bind_data->sample_output_order = std::move(sorted_indices);
+	} else {
+		bind_data->sample_output_order.resize(bind_data->raw_sample_ct);
+		for (uint32_t i = 0; i < bind_data->raw_sample_ct; i++) {
+			bind_data->sample_output_order[i] = i;
+		}
+	}
+
+	// --- Process loadings parameter ---
+	auto loadings_it = input.named_parameters.find("loadings");
+	if (loadings_it == input.named_parameters.end()) {
+		throw InvalidInputException("plink_pca_project: loadings parameter is required");
+	}
+	ResolveLoadings(loadings_it->second, *bind_data);
+
+	// --- Register output schema ---
+	names = {"FID", "IID"};
+	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR};
+	for (auto &pc_name : bind_data->pc_names) {
+		names.push_back(pc_name);
+		return_types.push_back(LogicalType::DOUBLE);
+	}
+
+	return std::move(bind_data);
+}
+
+// ---------------------------------------------------------------------------
+// Init global
+// ---------------------------------------------------------------------------
+
+static unique_ptr<GlobalTableFunctionState> PlinkPcaProjectInitGlobal(ClientContext &context,
+                                                                      TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PlinkPcaProjectBindData>();
+	auto state = make_uniq<PlinkPcaProjectGlobalState>();
+
+	state->total_samples = bind_data.effective_sample_ct;
+	state->variant_ct = static_cast<uint32_t>(bind_data.projected_variants.size());
+	state->column_ids = input.column_ids;
+	state->db_thread_count = static_cast<uint32_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
+	state->max_threads_config = GetPlinkingMaxThreads(context);
+
+	state->scores.resize(static_cast<idx_t>(state->total_samples) * bind_data.pc_ct, 0.0);
+	state->merge.Init(state->total_samples);
+
+	state->pgen_index = bind_data.pgen_index;
+
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Init local (per-thread PgenReader)
+// ---------------------------------------------------------------------------
+
+static unique_ptr<LocalTableFunctionState> PlinkPcaProjectInitLocal(ExecutionContext &context,
+                                                                    TableFunctionInitInput &input,
+                                                                    GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<PlinkPcaProjectBindData>();
+	auto &gstate = global_state->Cast<PlinkPcaProjectGlobalState>();
+	auto state = make_uniq<PlinkPcaProjectLocalState>();
+
+	// --- Per-thread PgenReader on the query's shared index ---
+	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_pca_project");
+
+	// Set up sample subsetting
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		plink2::PgrSetSampleSubsetIndex(bind_data.sample_subset->CumulativePopcounts(), &state->pgr, &state->pssi);
+	} else {
+		plink2::PgrClearSampleSubsetIndex(&state->pgr, &state->pssi);
+	}
+
+	// Allocate genotype decode buffer
+	uintptr_t genovec_word_ct = plink2::NypCtToAlignedWordCt(bind_data.raw_sample_ct);
+	state->genovec_buf.Allocate(genovec_word_ct * sizeof(uintptr_t));
+	std::memset(state->genovec_buf.ptr, 0, genovec_word_ct * sizeof(uintptr_t));
+
+	// Allocate panel and accumulator
+	state->geno_bytes.resize(bind_data.effective_sample_ct);
+	idx_t sample_ct = MaxValue<idx_t>(bind_data.effective_sample_ct, 1);
+	state->panel_variant_ct = static_cast<uint32_t>(
+	    MaxValue<idx_t>(1, MinValue<idx_t>(PROJECT_BATCH_SIZE, PROJECT_PANEL_MAX_DOUBLES / sample_ct)));
+	state->panel.resize(static_cast<idx_t>(state->panel_variant_ct) * bind_data.effective_sample_ct);
+	state->weight_panel.resize(static_cast<idx_t>(state->panel_variant_ct) * bind_data.pc_ct);
+	state->scores.resize(static_cast<idx_t>(bind_data.effective_sample_ct) * bind_data.pc_ct, 0.0);
+
+	state->initialized = true;
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Scan function
+// ---------------------------------------------------------------------------
+
+//! scores (N x pc_ct) += Pᵀ (N x panel_ct) × W (panel_ct x pc_ct)
+static void AccumulateProjectionPanel(const PlinkPcaProjectBindData &bind_data, PlinkPcaProjectLocalState &ls,
+                                      uint32_t panel_ct) {
+	idx_t sample_ct = bind_data.effective_sample_ct;
+	Eigen::Map<const ProjectRowMajorMatrix> p(ls.panel.data(), panel_ct, sample_ct);
+	Eigen::Map<const ProjectRowMajorMatrix> w(ls.weight_panel.data(), panel_ct, bind_data.pc_ct);
+	Eigen::Map<ProjectRowMajorMatrix> scores(ls.scores.data(), sample_ct, bind_data.pc_ct);
+	scores.noalias() += p.transpose() * w;
+}
+
+static void ProjectVariants(const PlinkPcaProjectBindData &bind_data, PlinkPcaProjectGlobalState &gs,
+                            PlinkPcaProjectLocalState &ls) {
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	uint32_t pc_ct = bind_data.pc_ct;
+	const uintptr_t *sample_include = nullptr;
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		sample_include = bind_data.sample_subset->SampleInclude();
+	}
+
+	uint32_t panel_ct = 0;
+	while (true) {
+		uint32_t batch_start = gs.next_variant_idx.fetch_add(PROJECT_BATCH_SIZE);
+		if (batch_start >= gs.variant_ct) {
+			break;
+		}
+		uint32_t batch_end = std::min(batch_start + PROJECT_BATCH_SIZE, gs.variant_ct);
+
+		for (uint32_t pi = batch_start; pi < batch_end; pi++) {
+			auto &pv = bind_data.projected_variants[pi];
+
+			plink2::PglErr err = plink2::PgrGet(sample_include, ls.pssi, sample_ct, pv.pgen_idx, &ls.pgr,
+			                                    ls.genovec_buf.As<uintptr_t>());
+			if (err != plink2::kPglRetSuccess) {
+				throw IOException("plink_pca_project: PgrGet failed for variant %u", pv.pgen_idx);
+			}
+			plink2::GenoarrToBytesMinus9(ls.genovec_buf.As<uintptr_t>(), sample_ct, ls.geno_bytes.data());
+			NormalizeGenotypes(ls.geno_bytes.data(), sample_ct, pv.norm,
+			                   ls.panel.data() + static_cast<idx_t>(panel_ct) * sample_ct);
+			std::copy_n(bind_data.weights.data() + static_cast<idx_t>(pv.weight_row) * pc_ct, pc_ct,
+			            ls.weight_panel.data() + static_cast<idx_t>(panel_ct) * pc_ct);
+
+			if (++panel_ct == ls.panel_variant_ct) {
+				AccumulateProjectionPanel(bind_data, ls, panel_ct);
+				panel_ct = 0;
+			}
+		}
+	}
+	if (panel_ct > 0) {
+		AccumulateProjectionPanel(bind_data, ls, panel_ct);
+	}
+}
+
+static void PlinkPcaProjectScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<PlinkPcaProjectBindData>();
+	auto &gs = data_p.global_state->Cast<PlinkPcaProjectGlobalState>();
+	auto &ls = data_p.local_state->Cast<PlinkPcaProjectLocalState>();
+	uint32_t pc_ct = bind_data.pc_ct;
+
+	// Phase 1: accumulate every matched variant (parallel via DuckDB thread pool)
+	if (!gs.projection_done.load(std::memory_order_acquire)) {
+		if (!ls.initialized || ls.phase1_done) {
+			CompatSetOutputCardinality(output, 0);
+			return;
+		}
+		gs.phase1_active.fetch_add(1, std::memory_order_acq_rel);
+
+		ProjectVariants(bind_data, gs, ls);
+
+		// Merge thread-local scores into global state, one sample stripe at a time
+		gs.merge.Merge([&](idx_t begin, idx_t end) {
+			for (idx_t i = begin * pc_ct; i < end * pc_ct; i++) {
+				gs.scores[i] += ls.scores[i];
+			}
+		});
+		ls.phase1_done = true;
+
+		// Last thread transitions to Phase 2
+		if (gs.phase1_active.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+			CompatSetOutputCardinality(output, 0);
+			return;
+		}
+		gs.projection_done.store(true, std::memory_order_release);
+	}
+
+	// Phase 2: one row per sample
+	auto &column_ids = gs.column_ids;
+	bool has_fid = !bind_data.sample_info.fids.empty();
+	idx_t rows_emitted = 0;
+
+	while (rows_emitted < STANDARD_VECTOR_SIZE) {
+		uint32_t sidx = gs.next_emit_idx.fetch_add(1);
+		if (sidx >= gs.total_samples) {
+			break;
+		}
+
+		uint32_t orig_idx = bind_data.sample_output_order[sidx];
+
+		for (idx_t out_col = 0; out_col < column_ids.size(); out_col++) {
+			auto file_col = column_ids[out_col];
+			if (file_col == COLUMN_IDENTIFIER_ROW_ID) {
+				continue;
+			}
+
+			auto &vec = output.data[out_col];
+
+			if (file_col == COL_FID) {
+				if (has_fid) {
+					FlatVector::GetData<string_t>(vec)[rows_emitted] =
+					    StringVector::AddString(vec, bind_data.sample_info.fids[orig_idx]);
+				} else {
+					FlatVector::SetNull(vec, rows_emitted, true);
+				}
+			} else if (file_col == COL_IID) {
+				FlatVector::GetData<string_t>(vec)[rows_emitted] =
+				    StringVector::AddString(vec, bind_data.sample_info.iids[orig_idx]);
+			} else if (file_col >= COL_PC_START && file_col < COL_PC_START + pc_ct) {
+				uint32_t pc = static_cast<uint32_t>(file_col - COL_PC_START);
+				FlatVector::GetData<double>(vec)[rows_emitted] = gs.scores[static_cast<idx_t>(sidx) * pc_ct + pc];
+			}
+		}
+		rows_emitted++;
+	}
+	CompatSetOutputCardinality(output, rows_emitted);
+}
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+void RegisterPlinkPcaProject(ExtensionLoader &loader) {
+	TableFunction plink_pca_project("plink_pca_project", {LogicalType::VARCHAR}, PlinkPcaProjectScan,
+	                                PlinkPcaProjectBind, PlinkPcaProjectInitGlobal, PlinkPcaProjectInitLocal);
+
+	plink_pca_project.projection_pushdown = true;
+
+	plink_pca_project.named_parameters["pvar"] = LogicalType::VARCHAR;
+	plink_pca_project.named_parameters["psam"] = LogicalType::VARCHAR;
+	plink_pca_project.named_parameters["loadings"] = LogicalType::ANY;
+	plink_pca_project.named_parameters["samples"] = LogicalType::ANY;
+
+	loader.RegisterFunction(plink_pca_project);
+}
+
+} // namespace duckdb
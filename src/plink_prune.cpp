@@ -0,0 +1,520 @@
+// plink_prune.cpp — LD-based variant pruning (plink2 --indep-pairwise), returning the
+// kept variant set.
+//
+// Per chromosome, a window of `window_kb` kilobases (or `window` variants) slides
+// forward `step` variants at a time. Within each window, any still-kept pair with
+// r² > r2_threshold loses the variant with the lower minor-allele frequency (ties: the
+// later variant). r² is plink_ld's genotype-level Pearson r² (the same pair kernel),
+// which is what plink 1.9/2 --indep-pairwise compute from hardcalls, but cross-check
+// against plink2 before relying on an exact kept-set match.
+//
+// A pair whose r² was already checked in an earlier window with both variants kept
+// cannot prune anything later (removals are permanent), so each window only tests the
+// pairs involving variants that just entered it: next_partner[i] remembers how far
+// variant i has been checked. Decoded variants stay resident in a per-thread
+// LdWindowCache sized to the widest window. Chromosomes are independent and are
+// claimed by threads one at a time.
+
+#include "plink_prune.hpp"
+#include "duckdb_compat.hpp"
+#include "plink_common.hpp"
+#include "plink_ld_kernel.hpp"
+#include "pgen_vfs_opener.hpp"
+
+#include <atomic>
+
+namespace duckdb {
+
+// ---------------------------------------------------------------------------
+// Column indices
+// ---------------------------------------------------------------------------
+
+static constexpr idx_t COL_CHROM = 0;
+static constexpr idx_t COL_POS = 1;
+static constexpr idx_t COL_ID = 2;
+static constexpr idx_t COL_REF = 3;
+static constexpr idx_t COL_ALT = 4;
+
+// ---------------------------------------------------------------------------
+// Bind data
+// ---------------------------------------------------------------------------
+
+struct PlinkPruneBindData : public TableFunctionData {
+	string pgen_path;
+	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
+	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
+	string pvar_path;
+	string psam_path;
+
+	VariantMetadataIndex variants;
+	SampleInfo sample_info;
+	bool has_sample_info = false;
+
+	uint32_t raw_variant_ct = 0;
+	uint32_t raw_sample_ct = 0;
+
+	// Sample subsetting
+	bool has_sample_subset = false;
+	unique_ptr<SampleSubset> sample_subset;
+	uint32_t effective_sample_ct = 0;
+
+	// Region filtering
+	VariantRange variant_range;
+
+	// Window: window_variant_ct > 0 selects a variant-count window, else window_bp
+	int64_t window_bp = 1000000; // window_kb * 1000
+	uint32_t window_variant_ct = 0;
+	uint32_t step = 1;
+	double r2_threshold = 0.2;
+
+	// Pair kernel (plinking_ld_kernel)
+	LdKernel ld_kernel = LdKernel::AUTO;
+};
+
+// ---------------------------------------------------------------------------
+// Global state
+// ---------------------------------------------------------------------------
+
+struct PlinkPruneGlobalState : public GlobalTableFunctionState {
+	//! [start, end) vidx of each chromosome in the scanned range — the unit of work
+	vector<std::pair<uint32_t, uint32_t>> chrom_ranges;
+	std::atomic<uint32_t> next_chrom {0};
+	uint32_t max_window_ct = 0; // most variants any window spans (sizes the window cache)
+	uint32_t max_threads_config = 0;
+
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
+	idx_t MaxThreads() const override {
+		return ApplyMaxThreadsCap(MaxValue<idx_t>(chrom_ranges.size(), 1), max_threads_config);
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Local state (per-thread)
+// ---------------------------------------------------------------------------
+
+struct PlinkPruneLocalState : public LocalTableFunctionState {
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
+
+	plink2::PgenReader pgr;
+	AlignedBuffer pgr_alloc_buf;
+
+	plink2::PgrSampleSubsetIndex pssi;
+
+	AlignedBuffer genovec_buf;       // PgrGet decode target
+	LdVariantGenotypes anchor_geno;  // uncached path
+	LdVariantGenotypes partner_geno; // uncached path
+	LdWindowCache window_cache;
+
+	// Pruning state for the current chromosome (indexed by vidx - chrom start)
+	vector<bool> removed;
+	vector<uint32_t> next_partner;
+
+	// Kept variants of the pruned chromosome, emitted across scan calls
+	vector<uint32_t> kept;
+	idx_t kept_emitted = 0;
+
+	bool initialized = false;
+
+	~PlinkPruneLocalState() {
+		if (initialized) {
+			plink2::PglErr reterr = plink2::kPglRetSuccess;
+			plink2::CleanupPgr(&pgr, &reterr);
+		}
+	}
+};
+
+// ---------------------------------------------------------------------------
+// Bind
+// ---------------------------------------------------------------------------
+
+static unique_ptr<FunctionData> PlinkPruneBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<PlinkPruneBindData>();
+	bind_data->pgen_path = input.inputs[0].GetValue<string>();
+
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	// --- Collect named parameters ---
+	bool has_window_kb = false;
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "pvar") {
+			bind_data->pvar_path = kv.second.GetValue<string>();
+		} else if (kv.first == "psam") {
+			bind_data->psam_path = kv.second.GetValue<string>();
+		} else if (kv.first == "window_kb") {
+			auto kb = kv.second.GetValue<int64_t>();
+			if (kb < 0) {
+				throw InvalidInputException("plink_prune: window_kb must be non-negative");
+			}
+			bind_data->window_bp = kb * 1000;
+			has_window_kb = true;
+		} else if (kv.first == "window") {
+			auto ct = kv.second.GetValue<int64_t>();
+			if (ct < 2) {
+				throw InvalidInputException("plink_prune: window must be at least 2 variants");
+			}
+			bind_data->window_variant_ct = static_cast<uint32_t>(MinValue<int64_t>(ct, UINT32_MAX));
+		} else if (kv.first == "step") {
+			auto step = kv.second.GetValue<int64_t>();
+			if (step < 1) {
+				throw InvalidInputException("plink_prune: step must be at least 1");
+			}
+			bind_data->step = static_cast<uint32_t>(MinValue<int64_t>(step, UINT32_MAX));
+		} else if (kv.first == "r2_threshold") {
+			bind_data->r2_threshold = kv.second.GetValue<double>();
+			if (bind_data->r2_threshold < 0.0 || bind_data->r2_threshold > 1.0) {
+				throw InvalidInputException("plink_prune: r2_threshold must be between 0.0 and 1.0");
+			}
+		} else if (kv.first == "samples" || kv.first == "region") {
+			// Handled after pgenlib init
+		}
+	}
+
+	if (has_window_kb && bind_data->window_variant_ct > 0) {
+		throw InvalidInputException("plink_prune: specify either window_kb or window, not both");
+	}
+
+	bind_data->ld_kernel = ResolveLdKernel(context, "plink_prune");
+
+	// --- Auto-discover companion files ---
+	if (bind_data->pvar_path.empty()) {
+		bind_data->pvar_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".pvar", ".bim"});
+		if (bind_data->pvar_path.empty()) {
+			throw InvalidInputException("plink_prune: cannot find .pvar or .bim companion for '%s' "
+			                            "(use pvar := 'path' to specify explicitly)",
+			                            bind_data->pgen_path);
+		}
+	}
+
+	if (bind_data->psam_path.empty()) {
+		bind_data->psam_path = FindCompanionFileWithParquet(context, fs, bind_data->pgen_path, {".psam", ".fam"});
+		// .psam is optional — only needed if samples parameter uses VARCHAR IDs
+	}
+
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
+	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
+	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
+	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
+
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_prune");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
+
+	// --- Load variant metadata ---
+	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_prune");
+
+	if (bind_data->variants.variant_ct != bind_data->raw_variant_ct) {
+		throw InvalidInputException("plink_prune: variant count mismatch: .pgen has %u variants, "
+		                            ".pvar/.bim '%s' has %llu variants",
+		                            bind_data->raw_variant_ct, bind_data->pvar_path,
+		                            static_cast<unsigned long long>(bind_data->variants.variant_ct));
+	}
+
+	// --- Load sample info (optional) ---
+	if (!bind_data->psam_path.empty()) {
+		bind_data->sample_info = LoadSampleMetadata(context, bind_data->psam_path);
+		bind_data->has_sample_info = true;
+
+		if (static_cast<uint32_t>(bind_data->sample_info.sample_ct) != bind_data->raw_sample_ct) {
+			throw InvalidInputException("plink_prune: sample count mismatch: .pgen has %u samples, "
+			                            ".psam/.fam '%s' has %llu samples",
+			                            bind_data->raw_sample_ct, bind_data->psam_path,
+			                            static_cast<unsigned long long>(bind_data->sample_info.sample_ct));
+		}
+	}
+
+	// --- Process samples parameter ---
+	bind_data->effective_sample_ct = bind_data->raw_sample_ct;
+
+	auto samples_it = input.named_parameters.find("samples");
+	if (samples_it != input.named_parameters.end()) {
+		auto indices =
+		    ResolveSampleIndices(samples_it->second, bind_data->raw_sample_ct,
+		                         bind_data->has_sample_info ? &bind_data->sample_info : nullptr, "plink_prune");
+
+		bind_data->sample_subset = make_uniq<SampleSubset>(BuildSampleSubset(bind_data->raw_sample_ct, indices));
+		bind_data->has_sample_subset = true;
+		bind_data->effective_sample_ct = bind_data->sample_subset->subset_sample_ct;
+	}
+
+	// --- Process region parameter ---
+	auto region_it = input.named_parameters.find("region");
+	if (region_it != input.named_parameters.end()) {
+		bind_data->variant_range =
+		    ParseRegion(region_it->second.GetValue<string>(), bind_data->variants, "plink_prune");
+	}
+
+	// --- Register output columns ---
+	names = {"CHROM", "POS", "ID", "REF", "ALT"};
+	return_types = {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                LogicalType::VARCHAR};
+
+	return std::move(bind_data);
+}
+
+// ---------------------------------------------------------------------------
+// Init global
+// ---------------------------------------------------------------------------
+
+static unique_ptr<GlobalTableFunctionState> PlinkPruneInitGlobal(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PlinkPruneBindData>();
+	auto state = make_uniq<PlinkPruneGlobalState>();
+	state->max_threads_config = GetPlinkingMaxThreads(context);
+
+	uint32_t start = 0;
+	uint32_t end = bind_data.raw_variant_ct;
+	if (bind_data.variant_range.has_filter) {
+		start = bind_data.variant_range.start_idx;
+		end = bind_data.variant_range.end_idx;
+	}
+
+	// Split the range at chromosome boundaries
+	auto &variants = bind_data.variants;
+	uint32_t chrom_start = start;
+	for (uint32_t vidx = start + 1; vidx <= end; vidx++) {
+		if (vidx == end || variants.GetChrom(vidx) != variants.GetChrom(chrom_start)) {
+			if (chrom_start < end) {
+				state->chrom_ranges.emplace_back(chrom_start, vidx);
+			}
+			chrom_start = vidx;
+		}
+	}
+
+	if (bind_data.window_variant_ct > 0) {
+		uint32_t longest = 0;
+		for (auto &range : state->chrom_ranges) {
+			longest = MaxValue(longest, range.second - range.first);
+		}
+		state->max_window_ct = MinValue(bind_data.window_variant_ct, longest);
+	} else if (start < end) {
+		state->max_window_ct = LdMaxWindowVariantCount(variants, start, end, bind_data.window_bp) + 1;
+	}
+
+	state->pgen_index = bind_data.pgen_index;
+
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Init local (per-thread PgenReader)
+// ---------------------------------------------------------------------------
+
+static unique_ptr<LocalTableFunctionState> PlinkPruneInitLocal(ExecutionContext &context,
+                                                               TableFunctionInitInput &input,
+                                                               GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<PlinkPruneBindData>();
+	auto &gstate = global_state->Cast<PlinkPruneGlobalState>();
+	auto state = make_uniq<PlinkPruneLocalState>();
+
+	// --- Per-thread PgenReader on the query's shared index ---
+	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_prune");
+
+	// Set up sample subsetting
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		plink2::PgrSetSampleSubsetIndex(bind_data.sample_subset->CumulativePopcounts(), &state->pgr, &state->pssi);
+	} else {
+		plink2::PgrClearSampleSubsetIndex(&state->pgr, &state->pssi);
+	}
+
+	// Decode buffer, scratch genotypes and the window cache
+	uintptr_t genovec_word_ct = plink2::NypCtToAlignedWordCt(bind_data.effective_sample_ct);
+	uintptr_t genovec_bytes = genovec_word_ct * sizeof(uintptr_t);
+	state->genovec_buf.Allocate(genovec_bytes);
+	std::memset(state->genovec_buf.ptr, 0, genovec_bytes);
+	state->anchor_geno.Allocate(bind_data.effective_sample_ct, bind_data.ld_kernel);
+	state->partner_geno.Allocate(bind_data.effective_sample_ct, bind_data.ld_kernel);
+
+	uint32_t slot_ct = LdWindowCache::SlotCountForBudget(GetLdWindowCacheBytes(context.client),
+	                                                     bind_data.effective_sample_ct, bind_data.ld_kernel,
+	                                                     gstate.max_window_ct);
+	state->window_cache.Init(slot_ct, bind_data.effective_sample_ct, bind_data.ld_kernel);
+
+	state->initialized = true;
+	return std::move(state);
+}
+
+// ---------------------------------------------------------------------------
+// Pruning
+// ---------------------------------------------------------------------------
+
+//! Variant `vidx` in kernel form: from the window cache when it is within
+//! SlotCount() of `anchor` (so it cannot evict the anchor's slot), else decoded
+//! into `scratch`.
+static const LdVariantGenotypes &FetchVariant(PlinkPruneLocalState &lstate, const PlinkPruneBindData &bind_data,
+                                              uint32_t vidx, uint32_t anchor, LdVariantGenotypes &scratch) {
+	auto &cache = lstate.window_cache;
+	LdVariantGenotypes *out = &scratch;
+	if (cache.Enabled() && vidx - anchor < cache.SlotCount()) {
+		if (cache.Lookup(vidx, out)) {
+			return *out;
+		}
+	}
+
+	const uintptr_t *sample_include = nullptr;
+	if (bind_data.has_sample_subset && bind_data.sample_subset) {
+		sample_include = bind_data.sample_subset->SampleInclude();
+	}
+	auto *genovec = lstate.genovec_buf.As<uintptr_t>();
+	plink2::PglErr err =
+	    plink2::PgrGet(sample_include, lstate.pssi, bind_data.effective_sample_ct, vidx, &lstate.pgr, genovec);
+	if (err != plink2::kPglRetSuccess) {
+		throw IOException("plink_prune: PgrGet failed for variant %u", vidx);
+	}
+	out->Assign(genovec);
+	return *out;
+}
+
+static double MinorAlleleFreq(const LdVariantGenotypes &geno) {
+	double freq = geno.AltFreq();
+	return MinValue(freq, 1.0 - freq);
+}
+
+//! Prune chromosome [chrom_start, chrom_end); leaves its kept variants in lstate.kept.
+static void PruneChromosome(const PlinkPruneBindData &bind_data, PlinkPruneLocalState &lstate, uint32_t chrom_start,
+                            uint32_t chrom_end) {
+	auto &variants = bind_data.variants;
+	uint32_t chrom_ct = chrom_end - chrom_start;
+	auto &removed = lstate.removed;
+	auto &next_partner = lstate.next_partner;
+	removed.assign(chrom_ct, false);
+	next_partner.assign(chrom_ct, 0);
+
+	uint32_t window_start = 0;
+	uint32_t window_end = 0;
+	while (true) {
+		// Window [window_start, window_end), as offsets into the chromosome
+		if (bind_data.window_variant_ct > 0) {
+			window_end = static_cast<uint32_t>(
+			    MinValue<uint64_t>(static_cast<uint64_t>(window_start) + bind_data.window_variant_ct, chrom_ct));
+		} else {
+			int64_t start_pos = variants.GetPos(chrom_start + window_start);
+			window_end = MaxValue(window_end, window_start + 1);
+			while (window_end < chrom_ct &&
+			       static_cast<int64_t>(variants.GetPos(chrom_start + window_end)) - start_pos <= bind_data.window_bp) {
+				window_end++;
+			}
+		}
+
+		for (uint32_t i = window_start; i < window_end; i++) {
+			if (removed[i]) {
+				continue;
+			}
+			uint32_t first_j = MaxValue(i + 1, next_partner[i]);
+			if (first_j >= window_end) {
+				continue;
+			}
+			uint32_t vidx_i = chrom_start + i;
+			auto &geno_i = FetchVariant(lstate, bind_data, vidx_i, vidx_i, lstate.anchor_geno);
+			for (uint32_t j = first_j; j < window_end; j++) {
+				if (removed[j]) {
+					continue;
+				}
+				auto &geno_j = FetchVariant(lstate, bind_data, chrom_start + j, vidx_i, lstate.partner_geno);
+				auto result = ComputeLdStats(geno_i, geno_j);
+				if (!result.is_valid || result.r2 <= bind_data.r2_threshold) {
+					continue;
+				}
+				// Drop the lower-MAF variant; on a tie, the later one
+				if (MinorAlleleFreq(geno_i) < MinorAlleleFreq(geno_j)) {
+					removed[i] = true;
+					break;
+				}
+				removed[j] = true;
+			}
+			next_partner[i] = window_end;
+		}
+
+		if (window_end >= chrom_ct) {
+			break;
+		}
+		window_start += bind_data.step;
+		if (window_start >= chrom_ct) {
+			break;
+		}
+	}
+
+	lstate.kept.clear();
+	lstate.kept_emitted = 0;
+	for (uint32_t i = 0; i < chrom_ct; i++) {
+		if (!removed[i]) {
+			lstate.kept.push_back(chrom_start + i);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Scan function
+// ---------------------------------------------------------------------------
+
+static void EmitVariantString(Vector &vec, idx_t row_idx, const string &val) {
+	if (val.empty()) {
+		FlatVector::SetNull(vec, row_idx, true);
+	} else {
+		FlatVector::GetData<string_t>(vec)[row_idx] = StringVector::AddString(vec, val);
+	}
+}
+
+static void PlinkPruneScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<PlinkPruneBindData>();
+	auto &gstate = data_p.global_state->Cast<PlinkPruneGlobalState>();
+	auto &lstate = data_p.local_state->Cast<PlinkPruneLocalState>();
+
+	if (!lstate.initialized) {
+		CompatSetOutputCardinality(output, 0);
+		return;
+	}
+
+	auto &variants = bind_data.variants;
+	idx_t rows_emitted = 0;
+
+	while (rows_emitted < STANDARD_VECTOR_SIZE) {
+		if (lstate.kept_emitted >= lstate.kept.size()) {
+			uint32_t chrom_idx = gstate.next_chrom.fetch_add(1);
+			if (chrom_idx >= gstate.chrom_ranges.size()) {
+				break;
+			}
+			auto &range = gstate.chrom_ranges[chrom_idx];
+			PruneChromosome(bind_data, lstate, range.first, range.second);
+			continue;
+		}
+
+		uint32_t vidx = lstate.kept[lstate.kept_emitted++];
+		FlatVector::GetData<string_t>(output.data[COL_CHROM])[rows_emitted] =
+		    StringVector::AddString(output.data[COL_CHROM], variants.GetChrom(vidx));
+		FlatVector::GetData<int32_t>(output.data[COL_POS])[rows_emitted] = variants.GetPos(vidx);
+		EmitVariantString(output.data[COL_ID], rows_emitted, variants.GetId(vidx));
+		EmitVariantString(output.data[COL_REF], rows_emitted, variants.GetRef(vidx));
+		EmitVariantString(output.data[COL_ALT], rows_emitted, variants.GetAlt(vidx));
+		rows_emitted++;
+	}
+
+	CompatSetOutputCardinality(output, rows_emitted);
+}
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+void RegisterPlinkPrune(ExtensionLoader &loader) {
+	TableFunction plink_prune("plink_prune", {LogicalType::VARCHAR}, PlinkPruneScan, PlinkPruneBind,
+	                          PlinkPruneInitGlobal, PlinkPruneInitLocal);
+
+	plink_prune.named_parameters["pvar"] = LogicalType::VARCHAR;
+	plink_prune.named_parameters["psam"] = LogicalType::VARCHAR;
+	plink_prune.named_parameters["window_kb"] = LogicalType::INTEGER;
+	plink_prune.named_parameters["window"] = LogicalType::INTEGER;
+	plink_prune.named_parameters["step"] = LogicalType::INTEGER;
+	plink_prune.named_parameters["r2_threshold"] = LogicalType::DOUBLE;
+	plink_prune.named_parameters["samples"] = LogicalType::ANY;
+	plink_prune.named_parameters["region"] = LogicalType::VARCHAR;
+
+	loader.RegisterFunction(plink_prune);
+}
+
+} // namespace duckdb
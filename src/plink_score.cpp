@@ -18,13 +18,23 @@ namespace duckdb {
 // Column indices
 // ---------------------------------------------------------------------------
 
-static constexpr idx_t COL_FID = 0;
-static constexpr idx_t COL_IID = 1;
-static constexpr idx_t COL_ALLELE_CT = 2;
-static constexpr idx_t COL_DENOM = 3;
-static constexpr idx_t COL_NAMED_ALLELE_DOSAGE_SUM = 4;
-static constexpr idx_t COL_SCORE_SUM = 5;
-static constexpr idx_t COL_SCORE_AVG = 6;
+// Output columns are resolved through PlinkScoreBindData::columns, since the
+// wide multi-score layout has two columns per score.
+enum class ScoreColumn : uint8_t {
+	FID,
+	IID,
+	SCORE,
+	ALLELE_CT,
+	DENOM,
+	NAMED_ALLELE_DOSAGE_SUM,
+	SCORE_SUM,
+	SCORE_AVG
+};
+
+struct ScoreOutputColumn {
+	ScoreColumn kind;
+	uint32_t score_idx; // wide SCORE_SUM / SCORE_AVG: which score
+};
 
 // ---------------------------------------------------------------------------
 // ScoredVariant
@@ -32,7 +42,7 @@ static constexpr idx_t COL_SCORE_AVG = 6;
 
 struct ScoredVariant {
 	uint32_t variant_idx; // index into .pgen file
-	double weight;        // scoring weight
+	uint32_t weight_row;  // row of bind_data.weights (score_ct weights)
 	bool flip;            // true if scored allele is REF (dosage = 2 - alt_dosage)
 };
 
@@ -44,6 +54,7 @@ struct PlinkScoreBindData : public TableFunctionData {
 	string pgen_path;
 	bool use_vfs = false; // route .pgen opens through DuckDB's VFS (plinking_pgen_io)
 	PgenLocalizeGuard localize_guard; // owns downloaded temp .pgen for 'localize' (per-query)
+	shared_ptr<PgenIndex> pgen_index; // loaded at bind, shared by the scan's readers
 	string pvar_path;
 	string psam_path;
 
@@ -64,10 +75,29 @@ struct PlinkScoreBindData : public TableFunctionData {
 	// Scored variants (built from weights parameter)
 	vector<ScoredVariant> scored_variants;
 
+	// Weight matrix: one row of score_ct weights per weight_row
+	uint32_t score_ct = 1;
+	vector<string> score_names;
+	vector<double> weights;
+
+	// Output layout: 'wide' (one row per sample) or 'long' (one row per sample x score)
+	bool long_output = false;
+	vector<ScoreOutputColumn> columns;
+
+	// Thread cap so per-thread sample x score accumulators stay within
+	// plinking_max_matrix_elements
+	idx_t max_accumulator_threads = 0;
+
 	// Options
 	bool center = false;
 	bool no_mean_imputation = false;
 
+	// Sparse (difflist) scoring of rare variants (plinking_score_sparse). Hardcall-only
+	// files: difflists carry no dosages.
+	bool file_has_dosage = false;
+	bool use_sparse = false;
+	uint32_t max_difflist_len = 0;
+
 	// Maps output index → original sample index (for sample metadata lookup)
 	vector<uint32_t> sample_output_order;
 };
@@ -77,35 +107,44 @@ struct PlinkScoreBindData : public TableFunctionData {
 // ---------------------------------------------------------------------------
 
 struct PlinkScoreGlobalState : public GlobalTableFunctionState {
-	// Per-sample accumulators (filled during phase 1)
+	// Per-sample accumulators (filled during phase 1); score_sums is sample x score and
+	// holds the deviations from hom_ref_scores (see ScoreAccumulator)
 	vector<double> score_sums;
+	vector<double> hom_ref_scores;
 	vector<double> named_allele_dosage_sums;
 	vector<uint32_t> allele_cts;
 
-	// Phase 1 synchronization (DuckDB thread pool pattern)
-	std::mutex merge_mutex;
+	// Phase 1 synchronization (DuckDB thread pool pattern); per-thread accumulators
+	// are merged stripe-parallel over the sample axis
+	StripedReduction merge;
 	std::atomic<bool> scoring_done {false};
 	std::atomic<uint32_t> phase1_active {0};
 	std::atomic<uint32_t> next_scored_idx {0};
 	uint32_t scored_variant_count = 0;
 
-	// Phase 2 emission
-	std::atomic<uint32_t> next_sample_idx {0};
+	// Phase 2 emission: rows are samples, or sample x score in long output
+	std::atomic<uint64_t> next_row_idx {0};
 	uint32_t total_samples = 0;
+	uint64_t total_rows = 0;
 
 	vector<column_t> column_ids;
 
 	// DuckDB-configured thread count
 	uint32_t db_thread_count = 1;
 	uint32_t max_threads_config = 0;
+	idx_t max_accumulator_threads = 0;
 
 	// MaxThreads > 1 enables parallel Phase 1 (scoring into per-thread
 	// accumulators). Single-threaded for small workloads (< 100 scored variants).
+	// .pgen index loaded once and shared by every thread's PgenReader
+	shared_ptr<PgenIndex> pgen_index;
+
 	idx_t MaxThreads() const override {
 		if (scored_variant_count < 100) {
 			return 1;
 		}
 		idx_t computed = std::min<idx_t>(scored_variant_count / 16 + 1, db_thread_count);
+		computed = std::min<idx_t>(computed, max_accumulator_threads);
 		return ApplyMaxThreadsCap(computed, max_threads_config);
 	}
 };
@@ -116,26 +155,180 @@ struct PlinkScoreGlobalState : public GlobalTableFunctionState {
 
 static constexpr uint32_t SCORE_BATCH_SIZE = 16;
 
+//! Budget for a thread's block of decoded dosages (block variants x samples doubles).
+static constexpr idx_t SCORE_DOSAGE_BLOCK_BYTES = 4 * 1024 * 1024;
+
 //! Per-thread scoring accumulators.
+//!
+//! Every variant's contribution is split into the value a hom_ref sample would get
+//! (added once per variant to hom_ref_scores / hom_ref_dosage_sum) and each sample's
+//! deviation from it (zero for hom_ref samples). The sparse path then only has to
+//! touch the difflist samples, and the dense path accumulates the same deviations,
+//! so both give identical sums.
 struct ScoreAccumulator {
-	vector<double> score_sums;
-	vector<double> dosage_sums;
-	vector<uint32_t> allele_cts;
-
-	void Init(uint32_t sample_ct) {
-		score_sums.resize(sample_ct, 0.0);
+	vector<double> score_sums;     // sample x score, row-major: sum of weight * deviation
+	vector<double> hom_ref_scores; // per score: sum of weight * hom_ref value
+	vector<double> dosage_sums;    // per sample: scored dosage minus hom_ref dosage
+	double hom_ref_dosage_sum = 0.0;
+	vector<uint32_t> missing_cts; // per sample: missing calls excluded from ALLELE_CT
+	uint32_t variant_ct = 0;      // variants that contributed
+
+	void Init(uint32_t sample_ct, uint32_t score_ct) {
+		score_sums.resize(static_cast<idx_t>(sample_ct) * score_ct, 0.0);
+		hom_ref_scores.resize(score_ct, 0.0);
 		dosage_sums.resize(sample_ct, 0.0);
-		allele_cts.resize(sample_ct, 0);
+		missing_cts.resize(sample_ct, 0);
 	}
 };
 
+//! How one variant's decoded ALT dosages (-9.0 = missing) map to scored values.
+struct ScoreVariantModel {
+	bool center = false;
+	bool no_mean_imputation = false;
+	bool flip = false;
+	double mean_alt = 0.0;
+	double mean_scored = 0.0;
+	double sd = 1.0;
+	double hom_ref_value = 0.0;  // Value(0.0)
+	double hom_ref_dosage = 0.0; // Dosage(0.0)
+
+	//! Value the weights multiply (0 for missing calls that are skipped).
+	double Value(double alt) const {
+		if (alt == -9.0) {
+			if (center || no_mean_imputation) {
+				return 0.0;
+			}
+			alt = mean_alt;
+		}
+		double scored_dosage = flip ? (2.0 - alt) : alt;
+		return center ? (scored_dosage - mean_scored) / sd : scored_dosage;
+	}
+
+	//! Contribution to NAMED_ALLELE_DOSAGE_SUM (not tracked under center).
+	double Dosage(double alt) const {
+		if (alt == -9.0) {
+			if (no_mean_imputation) {
+				return 0.0;
+			}
+			alt = mean_alt;
+		}
+		return flip ? (2.0 - alt) : alt;
+	}
+
+	//! Whether a missing call is left out of ALLELE_CT (no imputation).
+	bool ExcludesMissing() const {
+		return center || no_mean_imputation;
+	}
+};
+
+//! Build the model from the variant's ALT dosage sum over its non-missing samples.
+//! Returns false when the variant contributes nothing (all missing, or monomorphic
+//! under center).
+static bool BuildScoreVariantModel(const PlinkScoreBindData &bind_data, const ScoredVariant &sv, double sum_alt,
+                                   uint32_t non_missing_ct, ScoreVariantModel &model) {
+	if (non_missing_ct == 0) {
+		return false;
+	}
+	model.center = bind_data.center;
+	model.no_mean_imputation = bind_data.no_mean_imputation;
+	model.flip = sv.flip;
+	model.mean_alt = sum_alt / static_cast<double>(non_missing_ct);
+	if (model.center) {
+		double freq = model.mean_alt / 2.0;
+		model.sd = std::sqrt(2.0 * freq * (1.0 - freq));
+		if (model.sd == 0.0) {
+			return false;
+		}
+		model.mean_scored = sv.flip ? (2.0 - model.mean_alt) : model.mean_alt;
+	}
+	model.hom_ref_value = model.Value(0.0);
+	model.hom_ref_dosage = model.Dosage(0.0);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Blocked dosage x weights product
+// ---------------------------------------------------------------------------
+
+//! Tile sizes: a SCORE_TILE_SAMPLES x SCORE_TILE_SCORES block of the accumulator
+//! (64 KiB) stays in L2 while a block's dosage and weight rows stream through L1.
+static constexpr uint32_t SCORE_TILE_SAMPLES = 128;
+static constexpr uint32_t SCORE_TILE_SCORES = 64;
+
+//! scores[s * score_ct + k] += sum over b of dosages[b * sample_ct + s] * weights[b * score_ct + k].
+//! Each accumulator adds the block's variants in order, so the result is bit-identical
+//! to scoring the variants one at a time.
+static void AccumulateScoreBlock(const double *dosages, const double *weights, uint32_t block_ct, uint32_t sample_ct,
+                                 uint32_t score_ct, double *scores) {
+	for (uint32_t k0 = 0; k0 < score_ct; k0 += SCORE_TILE_SCORES) {
+		uint32_t k1 = MinValue(k0 + SCORE_TILE_SCORES, score_ct);
+		for (uint32_t s0 = 0; s0 < sample_ct; s0 += SCORE_TILE_SAMPLES) {
+			uint32_t s1 = MinValue(s0 + SCORE_TILE_SAMPLES, sample_ct);
+
+			// 4 samples x 4 scores register blocks
+			uint32_t s = s0;
+			for (; s + 4 <= s1; s += 4) {
+				uint32_t k = k0;
+				for (; k + 4 <= k1; k += 4) {
+					double acc[4][4];
+					for (uint32_t i = 0; i < 4; i++) {
+						for (uint32_t j = 0; j < 4; j++) {
+							acc[i][j] = scores[static_cast<idx_t>(s + i) * score_ct + k + j];
+						}
+					}
+					for (uint32_t b = 0; b < block_ct; b++) {
+						const double *d = dosages + static_cast<idx_t>(b) * sample_ct + s;
+						const double *w = weights + static_cast<idx_t>(b) * score_ct + k;
+						for (uint32_t i = 0; i < 4; i++) {
+							for (uint32_t j = 0; j < 4; j++) {
+								acc[i][j] += d[i] * w[j];
+							}
+						}
+					}
+					for (uint32_t i = 0; i < 4; i++) {
+						for (uint32_t j = 0; j < 4; j++) {
+							scores[static_cast<idx_t>(s + i) * score_ct + k + j] = acc[i][j];
+						}
+					}
+				}
+				// Score remainder (including the single-score case)
+				for (; k < k1; k++) {
+					double acc[4];
+					for (uint32_t i = 0; i < 4; i++) {
+						acc[i] = scores[static_cast<idx_t>(s + i) * score_ct + k];
+					}
+					for (uint32_t b = 0; b < block_ct; b++) {
+						const double *d = dosages + static_cast<idx_t>(b) * sample_ct + s;
+						double w = weights[static_cast<idx_t>(b) * score_ct + k];
+						for (uint32_t i = 0; i < 4; i++) {
+							acc[i] += d[i] * w;
+						}
+					}
+					for (uint32_t i = 0; i < 4; i++) {
+						scores[static_cast<idx_t>(s + i) * score_ct + k] = acc[i];
+					}
+				}
+			}
+			// Sample remainder
+			for (; s < s1; s++) {
+				for (uint32_t k = k0; k < k1; k++) {
+					double acc = scores[static_cast<idx_t>(s) * score_ct + k];
+					for (uint32_t b = 0; b < block_ct; b++) {
+						acc += dosages[static_cast<idx_t>(b) * sample_ct + s] * weights[static_cast<idx_t>(b) * score_ct + k];
+					}
+					scores[static_cast<idx_t>(s) * score_ct + k] = acc;
+				}
+			}
+		}
+	}
+}
+
 // ---------------------------------------------------------------------------
 // Local state (per-thread)
 // ---------------------------------------------------------------------------
 
 struct PlinkScoreLocalState : public LocalTableFunctionState {
-	plink2::PgenFileInfo pgfi;
-	AlignedBuffer pgfi_alloc_buf;
+	shared_ptr<PgenIndex> pgen_index; // shared read-only; declared first so it outlives pgr
 
 	plink2::PgenReader pgr;
 	AlignedBuffer pgr_alloc_buf;
@@ -148,6 +341,15 @@ struct PlinkScoreLocalState : public LocalTableFunctionState {
 	AlignedBuffer dosage_main_buf;
 	vector<double> dosage_doubles;
 
+	// Sparse path: packed 2-bit genotypes and subset-relative indices of the difflist
+	AlignedBuffer raregeno_buf;
+	vector<uint32_t> difflist_sample_ids;
+
+	// Block of scored dosages (block_capacity x samples) and their weight rows
+	vector<double> dosage_block;
+	vector<double> weight_block;
+	uint32_t block_capacity = 1;
+
 	// Thread-local scoring accumulator (for Phase 1)
 	ScoreAccumulator local_accum;
 	bool phase1_done = false;
@@ -158,7 +360,6 @@ struct PlinkScoreLocalState : public LocalTableFunctionState {
 		if (initialized) {
 			plink2::PglErr reterr = plink2::kPglRetSuccess;
 			plink2::CleanupPgr(&pgr, &reterr);
-			plink2::CleanupPgfi(&pgfi, &reterr);
 		}
 	}
 };
@@ -184,6 +385,14 @@ static unique_ptr<FunctionData> PlinkScoreBind(ClientContext &context, TableFunc
 			bind_data->center = kv.second.GetValue<bool>();
 		} else if (kv.first == "no_mean_imputation") {
 			bind_data->no_mean_imputation = kv.second.GetValue<bool>();
+		} else if (kv.first == "output") {
+			auto output = StringUtil::Lower(kv.second.GetValue<string>());
+			if (output == "long") {
+				bind_data->long_output = true;
+			} else if (output != "wide") {
+				throw InvalidInputException("plink_score: invalid output '%s' (expected 'wide' or 'long')",
+				                            kv.second.GetValue<string>());
+			}
 		} else if (kv.first == "weights" || kv.first == "samples" || kv.first == "region") {
 			// Handled below
 		}
@@ -212,48 +421,18 @@ static unique_ptr<FunctionData> PlinkScoreBind(ClientContext &context, TableFunc
 		}
 	}
 
-	// --- Initialize pgenlib (Phase 1) to get counts ---
+	// --- Load the .pgen index (counts now; the scan reuses it) ---
 	LocalizePgenIfRequested(context, bind_data->pgen_path, bind_data->localize_guard);
 	bind_data->use_vfs = PgenIoUseVfs(context, bind_data->pgen_path);
 	PgenVfsScope pgen_vfs_scope(context, bind_data->use_vfs);
 
-	plink2::PgenFileInfo pgfi;
-	plink2::PreinitPgfi(&pgfi);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err = plink2::PgfiInitPhase1(bind_data->pgen_path.c_str(), nullptr, UINT32_MAX, UINT32_MAX,
-	                                            &header_ctrl, &pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&pgfi, &cleanup_err);
-		throw IOException("plink_score: failed to open '%s': %s", bind_data->pgen_path, errstr_buf);
-	}
-
-	bind_data->raw_variant_ct = pgfi.raw_variant_ct;
-	bind_data->raw_sample_ct = pgfi.raw_sample_ct;
-
-	// Phase 2
-	AlignedBuffer pgfi_alloc;
-	if (pgfi_alloc_cacheline_ct > 0) {
-		pgfi_alloc.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
+	bind_data->pgen_index = LoadPgenIndex(bind_data->pgen_path, UINT32_MAX, UINT32_MAX, "plink_score");
+	bind_data->raw_variant_ct = bind_data->pgen_index->pgfi.raw_variant_ct;
+	bind_data->raw_sample_ct = bind_data->pgen_index->pgfi.raw_sample_ct;
 
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, pgfi.raw_variant_ct, &max_vrec_width, &pgfi,
-	                             pgfi_alloc.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-	plink2::CleanupPgfi(&pgfi, &cleanup_err);
-
-	if (err != plink2::kPglRetSuccess) {
-		throw IOException("plink_score: failed to initialize '%s' (phase 2): %s", bind_data->pgen_path, errstr_buf);
-	}
+	// gflags is final only after Phase 2 — variable-width pgen files only set
+	// kfPgenGlobalDosagePresent during Phase 2's vrtype scan
+	bind_data->file_has_dosage = (bind_data->pgen_index->pgfi.gflags & plink2::kfPgenGlobalDosagePresent) != 0;
 
 	// --- Load variant metadata ---
 	bind_data->variants = LoadVariantMetadata(context, bind_data->pvar_path, "plink_score");
@@ -330,12 +509,15 @@ static unique_ptr<FunctionData> PlinkScoreBind(ClientContext &context, TableFunc
 		}
 
 		if (child_type.id() == LogicalTypeId::STRUCT) {
-			// --- ID-keyed mode: LIST(STRUCT(id VARCHAR, allele VARCHAR, weight DOUBLE)) ---
+			// --- ID-keyed mode: LIST(STRUCT(id VARCHAR, allele VARCHAR, <score> DOUBLE, ...)) ---
+			// Every field besides id and allele is a score column; a single `weight`
+			// field is the classic one-score layout.
 			auto &struct_children = StructType::GetChildTypes(child_type);
 
 			// Validate struct field names
-			bool has_id = false, has_allele = false, has_weight = false;
-			idx_t id_idx = 0, allele_idx = 0, weight_idx = 0;
+			bool has_id = false, has_allele = false;
+			idx_t id_idx = 0, allele_idx = 0;
+			vector<idx_t> score_field_idx;
 			for (idx_t i = 0; i < struct_children.size(); i++) {
 				if (struct_children[i].first == "id") {
 					has_id = true;
@@ -343,16 +525,24 @@ static unique_ptr<FunctionData> PlinkScoreBind(ClientContext &context, TableFunc
 				} else if (struct_children[i].first == "allele") {
 					has_allele = true;
 					allele_idx = i;
-				} else if (struct_children[i].first == "weight") {
-					has_weight = true;
-					weight_idx = i;
+				} else {
+					score_field_idx.push_back(i);
 				}
 			}
 
-			if (!has_id || !has_allele || !has_weight) {
+			if (!has_id || !has_allele || score_field_idx.empty()) {
 				throw InvalidInputException("plink_score: ID-keyed weights must be "
-				                            "LIST(STRUCT(id VARCHAR, allele VARCHAR, weight DOUBLE))");
+				                            "LIST(STRUCT(id VARCHAR, allele VARCHAR, weight DOUBLE)), with one "
+				                            "numeric field per score for multiple scores");
 			}
+			for (auto i : score_field_idx) {
+				if (!struct_children[i].second.IsNumeric()) {
+					throw InvalidInputException("plink_score: score column '%s' must be numeric (got %s)",
+					                            struct_children[i].first, struct_children[i].second.ToString());
+				}
+				bind_data->score_names.push_back(struct_children[i].first);
+			}
+			bind_data->score_ct = static_cast<uint32_t>(score_field_idx.size());
 
 			// Build variant ID → file-row-vidx map restricted to the region.
 			// Iterating local indices (range is produced by ParseRegion in local
@@ -369,11 +559,19 @@ static unique_ptr<FunctionData> PlinkScoreBind(ClientContext &context, TableFunc
 			uint32_t unmatched_id_count = 0;
 			uint32_t unmatched_allele_count = 0;
 
+			vector<double> row(bind_data->score_ct);
 			for (auto &entry : children) {
 				auto &struct_vals = StructValue::GetChildren(entry);
 				string id = struct_vals[id_idx].GetValue<string>();
 				string allele = struct_vals[allele_idx].GetValue<string>();
-				double weight = struct_vals[weight_idx].GetValue<double>();
+
+				// A NULL score weight means the variant is not part of that score
+				bool any_nonzero = false;
+				for (uint32_t k = 0; k < bind_data->score_ct; k++) {
+					auto &w = struct_vals[score_field_idx[k]];
+					row[k] = w.IsNull() ? 0.0 : w.GetValue<double>();
+					any_nonzero |= row[k] != 0.0;
+				}
 
 				auto it = variant_id_map.find(id);
 				if (it == variant_id_map.end()) {
@@ -393,8 +591,10 @@ static unique_ptr<FunctionData> PlinkScoreBind(ClientContext &context, TableFunc
 					continue;
 				}
 
-				if (weight != 0.0) {
-					bind_data->scored_variants.push_back({vidx, weight, flip});
+				if (any_nonzero) {
+					auto weight_row = static_cast<uint32_t>(bind_data->weights.size() / bind_data->score_ct);
+					bind_data->weights.insert(bind_data->weights.end(), row.begin(), row.end());
+					bind_data->scored_variants.push_back({vidx, weight_row, flip});
 				}
 			}
 
@@ -412,7 +612,9 @@ static unique_ptr<FunctionData> PlinkScoreBind(ClientContext &context, TableFunc
 			for (idx_t i = 0; i < children.size(); i++) {
 				double w = children[i].GetValue<double>();
 				if (w != 0.0) {
-					bind_data->scored_variants.push_back({range_start + static_cast<uint32_t>(i), w, false});
+					auto weight_row = static_cast<uint32_t>(bind_data->weights.size());
+					bind_data->weights.push_back(w);
+					bind_data->scored_variants.push_back({range_start + static_cast<uint32_t>(i), weight_row, false});
 				}
 			}
 		}
@@ -421,10 +623,71 @@ static unique_ptr<FunctionData> PlinkScoreBind(ClientContext &context, TableFunc
 		                            "or LIST(STRUCT(id, allele, weight)) for ID-keyed mode)");
 	}
 
+	// --- Multi-score accumulator limit ---
+	// Each scoring thread holds a samples x scores accumulator; cap the thread count
+	// so that their total stays within plinking_max_matrix_elements.
+	uint64_t accum_elements = static_cast<uint64_t>(bind_data->effective_sample_ct) * bind_data->score_ct;
+	bind_data->max_accumulator_threads = NumericLimits<idx_t>::Maximum();
+	if (bind_data->score_ct > 1) {
+		Value max_elements_val;
+		uint64_t max_elements = 16ULL * 1024 * 1024 * 1024; // default
+		if (context.TryGetCurrentSetting("plinking_max_matrix_elements", max_elements_val)) {
+			auto val = max_elements_val.GetValue<int64_t>();
+			max_elements = val > 0 ? static_cast<uint64_t>(val) : 0;
+		}
+		if (accum_elements > max_elements) {
+			throw InvalidInputException(
+			    "plink_score: %u samples x %u scores would require %llu accumulator elements, exceeding "
+			    "plinking_max_matrix_elements (%llu). Score fewer panels per call, or increase the limit with "
+			    "SET plinking_max_matrix_elements = <value>.",
+			    bind_data->effective_sample_ct, bind_data->score_ct, static_cast<unsigned long long>(accum_elements),
+			    static_cast<unsigned long long>(max_elements));
+		}
+		bind_data->max_accumulator_threads = MaxValue<idx_t>(1, max_elements / MaxValue<uint64_t>(accum_elements, 1));
+	}
+
+	// --- Sparse (difflist) path: opt-in via plinking_score_sparse ---
+	// Rare variants are read as a difflist and only their carriers and missing samples
+	// are touched; common variants fall back to the dense decode per variant.
+	Value sparse_val;
+	bool want_sparse =
+	    context.TryGetCurrentSetting("plinking_score_sparse", sparse_val) && sparse_val.GetValue<bool>();
+	if (want_sparse && !bind_data->file_has_dosage) {
+		bind_data->use_sparse = true;
+		bind_data->max_difflist_len = MaxValue<uint32_t>(1, bind_data->effective_sample_ct / 8);
+	}
+
 	// --- Register output columns ---
-	names = {"FID", "IID", "ALLELE_CT", "DENOM", "NAMED_ALLELE_DOSAGE_SUM", "SCORE_SUM", "SCORE_AVG"};
-	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::INTEGER,
-	                LogicalType::DOUBLE,  LogicalType::DOUBLE,  LogicalType::DOUBLE};
+	// The classic single-score layout keeps SCORE_SUM / SCORE_AVG; named scores get
+	// <name>_SUM / <name>_AVG columns (wide) or a SCORE name column (long).
+	bool named_scores = !(bind_data->score_ct == 1 && (bind_data->score_names.empty() ||
+	                                                   bind_data->score_names[0] == "weight"));
+	if (!named_scores) {
+		bind_data->score_names = {"SCORE"};
+	}
+
+	auto add_column = [&](const string &name, const LogicalType &type, ScoreColumn kind, uint32_t score_idx = 0) {
+		names.push_back(name);
+		return_types.push_back(type);
+		bind_data->columns.push_back({kind, score_idx});
+	};
+	add_column("FID", LogicalType::VARCHAR, ScoreColumn::FID);
+	add_column("IID", LogicalType::VARCHAR, ScoreColumn::IID);
+	if (bind_data->long_output) {
+		add_column("SCORE", LogicalType::VARCHAR, ScoreColumn::SCORE);
+	}
+	add_column("ALLELE_CT", LogicalType::INTEGER, ScoreColumn::ALLELE_CT);
+	add_column("DENOM", LogicalType::INTEGER, ScoreColumn::DENOM);
+	add_column("NAMED_ALLELE_DOSAGE_SUM", LogicalType::DOUBLE, ScoreColumn::NAMED_ALLELE_DOSAGE_SUM);
+	if (bind_data->long_output || !named_scores) {
+		add_column("SCORE_SUM", LogicalType::DOUBLE, ScoreColumn::SCORE_SUM);
+		add_column("SCORE_AVG", LogicalType::DOUBLE, ScoreColumn::SCORE_AVG);
+	} else {
+		for (uint32_t k = 0; k < bind_data->score_ct; k++) {
+			add_column(bind_data->score_names[k] + "_SUM", LogicalType::DOUBLE, ScoreColumn::SCORE_SUM, k);
+			add_column(bind_data->score_names[k] + "_AVG", LogicalType::DOUBLE, ScoreColumn::SCORE_AVG, k);
+		}
+	}
 
 	return std::move(bind_data);
 }
@@ -443,11 +706,19 @@ static unique_ptr<GlobalTableFunctionState> PlinkScoreInitGlobal(ClientContext &
 	state->db_thread_count = static_cast<uint32_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
 	state->max_threads_config = GetPlinkingMaxThreads(context);
 	state->scored_variant_count = static_cast<uint32_t>(bind_data.scored_variants.size());
+	state->max_accumulator_threads = bind_data.max_accumulator_threads;
+	state->total_rows = static_cast<uint64_t>(state->total_samples) * (bind_data.long_output ? bind_data.score_ct : 1);
 
 	// Initialize accumulators
-	state->score_sums.resize(state->total_samples, 0.0);
+	state->score_sums.resize(static_cast<idx_t>(state->total_samples) * bind_data.score_ct, 0.0);
+	state->hom_ref_scores.resize(bind_data.score_ct, 0.0);
 	state->named_allele_dosage_sums.resize(state->total_samples, 0.0);
 	state->allele_cts.resize(state->total_samples, 0);
+	state->merge.Init(state->total_samples);
+
+	if (!bind_data.scored_variants.empty()) {
+		state->pgen_index = bind_data.pgen_index;
+	}
 
 	return std::move(state);
 }
@@ -459,6 +730,7 @@ static unique_ptr<GlobalTableFunctionState> PlinkScoreInitGlobal(ClientContext &
 static unique_ptr<LocalTableFunctionState> PlinkScoreInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
                                                                GlobalTableFunctionState *global_state) {
 	auto &bind_data = input.bind_data->Cast<PlinkScoreBindData>();
+	auto &gstate = global_state->Cast<PlinkScoreGlobalState>();
 	auto state = make_uniq<PlinkScoreLocalState>();
 
 	if (bind_data.scored_variants.empty()) {
@@ -466,55 +738,10 @@ static unique_ptr<LocalTableFunctionState> PlinkScoreInitLocal(ExecutionContext
 		return std::move(state);
 	}
 
-	// --- Initialize per-thread PgenFileInfo + PgenReader ---
+	// --- Per-thread PgenReader on the query's shared index ---
 	PgenVfsScope pgen_vfs_scope(context.client, bind_data.use_vfs);
-	plink2::PreinitPgfi(&state->pgfi);
-	plink2::PreinitPgr(&state->pgr);
-
-	char errstr_buf[plink2::kPglErrstrBufBlen];
-	plink2::PgenHeaderCtrl header_ctrl;
-	uintptr_t pgfi_alloc_cacheline_ct = 0;
-
-	plink2::PglErr err =
-	    plink2::PgfiInitPhase1(bind_data.pgen_path.c_str(), nullptr, bind_data.raw_variant_ct, bind_data.raw_sample_ct,
-	                           &header_ctrl, &state->pgfi, &pgfi_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_score: thread init failed (phase 1): %s", errstr_buf);
-	}
-
-	if (pgfi_alloc_cacheline_ct > 0) {
-		state->pgfi_alloc_buf.Allocate(pgfi_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	uint32_t max_vrec_width = 0;
-	uintptr_t pgr_alloc_cacheline_ct = 0;
-
-	err = plink2::PgfiInitPhase2(header_ctrl, 0, 0, 0, 0, state->pgfi.raw_variant_ct, &max_vrec_width, &state->pgfi,
-	                             state->pgfi_alloc_buf.As<unsigned char>(), &pgr_alloc_cacheline_ct, errstr_buf);
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_score: thread init failed (phase 2): %s", errstr_buf);
-	}
-
-	if (pgr_alloc_cacheline_ct > 0) {
-		state->pgr_alloc_buf.Allocate(pgr_alloc_cacheline_ct * plink2::kCacheline);
-	}
-
-	err = plink2::PgrInit(bind_data.pgen_path.c_str(), max_vrec_width, &state->pgfi, &state->pgr,
-	                      state->pgr_alloc_buf.As<unsigned char>());
-
-	if (err != plink2::kPglRetSuccess) {
-		plink2::PglErr cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgr(&state->pgr, &cleanup_err);
-		cleanup_err = plink2::kPglRetSuccess;
-		plink2::CleanupPgfi(&state->pgfi, &cleanup_err);
-		throw IOException("plink_score: PgrInit failed for '%s'", bind_data.pgen_path);
-	}
+	state->pgen_index = gstate.pgen_index;
+	InitPgenReader(*state->pgen_index, bind_data.pgen_path, state->pgr, state->pgr_alloc_buf, "plink_score");
 
 	// Set up sample subsetting
 	if (bind_data.has_sample_subset && bind_data.sample_subset) {
@@ -538,7 +765,20 @@ static unique_ptr<LocalTableFunctionState> PlinkScoreInitLocal(ExecutionContext
 
 	state->dosage_doubles.resize(bind_data.effective_sample_ct, 0.0);
 
-	state->local_accum.Init(bind_data.effective_sample_ct);
+	// Sparse workspace: sample_ids needs one extra slot (pgenlib appends sample_ct)
+	if (bind_data.use_sparse) {
+		uint32_t mdl = bind_data.max_difflist_len;
+		state->raregeno_buf.Allocate(plink2::NypCtToAlignedWordCt(mdl) * sizeof(uintptr_t));
+		state->difflist_sample_ids.resize(mdl + 2);
+	}
+
+	uint32_t sample_ct = MaxValue<uint32_t>(bind_data.effective_sample_ct, 1);
+	state->block_capacity = static_cast<uint32_t>(
+	    MaxValue<idx_t>(1, MinValue<idx_t>(SCORE_BATCH_SIZE, SCORE_DOSAGE_BLOCK_BYTES / (sample_ct * sizeof(double)))));
+	state->dosage_block.resize(static_cast<idx_t>(state->block_capacity) * bind_data.effective_sample_ct);
+	state->weight_block.resize(static_cast<idx_t>(state->block_capacity) * bind_data.score_ct);
+
+	state->local_accum.Init(bind_data.effective_sample_ct, bind_data.score_ct);
 
 	state->initialized = true;
 	return std::move(state);
@@ -548,10 +788,83 @@ static unique_ptr<LocalTableFunctionState> PlinkScoreInitLocal(ExecutionContext
 // Scan function
 // ---------------------------------------------------------------------------
 
+//! Decode a variant's ALT dosages (-9.0 = missing) into lstate.dosage_doubles.
+static void DecodeScoredDosages(const PlinkScoreBindData &bind_data, PlinkScoreLocalState &lstate,
+                                const uintptr_t *sample_include, uint32_t vidx) {
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	uint32_t dosage_ct = 0;
+
+	plink2::PglErr err = plink2::PgrGetD(sample_include, lstate.pssi, sample_ct, vidx, &lstate.pgr,
+	                                     lstate.genovec_buf.As<uintptr_t>(), lstate.dosage_present_buf.As<uintptr_t>(),
+	                                     lstate.dosage_main_buf.As<uint16_t>(), &dosage_ct);
+	if (err != plink2::kPglRetSuccess) {
+		throw IOException("plink_score: PgrGetD failed for variant %u", vidx);
+	}
+
+	plink2::Dosage16ToDoublesMinus9(lstate.genovec_buf.As<uintptr_t>(), lstate.dosage_present_buf.As<uintptr_t>(),
+	                                lstate.dosage_main_buf.As<uint16_t>(), sample_ct, dosage_ct,
+	                                lstate.dosage_doubles.data());
+}
+
+//! Sparse path read: returns true with the variant's difflist (carriers and missing
+//! samples of a hom_ref-majority variant) in lstate.raregeno_buf /
+//! difflist_sample_ids. Otherwise decodes densely into lstate.dosage_doubles and
+//! returns false.
+static bool ReadScoredDifflist(const PlinkScoreBindData &bind_data, PlinkScoreLocalState &lstate,
+                               const uintptr_t *sample_include, uint32_t vidx, uint32_t &difflist_len) {
+	uint32_t sample_ct = bind_data.effective_sample_ct;
+	uint32_t common_geno = 0;
+	auto *genovec = lstate.genovec_buf.As<uintptr_t>();
+	plink2::PglErr err = plink2::PgrGetDifflistOrGenovec(
+	    sample_include, lstate.pssi, sample_ct, bind_data.max_difflist_len, vidx, &lstate.pgr, genovec, &common_geno,
+	    lstate.raregeno_buf.As<uintptr_t>(), lstate.difflist_sample_ids.data(), &difflist_len);
+	if (err != plink2::kPglRetSuccess) {
+		throw IOException("plink_score: PgrGetDifflistOrGenovec failed for variant %u", vidx);
+	}
+	if (common_geno == 0) {
+		return true;
+	}
+	if (common_geno != UINT32_MAX) {
+		// A difflist whose majority is not hom_ref (ALT/missing-major): re-read
+		// densely. Such variants are uncommon, so the second read is negligible.
+		DecodeScoredDosages(bind_data, lstate, sample_include, vidx);
+		return false;
+	}
+	// Dense genovec returned; the file has no dosages, so hardcalls are the dosages
+	plink2::Dosage16ToDoublesMinus9(genovec, lstate.dosage_present_buf.As<uintptr_t>(),
+	                                lstate.dosage_main_buf.As<uint16_t>(), sample_ct, 0, lstate.dosage_doubles.data());
+	return false;
+}
+
+//! Per-variant constants: what every sample gets if it is hom_ref.
+static void AccumulateHomRef(const ScoreVariantModel &model, const double *weights, uint32_t score_ct,
+                             ScoreAccumulator &accum) {
+	for (uint32_t k = 0; k < score_ct; k++) {
+		accum.hom_ref_scores[k] += weights[k] * model.hom_ref_value;
+	}
+	if (!model.center) {
+		accum.hom_ref_dosage_sum += model.hom_ref_dosage;
+	}
+	accum.variant_ct++;
+}
+
+//! Per-sample deviation from the hom_ref constants, plus the weight-independent sums.
+static inline double AccumulateSampleDeviation(const ScoreVariantModel &model, double alt, uint32_t s,
+                                               ScoreAccumulator &accum) {
+	if (!model.center) {
+		accum.dosage_sums[s] += model.Dosage(alt) - model.hom_ref_dosage;
+	}
+	if (alt == -9.0 && model.ExcludesMissing()) {
+		accum.missing_cts[s]++;
+	}
+	return model.Value(alt) - model.hom_ref_value;
+}
+
 static void PlinkScoreScan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
 	auto &bind_data = data_p.bind_data->Cast<PlinkScoreBindData>();
 	auto &gstate = data_p.global_state->Cast<PlinkScoreGlobalState>();
 	auto &lstate = data_p.local_state->Cast<PlinkScoreLocalState>();
+	uint32_t score_ct = bind_data.score_ct;
 
 	// Phase 1: Score all variants (parallel via DuckDB thread pool)
 	if (!gstate.scoring_done.load(std::memory_order_acquire)) {
@@ -566,7 +879,10 @@ static void PlinkScoreScan(ClientContext &context, TableFunctionInput &data_p, D
 				sample_include = bind_data.sample_subset->SampleInclude();
 			}
 
-			// Claim batches of scored variants and process into thread-local accumulator
+			// Claim batches of scored variants. Each variant is decoded once into the
+			// dosage block; a full block is multiplied into the samples x scores
+			// accumulator in one pass instead of once per score.
+			uint32_t block_ct = 0;
 			while (true) {
 				uint32_t batch_start = gstate.next_scored_idx.fetch_add(SCORE_BATCH_SIZE);
 				if (batch_start >= total_scored) {
@@ -576,87 +892,109 @@ static void PlinkScoreScan(ClientContext &context, TableFunctionInput &data_p, D
 
 				for (uint32_t si = batch_start; si < batch_end; si++) {
 					auto &sv = bind_data.scored_variants[si];
-					uint32_t dosage_ct = 0;
-
-					plink2::PglErr err =
-					    plink2::PgrGetD(sample_include, lstate.pssi, sample_ct, sv.variant_idx, &lstate.pgr,
-					                    lstate.genovec_buf.As<uintptr_t>(), lstate.dosage_present_buf.As<uintptr_t>(),
-					                    lstate.dosage_main_buf.As<uint16_t>(), &dosage_ct);
-					if (err != plink2::kPglRetSuccess) {
-						throw IOException("plink_score: PgrGetD failed for variant %u", sv.variant_idx);
+					const double *weights = bind_data.weights.data() + static_cast<idx_t>(sv.weight_row) * score_ct;
+					auto &accum = lstate.local_accum;
+					ScoreVariantModel model;
+
+					uint32_t difflist_len = 0;
+					bool sparse = false;
+					if (bind_data.use_sparse) {
+						sparse = ReadScoredDifflist(bind_data, lstate, sample_include, sv.variant_idx, difflist_len);
+					} else {
+						DecodeScoredDosages(bind_data, lstate, sample_include, sv.variant_idx);
 					}
 
-					plink2::Dosage16ToDoublesMinus9(
-					    lstate.genovec_buf.As<uintptr_t>(), lstate.dosage_present_buf.As<uintptr_t>(),
-					    lstate.dosage_main_buf.As<uint16_t>(), sample_ct, dosage_ct, lstate.dosage_doubles.data());
+					if (sparse) {
+						// Only difflist samples deviate from hom_ref (2-bit codes 1, 2, 3 = missing)
+						const uintptr_t *raregeno = lstate.raregeno_buf.As<uintptr_t>();
+						const uint32_t *difflist_ids = lstate.difflist_sample_ids.data();
+						auto geno_at = [&](uint32_t j) {
+							return (raregeno[j / plink2::kBitsPerWordD2] >> (2 * (j % plink2::kBitsPerWordD2))) & 3;
+						};
+						double sum_alt = 0.0;
+						uint32_t missing_ct = 0;
+						for (uint32_t j = 0; j < difflist_len; j++) {
+							uintptr_t g = geno_at(j);
+							if (g == 3) {
+								missing_ct++;
+							} else {
+								sum_alt += static_cast<double>(g);
+							}
+						}
+						if (!BuildScoreVariantModel(bind_data, sv, sum_alt, sample_ct - missing_ct, model)) {
+							continue;
+						}
+
+						// Flush pending dense variants first so every accumulator adds its
+						// variants in file order, exactly as the dense path does.
+						if (block_ct > 0) {
+							AccumulateScoreBlock(lstate.dosage_block.data(), lstate.weight_block.data(), block_ct,
+							                     sample_ct, score_ct, accum.score_sums.data());
+							block_ct = 0;
+						}
+						AccumulateHomRef(model, weights, score_ct, accum);
+						for (uint32_t j = 0; j < difflist_len; j++) {
+							uint32_t s = difflist_ids[j];
+							uintptr_t g = geno_at(j);
+							double alt = (g == 3) ? -9.0 : static_cast<double>(g);
+							double deviation = AccumulateSampleDeviation(model, alt, s, accum);
+							double *scores = accum.score_sums.data() + static_cast<idx_t>(s) * score_ct;
+							for (uint32_t k = 0; k < score_ct; k++) {
+								scores[k] += deviation * weights[k];
+							}
+						}
+						continue;
+					}
 
-					// Per-variant statistics
+					// Dense: decoded dosages for every sample
+					const double *dosages = lstate.dosage_doubles.data();
 					double sum_alt = 0.0;
 					uint32_t non_missing_ct = 0;
 					for (uint32_t s = 0; s < sample_ct; s++) {
-						if (lstate.dosage_doubles[s] != -9.0) {
-							sum_alt += lstate.dosage_doubles[s];
+						if (dosages[s] != -9.0) {
+							sum_alt += dosages[s];
 							non_missing_ct++;
 						}
 					}
-
-					if (non_missing_ct == 0) {
+					if (!BuildScoreVariantModel(bind_data, sv, sum_alt, non_missing_ct, model)) {
 						continue;
 					}
 
-					if (bind_data.center) {
-						double mean_alt = sum_alt / static_cast<double>(non_missing_ct);
-						double freq = mean_alt / 2.0;
-						double sd = std::sqrt(2.0 * freq * (1.0 - freq));
-						if (sd == 0.0) {
-							continue;
-						}
-						double mean_scored = sv.flip ? (2.0 - mean_alt) : mean_alt;
-
-						for (uint32_t s = 0; s < sample_ct; s++) {
-							if (lstate.dosage_doubles[s] == -9.0) {
-								continue;
-							}
-							double scored_dosage =
-							    sv.flip ? (2.0 - lstate.dosage_doubles[s]) : lstate.dosage_doubles[s];
-							double standardized = (scored_dosage - mean_scored) / sd;
-							lstate.local_accum.score_sums[s] += sv.weight * standardized;
-							lstate.local_accum.allele_cts[s] += 2;
-						}
-					} else if (bind_data.no_mean_imputation) {
-						for (uint32_t s = 0; s < sample_ct; s++) {
-							if (lstate.dosage_doubles[s] == -9.0) {
-								continue;
-							}
-							double scored_dosage =
-							    sv.flip ? (2.0 - lstate.dosage_doubles[s]) : lstate.dosage_doubles[s];
-							lstate.local_accum.score_sums[s] += sv.weight * scored_dosage;
-							lstate.local_accum.dosage_sums[s] += scored_dosage;
-							lstate.local_accum.allele_cts[s] += 2;
-						}
-					} else {
-						double mean_alt = sum_alt / static_cast<double>(non_missing_ct);
-						for (uint32_t s = 0; s < sample_ct; s++) {
-							double alt_dosage =
-							    (lstate.dosage_doubles[s] == -9.0) ? mean_alt : lstate.dosage_doubles[s];
-							double scored_dosage = sv.flip ? (2.0 - alt_dosage) : alt_dosage;
-							lstate.local_accum.score_sums[s] += sv.weight * scored_dosage;
-							lstate.local_accum.dosage_sums[s] += scored_dosage;
-							lstate.local_accum.allele_cts[s] += 2;
-						}
+					AccumulateHomRef(model, weights, score_ct, accum);
+					double *row = lstate.dosage_block.data() + static_cast<idx_t>(block_ct) * sample_ct;
+					for (uint32_t s = 0; s < sample_ct; s++) {
+						row[s] = AccumulateSampleDeviation(model, dosages[s], s, accum);
+					}
+					std::copy_n(weights, score_ct, lstate.weight_block.data() + static_cast<idx_t>(block_ct) * score_ct);
+					if (++block_ct == lstate.block_capacity) {
+						AccumulateScoreBlock(lstate.dosage_block.data(), lstate.weight_block.data(), block_ct,
+						                     sample_ct, score_ct, accum.score_sums.data());
+						block_ct = 0;
 					}
 				}
 			}
+			if (block_ct > 0) {
+				AccumulateScoreBlock(lstate.dosage_block.data(), lstate.weight_block.data(), block_ct, sample_ct,
+				                     score_ct, lstate.local_accum.score_sums.data());
+			}
 
-			// Merge thread-local accumulator into global state under mutex
-			{
-				std::lock_guard<std::mutex> lock(gstate.merge_mutex);
-				for (uint32_t s = 0; s < sample_ct; s++) {
-					gstate.score_sums[s] += lstate.local_accum.score_sums[s];
-					gstate.named_allele_dosage_sums[s] += lstate.local_accum.dosage_sums[s];
-					gstate.allele_cts[s] += lstate.local_accum.allele_cts[s];
+			// Merge thread-local accumulator into global state, one sample stripe at a time
+			auto &accum = lstate.local_accum;
+			gstate.merge.Merge([&](idx_t begin, idx_t end) {
+				if (begin == 0) {
+					// The per-score constants ride along with the first stripe's lock
+					for (uint32_t k = 0; k < score_ct; k++) {
+						gstate.hom_ref_scores[k] += accum.hom_ref_scores[k];
+					}
 				}
-			}
+				for (idx_t i = begin * score_ct; i < end * score_ct; i++) {
+					gstate.score_sums[i] += accum.score_sums[i];
+				}
+				for (idx_t s = begin; s < end; s++) {
+					gstate.named_allele_dosage_sums[s] += accum.dosage_sums[s] + accum.hom_ref_dosage_sum;
+					gstate.allele_cts[s] += 2 * (accum.variant_ct - accum.missing_cts[s]);
+				}
+			});
 			lstate.phase1_done = true;
 
 			// Last thread transitions to Phase 2
@@ -671,26 +1009,27 @@ static void PlinkScoreScan(ClientContext &context, TableFunctionInput &data_p, D
 		}
 	}
 
-	// Phase 2: Emit one row per sample
+	// Phase 2: Emit one row per sample (wide) or per sample x score (long)
 	auto &column_ids = gstate.column_ids;
-	uint32_t total_samples = gstate.total_samples;
+	uint32_t rows_per_sample = bind_data.long_output ? score_ct : 1;
 	bool has_fid = !bind_data.sample_info.fids.empty();
 
 	idx_t rows_emitted = 0;
 
 	while (rows_emitted < STANDARD_VECTOR_SIZE) {
-		uint32_t sidx = gstate.next_sample_idx.fetch_add(1);
-		if (sidx >= total_samples) {
+		uint64_t row_idx = gstate.next_row_idx.fetch_add(1);
+		if (row_idx >= gstate.total_rows) {
 			break;
 		}
+		auto sidx = static_cast<uint32_t>(row_idx / rows_per_sample);
+		auto row_score = static_cast<uint32_t>(row_idx % rows_per_sample);
 
 		// Map output index to original sample index
 		uint32_t orig_idx = bind_data.sample_output_order[sidx];
 
 		uint32_t allele_ct = gstate.allele_cts[sidx];
-		double score_sum = gstate.score_sums[sidx];
 		double dosage_sum = gstate.named_allele_dosage_sums[sidx];
-		double score_avg = (allele_ct > 0) ? score_sum / static_cast<double>(allele_ct) : 0.0;
+		const double *deviation_sums = gstate.score_sums.data() + static_cast<idx_t>(sidx) * score_ct;
 
 		for (idx_t out_col = 0; out_col < column_ids.size(); out_col++) {
 			auto file_col = column_ids[out_col];
@@ -699,9 +1038,11 @@ static void PlinkScoreScan(ClientContext &context, TableFunctionInput &data_p, D
 			}
 
 			auto &vec = output.data[out_col];
+			auto &col = bind_data.columns[file_col];
+			uint32_t score_idx = bind_data.long_output ? row_score : col.score_idx;
 
-			switch (file_col) {
-			case COL_FID: {
+			switch (col.kind) {
+			case ScoreColumn::FID: {
 				if (has_fid) {
 					FlatVector::GetData<string_t>(vec)[rows_emitted] =
 					    StringVector::AddString(vec, bind_data.sample_info.fids[orig_idx]);
@@ -710,33 +1051,36 @@ static void PlinkScoreScan(ClientContext &context, TableFunctionInput &data_p, D
 				}
 				break;
 			}
-			case COL_IID: {
+			case ScoreColumn::IID: {
 				FlatVector::GetData<string_t>(vec)[rows_emitted] =
 				    StringVector::AddString(vec, bind_data.sample_info.iids[orig_idx]);
 				break;
 			}
-			case COL_ALLELE_CT: {
-				FlatVector::GetData<int32_t>(vec)[rows_emitted] = static_cast<int32_t>(allele_ct);
+			case ScoreColumn::SCORE: {
+				FlatVector::GetData<string_t>(vec)[rows_emitted] =
+				    StringVector::AddString(vec, bind_data.score_names[score_idx]);
 				break;
 			}
-			case COL_DENOM: {
+			case ScoreColumn::ALLELE_CT:
+			case ScoreColumn::DENOM: {
 				FlatVector::GetData<int32_t>(vec)[rows_emitted] = static_cast<int32_t>(allele_ct);
 				break;
 			}
-			case COL_NAMED_ALLELE_DOSAGE_SUM: {
+			case ScoreColumn::NAMED_ALLELE_DOSAGE_SUM: {
 				FlatVector::GetData<double>(vec)[rows_emitted] = dosage_sum;
 				break;
 			}
-			case COL_SCORE_SUM: {
-				FlatVector::GetData<double>(vec)[rows_emitted] = score_sum;
+			case ScoreColumn::SCORE_SUM: {
+				FlatVector::GetData<double>(vec)[rows_emitted] =
+				    gstate.hom_ref_scores[score_idx] + deviation_sums[score_idx];
 				break;
 			}
-			case COL_SCORE_AVG: {
-				FlatVector::GetData<double>(vec)[rows_emitted] = score_avg;
+			case ScoreColumn::SCORE_AVG: {
+				double score_sum = gstate.hom_ref_scores[score_idx] + deviation_sums[score_idx];
+				FlatVector::GetData<double>(vec)[rows_emitted] =
+				    (allele_ct > 0) ? score_sum / static_cast<double>(allele_ct) : 0.0;
 				break;
 			}
-			default:
-				break;
 			}
 		}
 
@@ -763,6 +1107,7 @@ void RegisterPlinkScore(ExtensionLoader &loader) {
 	plink_score.named_parameters["region"] = LogicalType::VARCHAR;
 	plink_score.named_parameters["center"] = LogicalType::BOOLEAN;
 	plink_score.named_parameters["no_mean_imputation"] = LogicalType::BOOLEAN;
+	plink_score.named_parameters["output"] = LogicalType::VARCHAR;
 
 	loader.RegisterFunction(plink_score);
 }
@@ -9,10 +9,15 @@
 #include "plink_hardy.hpp"
 #include "plink_missing.hpp"
 #include "plink_ld.hpp"
+#include "plink_prune.hpp"
+#include "plink_clump.hpp"
 #include "plink_score.hpp"
 #include "plink_glm.hpp"
+#include "plink_king.hpp"
 #include "vcf_reader.hpp"
+#include "pgen_vfs_opener.hpp"
 #ifdef PLINKING_HAVE_EIGEN3
+#include "plink_grm.hpp"
 #include "plink_pca.hpp"
 #endif
 #include "duckdb.hpp"
@@ -41,6 +46,19 @@ static void SetPlinkingMaxThreads(ClientContext &, SetScope, Value &parameter) {
 	}
 }
 
+static void SetPlinkingPgenCacheSize(ClientContext &, SetScope scope, Value &parameter) {
+	auto val = parameter.GetValue<int64_t>();
+	if (val < 0) {
+		throw InvalidInputException("plinking_pgen_cache_size must be non-negative (0 = disabled)");
+	}
+	// One cache per process: a session value would resize it under other sessions
+	if (scope != SetScope::GLOBAL) {
+		throw InvalidInputException("plinking_pgen_cache_size sizes a process-wide cache: use SET GLOBAL "
+		                            "(or RESET GLOBAL) plinking_pgen_cache_size");
+	}
+	SetPgenCacheBudget(val);
+}
+
 void PlinkingDuckExtension::Load(ExtensionLoader &loader) {
 	// Register config options
 	auto &db = loader.GetDatabaseInstance();
@@ -67,7 +85,10 @@ void PlinkingDuckExtension::Load(ExtensionLoader &loader) {
 	    "How .pgen bytes are read: 'auto' (default — remote/VFS paths via DuckDB's VFS, local via native "
 	    "fopen), 'native' (always native fopen; errors on remote), 'vfs' (always via DuckDB's VFS, even "
 	    "local), 'localize' (materialize a local temp copy then read natively — best for remote full scans; "
-	    "always copies, even a local source).",
+	    "always copies, even a local source), 'mmap' (local files read from one shared read-only mapping "
+	    "per process — for hot local files; remote paths as 'auto'), 'uring' (local files read through "
+	    "per-reader io_uring read-ahead of upcoming records — for latency-bound local scans; falls back to "
+	    "native fopen where io_uring is unavailable; remote paths as 'auto').",
 	    LogicalType::VARCHAR, Value("auto"));
 
 	config.AddExtensionOption("plinking_localize_dir",
@@ -77,6 +98,14 @@ void PlinkingDuckExtension::Load(ExtensionLoader &loader) {
 	                          "removed when the query's bind data is destroyed.",
 	                          LogicalType::VARCHAR, Value(""));
 
+	config.AddExtensionOption("plinking_pgen_cache_size",
+	                          "Byte budget of the process-wide block cache for .pgen reads through DuckDB's VFS "
+	                          "(remote paths, or plinking_pgen_io := 'vfs'). Shared by every thread, query and "
+	                          "session in the process, so it is set with SET GLOBAL only. LRU-evicted, keyed by "
+	                          "path, size, last-modified time and 256 KiB block. Default 256 MiB; 0 disables it "
+	                          "(each reader keeps a private 2 MiB read-ahead).",
+	                          LogicalType::BIGINT, Value::BIGINT(PGEN_CACHE_SIZE_DEFAULT), SetPlinkingPgenCacheSize);
+
 	config.AddExtensionOption("plinking_sample_counts_sparse",
 	                          "orient := 'sample' + genotypes := 'counts'|'stats': when true, use the "
 	                          "sparse (pgen difflist) accumulation path — reads only the non-hom_ref "
@@ -85,6 +114,57 @@ void PlinkingDuckExtension::Load(ExtensionLoader &loader) {
 	                          "both; both paths produce identical counts.",
 	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
 
+	config.AddExtensionOption("plinking_score_sparse",
+	                          "plink_score: when true, read rare variants as pgen difflists and touch only "
+	                          "their carriers and missing samples, adding the hom_ref contribution once per "
+	                          "variant (auto-falls-back to the dense decode per variant for common variants, "
+	                          "and for files with dosages). Both paths produce identical scores.",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+
+	config.AddExtensionOption("plinking_glm_linear_engine",
+	                          "plink_glm linear model with covariates: 'projected' (default — the intercept + "
+	                          "covariates are factored once per missingness pattern and each variant costs a few "
+	                          "dot products) or 'full' (the reference full regression per variant). Both give "
+	                          "the same results up to floating-point rounding; toggle to A/B time them.",
+	                          LogicalType::VARCHAR, Value("projected"));
+
+	config.AddExtensionOption("plinking_glm_sparse",
+	                          "plink_glm linear models: when true, read rare variants as pgen difflists and build "
+	                          "each fit's sufficient statistics from the carriers and missing samples only "
+	                          "(auto-falls-back to the dense decode per variant for common variants; off for files "
+	                          "with dosages and for logistic phenotypes). Results are identical to the projected "
+	                          "engine's dense path.",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+
+	config.AddExtensionOption("plinking_ld_kernel",
+	                          "Pair kernel for plink_ld: 'auto' (default — bitplane AND + popcount using the "
+	                          "widest SIMD variant the CPU supports: AVX-512, AVX2, else portable), 'popcount' "
+	                          "(bitplane kernel, portable 64-bit words only), 'scalar' (the reference per-sample "
+	                          "loop). All kernels produce identical results; toggle to A/B time them.",
+	                          LogicalType::VARCHAR, Value("auto"));
+
+	config.AddExtensionOption("plinking_pca_genotype_cache",
+	                          "plink_pca: keep every effective variant's packed 2-bit genotypes in memory after "
+	                          "the first pass, so the remaining n_pcs + 1 passes do no .pgen I/O or decompression. "
+	                          "Used only when the cache fits in half of the remaining memory_limit budget "
+	                          "(otherwise every pass re-reads); it is counted against memory_limit while the "
+	                          "query runs. Default true.",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+
+	config.AddExtensionOption("plinking_pca_sketch_max_bytes",
+	                          "plink_pca algorithm := 'sketch': memory budget for the in-memory sketch, QQ and "
+	                          "per-thread partials. One partial per scan thread is set aside first; sketch rows "
+	                          "then fold together as many consecutive variants as needed to fit the rest (one per "
+	                          "row when possible). Threads are capped to the partials that fit. The sketch and "
+	                          "partials count against memory_limit. Default 16 GiB.",
+	                          LogicalType::BIGINT, Value::BIGINT(16LL * 1024 * 1024 * 1024));
+
+	config.AddExtensionOption("plinking_ld_window_cache_bytes",
+	                          "Per-thread budget for plink_ld's windowed-mode cache of decoded variants. "
+	                          "Sized to the widest window, so each variant is decoded about once per thread "
+	                          "instead of once per anchor. Default 64 MiB; 0 disables the cache.",
+	                          LogicalType::BIGINT, Value::BIGINT(64LL * 1024 * 1024));
+
 	// Register table functions
 	RegisterPvarReader(loader);
 	RegisterPsamReader(loader);
@@ -94,11 +174,17 @@ void PlinkingDuckExtension::Load(ExtensionLoader &loader) {
 	RegisterPlinkHardy(loader);
 	RegisterPlinkMissing(loader);
 	RegisterPlinkLd(loader);
+	RegisterPlinkPrune(loader);
+	RegisterPlinkClump(loader);
 	RegisterPlinkScore(loader);
 	RegisterPlinkGlm(loader);
+	RegisterPlinkKing(loader);
 	RegisterPlinkVcfReader(loader);
+	RegisterPgenCacheStats(loader);
 #ifdef PLINKING_HAVE_EIGEN3
 	RegisterPlinkPca(loader);
+	RegisterPlinkPcaProject(loader);
+	RegisterPlinkGrm(loader);
 #endif
 }
 
@@ -4,7 +4,11 @@
 // Path V (opener registered + claims fname): a cookie FILE* (fopencookie on
 // glibc/musl, funopen on macOS/BSD) whose read/seek/close drive the extension's
 // per-thread opener (positioned reads on a DuckDB FileHandle). glibc stdio buffers
-// the cookie stream, so Path V gets readahead for free on top of the handle.
+// the cookie stream, so Path V gets readahead for free on top of the handle, and
+// plinking_pgen_prefetch fetches a scan's upcoming records in the background.
+// Path M (plinking_pgen_set_mmap + a local fname): a cookie FILE* whose reads
+// memcpy out of one shared, refcounted PROT_READ mapping of the file, with
+// MADV_WILLNEED ahead of sequential runs.
 //
 // Unsupported platforms (Windows/wasm — already excluded from the build) have no
 // cookie primitive: plinking_pgen_vfs_supported() returns 0 and Path V opens fall
@@ -21,6 +25,8 @@
 
 #include "plinking_pgen_vfs.hpp"
 
+#include <algorithm>
+#include <cerrno>
 #include <cstdlib>
 #include <cstring>
 
@@ -30,21 +36,191 @@
 #define PLINKING_PGEN_VFS_COOKIE 1
 #endif
 
+#if defined(PLINKING_PGEN_VFS_COOKIE) || defined(PLINKING_PGEN_VFS_FUNOPEN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif
+
+// Path U needs the io_uring uapi header; the syscalls are made directly (no liburing).
+#if defined(PLINKING_PGEN_VFS_COOKIE) && defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define PLINKING_PGEN_VFS_URING 1
+#endif
+#endif
+#endif
+
 namespace {
 
 // Per-thread registered opener (set by the extension for Path V).
 thread_local const PlinkingPgenVfsOpener *t_opener = nullptr;
 
+// Per-thread Path M switch (set by the extension under plinking_pgen_io := 'mmap').
+thread_local bool t_mmap = false;
+
+// Per-thread Path U switch (set by the extension under plinking_pgen_io := 'uring').
+thread_local bool t_uring = false;
+
 #if defined(PLINKING_PGEN_VFS_COOKIE) || defined(PLINKING_PGEN_VFS_FUNOPEN)
 
 // Read-ahead block cache. pgenlib reads in ~8 KiB stdio chunks; a remote FileHandle
 // (httpfs) over-fetches a large window PER read and does not reuse it, so a naive
 // 1:1 mapping fetched ~20x the bytes pgenlib actually needs. Instead we fetch
 // aligned BLOCK-sized chunks once and serve pgenlib's small reads (and pgen's
-// seek-back ldbase re-reads) from a tiny LRU — collapsing the over-fetch to ~1x
+// seek-back ldbase re-reads) from cached blocks — collapsing the over-fetch to ~1x
 // while staying below cache_httpfs (which, if loaded, caches these block fetches).
+//
+// Blocks live in a process-wide cache (below) shared by every cookie, so scan
+// threads and later queries reuse each other's fetches of the same index and
+// record blocks. With the shared cache disabled (budget 0) each open falls back
+// to a private LRU of kPgenVfsNBlocks blocks.
 static const uint64_t kPgenVfsBlock = 262144; // 256 KiB
-static const int kPgenVfsNBlocks = 8;         // 2 MiB read-ahead cache per open (per reader/thread)
+static const int kPgenVfsNBlocks = 8;         // 2 MiB private cache per open (shared cache disabled)
+
+// Largest span one plinking_pgen_prefetch fetches (further capped at budget / 8 so
+// a batch's blocks are not evicted before its reader gets to them).
+static const uint64_t kPgenPrefetchMax = 16777216; // 16 MiB
+
+// --- Process-wide shared block cache ---------------------------------------------
+
+// Blocks are keyed by (file id, block offset). A file id names one version of a
+// file: (path, size, version token — the opener's last-modified time), so a file
+// rewritten in place gets a new id and its stale blocks simply age out of the LRU.
+struct PgenBlockKey {
+	uint64_t file_id;
+	uint64_t offset;
+	bool operator==(const PgenBlockKey &other) const {
+		return file_id == other.file_id && offset == other.offset;
+	}
+};
+
+struct PgenBlockKeyHash {
+	size_t operator()(const PgenBlockKey &key) const {
+		uint64_t h = key.file_id * 0x9E3779B97F4A7C15ULL ^ (key.offset / kPgenVfsBlock);
+		return static_cast<size_t>(h ^ (h >> 29));
+	}
+};
+
+// A prefetch claims the blocks it will fetch by inserting kPending placeholders,
+// then publishes each as kReady — or kFailed, which sends its waiters to fetch it
+// themselves. Blocks fetched on demand are inserted kReady.
+enum PgenBlockState : int { kPgenBlockPending, kPgenBlockReady, kPgenBlockFailed };
+
+struct PgenBlock {
+	std::unique_ptr<unsigned char[]> data;
+	uint32_t len = 0; // written under the owning shard's lock
+	std::atomic<int> state {kPgenBlockReady};
+};
+
+// Sharded so concurrent readers rarely contend: a shard lock covers only the
+// lookup or the insert + eviction, never the fetch itself. Two threads missing the
+// same block may both fetch it; the second insert keeps the first copy.
+static const size_t kPgenCacheShards = 16;
+
+struct PgenCacheShard {
+	std::mutex lock;
+	std::list<std::pair<PgenBlockKey, std::shared_ptr<const PgenBlock>>> lru; // front = most recent
+	std::unordered_map<PgenBlockKey, decltype(lru)::iterator, PgenBlockKeyHash> index;
+	uint64_t bytes = 0;
+};
+
+struct PgenBlockCache {
+	PgenCacheShard shards[kPgenCacheShards];
+	std::atomic<uint64_t> budget {256ULL * 1024 * 1024}; // plinking_pgen_cache_size default
+	std::atomic<uint64_t> hits {0};
+	std::atomic<uint64_t> misses {0};
+	std::atomic<uint64_t> evictions {0};
+	std::atomic<uint64_t> prefetched {0};
+
+	// Readers waiting on a pending (prefetching) block.
+	std::mutex pending_lock;
+	std::condition_variable pending_cv;
+
+	PgenCacheShard &ShardFor(const PgenBlockKey &key) {
+		return shards[PgenBlockKeyHash()(key) % kPgenCacheShards];
+	}
+};
+
+// Leaked on purpose: cookies may still close during static destruction.
+PgenBlockCache &BlockCache() {
+	static auto *cache = new PgenBlockCache();
+	return *cache;
+}
+
+// Streams that act on plinking_pgen_prefetch hints (Path V on the shared cache,
+// Path U), keyed by the FILE* pgenlib holds.
+struct PgenPrefetchTarget {
+	void (*prefetch)(void *cookie, uint64_t offset, uint64_t len);
+	void *cookie;
+};
+
+struct PgenStreamRegistry {
+	std::mutex lock;
+	std::unordered_map<FILE *, PgenPrefetchTarget> streams;
+};
+
+// Leaked on purpose, like the block cache.
+PgenStreamRegistry &StreamRegistry() {
+	static auto *registry = new PgenStreamRegistry();
+	return *registry;
+}
+
+void RegisterStream(FILE *f, void (*prefetch)(void *, uint64_t, uint64_t), void *cookie) {
+	auto &registry = StreamRegistry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	registry.streams[f] = PgenPrefetchTarget {prefetch, cookie};
+}
+
+void UnregisterStream(FILE *f) {
+	auto &registry = StreamRegistry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	registry.streams.erase(f);
+}
+
+// Caller holds shard.lock.
+void EvictToBudget(PgenBlockCache &cache, PgenCacheShard &shard, uint64_t shard_budget) {
+	while (shard.bytes > shard_budget && !shard.lru.empty()) {
+		auto &victim = shard.lru.back();
+		shard.bytes -= victim.second->len;
+		shard.index.erase(victim.first);
+		shard.lru.pop_back();
+		cache.evictions.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+// A 64-bit FNV-1a hash of (path, size, version) rather than an interned counter, so
+// no per-file state outlives the file's blocks. Never 0 (0 = private cache).
+uint64_t PgenFileId(const char *fname, uint64_t size, int64_t version) {
+	uint64_t h = 0xCBF29CE484222325ULL;
+	auto mix = [&h](const void *p, size_t n) {
+		auto *bytes = static_cast<const unsigned char *>(p);
+		for (size_t i = 0; i < n; i++) {
+			h = (h ^ bytes[i]) * 0x100000001B3ULL;
+		}
+	};
+	mix(fname, std::strlen(fname) + 1);
+	mix(&size, sizeof(size));
+	mix(&version, sizeof(version));
+	return h ? h : 1;
+}
 
 // Cookie state — SELF-CONTAINED: it COPIES the read/close callbacks (it must
 // outlive the PlinkingPgenVfsOpener, which the extension may destroy right after
@@ -55,29 +231,56 @@ struct PgenCookie {
 	void *handle;
 	uint64_t offset;
 	uint64_t size;
-	unsigned char *cache;               // kPgenVfsNBlocks * kPgenVfsBlock
-	uint64_t blk_off[kPgenVfsNBlocks];  // aligned block start; UINT64_MAX = empty
-	uint32_t blk_len[kPgenVfsNBlocks];  // valid bytes in the block
-	uint32_t blk_tick[kPgenVfsNBlocks]; // LRU stamp
+
+	// The handle is not safe for concurrent reads: the stream and its background
+	// prefetch take turns. `prefetch` is the in-flight prefetch, joined on close.
+	std::mutex io_lock;
+	std::future<void> prefetch;
+	FILE *stream; // registered for plinking_pgen_prefetch (shared cache only)
+
+	// Shared cache (file_id != 0): the block the stream is currently reading, held so
+	// consecutive stdio reads within it skip the shard lookup (and survive eviction).
+	uint64_t file_id;
+	std::shared_ptr<const PgenBlock> cur;
+	uint64_t cur_off;
+
+	// Private cache (file_id == 0)
+	std::unique_ptr<unsigned char[]> cache; // kPgenVfsNBlocks * kPgenVfsBlock
+	uint64_t blk_off[kPgenVfsNBlocks];      // aligned block start; UINT64_MAX = empty
+	uint32_t blk_len[kPgenVfsNBlocks];      // valid bytes in the block
+	uint32_t blk_tick[kPgenVfsNBlocks];     // LRU stamp
 	uint32_t tick;
 };
 
-PgenCookie *MakeCookie(const PlinkingPgenVfsOpener *ops, void *handle) {
-	auto *c = static_cast<PgenCookie *>(std::malloc(sizeof(PgenCookie)));
+int64_t CookiePread(PgenCookie *c, void *buf, uint64_t n, uint64_t offset) {
+	std::lock_guard<std::mutex> guard(c->io_lock);
+	return c->pread(c->handle, buf, static_cast<int64_t>(n), offset);
+}
+
+PgenCookie *MakeCookie(const PlinkingPgenVfsOpener *ops, void *handle, const char *fname) {
+	auto *c = new (std::nothrow) PgenCookie();
 	if (!c) {
 		return nullptr;
 	}
-	c->cache = static_cast<unsigned char *>(std::malloc(static_cast<size_t>(kPgenVfsNBlocks) * kPgenVfsBlock));
-	if (!c->cache) {
-		std::free(c);
-		return nullptr;
-	}
 	c->pread = ops->pread;
 	c->close = ops->close;
 	c->handle = handle;
 	c->offset = 0;
 	int64_t sz = ops->size(handle);
 	c->size = (sz < 0) ? 0 : static_cast<uint64_t>(sz);
+	c->stream = nullptr;
+	c->file_id = 0;
+	c->cur_off = UINT64_MAX;
+	if (BlockCache().budget.load(std::memory_order_relaxed) > 0) {
+		int64_t version = ops->version ? ops->version(handle) : 0;
+		c->file_id = PgenFileId(fname, c->size, version);
+		return c;
+	}
+	c->cache.reset(new (std::nothrow) unsigned char[static_cast<size_t>(kPgenVfsNBlocks) * kPgenVfsBlock]);
+	if (!c->cache) {
+		delete c;
+		return nullptr;
+	}
 	for (int i = 0; i < kPgenVfsNBlocks; i++) {
 		c->blk_off[i] = UINT64_MAX;
 		c->blk_len[i] = 0;
@@ -87,26 +290,84 @@ PgenCookie *MakeCookie(const PlinkingPgenVfsOpener *ops, void *handle) {
 	return c;
 }
 
-// Serve up to one block's worth from `c->offset`; returns bytes served (0 at EOF,
-// <0 on error). A read spanning a block boundary is clamped — stdio re-calls for
-// the rest. Advances c->offset by the amount served.
-int64_t CachedRead(PgenCookie *c, void *buf, size_t n) {
-	if (c->offset >= c->size) {
-		return 0;
+// Wait out a pending prefetch of `block`; false when that prefetch failed.
+bool AwaitBlock(PgenBlockCache &cache, const PgenBlock &block) {
+	if (block.state.load(std::memory_order_acquire) == kPgenBlockPending) {
+		std::unique_lock<std::mutex> lock(cache.pending_lock);
+		cache.pending_cv.wait(lock,
+		                      [&block] { return block.state.load(std::memory_order_acquire) != kPgenBlockPending; });
 	}
-	uint64_t avail_total = c->size - c->offset;
-	if (static_cast<uint64_t>(n) > avail_total) {
-		n = static_cast<size_t>(avail_total);
+	return block.state.load(std::memory_order_acquire) == kPgenBlockReady;
+}
+
+void PublishBlock(PgenBlockCache &cache, PgenBlock &block, PgenBlockState state) {
+	{
+		std::lock_guard<std::mutex> guard(cache.pending_lock);
+		block.state.store(state, std::memory_order_release);
 	}
-	if (n == 0) {
-		return 0;
+	cache.pending_cv.notify_all();
+}
+
+// Fetch the block at `blk` (aligned) through the shared cache; nullptr on a read error.
+std::shared_ptr<const PgenBlock> SharedBlock(PgenCookie *c, uint64_t blk) {
+	auto &cache = BlockCache();
+	PgenBlockKey key {c->file_id, blk};
+	auto &shard = cache.ShardFor(key);
+	std::shared_ptr<const PgenBlock> found;
+	{
+		std::lock_guard<std::mutex> guard(shard.lock);
+		auto it = shard.index.find(key);
+		if (it != shard.index.end()) {
+			shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+			found = it->second->second;
+		}
 	}
-	uint64_t blk = (c->offset / kPgenVfsBlock) * kPgenVfsBlock;
-	size_t in_off = static_cast<size_t>(c->offset - blk);
-	size_t max_in_block = static_cast<size_t>(kPgenVfsBlock) - in_off;
-	if (n > max_in_block) {
-		n = max_in_block;
+	if (found && AwaitBlock(cache, *found)) {
+		cache.hits.fetch_add(1, std::memory_order_relaxed);
+		return found;
 	}
+	cache.misses.fetch_add(1, std::memory_order_relaxed);
+
+	uint64_t want = kPgenVfsBlock;
+	if (blk + want > c->size) {
+		want = c->size - blk;
+	}
+	std::shared_ptr<PgenBlock> block(new (std::nothrow) PgenBlock());
+	if (!block) {
+		return nullptr;
+	}
+	block->data.reset(new (std::nothrow) unsigned char[static_cast<size_t>(want)]);
+	if (!block->data) {
+		return nullptr;
+	}
+	int64_t got = CookiePread(c, block->data.get(), want, blk);
+	if (got < 0) {
+		return nullptr;
+	}
+	block->len = static_cast<uint32_t>(got);
+
+	uint64_t shard_budget = cache.budget.load(std::memory_order_relaxed) / kPgenCacheShards;
+	if (shard_budget == 0) {
+		return block; // cache disabled since this file was opened: serve uncached
+	}
+	std::lock_guard<std::mutex> guard(shard.lock);
+	auto it = shard.index.find(key);
+	if (it != shard.index.end()) {
+		if (it->second->second->state.load(std::memory_order_acquire) != kPgenBlockReady) {
+			return block; // a prefetch claimed it meanwhile and publishes its own copy
+		}
+		shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+		return it->second->second; // another reader fetched it meanwhile
+	}
+	shard.lru.emplace_front(key, block);
+	shard.index.emplace(key, shard.lru.begin());
+	shard.bytes += block->len;
+	EvictToBudget(cache, shard, shard_budget);
+	return block;
+}
+
+// Point `src`/`len` at the cached block starting at `blk`; false on a read error.
+bool PrivateBlock(PgenCookie *c, uint64_t blk, const unsigned char *&src, uint32_t &len) {
 	int slot = -1;
 	for (int i = 0; i < kPgenVfsNBlocks; i++) {
 		if (c->blk_off[i] == blk) {
@@ -125,27 +386,184 @@ int64_t CachedRead(PgenCookie *c, void *buf, size_t n) {
 		if (blk + want > c->size) {
 			want = c->size - blk;
 		}
-		int64_t got =
-		    c->pread(c->handle, c->cache + static_cast<size_t>(slot) * kPgenVfsBlock, static_cast<int64_t>(want), blk);
+		int64_t got = c->pread(c->handle, c->cache.get() + static_cast<size_t>(slot) * kPgenVfsBlock,
+		                       static_cast<int64_t>(want), blk);
 		if (got < 0) {
 			c->blk_off[slot] = UINT64_MAX;
-			return -1;
+			return false;
 		}
 		c->blk_off[slot] = blk;
 		c->blk_len[slot] = static_cast<uint32_t>(got);
 	}
-	if (in_off >= c->blk_len[slot]) {
+	c->blk_tick[slot] = ++c->tick;
+	src = c->cache.get() + static_cast<size_t>(slot) * kPgenVfsBlock;
+	len = c->blk_len[slot];
+	return true;
+}
+
+// Serve up to one block's worth from `c->offset`; returns bytes served (0 at EOF,
+// <0 on error). A read spanning a block boundary is clamped — stdio re-calls for
+// the rest. Advances c->offset by the amount served.
+int64_t CachedRead(PgenCookie *c, void *buf, size_t n) {
+	if (c->offset >= c->size) {
+		return 0;
+	}
+	uint64_t avail_total = c->size - c->offset;
+	if (static_cast<uint64_t>(n) > avail_total) {
+		n = static_cast<size_t>(avail_total);
+	}
+	if (n == 0) {
+		return 0;
+	}
+	uint64_t blk = (c->offset / kPgenVfsBlock) * kPgenVfsBlock;
+	size_t in_off = static_cast<size_t>(c->offset - blk);
+	size_t max_in_block = static_cast<size_t>(kPgenVfsBlock) - in_off;
+	if (n > max_in_block) {
+		n = max_in_block;
+	}
+	const unsigned char *src;
+	uint32_t len;
+	if (c->file_id != 0) {
+		if (c->cur_off != blk) {
+			c->cur = SharedBlock(c, blk);
+			if (!c->cur) {
+				c->cur_off = UINT64_MAX;
+				return -1;
+			}
+			c->cur_off = blk;
+		}
+		src = c->cur->data.get();
+		len = c->cur->len;
+	} else if (!PrivateBlock(c, blk, src, len)) {
+		return -1;
+	}
+	if (in_off >= len) {
 		return 0; // requested past the block's valid bytes (EOF)
 	}
 	size_t served = n;
-	if (served > c->blk_len[slot] - in_off) {
-		served = c->blk_len[slot] - in_off;
+	if (served > len - in_off) {
+		served = len - in_off;
 	}
-	std::memcpy(buf, c->cache + static_cast<size_t>(slot) * kPgenVfsBlock + in_off, served);
-	c->blk_tick[slot] = ++c->tick;
+	std::memcpy(buf, src + in_off, served);
 	c->offset += served;
 	return static_cast<int64_t>(served);
 }
+
+// Fetch the claimed placeholders (ascending, aligned offsets): one positioned read
+// per contiguous run, split into blocks and published.
+void FillPrefetched(PgenCookie *c, const std::vector<std::pair<uint64_t, std::shared_ptr<PgenBlock>>> &claimed) {
+	auto &cache = BlockCache();
+	size_t run_begin = 0;
+	while (run_begin < claimed.size()) {
+		size_t run_end = run_begin + 1;
+		while (run_end < claimed.size() && claimed[run_end].first == claimed[run_end - 1].first + kPgenVfsBlock) {
+			run_end++;
+		}
+		uint64_t start = claimed[run_begin].first;
+		uint64_t want = std::min(claimed[run_end - 1].first + kPgenVfsBlock, c->size) - start;
+		std::unique_ptr<unsigned char[]> buf(new (std::nothrow) unsigned char[static_cast<size_t>(want)]);
+		int64_t got = buf ? CookiePread(c, buf.get(), want, start) : -1;
+		for (size_t i = run_begin; i < run_end; i++) {
+			auto &block = claimed[i].second;
+			PgenBlockKey key {c->file_id, claimed[i].first};
+			uint64_t in_run = claimed[i].first - start;
+			uint64_t len = 0;
+			std::unique_ptr<unsigned char[]> data;
+			if (got > 0 && in_run < static_cast<uint64_t>(got)) {
+				len = std::min(kPgenVfsBlock, static_cast<uint64_t>(got) - in_run);
+				data.reset(new (std::nothrow) unsigned char[static_cast<size_t>(len)]);
+				if (data) {
+					std::memcpy(data.get(), buf.get() + in_run, static_cast<size_t>(len));
+				}
+			}
+			bool ok = data != nullptr; // otherwise waiters fetch the block themselves
+			auto &shard = cache.ShardFor(key);
+			{
+				std::lock_guard<std::mutex> guard(shard.lock);
+				auto it = shard.index.find(key);
+				bool indexed = it != shard.index.end() && it->second->second == block;
+				if (ok) {
+					block->data = std::move(data);
+					block->len = static_cast<uint32_t>(len);
+					if (indexed) {
+						shard.bytes += len;
+						EvictToBudget(cache, shard, cache.budget.load(std::memory_order_relaxed) / kPgenCacheShards);
+					}
+				} else if (indexed) {
+					shard.lru.erase(it->second);
+					shard.index.erase(it);
+				}
+			}
+			if (ok) {
+				cache.prefetched.fetch_add(1, std::memory_order_relaxed);
+			}
+			PublishBlock(cache, *block, ok ? kPgenBlockReady : kPgenBlockFailed);
+		}
+		run_begin = run_end;
+	}
+}
+
+void Prefetch(void *cookie, uint64_t offset, uint64_t len) {
+	auto *c = static_cast<PgenCookie *>(cookie);
+	auto &cache = BlockCache();
+	uint64_t budget = cache.budget.load(std::memory_order_relaxed);
+	if (budget == 0 || offset >= c->size) {
+		return;
+	}
+	len = std::min(std::min(len, c->size - offset), std::min(kPgenPrefetchMax, budget / 8));
+	if (len == 0) {
+		return;
+	}
+
+	// Claim the blocks nobody holds or is fetching yet
+	auto claimed = std::make_shared<std::vector<std::pair<uint64_t, std::shared_ptr<PgenBlock>>>>();
+	for (uint64_t blk = (offset / kPgenVfsBlock) * kPgenVfsBlock; blk < offset + len; blk += kPgenVfsBlock) {
+		PgenBlockKey key {c->file_id, blk};
+		auto &shard = cache.ShardFor(key);
+		std::lock_guard<std::mutex> guard(shard.lock);
+		if (shard.index.count(key)) {
+			continue;
+		}
+		std::shared_ptr<PgenBlock> block(new (std::nothrow) PgenBlock());
+		if (!block) {
+			break;
+		}
+		block->state.store(kPgenBlockPending, std::memory_order_relaxed);
+		shard.lru.emplace_front(key, block);
+		shard.index.emplace(key, shard.lru.begin());
+		claimed->emplace_back(blk, std::move(block));
+	}
+	if (claimed->empty()) {
+		return;
+	}
+	if (c->prefetch.valid()) {
+		c->prefetch.wait();
+	}
+	try {
+		c->prefetch = std::async(std::launch::async, [c, claimed] { FillPrefetched(c, *claimed); });
+	} catch (...) {
+		FillPrefetched(c, *claimed); // no thread available: fetch inline
+	}
+}
+
+void RegisterCookie(FILE *f, PgenCookie *c) {
+	if (c->file_id == 0) {
+		return; // private cache: nothing to prefetch into
+	}
+	RegisterStream(f, Prefetch, c);
+	c->stream = f;
+}
+
+void DestroyCookie(PgenCookie *c) {
+	if (c->stream) {
+		UnregisterStream(c->stream);
+	}
+	if (c->prefetch.valid()) {
+		c->prefetch.wait();
+	}
+	c->close(c->handle);
+	delete c;
+}
 #endif
 
 #if defined(PLINKING_PGEN_VFS_COOKIE)
@@ -168,15 +586,12 @@ int CookieSeek(void *cookie, off64_t *offset, int whence) {
 }
 
 int CookieClose(void *cookie) {
-	auto *c = static_cast<PgenCookie *>(cookie);
-	c->close(c->handle);
-	std::free(c->cache);
-	std::free(c);
+	DestroyCookie(static_cast<PgenCookie *>(cookie));
 	return 0;
 }
 
-FILE *OpenCookieFile(const PlinkingPgenVfsOpener *ops, void *handle) {
-	PgenCookie *c = MakeCookie(ops, handle);
+FILE *OpenCookieFile(const PlinkingPgenVfsOpener *ops, void *handle, const char *fname) {
+	PgenCookie *c = MakeCookie(ops, handle, fname);
 	if (!c) {
 		ops->close(handle);
 		return nullptr;
@@ -185,9 +600,10 @@ FILE *OpenCookieFile(const PlinkingPgenVfsOpener *ops, void *handle) {
 	FILE *f = fopencookie(c, "rb", io);
 	if (!f) {
 		ops->close(handle);
-		std::free(c->cache);
-		std::free(c);
+		delete c;
+		return nullptr;
 	}
+	RegisterCookie(f, c);
 	return f;
 }
 #elif defined(PLINKING_PGEN_VFS_FUNOPEN)
@@ -212,15 +628,12 @@ fpos_t FunSeekFn(void *cookie, fpos_t offset, int whence) {
 }
 
 int FunCloseFn(void *cookie) {
-	auto *c = static_cast<PgenCookie *>(cookie);
-	c->close(c->handle);
-	std::free(c->cache);
-	std::free(c);
+	DestroyCookie(static_cast<PgenCookie *>(cookie));
 	return 0;
 }
 
-FILE *OpenCookieFile(const PlinkingPgenVfsOpener *ops, void *handle) {
-	PgenCookie *c = MakeCookie(ops, handle);
+FILE *OpenCookieFile(const PlinkingPgenVfsOpener *ops, void *handle, const char *fname) {
+	PgenCookie *c = MakeCookie(ops, handle, fname);
 	if (!c) {
 		ops->close(handle);
 		return nullptr;
@@ -228,13 +641,609 @@ FILE *OpenCookieFile(const PlinkingPgenVfsOpener *ops, void *handle) {
 	FILE *f = funopen(c, FunReadFn, nullptr, FunSeekFn, FunCloseFn);
 	if (!f) {
 		ops->close(handle);
-		std::free(c->cache);
-		std::free(c);
+		delete c;
+		return nullptr;
+	}
+	RegisterCookie(f, c);
+	return f;
+}
+#endif
+
+#if defined(PLINKING_PGEN_VFS_COOKIE) || defined(PLINKING_PGEN_VFS_FUNOPEN)
+// --- Path M: shared read-only mappings ------------------------------------------
+
+// One mapping per (device, inode), refcounted by the FILE*s open on it, so every
+// thread and concurrent query reading a .pgen shares one view of the page cache.
+// A file replaced on disk (size or mtime changed) gets a fresh mapping; the stale
+// one lives until its last reader closes.
+struct PgenMapping {
+	std::pair<dev_t, ino_t> key;
+	uint64_t size;
+	time_t mtime;
+	unsigned char *base;
+	uint32_t refs;
+};
+
+struct PgenMappingRegistry {
+	std::mutex lock;
+	std::map<std::pair<dev_t, ino_t>, PgenMapping *> by_file;
+};
+
+// Leaked on purpose: readers may still close during static destruction.
+PgenMappingRegistry &MappingRegistry() {
+	static auto *registry = new PgenMappingRegistry();
+	return *registry;
+}
+
+PgenMapping *AcquireMapping(const char *fname) {
+	int fd = open(fname, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return nullptr;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		close(fd); // not mappable (a zero-length map is invalid) -> fopen reports it
+		return nullptr;
+	}
+	auto key = std::make_pair(st.st_dev, st.st_ino);
+	auto &registry = MappingRegistry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	auto it = registry.by_file.find(key);
+	if (it != registry.by_file.end() && it->second->size == static_cast<uint64_t>(st.st_size) &&
+	    it->second->mtime == st.st_mtime) {
+		it->second->refs++;
+		close(fd);
+		return it->second;
+	}
+	void *base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd); // the mapping holds its own reference to the file
+	if (base == MAP_FAILED) {
+		return nullptr;
+	}
+	auto *m = new (std::nothrow) PgenMapping;
+	if (!m) {
+		munmap(base, static_cast<size_t>(st.st_size));
+		return nullptr;
+	}
+	m->key = key;
+	m->size = static_cast<uint64_t>(st.st_size);
+	m->mtime = st.st_mtime;
+	m->base = static_cast<unsigned char *>(base);
+	m->refs = 1;
+	registry.by_file[key] = m; // displaces a stale mapping, which its readers still hold
+	return m;
+}
+
+void ReleaseMapping(PgenMapping *m) {
+	auto &registry = MappingRegistry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	if (--m->refs > 0) {
+		return;
+	}
+	auto it = registry.by_file.find(m->key);
+	if (it != registry.by_file.end() && it->second == m) {
+		registry.by_file.erase(it);
+	}
+	munmap(m->base, static_cast<size_t>(m->size));
+	delete m;
+}
+
+// Sequential runs ask the kernel to fault this far ahead (pgenlib reads a variant
+// record at a time, far below the kernel's own mmap readahead window on a scan).
+static const uint64_t kPgenMmapAdvise = 4194304; // 4 MiB
+
+struct MmapCookie {
+	PgenMapping *map;
+	uint64_t offset;
+	uint64_t run_end;     // end of the previous read: a read starting here is sequential
+	uint64_t advised_end; // end of the last MADV_WILLNEED range
+};
+
+int64_t MmapRead(MmapCookie *c, void *buf, size_t n) {
+	uint64_t size = c->map->size;
+	if (c->offset >= size) {
+		return 0;
+	}
+	if (static_cast<uint64_t>(n) > size - c->offset) {
+		n = static_cast<size_t>(size - c->offset);
+	}
+	if (c->offset != c->run_end) {
+		c->advised_end = c->offset; // random access: no hint until a run forms
+	} else if (c->offset + n > c->advised_end) {
+		static const uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+		uint64_t start = (std::max(c->offset, c->advised_end) / page) * page;
+		uint64_t end = std::min(size, c->offset + n + kPgenMmapAdvise);
+		madvise(c->map->base + start, static_cast<size_t>(end - start), MADV_WILLNEED);
+		c->advised_end = end;
+	}
+	std::memcpy(buf, c->map->base + c->offset, n);
+	c->offset += n;
+	c->run_end = c->offset;
+	return static_cast<int64_t>(n);
+}
+
+int64_t MmapSeek(MmapCookie *c, int64_t offset, int whence) {
+	int64_t base = (whence == SEEK_SET)   ? 0
+	               : (whence == SEEK_CUR) ? static_cast<int64_t>(c->offset)
+	                                      : static_cast<int64_t>(c->map->size);
+	int64_t target = base + offset;
+	if (target < 0) {
+		return -1;
+	}
+	c->offset = static_cast<uint64_t>(target);
+	return target;
+}
+
+int MmapClose(MmapCookie *c) {
+	ReleaseMapping(c->map);
+	std::free(c);
+	return 0;
+}
+#endif
+
+#if defined(PLINKING_PGEN_VFS_COOKIE)
+ssize_t MmapCookieRead(void *cookie, char *buf, size_t n) {
+	return static_cast<ssize_t>(MmapRead(static_cast<MmapCookie *>(cookie), buf, n));
+}
+
+int MmapCookieSeek(void *cookie, off64_t *offset, int whence) {
+	int64_t target = MmapSeek(static_cast<MmapCookie *>(cookie), *offset, whence);
+	if (target < 0) {
+		return -1;
+	}
+	*offset = target;
+	return 0;
+}
+
+int MmapCookieClose(void *cookie) {
+	return MmapClose(static_cast<MmapCookie *>(cookie));
+}
+#elif defined(PLINKING_PGEN_VFS_FUNOPEN)
+int MmapFunReadFn(void *cookie, char *buf, int n) {
+	if (n < 0) {
+		return -1;
 	}
+	return static_cast<int>(MmapRead(static_cast<MmapCookie *>(cookie), buf, static_cast<size_t>(n)));
+}
+
+fpos_t MmapFunSeekFn(void *cookie, fpos_t offset, int whence) {
+	return static_cast<fpos_t>(MmapSeek(static_cast<MmapCookie *>(cookie), static_cast<int64_t>(offset), whence));
+}
+
+int MmapFunCloseFn(void *cookie) {
+	return MmapClose(static_cast<MmapCookie *>(cookie));
+}
+#endif
+
+#if defined(PLINKING_PGEN_VFS_COOKIE) || defined(PLINKING_PGEN_VFS_FUNOPEN)
+// nullptr when the file cannot be mapped; the caller falls back to fopen.
+FILE *OpenMmapFile(const char *fname) {
+	PgenMapping *m = AcquireMapping(fname);
+	if (!m) {
+		return nullptr;
+	}
+	auto *c = static_cast<MmapCookie *>(std::malloc(sizeof(MmapCookie)));
+	if (!c) {
+		ReleaseMapping(m);
+		return nullptr;
+	}
+	c->map = m;
+	c->offset = 0;
+	c->run_end = 0;
+	c->advised_end = 0;
+#if defined(PLINKING_PGEN_VFS_COOKIE)
+	cookie_io_functions_t io = {MmapCookieRead, nullptr, MmapCookieSeek, MmapCookieClose};
+	FILE *f = fopencookie(c, "rb", io);
+#else
+	FILE *f = funopen(c, MmapFunReadFn, nullptr, MmapFunSeekFn, MmapFunCloseFn);
+#endif
+	if (!f) {
+		MmapClose(c);
+		return nullptr;
+	}
+	// Keep stdio's buffer: an unbuffered cookie stream is read one byte per callback
+	// (glibc), which made sequential scans ~100x slower than fopen. Reads larger than
+	// the buffer still go straight to MmapRead.
 	return f;
 }
 #endif
 
+#if defined(PLINKING_PGEN_VFS_URING)
+// --- Path U: io_uring read-ahead over a local file --------------------------------
+
+// Each stream owns a small ring and kPgenUringSlots chunk buffers. Chunks ahead of
+// the reader are queued as reads on the ring — the span of each plinking_pgen_prefetch
+// hint (the scan's claimed batches), and kPgenUringAhead chunks past a sequential
+// run — so the next records are in flight while pgenlib decodes the current one.
+static const uint64_t kPgenUringChunk = 131072; // 128 KiB
+static const unsigned kPgenUringSlots = 16;     // 2 MiB queued per stream at most
+static const unsigned kPgenUringAhead = 4;      // read-ahead on a sequential run without hints
+
+// Opens served by Path U since process start (plinking_pgen_cache_stats). Leaked on
+// purpose, like the block cache.
+std::atomic<uint64_t> &UringOpenCount() {
+	static auto *count = new std::atomic<uint64_t>(0);
+	return *count;
+}
+
+struct PgenUringSlot {
+	uint64_t off; // chunk start; UINT64_MAX = empty
+	uint32_t len; // valid bytes once complete
+	bool in_flight;
+	bool failed; // read error or short read: served by a plain pread instead
+	uint32_t tick;
+	struct iovec iov;
+};
+
+struct UringCookie {
+	int fd;
+	uint64_t size;
+	uint64_t offset;
+	uint64_t run_end;  // end of the previous read: a read starting here is sequential
+	uint64_t hint_end; // keep chunks queued up to here (plinking_pgen_prefetch)
+	FILE *stream;
+
+	int ring_fd;
+	unsigned *sq_tail;
+	unsigned *sq_mask;
+	unsigned *sq_array;
+	unsigned *cq_head;
+	unsigned *cq_tail;
+	unsigned *cq_mask;
+	struct io_uring_sqe *sqes;
+	struct io_uring_cqe *cqes;
+	void *sq_map;
+	size_t sq_map_len;
+	void *cq_map;
+	size_t cq_map_len;
+	void *sqe_map;
+	size_t sqe_map_len;
+	unsigned to_submit;
+	unsigned in_flight;
+	bool dead;      // io_uring_enter failed: every later read is a plain pread
+	bool abandoned; // reads were submitted when the ring died; the kernel may still write them
+
+	std::unique_ptr<unsigned char[]> buf; // kPgenUringSlots * kPgenUringChunk
+	PgenUringSlot slots[kPgenUringSlots];
+	uint32_t tick;
+};
+
+void UringUnmap(UringCookie *c) {
+	if (c->sqe_map != MAP_FAILED) {
+		munmap(c->sqe_map, c->sqe_map_len);
+	}
+	if (c->cq_map != MAP_FAILED && c->cq_map != c->sq_map) {
+		munmap(c->cq_map, c->cq_map_len);
+	}
+	if (c->sq_map != MAP_FAILED) {
+		munmap(c->sq_map, c->sq_map_len);
+	}
+	if (c->ring_fd >= 0) {
+		close(c->ring_fd);
+	}
+}
+
+// False when this kernel (or a seccomp policy) refuses io_uring: the caller falls back.
+bool UringSetup(UringCookie *c) {
+	struct io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+	c->ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, kPgenUringSlots, &params));
+	if (c->ring_fd < 0) {
+		return false;
+	}
+	c->sq_map_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	c->cq_map_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	bool single_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (single_map) {
+		c->sq_map_len = c->cq_map_len = std::max(c->sq_map_len, c->cq_map_len);
+	}
+	c->sq_map = mmap(nullptr, c->sq_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, c->ring_fd,
+	                 IORING_OFF_SQ_RING);
+	if (c->sq_map == MAP_FAILED) {
+		return false;
+	}
+	c->cq_map = single_map ? c->sq_map
+	                       : mmap(nullptr, c->cq_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+	                              c->ring_fd, IORING_OFF_CQ_RING);
+	if (c->cq_map == MAP_FAILED) {
+		return false;
+	}
+	c->sqe_map_len = params.sq_entries * sizeof(struct io_uring_sqe);
+	c->sqe_map = mmap(nullptr, c->sqe_map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, c->ring_fd,
+	                  IORING_OFF_SQES);
+	if (c->sqe_map == MAP_FAILED) {
+		return false;
+	}
+	auto *sq = static_cast<unsigned char *>(c->sq_map);
+	auto *cq = static_cast<unsigned char *>(c->cq_map);
+	c->sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+	c->sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+	c->sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+	c->cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+	c->cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+	c->cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+	c->cqes = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+	c->sqes = static_cast<struct io_uring_sqe *>(c->sqe_map);
+	return true;
+}
+
+// Fail every slot still in flight on a dead ring, so no caller waits for a completion
+// that will never be reaped; they are re-read with pread.
+void UringAbandon(UringCookie *c) {
+	c->abandoned |= c->in_flight > c->to_submit;
+	for (auto &slot : c->slots) {
+		if (slot.in_flight) {
+			slot.in_flight = false;
+			slot.failed = true;
+			slot.len = 0;
+		}
+	}
+	c->in_flight = 0;
+	c->to_submit = 0;
+}
+
+// Submit the queued reads; with `wait`, also block until at least one completes.
+// Then retire every completion. A hard io_uring_enter error kills the ring.
+void UringEnter(UringCookie *c, bool wait) {
+	if (c->dead) {
+		UringAbandon(c);
+		return;
+	}
+	bool failed = false;
+	if (c->to_submit > 0 || wait) {
+		unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+		long ret;
+		do {
+			ret = syscall(__NR_io_uring_enter, c->ring_fd, c->to_submit, wait ? 1 : 0, flags, nullptr, 0);
+		} while (ret < 0 && errno == EINTR);
+		if (ret > 0) {
+			c->to_submit -= std::min(c->to_submit, static_cast<unsigned>(ret));
+		}
+		failed = ret < 0;
+	}
+	unsigned head = *c->cq_head;
+	while (head != __atomic_load_n(c->cq_tail, __ATOMIC_ACQUIRE)) {
+		const struct io_uring_cqe &cqe = c->cqes[head & *c->cq_mask];
+		PgenUringSlot &slot = c->slots[cqe.user_data];
+		slot.in_flight = false;
+		uint64_t want = std::min(kPgenUringChunk, c->size - slot.off);
+		slot.failed = cqe.res < 0 || static_cast<uint64_t>(cqe.res) < want;
+		slot.len = slot.failed ? 0 : static_cast<uint32_t>(cqe.res);
+		c->in_flight--;
+		head++;
+	}
+	__atomic_store_n(c->cq_head, head, __ATOMIC_RELEASE);
+	if (failed) {
+		c->dead = true;
+		UringAbandon(c);
+	}
+}
+
+PgenUringSlot *UringFind(UringCookie *c, uint64_t chunk) {
+	for (auto &slot : c->slots) {
+		if (slot.off == chunk) {
+			return &slot;
+		}
+	}
+	return nullptr;
+}
+
+// Queue a read of `chunk` into the least recently used idle slot. With `behind_only`
+// (read-ahead) only a slot wholly behind `cur` may be reused, so queued chunks the
+// reader has not reached yet are never displaced. nullptr when no slot qualifies.
+PgenUringSlot *UringQueue(UringCookie *c, uint64_t chunk, uint64_t cur, bool behind_only) {
+	if (c->dead) {
+		return nullptr;
+	}
+	PgenUringSlot *victim = nullptr;
+	for (auto &slot : c->slots) {
+		if (slot.in_flight || (behind_only && slot.off != UINT64_MAX && slot.off + kPgenUringChunk > cur)) {
+			continue;
+		}
+		if (!victim || slot.off == UINT64_MAX || (victim->off != UINT64_MAX && slot.tick < victim->tick)) {
+			victim = &slot;
+		}
+	}
+	if (!victim) {
+		return nullptr;
+	}
+	auto idx = static_cast<unsigned>(victim - c->slots);
+	victim->off = chunk;
+	victim->len = 0;
+	victim->failed = false;
+	victim->in_flight = true;
+	victim->tick = ++c->tick;
+	victim->iov.iov_base = c->buf.get() + static_cast<size_t>(idx) * kPgenUringChunk;
+	victim->iov.iov_len = static_cast<size_t>(std::min(kPgenUringChunk, c->size - chunk));
+
+	unsigned tail = *c->sq_tail;
+	unsigned sqe_idx = tail & *c->sq_mask;
+	struct io_uring_sqe &sqe = c->sqes[sqe_idx];
+	std::memset(&sqe, 0, sizeof(sqe));
+	sqe.opcode = IORING_OP_READV;
+	sqe.fd = c->fd;
+	sqe.off = chunk;
+	sqe.addr = reinterpret_cast<uint64_t>(&victim->iov);
+	sqe.len = 1;
+	sqe.user_data = idx;
+	c->sq_array[sqe_idx] = sqe_idx;
+	__atomic_store_n(c->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	c->to_submit++;
+	c->in_flight++;
+	return victim;
+}
+
+// Queue the not-yet-queued chunks in [from, end) while idle slots behind `cur` last.
+void UringReadAhead(UringCookie *c, uint64_t from, uint64_t end, uint64_t cur) {
+	end = std::min(end, c->size);
+	for (uint64_t chunk = (from / kPgenUringChunk) * kPgenUringChunk; chunk < end; chunk += kPgenUringChunk) {
+		if (!UringFind(c, chunk) && !UringQueue(c, chunk, cur, true)) {
+			break;
+		}
+	}
+}
+
+void UringPrefetch(void *cookie, uint64_t offset, uint64_t len) {
+	auto *c = static_cast<UringCookie *>(cookie);
+	if (offset >= c->size || c->dead) {
+		return;
+	}
+	uint64_t end = offset + std::min(len, c->size - offset);
+	c->hint_end = std::max(c->hint_end, end);
+	uint64_t cur = (c->offset / kPgenUringChunk) * kPgenUringChunk;
+	UringReadAhead(c, std::max(offset, cur), end, cur);
+	UringEnter(c, false);
+}
+
+int64_t UringPread(UringCookie *c, void *buf, size_t n) {
+	ssize_t got;
+	do {
+		got = pread(c->fd, buf, n, static_cast<off_t>(c->offset));
+	} while (got < 0 && errno == EINTR);
+	if (got > 0) {
+		c->offset += static_cast<uint64_t>(got);
+		c->run_end = c->offset;
+	}
+	return got;
+}
+
+// Serve up to the rest of the chunk at c->offset (stdio re-calls for more).
+int64_t UringRead(UringCookie *c, void *buf, size_t n) {
+	if (c->offset >= c->size) {
+		return 0;
+	}
+	if (c->dead) {
+		return UringPread(c, buf, n);
+	}
+	uint64_t chunk = (c->offset / kPgenUringChunk) * kPgenUringChunk;
+	size_t in_off = static_cast<size_t>(c->offset - chunk);
+	n = static_cast<size_t>(std::min<uint64_t>(n, std::min(kPgenUringChunk - in_off, c->size - c->offset)));
+
+	PgenUringSlot *slot = UringFind(c, chunk);
+	if (!slot) {
+		while (!(slot = UringQueue(c, chunk, chunk, false)) && c->in_flight > 0) {
+			UringEnter(c, true); // every slot in flight: retire one
+		}
+		if (!slot) {
+			return UringPread(c, buf, n);
+		}
+	}
+	slot->tick = ++c->tick;
+	if (c->offset == c->run_end) {
+		// Sequential: keep the hinted span, or a short window, queued past this chunk
+		uint64_t ahead_end = std::max(c->hint_end, chunk + (kPgenUringAhead + 1) * kPgenUringChunk);
+		UringReadAhead(c, chunk + kPgenUringChunk, ahead_end, chunk);
+	}
+	UringEnter(c, false);
+	while (slot->in_flight) {
+		UringEnter(c, true);
+	}
+	if (slot->failed) {
+		slot->off = UINT64_MAX;
+		return UringPread(c, buf, n);
+	}
+	std::memcpy(buf, c->buf.get() + static_cast<size_t>(slot - c->slots) * kPgenUringChunk + in_off, n);
+	c->offset += n;
+	c->run_end = c->offset;
+	return static_cast<int64_t>(n);
+}
+
+void DestroyUringCookie(UringCookie *c) {
+	if (c->stream) {
+		UnregisterStream(c->stream);
+	}
+	if (c->sqe_map != MAP_FAILED) {
+		while (c->in_flight > 0 && !c->dead) {
+			UringEnter(c, true); // the kernel still writes into our buffers
+		}
+	}
+	if (c->abandoned) {
+		// Reads the dead ring never reported may still land in the chunk buffers: leak them
+		c->buf.release();
+	}
+	UringUnmap(c);
+	close(c->fd);
+	delete c;
+}
+
+ssize_t UringCookieRead(void *cookie, char *buf, size_t n) {
+	return static_cast<ssize_t>(UringRead(static_cast<UringCookie *>(cookie), buf, n));
+}
+
+int UringCookieSeek(void *cookie, off64_t *offset, int whence) {
+	auto *c = static_cast<UringCookie *>(cookie);
+	int64_t base = (whence == SEEK_SET)   ? 0
+	               : (whence == SEEK_CUR) ? static_cast<int64_t>(c->offset)
+	                                      : static_cast<int64_t>(c->size);
+	int64_t target = base + *offset;
+	if (target < 0) {
+		return -1;
+	}
+	c->offset = static_cast<uint64_t>(target);
+	*offset = target;
+	return 0;
+}
+
+int UringCookieClose(void *cookie) {
+	DestroyUringCookie(static_cast<UringCookie *>(cookie));
+	return 0;
+}
+
+// nullptr when the file cannot be opened or io_uring is unavailable; the caller
+// falls back to the next path.
+FILE *OpenUringFile(const char *fname) {
+	int fd = open(fname, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return nullptr;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		close(fd);
+		return nullptr;
+	}
+	auto *c = new (std::nothrow) UringCookie();
+	if (!c) {
+		close(fd);
+		return nullptr;
+	}
+	c->fd = fd;
+	c->size = static_cast<uint64_t>(st.st_size);
+	c->ring_fd = -1;
+	c->sq_map = c->cq_map = c->sqe_map = MAP_FAILED;
+	for (auto &slot : c->slots) {
+		slot.off = UINT64_MAX;
+	}
+	c->buf.reset(new (std::nothrow) unsigned char[static_cast<size_t>(kPgenUringSlots) * kPgenUringChunk]);
+	if (!c->buf || !UringSetup(c)) {
+		DestroyUringCookie(c);
+		return nullptr;
+	}
+	cookie_io_functions_t io = {UringCookieRead, nullptr, UringCookieSeek, UringCookieClose};
+	FILE *f = fopencookie(c, "rb", io);
+	if (!f) {
+		DestroyUringCookie(c);
+		return nullptr;
+	}
+	RegisterStream(f, UringPrefetch, c);
+	c->stream = f;
+	UringOpenCount().fetch_add(1, std::memory_order_relaxed);
+	return f;
+}
+
+// One throwaway ring: does this kernel (and its seccomp / io_uring_disabled policy)
+// let us create io_uring instances at all?
+bool UringProbe() {
+	struct io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+	int fd = static_cast<int>(syscall(__NR_io_uring_setup, 1, &params));
+	if (fd < 0) {
+		return false;
+	}
+	close(fd);
+	return true;
+}
+#endif
+
 } // namespace
 
 extern "C" {
@@ -245,9 +1254,23 @@ FILE *plinking_pgen_fopen(const char *fname) {
 	if (op && op->open) {
 		void *handle = op->open(fname, op->user);
 		if (handle) {
-			return OpenCookieFile(op, handle); // Path V
+			return OpenCookieFile(op, handle, fname); // Path V
+		}
+		// opener declined this fname -> fall through to Path U / M / L
+	}
+#if defined(PLINKING_PGEN_VFS_URING)
+	if (t_uring) {
+		FILE *f = OpenUringFile(fname);
+		if (f) {
+			return f; // Path U
+		}
+	}
+#endif
+	if (t_mmap) {
+		FILE *f = OpenMmapFile(fname);
+		if (f) {
+			return f; // Path M
 		}
-		// opener declined this fname -> fall through to Path L
 	}
 #endif
 	return std::fopen(fname, "rb"); // Path L (local/native fastpath)
@@ -257,6 +1280,79 @@ void plinking_pgen_set_vfs_opener(const PlinkingPgenVfsOpener *opener) {
 	t_opener = opener;
 }
 
+void plinking_pgen_set_mmap(int enabled) {
+	t_mmap = enabled != 0;
+}
+
+void plinking_pgen_set_uring(int enabled) {
+	t_uring = enabled != 0;
+}
+
+int plinking_pgen_uring_supported(void) {
+#if defined(PLINKING_PGEN_VFS_URING)
+	static const bool supported = UringProbe();
+	return supported ? 1 : 0;
+#else
+	return 0;
+#endif
+}
+
+void plinking_pgen_cache_set_budget(uint64_t bytes) {
+#if defined(PLINKING_PGEN_VFS_COOKIE) || defined(PLINKING_PGEN_VFS_FUNOPEN)
+	auto &cache = BlockCache();
+	if (cache.budget.exchange(bytes) <= bytes) {
+		return;
+	}
+	for (auto &shard : cache.shards) {
+		std::lock_guard<std::mutex> guard(shard.lock);
+		EvictToBudget(cache, shard, bytes / kPgenCacheShards);
+	}
+#else
+	(void)bytes;
+#endif
+}
+
+void plinking_pgen_cache_stats(PlinkingPgenCacheStats *out) {
+	std::memset(out, 0, sizeof(*out));
+#if defined(PLINKING_PGEN_VFS_COOKIE) || defined(PLINKING_PGEN_VFS_FUNOPEN)
+	auto &cache = BlockCache();
+	out->budget = cache.budget.load();
+	for (auto &shard : cache.shards) {
+		std::lock_guard<std::mutex> guard(shard.lock);
+		out->bytes += shard.bytes;
+		out->blocks += shard.lru.size();
+	}
+	out->hits = cache.hits.load();
+	out->misses = cache.misses.load();
+	out->evictions = cache.evictions.load();
+	out->prefetched = cache.prefetched.load();
+#endif
+#if defined(PLINKING_PGEN_VFS_URING)
+	out->uring_opens = UringOpenCount().load();
+#endif
+}
+
+void plinking_pgen_prefetch(FILE *f, uint64_t offset, uint64_t len) {
+#if defined(PLINKING_PGEN_VFS_COOKIE) || defined(PLINKING_PGEN_VFS_FUNOPEN)
+	PgenPrefetchTarget target;
+	{
+		auto &registry = StreamRegistry();
+		std::lock_guard<std::mutex> guard(registry.lock);
+		auto it = registry.streams.find(f);
+		if (it == registry.streams.end()) {
+			return;
+		}
+		target = it->second;
+	}
+	// The caller owns `f` and closes it on this same thread, so the cookie stays valid.
+	target.prefetch(target.cookie, offset, len);
+#else
+	(void)f;
+	(void)offset;
+	(void)len;
+#endif
+}
+
 int plinking_pgen_vfs_supported(void) {
 #if defined(PLINKING_PGEN_VFS_COOKIE) || defined(PLINKING_PGEN_VFS_FUNOPEN)
 	return 1;
@@ -12,7 +12,9 @@
 // per-thread VFS opener (Path V), a fname the opener claims is served by a cookie
 // FILE* whose reads go through a DuckDB FileHandle (positioned reads) — so remote
 // (.pgen over s3://, https://, …) and VFS-resolved paths work with no other
-// pgenlib change and no DuckDB types inside pgenlib.
+// pgenlib change and no DuckDB types inside pgenlib. Path M serves local files
+// from a process-wide read-only mapping through the same cookie mechanism, and
+// Path U (Linux) from per-stream io_uring read-ahead.
 #pragma once
 
 #include <cstdint>
@@ -29,11 +31,14 @@ struct PlinkingPgenVfsOpener {
 	void *(*open)(const char *fname, void *user);                          // -> handle, or nullptr
 	int64_t (*pread)(void *handle, void *buf, int64_t n, uint64_t offset); // bytes, <0 on error
 	int64_t (*size)(void *handle);                                         // file size, <0 on error
+	int64_t (*version)(void *handle); // change token (e.g. last-modified), 0 if unknown; may be null
 	void (*close)(void *handle);
 };
 
 // pgenlib calls this in place of fopen(fname, "rb"). Path L (default) = real fopen;
-// Path V = a cookie FILE* over the registered opener when it claims `fname`.
+// Path V = a cookie FILE* over the registered opener when it claims `fname`;
+// Path U = a cookie FILE* over io_uring reads (plinking_pgen_set_uring);
+// Path M = a cookie FILE* over a shared mapping (plinking_pgen_set_mmap).
 FILE *plinking_pgen_fopen(const char *fname);
 
 // Register / clear the per-thread VFS opener. The extension sets it (with the
@@ -42,7 +47,54 @@ FILE *plinking_pgen_fopen(const char *fname);
 // The pointer must outlive any pgen open made while it is set.
 void plinking_pgen_set_vfs_opener(const PlinkingPgenVfsOpener *opener);
 
-// True iff this platform has the cookie/funopen primitive (Path V available).
+// Enable / disable Path M for opens on this thread. While enabled (and no opener
+// claims the fname), a local file is served from one read-only mmap per file per
+// process, shared by every FILE* open on it — threads and concurrent queries alike.
+// Falls back to fopen when the file cannot be mapped.
+void plinking_pgen_set_mmap(int enabled);
+
+// Enable / disable Path U for opens on this thread. While enabled (and no opener
+// claims the fname), a local file is read through the stream's own io_uring: the
+// chunks of each plinking_pgen_prefetch span, and a short window past a sequential
+// run, are queued as asynchronous reads, so I/O overlaps pgenlib's decoding. Falls
+// back to the next path (Path M if enabled, else fopen) when io_uring is unavailable
+// at build time or refused by the kernel.
+void plinking_pgen_set_uring(int enabled);
+
+// True iff Path U can serve opens: it was compiled in (Linux with the io_uring uapi
+// header) and the kernel accepts io_uring_setup (probed once; seccomp profiles and
+// io_uring_disabled refuse it). When false, Path U opens fall back.
+int plinking_pgen_uring_supported(void);
+
+// Path V blocks are served from one process-wide cache shared by every open, keyed
+// by (fname, size, version, block offset) with LRU eviction. Set its byte budget
+// (0 = disabled: each open keeps a small private read-ahead cache instead).
+// Lowering the budget evicts immediately.
+void plinking_pgen_cache_set_budget(uint64_t bytes);
+
+struct PlinkingPgenCacheStats {
+	uint64_t budget;    // configured byte budget
+	uint64_t bytes;     // bytes currently cached
+	uint64_t blocks;    // blocks currently cached
+	uint64_t hits;      // block lookups served from the cache (since process start)
+	uint64_t misses;    // block lookups that fetched from the opener
+	uint64_t evictions; // blocks evicted to stay within the budget
+	uint64_t prefetched; // blocks fetched ahead of use by plinking_pgen_prefetch
+	uint64_t uring_opens; // local opens served by Path U (not a cache counter, reported alongside)
+};
+
+void plinking_pgen_cache_stats(PlinkingPgenCacheStats *out);
+
+// Hint that [offset, offset + len) of the file behind `f` is about to be read (the
+// extension passes the record span of a claimed variant batch). For a Path V FILE*
+// with the shared cache enabled, the blocks not yet cached are fetched by one
+// coalesced positioned read per contiguous run on a background thread; a reader
+// needing one of them meanwhile waits for it instead of fetching it again. At most
+// one prefetch per FILE* is in flight. For a Path U FILE*, the span's chunks are
+// queued on its ring. A no-op for any other FILE*.
+void plinking_pgen_prefetch(FILE *f, uint64_t offset, uint64_t len);
+
+// True iff this platform has the cookie/funopen primitive (Paths V and M available).
 int plinking_pgen_vfs_supported(void);
 
 } // extern "C"
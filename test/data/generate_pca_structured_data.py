@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Generate a PCA fixture with population structure: 240 samples x 600 variants.
+
+pca_example (plink2 --dummy) is unstructured, so its top PCs are noise and differ
+between any two approximations. This fixture has two populations of 120 samples
+whose allele frequencies drift apart (Balding-Nichols, Fst ~ 0.1), so PC1
+separates them clearly. Used by test/sql/plink_pca.test to check the accuracy of
+the compressed plink_pca sketch against algorithm := 'approx'.
+
+plink2 cannot simulate structure, so the .pgen is written directly, in the layout
+plink2 --make-pgen uses for pca_example: storage mode 0x10, one variant block,
+4-bit record types (all 0: plain 2-bit genotype arrays, 0 = hom ref, 1 = het,
+2 = hom alt, 3 = missing, low bits first) and 1-byte record lengths.
+
+Requires: python3 (standard library only).
+
+Output: test/data/pca_structured.{pgen,pvar,psam}
+"""
+
+import os
+import random
+import struct
+
+SEED = 2024
+POPS = 2
+SAMPLES_PER_POP = 120
+N_VARIANTS = 600
+FST = 0.1
+MISSING_RATE = 0.005
+
+OUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "pca_structured")
+
+
+def main():
+    rng = random.Random(SEED)
+    n_samples = POPS * SAMPLES_PER_POP
+    rec_len = (n_samples + 3) // 4
+    assert rec_len < 256  # 1-byte record lengths
+
+    records = []
+    for _ in range(N_VARIANTS):
+        p = rng.uniform(0.1, 0.9)
+        a = p * (1 - FST) / FST
+        b = (1 - p) * (1 - FST) / FST
+        rec = bytearray(rec_len)
+        for pop in range(POPS):
+            q = rng.betavariate(a, b)
+            for k in range(SAMPLES_PER_POP):
+                s = pop * SAMPLES_PER_POP + k
+                if rng.random() < MISSING_RATE:
+                    g = 3
+                else:
+                    g = (rng.random() < q) + (rng.random() < q)
+                rec[s // 4] |= g << (2 * (s % 4))
+        records.append(bytes(rec))
+
+    header = b"\x6c\x1b\x10" + struct.pack("<II", N_VARIANTS, n_samples) + b"\x40"
+    vrtypes = bytes((N_VARIANTS + 1) // 2)
+    vrec_lens = bytes([rec_len]) * N_VARIANTS
+    first_record = len(header) + 8 + len(vrtypes) + len(vrec_lens)
+    with open(OUT + ".pgen", "wb") as f:
+        f.write(header)
+        f.write(struct.pack("<Q", first_record))
+        f.write(vrtypes)
+        f.write(vrec_lens)
+        for rec in records:
+            f.write(rec)
+
+    with open(OUT + ".pvar", "w") as f:
+        f.write("#CHROM\tPOS\tID\tREF\tALT\n")
+        for v in range(N_VARIANTS):
+            f.write("1\t%d\tsnp%d\tA\tG\n" % (1000 * (v + 1), v))
+
+    with open(OUT + ".psam", "w") as f:
+        f.write("#IID\tSEX\n")
+        for pop in range(POPS):
+            for k in range(SAMPLES_PER_POP):
+                f.write("pop%d_%d\tNA\n" % (pop + 1, k))
+
+
+if __name__ == "__main__":
+    main()